@@ -34,15 +34,40 @@
 #include "zw_build_no.h"
 #include "zaf_protocol_config.h"
 #include "ZW_TransportEndpoint.h"
+#include "CC_Configuration.h"
 #ifdef DEBUGPRINT
 #include "ZAF_PrintAppInfo.h"
 #endif
 
 #include "max6675.h"
 #include "st7565.h"
+#include "sensor_sample_cache.h"
+#include "report_policy.h"
+#include "sensor_aggregation.h"
+
+/**
+ * Sampling period. Runs off the Multilevel Sensor autoreport timer, which
+ * only reports when report_policy says so. Also the resolution of the
+ * report policy's intervals.
+ */
+#if !defined(APP_SENSOR_SAMPLE_PERIOD_MS)
+#define APP_SENSOR_SAMPLE_PERIOD_MS  (5 * 1000)
+#endif
+
+/**
+ * Configuration parameter telling whether the lifeline controller supports
+ * Multi Command. Must match MultilevelSensor.yaml.
+ */
+#define APP_PARAM_LIFELINE_MULTI_CMD  12
 
 static zpal_pm_handle_t radio_power_lock;
 
+/**
+ * Set when a report was requested by the user, it goes out unconditionally
+ * once the acquisition started for it has finished.
+ */
+static bool report_on_next_sample = false;
+
 #ifdef DEBUGPRINT
 static uint8_t m_aDebugPrintBuffer[96];
 // Debug port is defined in apps hardware file
@@ -118,6 +143,9 @@ ApplicationTask(SApplicationHandles* pAppHandles)
 
   DPRINT("Multilevel Sensor Main App/Task started!\n");
 
+  // Must be set before ZAF_Init() so the CC starts its timer with this period.
+  cc_multilevel_sensor_set_autoreport_period(APP_SENSOR_SAMPLE_PERIOD_MS);
+
   ZAF_Init(xTaskGetCurrentTaskHandle(), pAppHandles);
 
 #ifdef DEBUGPRINT
@@ -138,6 +166,8 @@ ApplicationTask(SApplicationHandles* pAppHandles)
    *     initialized first.
    */
   AppTimerDeepSleepPersistentLoadAll(resetReason);
+  // Same for the aggregation window, the sensor is registered by now.
+  sensor_aggregation_init(resetReason);
 
   if (ZPAL_RESET_REASON_DEEP_SLEEP_EXT_INT == resetReason)
   {
@@ -164,7 +194,8 @@ ApplicationTask(SApplicationHandles* pAppHandles)
   max6675_init();
   initialize_spi();
   display_init();
-  init_timer_30s();
+  // Have a sample cached before the first Get or report.
+  (void) sensor_sample_cache_acquire();
 
   // Wait for and process events
   DPRINT("Multilevel Sensor Event Distributor Started\n");
@@ -192,15 +223,78 @@ zaf_event_distributor_app_event_manager(const uint8_t event)
     case EVENT_APP_SEND_BATTERY_LEVEL_AND_SENSOR_REPORT:
       // (void) CC_Battery_LevelReport_tx(NULL,ENDPOINT_ROOT, NULL);      
       // display_test_on_button_press();
-      cc_multilevel_sensor_send_sensor_data();
+      // Report once a fresh sample is in, see EVENT_APP_MAX6675_SAMPLE.
+      report_on_next_sample = true;
+      (void) sensor_sample_cache_acquire();
+      break;
+    case EVENT_APP_DISPLAY_UPDATE:
+      // A refresh was requested while the previous one was still in flight.
+      display_update();
+      break;
+    case EVENT_APP_MAX6675_SAMPLE:
+      if (!max6675_process())
+      {
+        // More conversions to go, or a stale event.
+        break;
+      }
+      (void) sensor_sample_cache_update();
+      sensor_aggregation_add_cached_sample();
+      if (report_on_next_sample)
+      {
+        report_on_next_sample = false;
+        report_policy_mark_reported();
+        cc_multilevel_sensor_send_sensor_data();
+      }
+      else if (report_policy_is_due())
+      {
+        cc_multilevel_sensor_send_sensor_data();
+      }
       break;
     default:
       break;
   }
 }
 
+/**
+ * Called by the Multilevel Sensor autoreport timer, so sampling runs off one
+ * deep sleep aware clock. Only starts the acquisition, the report policy is
+ * evaluated when it finishes.
+ */
+void
+cc_multilevel_sensor_autoreport_acquire(void)
+{
+  (void) sensor_sample_cache_acquire();
+}
+
+/**
+ * The timer expiry only starts an acquisition. Reports are sent from
+ * EVENT_APP_MAX6675_SAMPLE once the sample is in, see report_policy.h.
+ */
+bool
+cc_multilevel_sensor_autoreport_is_due(void)
+{
+  return false;
+}
+
+/**
+ * The device has no way to learn the lifeline controller's command classes,
+ * so whoever includes it says whether Multi Command may be used.
+ */
+bool
+cc_multilevel_sensor_destination_supports_multi_cmd(__attribute__((unused)) const zaf_tx_options_t *tx_options)
+{
+  cc_config_parameter_buffer_t parameter;
+
+  if (!cc_configuration_get(APP_PARAM_LIFELINE_MULTI_CMD, &parameter))
+  {
+    return false;
+  }
+  return (0 != parameter.data_buffer.as_int32);
+}
+
 void
 zaf_nvm_app_reset(void)
 {
   AppTimerDeepSleepPersistentResetStorage();
+  cc_multilevel_sensor_aggregation_reset();
 }
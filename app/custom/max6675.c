@@ -1,53 +1,163 @@
 #define DEBUGPRINT
 #include "DebugPrint.h"
-#include "sysctrl.h"
 #include "tr_hal_spi.h"
-#include "T32CZ20_spi.h"
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include "max6675.h"
+#include "AppTimer.h"
+#include "SwTimer.h"
+#include "TickTime.h"
 #include "events.h"
+#include "zaf_event_distributor_soc.h"
+#include "spi_scheduler.h"
+#include "max6675.h"
+
+#define MAX6675_FRAME_SIZE        2
+#define MAX6675_OPEN_CIRCUIT_BIT  0x0004
+// Q4 fixed point for the IIR state, in 1/100 degree.
+#define MAX6675_IIR_FRACTION_BITS 4
+
+typedef enum
+{
+    MAX6675_STATE_IDLE = 0,
+    MAX6675_STATE_CONVERTING,   ///< Waiting for the conversion window.
+    MAX6675_STATE_TRANSFERRING  ///< Frame in flight, completes in the ISR.
+} max6675_state_t;
 
 static bool max6675_initialized = false;
+static max6675_state_t max6675_state = MAX6675_STATE_IDLE;
+static SSwTimer max6675_timer;
+
+// Reads go out at high priority, ahead of display refresh segments queued
+// on the same bus.
+static const uint8_t max6675_dummy_tx[MAX6675_FRAME_SIZE] = {0xFF, 0xFF};
+static uint8_t max6675_rx_frame[MAX6675_FRAME_SIZE];
+static spi_transaction_t max6675_transaction;
+// Set by the SPI ISR.
+static volatile bool max6675_transfer_done = false;
+static volatile bool max6675_transfer_ok = false;
+
+// Tick time CS was last released, i.e. when the running conversion started.
+static uint32_t max6675_conversion_start = 0;
+static bool max6675_conversion_started = false;
+
+static int max6675_batch[MAX6675_OVERSAMPLING];
+static uint8_t max6675_batch_count = 0;
+static max6675_status_t max6675_batch_status = MAX6675_OK;
+
+#if MAX6675_FILTER == MAX6675_FILTER_IIR
+static int32_t max6675_iir_q4 = 0;
+static bool max6675_iir_primed = false;
+#endif
+
+static int max6675_result_x100 = 0;
+static max6675_status_t max6675_result_status = MAX6675_ERROR;
 
-static tr_hal_timer_settings_t timer_settings_30s = DEFAULT_32MHZ_TIMER_CONFIG;
+static void max6675_schedule_next(void);
 
-static void timer_30sec_callback(tr_hal_timer_id_t expired_timer_id)
+// SPI ISR context: the frame is in, the app task decodes it.
+static void max6675_transfer_done_handler(__attribute__((unused)) spi_transaction_t *transaction, bool success)
 {
-   if (expired_timer_id == TIMER_0_ID)
+    max6675_transfer_ok = success;
+    max6675_transfer_done = true;
+    (void) zaf_event_distributor_enqueue_app_event_from_isr(EVENT_APP_MAX6675_SAMPLE);
+}
+
+static void max6675_start_transfer(void)
+{
+    max6675_transfer_done = false;
+    max6675_state = MAX6675_STATE_TRANSFERRING;
+
+    if (!spi_scheduler_submit(&max6675_transaction))
     {
-        DPRINT("Timer 30s runing\n");
-        //cc_multilevel_sensor_send_sensor_data();
-        zaf_event_distributor_app_event_manager(EVENT_APP_SEND_BATTERY_LEVEL_AND_SENSOR_REPORT);
+        DPRINT("MAX6675: TX failed\n");
+        max6675_batch_status = MAX6675_ERROR;
+        max6675_state = MAX6675_STATE_IDLE;
+        (void) zaf_event_distributor_enqueue_app_event(EVENT_APP_MAX6675_SAMPLE);
+        return;
     }
+
+    // The wait for the bus behind a refresh segment counts against the
+    // timeout as well, one segment is far shorter.
+    TimerStart(&max6675_timer, MAX6675_TRANSFER_TIMEOUT_MS);
 }
 
+static void max6675_timer_callback(__attribute__((unused)) SSwTimer *pTimer)
+{
+    if (MAX6675_STATE_CONVERTING == max6675_state)
+    {
+        max6675_start_transfer();
+    }
+    else if (MAX6675_STATE_TRANSFERRING == max6675_state)
+    {
+        DPRINT("MAX6675: RX timeout\n");
+        spi_scheduler_cancel(&max6675_transaction);
+        max6675_batch_status = MAX6675_ERROR;
+        max6675_state = MAX6675_STATE_IDLE;
+        (void) zaf_event_distributor_enqueue_app_event(EVENT_APP_MAX6675_SAMPLE);
+    }
+}
 
-void init_timer_30s(void)
+/*
+ * Reading while the chip converts aborts the conversion and returns the
+ * previous one again, so the next frame is only clocked out once the window
+ * since the last CS release has passed.
+ */
+static void max6675_schedule_next(void)
 {
-    tr_hal_status_t status;
-
-    
-    timer_settings_30s.timer_start_value = 32000 * 30; 
-    timer_settings_30s.prescalar = TR_HAL_TIMER_PRESCALER_1024;
-    timer_settings_30s.interrupt_enabled = true;
-    timer_settings_30s.timer_repeats = true;
-    timer_settings_30s.timer_enabled = true;
-    timer_settings_30s.event_handler_fx = timer_30sec_callback;
-    timer_settings_30s.interrupt_priority = TR_HAL_INTERRUPT_PRIORITY_5;
-    status = tr_hal_timer_init(TIMER_0_ID, &timer_settings_30s);
-    if (status == TR_HAL_SUCCESS)
-    {
-        DPRINT("Timer init correctly\n");
-        tr_hal_timer_start(TIMER_0_ID);
-        DPRINT("Timer 0 start\n");
+    uint32_t elapsed_ms = getTickTimePassed(max6675_conversion_start) * portTICK_PERIOD_MS;
+
+    if (!max6675_conversion_started || (elapsed_ms >= MAX6675_CONVERSION_TIME_MS))
+    {
+        max6675_start_transfer();
+        return;
     }
-    else
+
+    max6675_state = MAX6675_STATE_CONVERTING;
+    TimerStart(&max6675_timer, MAX6675_CONVERSION_TIME_MS - elapsed_ms);
+}
+
+#if MAX6675_FILTER == MAX6675_FILTER_MEDIAN
+static int max6675_filter_batch(void)
+{
+    int sorted[MAX6675_OVERSAMPLING];
+
+    // Insertion sort, the batch is at most 8 entries.
+    for (uint8_t i = 0; i < max6675_batch_count; i++)
     {
-        DPRINT("Error init timer\n");
+        int value = max6675_batch[i];
+        uint8_t j = i;
+        while ((j > 0) && (sorted[j - 1] > value))
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
     }
+
+    uint8_t middle = max6675_batch_count / 2;
+    if (max6675_batch_count & 1)
+    {
+        return sorted[middle];
+    }
+    return (sorted[middle - 1] + sorted[middle]) / 2;
 }
+#else
+static int max6675_filter_batch(void)
+{
+    for (uint8_t i = 0; i < max6675_batch_count; i++)
+    {
+        int32_t sample_q4 = (int32_t)max6675_batch[i] << MAX6675_IIR_FRACTION_BITS;
+        if (!max6675_iir_primed)
+        {
+            max6675_iir_q4 = sample_q4;
+            max6675_iir_primed = true;
+        }
+        max6675_iir_q4 += (sample_q4 - max6675_iir_q4) >> MAX6675_IIR_SHIFT;
+    }
+    return (int)((max6675_iir_q4 + (1 << (MAX6675_IIR_FRACTION_BITS - 1))) >> MAX6675_IIR_FRACTION_BITS);
+}
+#endif
 
 max6675_status_t max6675_init(void)
 {
@@ -55,20 +165,30 @@ max6675_status_t max6675_init(void)
 
     tr_hal_spi_settings_t spi_settings = SPI_CONFIG_CONTROLLER_NORMAL_MODE;
 
-    tr_hal_status_t status = tr_hal_spi_init(MAX6675_SPI_ID, &spi_settings);
+    tr_hal_status_t status = spi_scheduler_bus_init(MAX6675_SPI_ID, &spi_settings);
     if (status != TR_HAL_SUCCESS)
     {
         DPRINT("MAX6675: SPI init failed\n");
         return MAX6675_ERROR;
     }
 
+    max6675_transaction.spi_id = MAX6675_SPI_ID;
+    max6675_transaction.cs_index = MAX6675_CS_INDEX;
+    max6675_transaction.priority = SPI_SCHEDULER_PRIORITY_HIGH;
+    max6675_transaction.dc_pin = SPI_SCHEDULER_NO_DC_PIN;
+    max6675_transaction.tx_bytes = max6675_dummy_tx;
+    max6675_transaction.length = MAX6675_FRAME_SIZE;
+    max6675_transaction.rx_bytes = max6675_rx_frame;
+    max6675_transaction.done = max6675_transfer_done_handler;
+
+    AppTimerRegister(&max6675_timer, false, max6675_timer_callback);
+
     max6675_initialized = true;
     DPRINT("MAX6675: Init OK\n");
     return MAX6675_OK;
 }
 
-// Read temperature - returns temperature * 100 (so 25.75°C returns 2575)
-max6675_status_t max6675_read_temperature(int *temp_x100)
+max6675_status_t max6675_start_acquisition(void)
 {
     if (!max6675_initialized)
     {
@@ -76,77 +196,95 @@ max6675_status_t max6675_read_temperature(int *temp_x100)
         return MAX6675_ERROR;
     }
 
-    if (temp_x100 == NULL)
+    if (MAX6675_STATE_IDLE != max6675_state)
     {
-        return MAX6675_ERROR;
+        return MAX6675_BUSY;
     }
 
-    uint8_t rx_buffer[2] = {0};
-    uint8_t dummy_tx[2] = {0xFF, 0xFF};
-    uint16_t num_received = 0;
-
-    DPRINT("MAX6675: Reading...\n");
-
-    // Send dummy data to read
-    tr_hal_status_t status = tr_hal_spi_raw_tx_buffer(
-        MAX6675_SPI_ID,
-        MAX6675_CS_INDEX,
-        (char *)dummy_tx,
-        2,
-        true);
+    max6675_batch_count = 0;
+    max6675_batch_status = MAX6675_OK;
+    max6675_schedule_next();
+    return MAX6675_OK;
+}
 
-    if (status != TR_HAL_SUCCESS)
+bool max6675_process(void)
+{
+    if (MAX6675_STATE_TRANSFERRING == max6675_state)
     {
-        DPRINT("MAX6675: TX failed\n");
-        return MAX6675_ERROR;
-    }
+        if (!max6675_transfer_done)
+        {
+            return false;
+        }
+        TimerStop(&max6675_timer);
 
-    Delay_ms(1);
+        // CS is released now, the chip has started the next conversion.
+        max6675_conversion_start = getTickTime();
+        max6675_conversion_started = true;
 
-    // Read response
-    status = tr_hal_spi_raw_rx_available_bytes(
-        MAX6675_SPI_ID,
-        (char *)rx_buffer,
-        2,
-        &num_received);
+        // Combine bytes (MSB first)
+        uint16_t raw_data = ((uint16_t)max6675_rx_frame[0] << 8) | max6675_rx_frame[1];
 
-    if (status != TR_HAL_STATUS_DONE || num_received != 2)
+        if (!max6675_transfer_ok)
+        {
+            DPRINT("MAX6675: TX failed\n");
+            max6675_batch_status = MAX6675_ERROR;
+        }
+        else if (raw_data & MAX6675_OPEN_CIRCUIT_BIT)
+        {
+            DPRINT("MAX6675: Open circuit\n");
+            max6675_batch_status = MAX6675_OPEN_CIRCUIT;
+        }
+        else
+        {
+            // Bits 14-3, each LSB = 0.25 degree = 25/100 degree
+            max6675_batch[max6675_batch_count++] = (int)((raw_data >> 3) & 0x0FFF) * 25;
+
+            if (max6675_batch_count < MAX6675_OVERSAMPLING)
+            {
+                max6675_schedule_next();
+                return false;
+            }
+        }
+        max6675_state = MAX6675_STATE_IDLE;
+    }
+    else if ((MAX6675_STATE_IDLE != max6675_state) || (MAX6675_OK == max6675_batch_status))
     {
-        DPRINT("MAX6675: RX failed\n");
-        return MAX6675_ERROR;
+        // Stale event, or nothing failed while idle.
+        return false;
     }
 
-    // Combine bytes (MSB first)
-    uint16_t raw_data = ((uint16_t)rx_buffer[0] << 8) | rx_buffer[1];
-
-    // Check for open circuit (bit 2)
-    if (raw_data & 0x0004)
+    // An open thermocouple ends the batch at once, there is nothing to filter.
+    if (MAX6675_OK == max6675_batch_status)
     {
-        DPRINT("MAX6675: Open circuit\n");
-        return MAX6675_OPEN_CIRCUIT;
+        max6675_result_x100 = max6675_filter_batch();
     }
+    max6675_result_status = max6675_batch_status;
+    // Consumed, a later stray event must not report it twice.
+    max6675_batch_status = MAX6675_OK;
+    max6675_batch_count = 0;
 
-    // Extract temperature data (bits 14-3, shift right by 3)
-    uint16_t temp_data = (raw_data >> 3) & 0x0FFF;
-
-    // Convert to temperature * 100 (each LSB = 0.25°C = 25/100°C)
-    *temp_x100 = (int)temp_data * 25;
+    DPRINTF("MAX6675: Status=%d Result=%d\n", max6675_result_status, max6675_result_x100);
+    return true;
+}
 
-    DPRINT("MAX6675: Raw=");
-    DPRINTF("%d", raw_data);
-    DPRINT(" Temp=");
-    DPRINTF("%d", temp_data);
-    DPRINT(" Result=");
-    DPRINTF("%d", *temp_x100);
-    DPRINT("\n");
+bool max6675_is_busy(void)
+{
+    return (MAX6675_STATE_IDLE != max6675_state);
+}
 
-    return MAX6675_OK;
+max6675_status_t max6675_get_result(int *temp_x100)
+{
+    if ((MAX6675_OK == max6675_result_status) && (temp_x100 != NULL))
+    {
+        *temp_x100 = max6675_result_x100;
+    }
+    return max6675_result_status;
 }
 
 void max6675_example_usage(void)
 {
     int temperature_x100;
-    max6675_status_t status = max6675_read_temperature(&temperature_x100);
+    max6675_status_t status = max6675_get_result(&temperature_x100);
 
     if (status == MAX6675_OK)
     {
@@ -1,16 +1,88 @@
+#ifndef MAX6675_DRIVER_H
+#define MAX6675_DRIVER_H
+
+#include <stdbool.h>
+
 #define MAX6675_SPI_ID SPI_0_ID
 #define MAX6675_CS_INDEX 0
 
+// The chip starts a conversion when CS is released and aborts it if CS is
+// asserted again before it is done. The datasheet gives 220 ms max.
+#if !defined(MAX6675_CONVERSION_TIME_MS)
+#define MAX6675_CONVERSION_TIME_MS 220
+#endif
+
+// Give up on a transfer whose completion interrupt never came.
+#if !defined(MAX6675_TRANSFER_TIMEOUT_MS)
+#define MAX6675_TRANSFER_TIMEOUT_MS 10
+#endif
+
+// Number of conversions filtered into one result.
+#if !defined(MAX6675_OVERSAMPLING)
+#define MAX6675_OVERSAMPLING 3
+#endif
+
+#define MAX6675_FILTER_MEDIAN 0
+#define MAX6675_FILTER_IIR    1
+
+// Median of the oversampled batch, or a first order IIR running across
+// batches. The IIR weight of a new conversion is 1 / 2^MAX6675_IIR_SHIFT.
+#if !defined(MAX6675_FILTER)
+#define MAX6675_FILTER MAX6675_FILTER_MEDIAN
+#endif
+
+#if !defined(MAX6675_IIR_SHIFT)
+#define MAX6675_IIR_SHIFT 2
+#endif
+
+#if (MAX6675_OVERSAMPLING < 1) || (MAX6675_OVERSAMPLING > 8)
+#error "MAX6675_OVERSAMPLING must be between 1 and 8"
+#endif
+
 
 typedef enum
 {
     MAX6675_OK = 0,
     MAX6675_ERROR = 1,
-    MAX6675_OPEN_CIRCUIT = 2
+    MAX6675_OPEN_CIRCUIT = 2,
+    MAX6675_BUSY = 3
 } max6675_status_t;
 
 
 max6675_status_t max6675_init(void);
-max6675_status_t max6675_read_temperature(int *temp_x100);
+
+/**
+ * Starts an oversampled acquisition. Never blocks: the conversion window is
+ * waited out on a timer and each transfer completes in the SPI interrupt,
+ * which enqueues EVENT_APP_MAX6675_SAMPLE for the application task.
+ *
+ * @return MAX6675_OK if started, MAX6675_BUSY if one is already running (its
+ *         result serves the caller as well), MAX6675_ERROR if not initialized.
+ */
+max6675_status_t max6675_start_acquisition(void);
+
+/**
+ * Advances the acquisition. Must be called from the application task on
+ * EVENT_APP_MAX6675_SAMPLE.
+ *
+ * @return true when the acquisition finished and a new result is available.
+ */
+bool max6675_process(void);
+
+/**
+ * @return true while an acquisition is running.
+ */
+bool max6675_is_busy(void);
+
+/**
+ * Returns the result of the last finished acquisition. Open thermocouple
+ * and bus errors are kept until the next acquisition finishes.
+ *
+ * @param[out] temp_x100 Filtered temperature * 100, only set on MAX6675_OK.
+ * @return Status of the last acquisition, MAX6675_ERROR if there was none.
+ */
+max6675_status_t max6675_get_result(int *temp_x100);
+
 void max6675_example_usage(void);
-void init_timer_30s(void);
+
+#endif /* MAX6675_DRIVER_H */
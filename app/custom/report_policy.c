@@ -0,0 +1,154 @@
+#define DEBUGPRINT
+#include "DebugPrint.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "TickTime.h"
+#include "CC_Configuration.h"
+#include "sensor_sample_cache.h"
+#include "report_policy.h"
+
+// Limits are configured in whole degrees, delta and hysteresis in tenths,
+// samples come in hundredths.
+#define REPORT_POLICY_LIMIT_TO_X100(x)   ((int32_t)(x) * 100)
+#define REPORT_POLICY_TENTHS_TO_X100(x)  ((int32_t)(x) * 10)
+
+typedef enum
+{
+    REPORT_ZONE_NORMAL = 0,
+    REPORT_ZONE_BELOW_MIN,
+    REPORT_ZONE_ABOVE_MAX
+} report_zone_t;
+
+typedef struct
+{
+    int32_t       temperature_x100;  ///< Value in the last report.
+    uint32_t      timestamp;         ///< Tick time of the last report.
+    report_zone_t zone;              ///< Zone at the last report.
+    bool          valid;             ///< False until something was reported.
+} report_state_t;
+
+static report_state_t m_last_report = { 0 };
+
+static int32_t report_policy_param(uint16_t number, int32_t fallback)
+{
+    cc_config_parameter_buffer_t buffer;
+
+    if (!cc_configuration_get(number, &buffer))
+    {
+        return fallback;
+    }
+    return buffer.data_buffer.as_int32;
+}
+
+/*
+ * A limit is entered as soon as it is crossed, but only left again once the
+ * temperature is back inside by the hysteresis, so a reading sitting on the
+ * limit does not report on every sample.
+ */
+static report_zone_t report_policy_zone(int32_t temperature_x100, report_zone_t current)
+{
+    int32_t min_x100  = REPORT_POLICY_LIMIT_TO_X100(report_policy_param(REPORT_POLICY_PARAM_MIN_LIMIT, 10));
+    int32_t max_x100  = REPORT_POLICY_LIMIT_TO_X100(report_policy_param(REPORT_POLICY_PARAM_MAX_LIMIT, 35));
+    int32_t hyst_x100 = REPORT_POLICY_TENTHS_TO_X100(report_policy_param(REPORT_POLICY_PARAM_HYSTERESIS, 5));
+
+    if (temperature_x100 > max_x100)
+    {
+        return REPORT_ZONE_ABOVE_MAX;
+    }
+    if (temperature_x100 < min_x100)
+    {
+        return REPORT_ZONE_BELOW_MIN;
+    }
+    if ((REPORT_ZONE_ABOVE_MAX == current) && (temperature_x100 > (max_x100 - hyst_x100)))
+    {
+        return REPORT_ZONE_ABOVE_MAX;
+    }
+    if ((REPORT_ZONE_BELOW_MIN == current) && (temperature_x100 < (min_x100 + hyst_x100)))
+    {
+        return REPORT_ZONE_BELOW_MIN;
+    }
+    return REPORT_ZONE_NORMAL;
+}
+
+static void report_policy_record(int32_t temperature_x100, report_zone_t zone)
+{
+    m_last_report.temperature_x100 = temperature_x100;
+    m_last_report.timestamp        = getTickTime();
+    m_last_report.zone             = zone;
+    m_last_report.valid            = true;
+}
+
+bool report_policy_is_due(void)
+{
+    int temperature_x100;
+
+    if (MAX6675_OK != sensor_sample_cache_get(&temperature_x100))
+    {
+        // Nothing to report, the CC would skip the sensor anyway.
+        return false;
+    }
+
+    report_zone_t zone = report_policy_zone(temperature_x100, m_last_report.zone);
+
+    if (!m_last_report.valid)
+    {
+        report_policy_record(temperature_x100, zone);
+        return true;
+    }
+
+    if (zone != m_last_report.zone)
+    {
+        DPRINTF("Report policy: limit zone %d -> %d\n", m_last_report.zone, zone);
+        report_policy_record(temperature_x100, zone);
+        return true;
+    }
+
+    // Whole seconds, the intervals are too long for pdMS_TO_TICKS() to
+    // convert without overflowing.
+    uint32_t elapsed_s = getTickTimePassed(m_last_report.timestamp) / pdMS_TO_TICKS(1000);
+
+    int32_t heartbeat_s = report_policy_param(REPORT_POLICY_PARAM_HEARTBEAT, 3600);
+    if ((heartbeat_s > 0) && (elapsed_s >= (uint32_t)heartbeat_s))
+    {
+        report_policy_record(temperature_x100, zone);
+        return true;
+    }
+
+    int32_t delta_x100 = REPORT_POLICY_TENTHS_TO_X100(report_policy_param(REPORT_POLICY_PARAM_DELTA, 5));
+    if (delta_x100 <= 0)
+    {
+        return false;
+    }
+
+    int32_t change = temperature_x100 - m_last_report.temperature_x100;
+    if (change < 0)
+    {
+        change = -change;
+    }
+    if (change < delta_x100)
+    {
+        return false;
+    }
+
+    int32_t min_interval_s = report_policy_param(REPORT_POLICY_PARAM_MIN_INTERVAL, 30);
+    if ((min_interval_s > 0) && (elapsed_s < (uint32_t)min_interval_s))
+    {
+        // Rate limited, the change stays pending and is picked up by a
+        // later sample if it still holds.
+        return false;
+    }
+
+    report_policy_record(temperature_x100, zone);
+    return true;
+}
+
+void report_policy_mark_reported(void)
+{
+    int temperature_x100;
+
+    if (MAX6675_OK != sensor_sample_cache_get(&temperature_x100))
+    {
+        return;
+    }
+    report_policy_record(temperature_x100, report_policy_zone(temperature_x100, m_last_report.zone));
+}
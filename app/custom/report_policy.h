@@ -0,0 +1,50 @@
+/**
+ * @file report_policy.h
+ *
+ * Decides when the Multilevel Sensor lifeline report is worth sending.
+ *
+ * The autoreport timer only samples; a report goes out when one of these
+ * holds for the cached sample:
+ *  - the temperature crossed the min/max limit (parameters 1 and 2), with
+ *    the hysteresis of parameter 4 before the limit re-arms. Sent at once.
+ *  - the temperature moved by at least the delta threshold (parameter 3)
+ *    since the last report, and the minimum report interval (parameter 5)
+ *    has passed.
+ *  - nothing was reported for the heartbeat interval (parameter 6).
+ *
+ * All parameters are read from CC_Configuration on every evaluation, so a
+ * Configuration Set takes effect on the next sample.
+ */
+#ifndef REPORT_POLICY_H
+#define REPORT_POLICY_H
+
+#include <stdbool.h>
+
+/**
+ * Configuration parameter numbers used by the policy.
+ * Must match MultilevelSensor.yaml.
+ */
+#define REPORT_POLICY_PARAM_MIN_LIMIT        1  ///< Celsius
+#define REPORT_POLICY_PARAM_MAX_LIMIT        2  ///< Celsius
+#define REPORT_POLICY_PARAM_DELTA            3  ///< 0.1 Celsius, 0 disables
+#define REPORT_POLICY_PARAM_HYSTERESIS       4  ///< 0.1 Celsius
+#define REPORT_POLICY_PARAM_MIN_INTERVAL     5  ///< Seconds
+#define REPORT_POLICY_PARAM_HEARTBEAT        6  ///< Seconds, 0 disables
+
+/**
+ * Evaluates the cached sample against the policy.
+ * When it returns true the sample is recorded as the last reported one, the
+ * caller is expected to send the report.
+ *
+ * @return true if a report must be sent now.
+ */
+bool report_policy_is_due(void);
+
+/**
+ * Records the cached sample as reported without evaluating the policy.
+ * Used when a report is sent for another reason, e.g. a button press, so
+ * the delta and the heartbeat restart from what the controller last saw.
+ */
+void report_policy_mark_reported(void);
+
+#endif /* REPORT_POLICY_H */
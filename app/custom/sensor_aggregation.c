@@ -0,0 +1,127 @@
+#define DEBUGPRINT
+#include "DebugPrint.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "ZAF_nvm.h"
+#include "ZAF_file_ids.h"
+#include "CC_Configuration.h"
+#include "cc_configuration_io.h"
+#include "CC_MultilevelSensor_SensorHandler.h"
+#include "CC_MultilevelSensor_Aggregation.h"
+#include "max6675.h"
+#include "sensor_aggregation.h"
+
+#define SENSOR_AGGREGATION_FILE_ID(x)  (ZAF_FILE_ID_CC_CONFIGURATION_BASE + (x))
+
+static const sensor_interface_t* sensor_aggregation_interface(void)
+{
+    sensor_interface_t *interface = NULL;
+    const sensor_type_t *sensor_type = cc_multilevel_sensor_get_sensor_type(SENSOR_NAME_AIR_TEMPERATURE);
+
+    if ((sensor_type == NULL)
+        || (CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK != cc_multilevel_sensor_get_interface(sensor_type->value, &interface)))
+    {
+        return NULL;
+    }
+    return interface;
+}
+
+static void sensor_aggregation_apply_window(void)
+{
+    cc_config_parameter_buffer_t buffer;
+
+    if (cc_configuration_get(SENSOR_AGGREGATION_PARAM_WINDOW, &buffer)
+        && (buffer.data_buffer.as_int32 > 0)
+        && ((uint32_t)buffer.data_buffer.as_int32 != cc_multilevel_sensor_aggregation_get_window()))
+    {
+        (void) cc_multilevel_sensor_aggregation_set_window((uint32_t)buffer.data_buffer.as_int32);
+    }
+}
+
+void sensor_aggregation_init(zpal_reset_reason_t reset_reason)
+{
+    // The window length decides whether the retained samples are still in.
+    sensor_aggregation_apply_window();
+    cc_multilevel_sensor_aggregation_load(reset_reason);
+}
+
+void sensor_aggregation_add_cached_sample(void)
+{
+    int temperature_x100;
+
+    if (MAX6675_OK != max6675_get_result(&temperature_x100))
+    {
+        return;
+    }
+
+    sensor_aggregation_apply_window();
+    (void) cc_multilevel_sensor_aggregation_add_sample(sensor_aggregation_interface(), (int32_t)temperature_x100);
+}
+
+bool sensor_aggregation_get(cc_multilevel_sensor_aggregate_t *aggregate)
+{
+    return (CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK
+            == cc_multilevel_sensor_aggregation_get(sensor_aggregation_interface(), aggregate));
+}
+
+static bool sensor_aggregation_is_aggregate_file(zpal_nvm_object_key_t file_id)
+{
+    return (file_id >= SENSOR_AGGREGATION_FILE_ID(SENSOR_AGGREGATION_FILE_ID_MIN))
+           && (file_id <= SENSOR_AGGREGATION_FILE_ID(SENSOR_AGGREGATION_FILE_ID_COUNT));
+}
+
+/*
+ * Overrides the weak CC_Configuration storage hooks. The aggregate
+ * parameters are computed on every read; writing them, e.g. the defaults on
+ * a Default Reset, is accepted and ignored. Everything else goes to NVM.
+ */
+bool cc_configuration_io_write(zpal_nvm_object_key_t file_id, uint8_t const* data, size_t size)
+{
+    if ((data == NULL) || (size == 0))
+    {
+        return false;
+    }
+    if (sensor_aggregation_is_aggregate_file(file_id))
+    {
+        return true;
+    }
+    return (ZPAL_STATUS_OK == ZAF_nvm_write(file_id, data, size));
+}
+
+bool cc_configuration_io_read(zpal_nvm_object_key_t file_id, uint8_t *data, size_t size)
+{
+    cc_multilevel_sensor_aggregate_t aggregate = { 0 };
+    cc_config_parameter_value_t value;
+
+    if ((data == NULL) || (size == 0))
+    {
+        return false;
+    }
+    if (!sensor_aggregation_is_aggregate_file(file_id))
+    {
+        return (ZPAL_STATUS_OK == ZAF_nvm_read(file_id, data, size));
+    }
+
+    // An empty window reads as all zero.
+    (void) sensor_aggregation_get(&aggregate);
+
+    memset(&value, 0, sizeof(value));
+    switch (file_id - ZAF_FILE_ID_CC_CONFIGURATION_BASE)
+    {
+        case SENSOR_AGGREGATION_FILE_ID_MIN:
+            value.as_int32 = aggregate.min;
+            break;
+        case SENSOR_AGGREGATION_FILE_ID_MAX:
+            value.as_int32 = aggregate.max;
+            break;
+        case SENSOR_AGGREGATION_FILE_ID_MEAN:
+            value.as_int32 = aggregate.mean;
+            break;
+        default:
+            value.as_int32 = (int32_t)aggregate.sample_count;
+            break;
+    }
+    memcpy(data, &value, (size < sizeof(value)) ? size : sizeof(value));
+    return true;
+}
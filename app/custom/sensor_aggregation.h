@@ -0,0 +1,58 @@
+/**
+ * @file sensor_aggregation.h
+ *
+ * Min/max/mean of the thermocouple samples over a configurable window.
+ *
+ * Every processed sample goes into the Multilevel Sensor aggregation window
+ * of the air temperature interface. The aggregate is exposed as read only
+ * Configuration parameters, so a controller reads a trend with a few
+ * Configuration Gets instead of polling every sample:
+ *  - parameter 7 sets the window length in seconds.
+ *  - parameters 8, 9 and 10 are the min, max and mean in 0.01 Celsius.
+ *  - parameter 11 is the number of samples they are made of.
+ *
+ * The read only parameters are served from RAM, they never reach NVM.
+ */
+#ifndef SENSOR_AGGREGATION_H
+#define SENSOR_AGGREGATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zpal_init.h>
+#include "CC_MultilevelSensor_Aggregation.h"
+
+/**
+ * Configuration parameter numbers and file ids.
+ * Must match MultilevelSensor.yaml.
+ */
+#define SENSOR_AGGREGATION_PARAM_WINDOW        7   ///< Seconds
+#define SENSOR_AGGREGATION_PARAM_MIN           8   ///< 0.01 Celsius, read only
+#define SENSOR_AGGREGATION_PARAM_MAX           9   ///< 0.01 Celsius, read only
+#define SENSOR_AGGREGATION_PARAM_MEAN          10  ///< 0.01 Celsius, read only
+#define SENSOR_AGGREGATION_PARAM_COUNT         11  ///< Samples, read only
+
+#define SENSOR_AGGREGATION_FILE_ID_MIN         7
+#define SENSOR_AGGREGATION_FILE_ID_MAX         8
+#define SENSOR_AGGREGATION_FILE_ID_MEAN        9
+#define SENSOR_AGGREGATION_FILE_ID_COUNT       10
+
+/**
+ * Restores the window kept across Deep Sleep. Call once after the sensor
+ * interfaces are registered.
+ */
+void sensor_aggregation_init(zpal_reset_reason_t reset_reason);
+
+/**
+ * Adds the cached sample to the window, if it is a valid reading.
+ * The window length is taken from parameter 7 first, so a Configuration Set
+ * takes effect on the next sample.
+ */
+void sensor_aggregation_add_cached_sample(void);
+
+/**
+ * @param[out] aggregate Aggregate over the window.
+ * @return false if the window holds no sample.
+ */
+bool sensor_aggregation_get(cc_multilevel_sensor_aggregate_t *aggregate);
+
+#endif /* SENSOR_AGGREGATION_H */
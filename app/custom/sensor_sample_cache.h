@@ -0,0 +1,66 @@
+/**
+ * @file sensor_sample_cache.h
+ *
+ * Timestamped cache between the MAX6675 driver and the Multilevel Sensor CC.
+ *
+ * The thermocouple is sampled on the application's schedule and every
+ * consumer (Sensor Multilevel Get, lifeline reports, each scale) is served
+ * from the last sample. The bus is only touched again when the cached
+ * sample is older than the configured max-age.
+ */
+#ifndef SENSOR_SAMPLE_CACHE_H
+#define SENSOR_SAMPLE_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "max6675.h"
+
+/**
+ * Default max-age of a cached sample in milliseconds.
+ * The MAX6675 needs ~220 ms per conversion, so anything below that makes no
+ * difference to what is read back.
+ */
+#if !defined(SENSOR_SAMPLE_CACHE_MAX_AGE_MS)
+#define SENSOR_SAMPLE_CACHE_MAX_AGE_MS  5000
+#endif
+
+/**
+ * Sets how old a cached sample may get before the next read goes to the bus.
+ *
+ * @param max_age_ms Max-age in milliseconds. 0 makes every read hit the bus.
+ */
+void sensor_sample_cache_set_max_age(uint32_t max_age_ms);
+
+/**
+ * @return The current max-age in milliseconds.
+ */
+uint32_t sensor_sample_cache_get_max_age(void);
+
+/**
+ * Starts a new thermocouple acquisition, regardless of the cached sample's
+ * age. Called on the application's sampling schedule. Does not block, the
+ * cache is refreshed by sensor_sample_cache_update() once the driver is done.
+ *
+ * @return MAX6675_OK if started, MAX6675_BUSY if one is already running.
+ */
+max6675_status_t sensor_sample_cache_acquire(void);
+
+/**
+ * Copies the result of the finished acquisition into the cache. Called from
+ * the application task when max6675_process() returns true.
+ *
+ * @return true if the cached sample changed.
+ */
+bool sensor_sample_cache_update(void);
+
+/**
+ * Returns the cached temperature. If the cached sample is stale a new
+ * acquisition is started, but the current one is returned right away.
+ *
+ * @param[out] temperature_x100 Temperature in 1/100 degree Celsius.
+ * @return Status of the sample that was returned, MAX6675_ERROR before the
+ *         first acquisition finished.
+ */
+max6675_status_t sensor_sample_cache_get(int *temperature_x100);
+
+#endif /* SENSOR_SAMPLE_CACHE_H */
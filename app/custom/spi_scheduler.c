@@ -0,0 +1,357 @@
+#define DEBUGPRINT
+#include "DebugPrint.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "tr_hal_spi.h"
+#include "tr_hal_gpio.h"
+#include "sysfun.h"
+#include "spi_scheduler.h"
+
+#if TR_HAL_NUM_SPI != 2
+#error "spi_scheduler has one RX handler per bus, add the missing ones"
+#endif
+
+typedef struct
+{
+    spi_transaction_t* head[SPI_SCHEDULER_PRIORITY_COUNT];
+    spi_transaction_t* tail[SPI_SCHEDULER_PRIORITY_COUNT];
+    spi_transaction_t* volatile current;  ///< On the wire.
+    volatile bool      cancelled;         ///< current was cancelled, its end is awaited.
+    bool               dma;
+    bool               initialized;
+} spi_bus_t;
+
+static spi_bus_t spi_buses[TR_HAL_NUM_SPI];
+
+static spi_transaction_t* spi_scheduler_pop(spi_bus_t *bus)
+{
+    for (uint8_t priority = 0; priority < SPI_SCHEDULER_PRIORITY_COUNT; priority++)
+    {
+        spi_transaction_t *transaction = bus->head[priority];
+        if (transaction != NULL)
+        {
+            bus->head[priority] = transaction->next;
+            if (bus->head[priority] == NULL)
+            {
+                bus->tail[priority] = NULL;
+            }
+            transaction->next = NULL;
+            return transaction;
+        }
+    }
+    return NULL;
+}
+
+// Calls the callbacks of the transactions the HAL refused, in the order
+// they were refused.
+static void spi_scheduler_notify_refused(spi_transaction_t *refused)
+{
+    while (refused != NULL)
+    {
+        spi_transaction_t *transaction = refused;
+        refused = transaction->next;
+        transaction->next = NULL;
+        transaction->submitted = false;
+        if (transaction->done != NULL)
+        {
+            transaction->done(transaction, false);
+        }
+    }
+}
+
+// Starts queued transactions until one is on the wire or the queues are
+// empty. Runs in the SPI interrupt or with interrupts masked. The
+// transactions the HAL refused are returned, so that a caller in task
+// context can report them once it left the critical section.
+static spi_transaction_t* spi_scheduler_start_next(spi_bus_t *bus)
+{
+    spi_transaction_t *refused = NULL;
+    spi_transaction_t *refused_tail = NULL;
+
+    while (bus->current == NULL)
+    {
+        spi_transaction_t *transaction = spi_scheduler_pop(bus);
+        if (transaction == NULL)
+        {
+            break;
+        }
+
+        transaction->rx_count = 0;
+        transaction->tx_done = false;
+        bus->current = transaction;
+
+        if (transaction->dc_pin != SPI_SCHEDULER_NO_DC_PIN)
+        {
+            tr_hal_gpio_pin_t dc_pin = {transaction->dc_pin};
+            tr_hal_gpio_set_output(dc_pin, transaction->dc_level ? TR_HAL_GPIO_LEVEL_HIGH : TR_HAL_GPIO_LEVEL_LOW);
+        }
+
+        tr_hal_status_t status;
+        if (bus->dma)
+        {
+            // Without RX DMA the HAL hands the received bytes to the RX
+            // handler when the transfer is done.
+            status = tr_hal_spi_dma_tx_bytes_in_buffer(transaction->spi_id,
+                                                       transaction->cs_index,
+                                                       (char *)transaction->tx_bytes,
+                                                       transaction->length,
+                                                       transaction->rx_bytes != NULL);
+        }
+        else
+        {
+            status = tr_hal_spi_raw_tx_buffer(transaction->spi_id,
+                                              transaction->cs_index,
+                                              (char *)transaction->tx_bytes,
+                                              transaction->length,
+                                              transaction->rx_bytes != NULL);
+        }
+
+        if (status == TR_HAL_SUCCESS)
+        {
+            break;
+        }
+
+        DPRINTF("SPI%d: transfer refused (%d)\n", transaction->spi_id, status);
+        bus->current = NULL;
+        if (refused_tail == NULL)
+        {
+            refused = transaction;
+        }
+        else
+        {
+            refused_tail->next = transaction;
+        }
+        refused_tail = transaction;
+    }
+    return refused;
+}
+
+static void spi_scheduler_check_done(spi_bus_t *bus)
+{
+    spi_transaction_t *transaction = bus->current;
+
+    if ((transaction == NULL) || !transaction->tx_done)
+    {
+        return;
+    }
+    if ((transaction->rx_bytes != NULL) && (transaction->rx_count < transaction->length))
+    {
+        return;
+    }
+
+    bus->current = NULL;
+    transaction->submitted = false;
+    if (transaction->done != NULL)
+    {
+        transaction->done(transaction, true);
+    }
+    spi_scheduler_notify_refused(spi_scheduler_start_next(bus));
+}
+
+// SPI ISR context.
+static void spi_scheduler_event_handler(tr_hal_spi_id_t spi_id, uint32_t event_bitmask)
+{
+    spi_bus_t *bus = &spi_buses[spi_id];
+
+    // The HAL releases the transmitter on TX_EMPTY. A transfer is only
+    // started when it fits the FIFO or goes by DMA, so this is its end.
+    if (!(event_bitmask & TR_HAL_SPI_EVENT_TX_EMPTY) || (bus->current == NULL))
+    {
+        return;
+    }
+    if (bus->cancelled)
+    {
+        // The HAL stopped the TX DMA and the RX bytes of the cancelled
+        // transfer were dropped, the bus can be reused.
+        bus->cancelled = false;
+        bus->current = NULL;
+        spi_scheduler_notify_refused(spi_scheduler_start_next(bus));
+        return;
+    }
+    bus->current->tx_done = true;
+    spi_scheduler_check_done(bus);
+}
+
+static void spi_scheduler_rx(tr_hal_spi_id_t spi_id, uint8_t num_received_bytes, uint8_t* byte_buffer)
+{
+    spi_bus_t *bus = &spi_buses[spi_id];
+    spi_transaction_t *transaction = bus->current;
+
+    if ((transaction == NULL) || bus->cancelled || (transaction->rx_bytes == NULL))
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; (i < num_received_bytes) && (transaction->rx_count < transaction->length); i++)
+    {
+        transaction->rx_bytes[transaction->rx_count++] = byte_buffer[i];
+    }
+    spi_scheduler_check_done(bus);
+}
+
+// The HAL RX callback does not tell the bus apart.
+static void spi_scheduler_rx_0(uint8_t num_received_bytes, uint8_t* byte_buffer)
+{
+    spi_scheduler_rx(SPI_0_ID, num_received_bytes, byte_buffer);
+}
+
+static void spi_scheduler_rx_1(uint8_t num_received_bytes, uint8_t* byte_buffer)
+{
+    spi_scheduler_rx(SPI_1_ID, num_received_bytes, byte_buffer);
+}
+
+static const tr_hal_spi_receive_callback_t spi_scheduler_rx_handlers[TR_HAL_NUM_SPI] = {
+    spi_scheduler_rx_0,
+    spi_scheduler_rx_1
+};
+
+tr_hal_status_t spi_scheduler_bus_init(tr_hal_spi_id_t spi_id, tr_hal_spi_settings_t *settings)
+{
+    if ((spi_id >= TR_HAL_NUM_SPI) || (settings == NULL))
+    {
+        return TR_HAL_ERROR_INVALID_PARAM;
+    }
+
+    // Read bytes are taken from the RX handler, which RX DMA bypasses.
+    if (settings->rx_dma_enabled)
+    {
+        return TR_HAL_ERROR_INVALID_PARAM;
+    }
+
+    spi_bus_t *bus = &spi_buses[spi_id];
+    memset(bus, 0, sizeof(spi_bus_t));
+
+    settings->event_handler_fx = spi_scheduler_event_handler;
+    settings->rx_handler_function = spi_scheduler_rx_handlers[spi_id];
+
+    tr_hal_status_t status = tr_hal_spi_init(spi_id, settings);
+    if (status == TR_HAL_SUCCESS)
+    {
+        bus->dma = settings->tx_dma_enabled;
+        bus->initialized = true;
+    }
+    return status;
+}
+
+bool spi_scheduler_submit(spi_transaction_t *transaction)
+{
+    if ((transaction == NULL)
+        || (transaction->spi_id >= TR_HAL_NUM_SPI)
+        || (transaction->priority >= SPI_SCHEDULER_PRIORITY_COUNT)
+        || (transaction->tx_bytes == NULL)
+        || (transaction->length == 0))
+    {
+        return false;
+    }
+
+    spi_bus_t *bus = &spi_buses[transaction->spi_id];
+    if (!bus->initialized)
+    {
+        return false;
+    }
+    // Read bytes are collected from the RX FIFO on either kind of bus, and
+    // a transfer without DMA is written to the TX FIFO in one go.
+    if ((transaction->rx_bytes != NULL) ? (transaction->length > TR_HAL_SPI_RX_FIFO_SIZE)
+                                        : (!bus->dma && (transaction->length > TR_HAL_SPI_TX_FIFO_SIZE)))
+    {
+        DPRINTF("SPI%d: transaction not supported on this bus\n", transaction->spi_id);
+        return false;
+    }
+
+    enter_critical_section();
+    if (transaction->submitted)
+    {
+        leave_critical_section();
+        return false;
+    }
+    transaction->submitted = true;
+    transaction->next = NULL;
+    if (bus->tail[transaction->priority] == NULL)
+    {
+        bus->head[transaction->priority] = transaction;
+    }
+    else
+    {
+        bus->tail[transaction->priority]->next = transaction;
+    }
+    bus->tail[transaction->priority] = transaction;
+
+    spi_transaction_t *refused = spi_scheduler_start_next(bus);
+    leave_critical_section();
+
+    // Not from within the critical section, the callbacks may post events.
+    spi_scheduler_notify_refused(refused);
+    return true;
+}
+
+void spi_scheduler_cancel(spi_transaction_t *transaction)
+{
+    if ((transaction == NULL) || (transaction->spi_id >= TR_HAL_NUM_SPI))
+    {
+        return;
+    }
+    spi_bus_t *bus = &spi_buses[transaction->spi_id];
+
+    enter_critical_section();
+    if (!transaction->submitted)
+    {
+        leave_critical_section();
+        return;
+    }
+    transaction->submitted = false;
+
+    if ((bus->current == transaction) && !bus->cancelled)
+    {
+        // The HAL has no way to stop a transfer, the DMA may still read the
+        // TX buffer and the RX FIFO fill up. The bus stays taken until the
+        // TX_EMPTY event of the transfer.
+        bus->cancelled = true;
+        leave_critical_section();
+        return;
+    }
+
+    spi_transaction_t *previous = NULL;
+    spi_transaction_t *entry = bus->head[transaction->priority];
+    while ((entry != NULL) && (entry != transaction))
+    {
+        previous = entry;
+        entry = entry->next;
+    }
+    if (entry != NULL)
+    {
+        if (previous == NULL)
+        {
+            bus->head[transaction->priority] = entry->next;
+        }
+        else
+        {
+            previous->next = entry->next;
+        }
+        if (bus->tail[transaction->priority] == entry)
+        {
+            bus->tail[transaction->priority] = previous;
+        }
+        entry->next = NULL;
+    }
+    leave_critical_section();
+}
+
+bool spi_scheduler_is_idle(tr_hal_spi_id_t spi_id)
+{
+    if (spi_id >= TR_HAL_NUM_SPI)
+    {
+        return true;
+    }
+    spi_bus_t *bus = &spi_buses[spi_id];
+
+    enter_critical_section();
+    bool idle = (bus->current == NULL);
+    for (uint8_t priority = 0; idle && (priority < SPI_SCHEDULER_PRIORITY_COUNT); priority++)
+    {
+        idle = (bus->head[priority] == NULL);
+    }
+    leave_critical_section();
+    return idle;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file spi_scheduler.h
+ *
+ * Queued SPI transactions on top of tr_hal_spi.
+ *
+ * The drivers describe each transfer in a spi_transaction_t they own and
+ * submit it. The scheduler keeps one queue per bus and priority, sets the
+ * DC pin right before the transfer starts and calls the completion callback
+ * from the SPI interrupt, then starts the next transaction. Nothing waits
+ * for the bus: a long framebuffer push is a series of transactions, so a
+ * higher priority sensor read on the same bus goes out between two of them.
+ */
+#ifndef SPI_SCHEDULER_H
+#define SPI_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tr_hal_spi.h"
+
+// No DC pin to set before the transfer.
+#define SPI_SCHEDULER_NO_DC_PIN 0xFF
+
+typedef enum
+{
+    SPI_SCHEDULER_PRIORITY_HIGH = 0,  ///< Sensor reads.
+    SPI_SCHEDULER_PRIORITY_NORMAL,
+    SPI_SCHEDULER_PRIORITY_LOW,       ///< Bulk transfers, e.g. display refresh.
+    SPI_SCHEDULER_PRIORITY_COUNT
+} spi_scheduler_priority_t;
+
+typedef struct spi_transaction spi_transaction_t;
+
+/**
+ * Completion callback, must not block. Runs in SPI interrupt context, except
+ * when the HAL refuses a transfer started by spi_scheduler_submit(). Then
+ * it runs in the caller's context, after the scheduler left its critical
+ * section.
+ *
+ * @param transaction The finished transaction, it can be submitted again.
+ * @param success False if the HAL refused the transfer.
+ */
+typedef void (*spi_transaction_done_t)(spi_transaction_t *transaction, bool success);
+
+struct spi_transaction
+{
+    tr_hal_spi_id_t          spi_id;
+    uint8_t                  cs_index;
+    spi_scheduler_priority_t priority;
+    uint8_t                  dc_pin;     ///< Set to dc_level before the transfer, or SPI_SCHEDULER_NO_DC_PIN.
+    bool                     dc_level;
+    const uint8_t*           tx_bytes;
+    uint16_t                 length;
+    uint8_t*                 rx_bytes;   ///< Receives length bytes, NULL for TX only.
+    spi_transaction_done_t   done;       ///< Optional.
+    void*                    context;    ///< Free for the submitter.
+
+    // Owned by the scheduler while submitted.
+    spi_transaction_t*       next;
+    uint16_t                 rx_count;
+    bool                     tx_done;
+    bool                     submitted;
+};
+
+/**
+ * Initializes a bus and hands its interrupts to the scheduler. The event
+ * and RX handlers in the settings are replaced.
+ *
+ * Transfers use DMA if the settings enable TX DMA, reads included, so one
+ * bus carries the display pages and the sensor reads. A read must fit the RX
+ * FIFO, and without DMA any transaction must fit the TX FIFO.
+ *
+ * @return Status of tr_hal_spi_init(), TR_HAL_ERROR_INVALID_PARAM if the
+ *         settings enable RX DMA.
+ */
+tr_hal_status_t spi_scheduler_bus_init(tr_hal_spi_id_t spi_id, tr_hal_spi_settings_t *settings);
+
+/**
+ * Queues a transaction behind all others of the same or a higher priority
+ * on its bus, and starts it right away if the bus is idle. The transaction
+ * and its buffers must stay valid until it completed or was cancelled.
+ *
+ * @return false if the transaction is invalid or already submitted.
+ */
+bool spi_scheduler_submit(spi_transaction_t *transaction);
+
+/**
+ * Takes a transaction back without calling its callback. A transfer that
+ * is already on the wire runs to its end, and its received bytes are
+ * dropped. Its TX buffer must stay valid until then. The transaction can
+ * be submitted again right away, but the bus starts the next transfer only
+ * after the TX_EMPTY event of the cancelled one. If that event never comes,
+ * spi_scheduler_bus_init() resets the bus.
+ */
+void spi_scheduler_cancel(spi_transaction_t *transaction);
+
+/**
+ * @return true if nothing is queued or in flight on the bus.
+ */
+bool spi_scheduler_is_idle(tr_hal_spi_id_t spi_id);
+
+#endif /* SPI_SCHEDULER_H */
@@ -1,14 +1,18 @@
 #include "tr_hal_spi.h"
-#include "T32CZ20_spi.h"
 #include "tr_hal_gpio.h"
-#include "T32CZ20_gpio.h"
-#include "sysctrl.h"
+#include "sysfun.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include "CC_MultilevelSensor_SensorHandlerTypes.h"
 
+#include "AppTimer.h"
+#include "SwTimer.h"
 #include "st7565.h"
+#include "spi_scheduler.h"
+#include "events.h"
+#include <zaf_event_distributor_soc.h>
+#include <zpal_misc.h>
 #define DEBUGPRINT
 #include "DebugPrint.h"
 
@@ -28,17 +32,53 @@ const uint8_t font5x7[] = {
     0x08,0x36,0x41,0x00,0x00,0x00,0x7F,0x00,0x00,0x00,0x41,0x36,0x08,0x00,0x02,0x01,0x02,0x01,0x00,
 };
 
-static uint8_t spi_tx_buffer[SHARED_SPI_TX_BUFFER_SIZE];
-static volatile bool g_spi_tx_is_complete = true;
-
+// the buffer the application draws into
 static uint8_t display_buffer[LCD_PAGES][LCD_WIDTH];
 
-static void display_dc_set(bool state)
+// what is currently on the glass. pages are copied in here right before
+// they are queued, so this is also the DMA source and the app is free to
+// keep drawing into display_buffer while a refresh is in flight
+static uint8_t display_shadow[LCD_PAGES][LCD_WIDTH];
+
+// one bit per page, set by the drawing functions
+static uint8_t display_dirty_pages = 0;
+
+// one bit per page, set once display_shadow matches the glass
+static uint8_t display_shadow_valid = 0;
+
+// commands that go out in front of the next page payloads (init, contrast)
+static uint8_t display_pending_cmds[DISPLAY_CMD_QUEUE_SIZE];
+static uint8_t display_pending_cmd_count = 0;
+static uint8_t display_cmd_buffer[DISPLAY_CMD_QUEUE_SIZE];
+
+// page / column address commands, one set per page
+static uint8_t display_page_cmds[LCD_PAGES][3];
+
+// last contrast sent, so redraws don't resend it
+static int16_t display_contrast = -1;
+
+// the transfer chain: an optional command segment followed by a
+// command + payload segment pair for each page that changed. all of it is
+// queued on the SPI scheduler at low priority, so a sensor read sharing the
+// bus goes out between two segments
+static spi_transaction_t display_chain[1 + (2 * LCD_PAGES)];
+static uint8_t display_chain_length = 0;
+static volatile bool display_chain_busy = false;
+static volatile bool display_chain_failed = false;
+static volatile bool display_update_pending = false;
+
+typedef enum
 {
-    tr_hal_gpio_pin_t dc_pin = {(uint8_t)DISPLAY_DC_PIN};
-    tr_hal_level_t level = state ? TR_HAL_GPIO_LEVEL_HIGH : TR_HAL_GPIO_LEVEL_LOW;
-    tr_hal_gpio_set_output(dc_pin, level);
-}
+    DISPLAY_RESET_ASSERTED = 0,
+    DISPLAY_RESET_RELEASED,
+    DISPLAY_READY
+} display_reset_state_t;
+
+// the reset pulse is timed by an app timer instead of busy waiting
+static display_reset_state_t display_reset_state = DISPLAY_RESET_ASSERTED;
+static SSwTimer display_reset_timer;
+
+static void display_segment_done(spi_transaction_t* transaction, bool success);
 
 
 static void display_rst_set(bool state)
@@ -50,34 +90,141 @@ static void display_rst_set(bool state)
 
 static void display_send_cmd(uint8_t cmd)
 {
-    display_dc_set(false);
-    tr_hal_status_t status = tr_hal_spi_raw_tx_one_byte(DISPLAY_SPI_ID, DISPLAY_CS_INDEX, cmd, true);
-
-    if (status != TR_HAL_SUCCESS)
+    if (display_pending_cmd_count >= DISPLAY_CMD_QUEUE_SIZE)
     {
-        DPRINTF("ERROR: display_send_cmd failed: %d\n", cmd, status);
+        DPRINTF("ERROR: display command queue full, dropping: 0x%02x\n", cmd);
         return;
     }
+    display_pending_cmds[display_pending_cmd_count++] = cmd;
 }
 
-static void display_send_data(uint8_t data)
+static void display_chain_add(uint8_t index, bool is_data, const uint8_t* bytes, uint16_t length)
 {
-    display_dc_set(true);
-    tr_hal_status_t status = tr_hal_spi_raw_tx_one_byte(DISPLAY_SPI_ID, DISPLAY_CS_INDEX, data, true);
+    spi_transaction_t* segment = &display_chain[index];
+
+    segment->spi_id = DISPLAY_SPI_ID;
+    segment->cs_index = DISPLAY_CS_INDEX;
+    segment->priority = SPI_SCHEDULER_PRIORITY_LOW;
+    segment->dc_pin = DISPLAY_DC_PIN;
+    segment->dc_level = is_data;
+    segment->tx_bytes = bytes;
+    segment->length = length;
+    segment->rx_bytes = NULL;
+    segment->done = display_segment_done;
+}
 
-    if (status != TR_HAL_SUCCESS)
+// builds the transfer chain from the queued commands and the dirty pages.
+// must only be called while no chain is in flight
+static uint8_t display_chain_build(void)
+{
+    uint8_t count = 0;
+
+    if (display_pending_cmd_count > 0)
+    {
+        memcpy(display_cmd_buffer, display_pending_cmds, display_pending_cmd_count);
+        display_chain_add(count++, false, display_cmd_buffer, display_pending_cmd_count);
+        display_pending_cmd_count = 0;
+    }
+
+    for (uint8_t page = 0; page < LCD_PAGES; page++)
+    {
+        if ((display_dirty_pages & (1 << page)) == 0)
+        {
+            continue;
+        }
+        // only pages whose content actually changed go out
+        if ((display_shadow_valid & (1 << page))
+            && (memcmp(display_shadow[page], display_buffer[page], LCD_WIDTH) == 0))
+        {
+            continue;
+        }
+        memcpy(display_shadow[page], display_buffer[page], LCD_WIDTH);
+        display_shadow_valid |= (uint8_t)(1 << page);
+
+        display_chain_add(count++, false, display_page_cmds[page], sizeof(display_page_cmds[page]));
+        display_chain_add(count++, true, display_shadow[page], LCD_WIDTH);
+    }
+    display_dirty_pages = 0;
+
+    display_chain_length = count;
+    display_chain_failed = false;
+    return count;
+}
+
+// drops the chain and forgets what is on the glass, so the next update
+// resends everything
+static void display_chain_abort(void)
+{
+    DPRINT("ERROR: display transfer chain aborted\n");
+    display_shadow_valid = 0;
+    display_dirty_pages = DISPLAY_ALL_PAGES;
+}
+
+// runs once the last segment is done. that is the SPI interrupt, or the
+// app task if the HAL refused the last segment right when it was submitted
+static void display_chain_finish(void)
+{
+    if (display_chain_failed)
+    {
+        display_chain_abort();
+    }
+    display_chain_busy = false;
+
+    // an update came in while we were busy, let the app task rebuild the
+    // chain so the framebuffer is never copied mid-draw
+    if (display_update_pending)
     {
-        DPRINTF("ERROR: display_send_data failed: %d\n", status);
+        display_update_pending = false;
+        if (zpal_in_isr())
+        {
+            zaf_event_distributor_enqueue_app_event_from_isr(EVENT_APP_DISPLAY_UPDATE);
+        }
+        else
+        {
+            zaf_event_distributor_enqueue_app_event(EVENT_APP_DISPLAY_UPDATE);
+        }
+    }
+}
+
+// SPI interrupt context, or the app task for a segment refused on submit.
+// the segments complete in order, a failed one is only noted so the chain
+// still ends on its last segment
+static void display_segment_done(spi_transaction_t* transaction, bool success)
+{
+    if (!success)
+    {
+        display_chain_failed = true;
+    }
+    if (transaction == &display_chain[display_chain_length - 1])
+    {
+        display_chain_finish();
+    }
+}
+
+// holds RST low for 5 ms, then gives the controller 5 ms to come up
+static void display_reset_timer_callback(__attribute__((unused)) SSwTimer *pTimer)
+{
+    if (DISPLAY_RESET_ASSERTED == display_reset_state)
+    {
+        display_rst_set(true);
+        display_reset_state = DISPLAY_RESET_RELEASED;
+        TimerStart(&display_reset_timer, 5);
         return;
     }
+
+    display_reset_state = DISPLAY_READY;
+    if (display_update_pending)
+    {
+        display_update_pending = false;
+        display_update();
+    }
 }
 
 static void display_reset(void)
 {
+    display_reset_state = DISPLAY_RESET_ASSERTED;
     display_rst_set(false);
-    Delay_ms(5);
-    display_rst_set(true);
-    Delay_ms(5);
+    TimerStart(&display_reset_timer, 5);
 }
 
 void display_init(void)
@@ -105,24 +252,24 @@ void display_init(void)
         DPRINTF("ERROR: Failed to initialize display RST pin!\n");
     }
 
+    for (uint8_t page = 0; page < LCD_PAGES; page++)
+    {
+        display_page_cmds[page][0] = 0xB0 + page;
+        display_page_cmds[page][1] = 0x10;
+        display_page_cmds[page][2] = 0x00;
+    }
+
+    AppTimerRegister(&display_reset_timer, false, display_reset_timer_callback);
     display_reset();
 
+    // the init sequence goes out in front of the first frame
     display_send_cmd(0xA2);
-    Delay_ms(5);
     display_send_cmd(0xA0);
-    Delay_ms(5);
     display_send_cmd(0xC8);
-    Delay_ms(5);
     display_send_cmd(0x24);
-    Delay_ms(5);
-    display_send_cmd(0x81);
-    Delay_ms(5);
-    display_send_cmd(30);
-    Delay_ms(5);
+    display_set_contrast(30);
     display_send_cmd(0x2F);
-    Delay_ms(5);
     display_send_cmd(0xAF);
-    Delay_ms(5);
 
     display_clear();
     display_update();
@@ -130,42 +277,67 @@ void display_init(void)
 
 void display_set_contrast(uint8_t contrast)
 {
-    display_send_cmd(0x81);
+    contrast &= 0x3F;
+    if (display_contrast == contrast)
+    {
+        return;
+    }
+    display_contrast = contrast;
 
-    display_send_cmd(contrast & 0x3F);
+    display_send_cmd(0x81);
+    display_send_cmd(contrast);
 }
 
 void display_clear(void)
 {
     memset(display_buffer, 0, sizeof(display_buffer));
+    display_dirty_pages = DISPLAY_ALL_PAGES;
 }
 
+// queues the changed pages and returns right away, the transfer is
+// driven by the SPI scheduler
 void display_update(void)
 {
-    for (uint8_t page = 0; page < LCD_PAGES; page++)
+    enter_critical_section();
+    if (display_chain_busy || (DISPLAY_READY != display_reset_state))
     {
-        display_send_cmd(0xB0 + page);
-        Delay_ms(5);
-
-        display_send_cmd(0x10);
-        Delay_ms(5);
-
-        display_send_cmd(0x00);
-        Delay_ms(5);
-
-        display_dc_set(true);
+        // picked up again once the chain in flight has completed or the
+        // controller is out of reset
+        display_update_pending = true;
+        leave_critical_section();
+        return;
+    }
+    display_chain_busy = true;
+    leave_critical_section();
 
-        tr_hal_status_t status = tr_hal_spi_raw_tx_buffer(DISPLAY_SPI_ID, DISPLAY_CS_INDEX, display_buffer[page], LCD_WIDTH, true);
+    if (display_chain_build() == 0)
+    {
+        display_chain_busy = false;
+        return;
+    }
 
-        if (status != TR_HAL_SUCCESS)
+    for (uint8_t i = 0; i < display_chain_length; i++)
+    {
+        if (spi_scheduler_submit(&display_chain[i]))
+        {
+            continue;
+        }
+        // the chain would never reach its last segment, take it back
+        while (i > 0)
         {
-            DPRINTF("ERROR: tr_hal_spi_raw_tx_buffer failed: %d\n", status);
-            return;
+            spi_scheduler_cancel(&display_chain[--i]);
         }
-        Delay_ms(5);
+        display_chain_abort();
+        display_chain_busy = false;
+        return;
     }
 }
 
+bool display_is_busy(void)
+{
+    return display_chain_busy || (DISPLAY_READY != display_reset_state);
+}
+
 static uint8_t cursor_x = 0;
 static uint8_t cursor_y_page = 0;
 
@@ -193,6 +365,7 @@ void display_print_string(const char *str)
                 display_buffer[cursor_y_page][cursor_x++] = font_char[i];
             }
         }
+        display_dirty_pages |= (uint8_t)(1 << cursor_y_page);
 
         if (cursor_x < LCD_WIDTH)
         {
@@ -222,62 +395,54 @@ void display_temperature(int temperature_centi_degrees)
     display_set_contrast(50);
     display_clear();
 
-    // Convert temperature to float-like string with 2 decimal places
+    // Both lines are printed from hundredths, no float math needed
     char temp_buffer[20];
     char temp_buffer_b[20];
 
-    int integer_part = temperature_centi_degrees / 100;
-    int decimal_part = abs(temperature_centi_degrees % 100);
+    int32_t temperature_f = 0;
+    (void)cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE,
+                                             SENSOR_SCALE_FAHRENHEIT,
+                                             temperature_centi_degrees,
+                                             SENSOR_READ_RESULT_PRECISION_2,
+                                             &temperature_f);
 
-    float temp_c = temperature_centi_degrees / 100.0f;
-    float temp_f = temp_c * 9.0f / 5.0f + 32.0f;
+    const char *sign = (temperature_centi_degrees < 0) ? "-" : "";
+    int integer_part = abs(temperature_centi_degrees / 100);
+    int decimal_part = abs(temperature_centi_degrees % 100);
 
-    int integer_part_f = (int)temp_f;
-    int decimal_part_f = (int)((fabsf(temp_f - integer_part_f)) * 100.0f);
+    const char *sign_f = (temperature_f < 0) ? "-" : "";
+    int integer_part_f = (int)labs((long)(temperature_f / 100));
+    int decimal_part_f = (int)labs((long)(temperature_f % 100));
 
-    DPRINTF("Temp: %d.%02d C\n", integer_part, decimal_part);
-    DPRINTF("Temp: %d.%02d F\n", integer_part_f, decimal_part_f);
+    DPRINTF("Temp: %s%d.%02d C\n", sign, integer_part, decimal_part);
+    DPRINTF("Temp: %s%d.%02d F\n", sign_f, integer_part_f, decimal_part_f);
 
-    snprintf(temp_buffer, sizeof(temp_buffer), "TEMP: %d.%02d C", integer_part, decimal_part);
+    snprintf(temp_buffer, sizeof(temp_buffer), "TEMP: %s%d.%02d C", sign, integer_part, decimal_part);
     
     display_set_cursor(3, 10);
     display_print_string(temp_buffer);
 
     display_set_cursor(5, 10);
-    snprintf(temp_buffer_b, sizeof(temp_buffer_b), "TEMP: %d.%02d F", integer_part_f , decimal_part_f);
+    snprintf(temp_buffer_b, sizeof(temp_buffer_b), "TEMP: %s%d.%02d F", sign_f, integer_part_f, decimal_part_f);
     display_print_string(temp_buffer_b);
 
     display_update();
 }
 
-bool shared_spi_is_tx_complete(void)
-{
-    return g_spi_tx_is_complete;
-}
-
-static void internal_spi_event_handler(tr_hal_spi_id_t spi_id, uint32_t event_bitmask)
-{
-    if (event_bitmask & TR_HAL_SPI_EVENT_TRANSFER_DONE)
-    {
-        g_spi_tx_is_complete = true;
-    }
-}
-
 void initialize_spi(void)
 {
     tr_hal_status_t status;
 
     // Configure SPI settings and set standard pins
     tr_hal_spi_settings_t spi_settings = SPI_CONFIG_CONTROLLER_NORMAL_MODE;
-    spi_settings.raw_tx_buffer = spi_tx_buffer;
-    spi_settings.raw_tx_buff_length = SHARED_SPI_TX_BUFFER_SIZE;
+    spi_settings.tx_dma_enabled = true;
     spi_settings.clock_pin = (tr_hal_gpio_pin_t) { SPI1_CLK_PIN_DISPLAY };
     spi_settings.io_0_pin = (tr_hal_gpio_pin_t) { SPI1_IO0_PIN_DISPLAY };
     spi_settings.io_1_pin = (tr_hal_gpio_pin_t) { SPI1_IO1_PIN_DISPLAY };
     spi_settings.chip_select_0 =  (tr_hal_gpio_pin_t) { SPI1_CS0_PIN_DISPLAY };
 
 
-    status = tr_hal_spi_init(DISPLAY_SPI_ID, &spi_settings);
+    status = spi_scheduler_bus_init(DISPLAY_SPI_ID, &spi_settings);
     if (status != TR_HAL_SUCCESS) {
         DPRINTF("SPI1 init failed with status: %d\n", status);
     } else {
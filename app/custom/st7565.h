@@ -1,3 +1,4 @@
+#ifndef ST7565_DRIVER_H
 #define ST7565_DRIVER_H
 
 #define DISPLAY_SPI_ID SPI_1_ID
@@ -17,11 +18,18 @@
 #define SPI1_MAX_CHIP_SELECT_PINS 1
 #define SPI1_CS0_PIN_DISPLAY 9
 
-#define SHARED_SPI_TX_BUFFER_SIZE 128
+// max number of commands queued between two display_update() calls
+#define DISPLAY_CMD_QUEUE_SIZE 16
+
+#define DISPLAY_ALL_PAGES ((uint8_t)((1U << LCD_PAGES) - 1))
 
 void display_clear(void);
 void display_update(void);
+bool display_is_busy(void);
 void display_init(void);
+void display_set_contrast(uint8_t contrast);
 void initialize_spi(void);
 void display_temperature(int temperature_centi_degrees);
-void display_test_on_button_press(void);
\ No newline at end of file
+void display_test_on_button_press(void);
+
+#endif /* ST7565_DRIVER_H */
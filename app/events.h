@@ -28,6 +28,8 @@ typedef enum EVENT_APP_MULTILEVELSENSOR
 {
   EVENT_EMPTY = DEFINE_EVENT_APP_NBR,
   EVENT_APP_SEND_BATTERY_LEVEL_AND_SENSOR_REPORT,
+  EVENT_APP_DISPLAY_UPDATE,
+  EVENT_APP_MAX6675_SAMPLE,
 }
 EVENT_APP;
 
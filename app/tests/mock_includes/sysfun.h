@@ -0,0 +1,12 @@
+/**
+ * @file sysfun.h
+ *
+ * Test stand-in for the critical section helpers, the tests define them.
+ */
+#ifndef TEST_SYSFUN_H
+#define TEST_SYSFUN_H
+
+void enter_critical_section(void);
+void leave_critical_section(void);
+
+#endif /* TEST_SYSFUN_H */
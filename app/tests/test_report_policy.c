@@ -0,0 +1,209 @@
+/**
+ * @file test_report_policy.c
+ *
+ * Tests of the lifeline report decision. The sample cache, the configuration
+ * parameters and the tick count are faked, so each test sets the temperature
+ * and the time it wants the policy to see.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unity.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "CC_Configuration.h"
+#include "sensor_sample_cache.h"
+#include "report_policy.h"
+
+static int32_t m_params[REPORT_POLICY_PARAM_HEARTBEAT + 1];
+static int m_temperature_x100;
+static max6675_status_t m_sample_status;
+static TickType_t m_tick;
+
+bool cc_configuration_get(uint16_t parameter_number, cc_config_parameter_buffer_t* parameter_buffer)
+{
+    if (parameter_number >= (sizeof(m_params) / sizeof(m_params[0])))
+    {
+        return false;
+    }
+    memset(parameter_buffer, 0, sizeof(cc_config_parameter_buffer_t));
+    parameter_buffer->data_buffer.as_int32 = m_params[parameter_number];
+    return true;
+}
+
+max6675_status_t sensor_sample_cache_get(int *temperature_x100)
+{
+    *temperature_x100 = m_temperature_x100;
+    return m_sample_status;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return m_tick;
+}
+
+static void advance_s(uint32_t seconds)
+{
+    m_tick += pdMS_TO_TICKS(seconds * 1000UL);
+}
+
+// Makes the temperature the last reported one, so every test starts from a
+// known report whatever the tests before left behind.
+static void start_from_report(int temperature_x100)
+{
+    m_temperature_x100 = temperature_x100;
+    report_policy_mark_reported();
+}
+
+static bool is_due_at(int temperature_x100)
+{
+    m_temperature_x100 = temperature_x100;
+    return report_policy_is_due();
+}
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+    // The defaults of MultilevelSensor.yaml.
+    m_params[REPORT_POLICY_PARAM_MIN_LIMIT]    = 10;
+    m_params[REPORT_POLICY_PARAM_MAX_LIMIT]    = 35;
+    m_params[REPORT_POLICY_PARAM_DELTA]        = 5;
+    m_params[REPORT_POLICY_PARAM_HYSTERESIS]   = 5;
+    m_params[REPORT_POLICY_PARAM_MIN_INTERVAL] = 30;
+    m_params[REPORT_POLICY_PARAM_HEARTBEAT]    = 3600;
+    m_sample_status = MAX6675_OK;
+    m_tick = 1000;
+
+    start_from_report(2000);
+}
+
+void tearDown(void)
+{
+}
+
+void test_no_report_without_sample(void)
+{
+    advance_s(7200);
+    m_sample_status = MAX6675_OPEN_CIRCUIT;
+    TEST_ASSERT_FALSE(is_due_at(4000));
+}
+
+/**
+ * A crossed limit is reported at once, even within the minimum interval, and
+ * only once while the temperature stays beyond it.
+ */
+void test_limit_crossing(void)
+{
+    TEST_ASSERT_FALSE(is_due_at(3500));
+    TEST_ASSERT_TRUE(is_due_at(3501));
+    TEST_ASSERT_FALSE(is_due_at(3530));
+
+    TEST_ASSERT_TRUE(is_due_at(999));
+    TEST_ASSERT_FALSE(is_due_at(990));
+}
+
+/**
+ * A crossed limit re-arms only once the temperature is back inside by the
+ * hysteresis. Leaving the limit is a report of its own.
+ */
+void test_limit_rearms_after_hysteresis(void)
+{
+    TEST_ASSERT_TRUE(is_due_at(3501));
+
+    // Back below the limit, but within the 0.5 degree hysteresis.
+    TEST_ASSERT_FALSE(is_due_at(3490));
+    TEST_ASSERT_FALSE(is_due_at(3501));
+    TEST_ASSERT_FALSE(is_due_at(3451));
+
+    TEST_ASSERT_TRUE(is_due_at(3449));
+    TEST_ASSERT_TRUE(is_due_at(3501));
+
+    // The same on the lower limit.
+    TEST_ASSERT_TRUE(is_due_at(2000));
+    TEST_ASSERT_TRUE(is_due_at(999));
+    TEST_ASSERT_FALSE(is_due_at(1049));
+    TEST_ASSERT_TRUE(is_due_at(1050));
+}
+
+void test_delta_threshold(void)
+{
+    advance_s(60);
+    TEST_ASSERT_FALSE(is_due_at(2049));
+    TEST_ASSERT_FALSE(is_due_at(1951));
+    TEST_ASSERT_TRUE(is_due_at(2050));
+
+    // The delta counts from the last report, not from the last sample.
+    advance_s(60);
+    TEST_ASSERT_FALSE(is_due_at(2090));
+    TEST_ASSERT_TRUE(is_due_at(2000));
+
+    // A delta of 0 disables change reports.
+    m_params[REPORT_POLICY_PARAM_DELTA] = 0;
+    advance_s(60);
+    TEST_ASSERT_FALSE(is_due_at(3000));
+}
+
+/**
+ * A change within the minimum interval is held back and reported by the
+ * first sample after the interval that still shows it.
+ */
+void test_min_interval_suppression(void)
+{
+    advance_s(10);
+    TEST_ASSERT_FALSE(is_due_at(2100));
+    advance_s(19);
+    TEST_ASSERT_FALSE(is_due_at(2100));
+    advance_s(1);
+    TEST_ASSERT_TRUE(is_due_at(2100));
+
+    // The change went away before the interval passed.
+    advance_s(10);
+    TEST_ASSERT_FALSE(is_due_at(2200));
+    advance_s(20);
+    TEST_ASSERT_FALSE(is_due_at(2110));
+
+    m_params[REPORT_POLICY_PARAM_MIN_INTERVAL] = 0;
+    TEST_ASSERT_TRUE(is_due_at(2200));
+}
+
+void test_heartbeat(void)
+{
+    advance_s(3599);
+    TEST_ASSERT_FALSE(is_due_at(2000));
+    advance_s(1);
+    TEST_ASSERT_TRUE(is_due_at(2000));
+
+    // The heartbeat restarts from every report.
+    advance_s(1800);
+    TEST_ASSERT_TRUE(is_due_at(2100));
+    advance_s(3599);
+    TEST_ASSERT_FALSE(is_due_at(2100));
+    advance_s(1);
+    TEST_ASSERT_TRUE(is_due_at(2100));
+
+    // A heartbeat of 0 disables it.
+    m_params[REPORT_POLICY_PARAM_HEARTBEAT] = 0;
+    advance_s(86400);
+    TEST_ASSERT_FALSE(is_due_at(2100));
+}
+
+/**
+ * A report sent for another reason restarts the delta and the heartbeat.
+ */
+void test_mark_reported(void)
+{
+    advance_s(3000);
+    start_from_report(2100);
+
+    advance_s(3599);
+    TEST_ASSERT_FALSE(is_due_at(2140));
+    advance_s(1);
+    TEST_ASSERT_TRUE(is_due_at(2140));
+}
@@ -0,0 +1,386 @@
+/**
+ * @file test_spi_scheduler.c
+ *
+ * Tests of the SPI transaction queues against a fake HAL. The fake records
+ * every transfer started, and a test ends a transfer by calling the handlers
+ * the scheduler installed, the way the SPI interrupt does.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unity.h>
+#include "tr_hal_spi.h"
+#include "tr_hal_gpio.h"
+#include "sysfun.h"
+#include "spi_scheduler.h"
+
+#define MAX_TRANSFERS  8
+#define PAGE_SIZE      128
+
+typedef struct
+{
+    tr_hal_spi_id_t spi_id;
+    const uint8_t*  bytes;
+    uint16_t        length;
+    bool            receive;
+    bool            dma;
+} transfer_t;
+
+static tr_hal_spi_settings_t m_bus_settings[TR_HAL_NUM_SPI];
+static transfer_t m_transfers[MAX_TRANSFERS];
+static uint8_t m_transfer_count;
+static tr_hal_status_t m_transfer_status;
+static int m_critical_depth;
+
+static spi_transaction_t* m_done[MAX_TRANSFERS];
+static bool m_done_success[MAX_TRANSFERS];
+static uint8_t m_done_count;
+
+void enter_critical_section(void)
+{
+    m_critical_depth++;
+}
+
+void leave_critical_section(void)
+{
+    m_critical_depth--;
+}
+
+tr_hal_status_t tr_hal_spi_init(tr_hal_spi_id_t spi_id, tr_hal_spi_settings_t* spi_settings)
+{
+    m_bus_settings[spi_id] = *spi_settings;
+    return TR_HAL_SUCCESS;
+}
+
+static tr_hal_status_t fake_transfer(tr_hal_spi_id_t spi_id, char* bytes, uint16_t length, bool receive, bool dma)
+{
+    TEST_ASSERT_TRUE(m_transfer_count < MAX_TRANSFERS);
+    TEST_ASSERT_EQUAL(dma, m_bus_settings[spi_id].tx_dma_enabled);
+    if (m_transfer_status != TR_HAL_SUCCESS)
+    {
+        return m_transfer_status;
+    }
+    m_transfers[m_transfer_count].spi_id  = spi_id;
+    m_transfers[m_transfer_count].bytes   = (const uint8_t *)bytes;
+    m_transfers[m_transfer_count].length  = length;
+    m_transfers[m_transfer_count].receive = receive;
+    m_transfers[m_transfer_count].dma     = dma;
+    m_transfer_count++;
+    return TR_HAL_SUCCESS;
+}
+
+tr_hal_status_t tr_hal_spi_raw_tx_buffer(tr_hal_spi_id_t spi_id,
+                                         uint8_t         chip_select_index_to_use,
+                                         char*           bytes_to_send,
+                                         uint16_t        num_bytes_to_send,
+                                         bool            receive_bytes)
+{
+    (void)chip_select_index_to_use;
+    return fake_transfer(spi_id, bytes_to_send, num_bytes_to_send, receive_bytes, false);
+}
+
+tr_hal_status_t tr_hal_spi_dma_tx_bytes_in_buffer(tr_hal_spi_id_t spi_id,
+                                                  uint8_t         chip_select_index_to_use,
+                                                  char*           bytes_to_send,
+                                                  uint16_t        num_bytes_to_send,
+                                                  bool            receive_bytes)
+{
+    (void)chip_select_index_to_use;
+    return fake_transfer(spi_id, bytes_to_send, num_bytes_to_send, receive_bytes, true);
+}
+
+tr_hal_status_t tr_hal_gpio_set_output(tr_hal_gpio_pin_t pin, tr_hal_level_t level)
+{
+    (void)pin;
+    (void)level;
+    return TR_HAL_SUCCESS;
+}
+
+// The SPI interrupt at the end of a transfer: the received bytes first, then
+// the events.
+static void complete_transfer(tr_hal_spi_id_t spi_id, uint8_t *received, uint8_t count)
+{
+    if (count > 0)
+    {
+        m_bus_settings[spi_id].rx_handler_function(count, received);
+    }
+    m_bus_settings[spi_id].event_handler_fx(spi_id, TR_HAL_SPI_EVENT_TX_EMPTY | TR_HAL_SPI_EVENT_TRANSFER_DONE);
+}
+
+static void transaction_done(spi_transaction_t *transaction, bool success)
+{
+    TEST_ASSERT_EQUAL(0, m_critical_depth);
+    TEST_ASSERT_TRUE(m_done_count < MAX_TRANSFERS);
+    m_done[m_done_count] = transaction;
+    m_done_success[m_done_count] = success;
+    m_done_count++;
+}
+
+static void init_bus(tr_hal_spi_id_t spi_id, bool dma)
+{
+    tr_hal_spi_settings_t settings;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.tx_dma_enabled = dma;
+    TEST_ASSERT_EQUAL(TR_HAL_SUCCESS, spi_scheduler_bus_init(spi_id, &settings));
+}
+
+static void init_transaction(spi_transaction_t *transaction,
+                             spi_scheduler_priority_t priority,
+                             const uint8_t *tx_bytes,
+                             uint16_t length,
+                             uint8_t *rx_bytes)
+{
+    memset(transaction, 0, sizeof(spi_transaction_t));
+    transaction->spi_id   = SPI_0_ID;
+    transaction->priority = priority;
+    transaction->dc_pin   = SPI_SCHEDULER_NO_DC_PIN;
+    transaction->tx_bytes = tx_bytes;
+    transaction->length   = length;
+    transaction->rx_bytes = rx_bytes;
+    transaction->done     = transaction_done;
+}
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+    memset(m_bus_settings, 0, sizeof(m_bus_settings));
+    m_transfer_count = 0;
+    m_transfer_status = TR_HAL_SUCCESS;
+    m_critical_depth = 0;
+    m_done_count = 0;
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_EQUAL(0, m_critical_depth);
+}
+
+/**
+ * A display page and a sensor read share a DMA bus. The read is queued
+ * behind a page on the wire and another page waiting, and goes out as soon
+ * as the bus is free, before the waiting page.
+ */
+void test_high_read_overtakes_queued_low_write(void)
+{
+    static uint8_t page_a[PAGE_SIZE];
+    static uint8_t page_b[PAGE_SIZE];
+    uint8_t read_command[2] = {0};
+    uint8_t read_bytes[2] = {0};
+    uint8_t received[2] = {0x12, 0x34};
+    spi_transaction_t write_a;
+    spi_transaction_t write_b;
+    spi_transaction_t read;
+
+    init_bus(SPI_0_ID, true);
+    init_transaction(&write_a, SPI_SCHEDULER_PRIORITY_LOW, page_a, sizeof(page_a), NULL);
+    init_transaction(&write_b, SPI_SCHEDULER_PRIORITY_LOW, page_b, sizeof(page_b), NULL);
+    init_transaction(&read, SPI_SCHEDULER_PRIORITY_HIGH, read_command, sizeof(read_command), read_bytes);
+
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&write_a));
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&write_b));
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&read));
+
+    TEST_ASSERT_EQUAL(1, m_transfer_count);
+    TEST_ASSERT_EQUAL_PTR(page_a, m_transfers[0].bytes);
+    TEST_ASSERT_FALSE(m_transfers[0].receive);
+
+    complete_transfer(SPI_0_ID, NULL, 0);
+
+    TEST_ASSERT_EQUAL(2, m_transfer_count);
+    TEST_ASSERT_EQUAL_PTR(read_command, m_transfers[1].bytes);
+    TEST_ASSERT_EQUAL(sizeof(read_command), m_transfers[1].length);
+    TEST_ASSERT_TRUE(m_transfers[1].dma);
+    TEST_ASSERT_TRUE(m_transfers[1].receive);
+
+    complete_transfer(SPI_0_ID, received, sizeof(received));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(received, read_bytes, sizeof(received));
+    TEST_ASSERT_EQUAL(3, m_transfer_count);
+    TEST_ASSERT_EQUAL_PTR(page_b, m_transfers[2].bytes);
+
+    complete_transfer(SPI_0_ID, NULL, 0);
+
+    TEST_ASSERT_EQUAL(3, m_done_count);
+    TEST_ASSERT_EQUAL_PTR(&write_a, m_done[0]);
+    TEST_ASSERT_EQUAL_PTR(&read, m_done[1]);
+    TEST_ASSERT_EQUAL_PTR(&write_b, m_done[2]);
+    TEST_ASSERT_TRUE(m_done_success[1]);
+    TEST_ASSERT_TRUE(spi_scheduler_is_idle(SPI_0_ID));
+}
+
+/**
+ * A read is done when both its bytes and the end of the transfer are in,
+ * whichever comes last.
+ */
+void test_read_waits_for_all_bytes(void)
+{
+    uint8_t read_command[2] = {0};
+    uint8_t read_bytes[2] = {0};
+    uint8_t received[2] = {0x56, 0x78};
+    spi_transaction_t read;
+
+    init_bus(SPI_0_ID, false);
+    init_transaction(&read, SPI_SCHEDULER_PRIORITY_HIGH, read_command, sizeof(read_command), read_bytes);
+
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&read));
+    TEST_ASSERT_FALSE(m_transfers[0].dma);
+    TEST_ASSERT_TRUE(m_transfers[0].receive);
+
+    complete_transfer(SPI_0_ID, received, 1);
+    TEST_ASSERT_EQUAL(0, m_done_count);
+
+    m_bus_settings[SPI_0_ID].rx_handler_function(1, &received[1]);
+    TEST_ASSERT_EQUAL(1, m_done_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(received, read_bytes, sizeof(received));
+}
+
+void test_transaction_limits(void)
+{
+    static uint8_t bytes[TR_HAL_SPI_TX_FIFO_SIZE + 1];
+    static uint8_t read_bytes[TR_HAL_SPI_RX_FIFO_SIZE + 1];
+    spi_transaction_t transaction;
+
+    // Without DMA everything goes through the TX FIFO.
+    init_bus(SPI_0_ID, false);
+    init_transaction(&transaction, SPI_SCHEDULER_PRIORITY_LOW, bytes, TR_HAL_SPI_TX_FIFO_SIZE + 1, NULL);
+    TEST_ASSERT_FALSE(spi_scheduler_submit(&transaction));
+    transaction.length = TR_HAL_SPI_TX_FIFO_SIZE;
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&transaction));
+    complete_transfer(SPI_0_ID, NULL, 0);
+
+    // With DMA only reads are limited, by the RX FIFO.
+    init_bus(SPI_0_ID, true);
+    init_transaction(&transaction, SPI_SCHEDULER_PRIORITY_LOW, bytes, TR_HAL_SPI_TX_FIFO_SIZE + 1, NULL);
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&transaction));
+    complete_transfer(SPI_0_ID, NULL, 0);
+
+    init_transaction(&transaction, SPI_SCHEDULER_PRIORITY_HIGH, bytes, TR_HAL_SPI_RX_FIFO_SIZE + 1, read_bytes);
+    TEST_ASSERT_FALSE(spi_scheduler_submit(&transaction));
+
+    TEST_ASSERT_EQUAL(2, m_transfer_count);
+}
+
+void test_rx_dma_rejected(void)
+{
+    tr_hal_spi_settings_t settings;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.tx_dma_enabled = true;
+    settings.rx_dma_enabled = true;
+    TEST_ASSERT_EQUAL(TR_HAL_ERROR_INVALID_PARAM, spi_scheduler_bus_init(SPI_0_ID, &settings));
+}
+
+/**
+ * A transfer the HAL refuses is reported after the critical section, and
+ * the next transaction is started in its place.
+ */
+void test_refused_transfer(void)
+{
+    uint8_t command[2] = {0};
+    spi_transaction_t refused;
+    spi_transaction_t next;
+
+    init_bus(SPI_0_ID, true);
+    init_transaction(&refused, SPI_SCHEDULER_PRIORITY_HIGH, command, sizeof(command), NULL);
+    init_transaction(&next, SPI_SCHEDULER_PRIORITY_LOW, command, sizeof(command), NULL);
+
+    m_transfer_status = TR_HAL_ERROR_NOT_INITIALIZED;
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&refused));
+    TEST_ASSERT_EQUAL(1, m_done_count);
+    TEST_ASSERT_EQUAL_PTR(&refused, m_done[0]);
+    TEST_ASSERT_FALSE(m_done_success[0]);
+    TEST_ASSERT_TRUE(spi_scheduler_is_idle(SPI_0_ID));
+
+    // It can be submitted again right away.
+    m_transfer_status = TR_HAL_SUCCESS;
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&refused));
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&next));
+    m_transfer_status = TR_HAL_ERROR_NOT_INITIALIZED;
+    complete_transfer(SPI_0_ID, NULL, 0);
+
+    TEST_ASSERT_EQUAL(3, m_done_count);
+    TEST_ASSERT_TRUE(m_done_success[1]);
+    TEST_ASSERT_EQUAL_PTR(&next, m_done[2]);
+    TEST_ASSERT_FALSE(m_done_success[2]);
+}
+
+/**
+ * Cancelling queued transfers takes them out of the queue. The transfer on
+ * the wire keeps the bus until its TX_EMPTY event, its read bytes are
+ * dropped, and neither gets a callback.
+ */
+void test_cancel(void)
+{
+    uint8_t command[2] = {0};
+    uint8_t received[2] = {0x12, 0x34};
+    uint8_t first_rx[2] = {0};
+    spi_transaction_t first;
+    spi_transaction_t second;
+    spi_transaction_t third;
+
+    init_bus(SPI_0_ID, true);
+    init_transaction(&first, SPI_SCHEDULER_PRIORITY_LOW, command, sizeof(command), first_rx);
+    init_transaction(&second, SPI_SCHEDULER_PRIORITY_LOW, command, sizeof(command), NULL);
+    init_transaction(&third, SPI_SCHEDULER_PRIORITY_LOW, command, sizeof(command), NULL);
+
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&first));
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&second));
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&third));
+
+    spi_scheduler_cancel(&second);
+    spi_scheduler_cancel(&first);
+    TEST_ASSERT_EQUAL(1, m_transfer_count);
+    TEST_ASSERT_FALSE(spi_scheduler_is_idle(SPI_0_ID));
+
+    // A cancelled transaction can be queued again, behind the others.
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&first));
+    TEST_ASSERT_EQUAL(1, m_transfer_count);
+
+    complete_transfer(SPI_0_ID, received, sizeof(received));
+    TEST_ASSERT_EQUAL(0, m_done_count);
+    TEST_ASSERT_EQUAL_HEX8(0, first_rx[0]);
+    TEST_ASSERT_EQUAL(2, m_transfer_count);
+
+    complete_transfer(SPI_0_ID, NULL, 0);
+    TEST_ASSERT_EQUAL(1, m_done_count);
+    TEST_ASSERT_EQUAL_PTR(&third, m_done[0]);
+    TEST_ASSERT_EQUAL(3, m_transfer_count);
+
+    complete_transfer(SPI_0_ID, received, sizeof(received));
+    TEST_ASSERT_EQUAL(2, m_done_count);
+    TEST_ASSERT_EQUAL_PTR(&first, m_done[1]);
+    TEST_ASSERT_TRUE(m_done_success[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x34, first_rx[1]);
+    TEST_ASSERT_TRUE(spi_scheduler_is_idle(SPI_0_ID));
+}
+
+/**
+ * A transaction queued again after its transfer on the wire was cancelled
+ * can be cancelled once more, which only takes it out of the queue.
+ */
+void test_cancel_resubmitted(void)
+{
+    uint8_t command[2] = {0};
+    spi_transaction_t first;
+
+    init_bus(SPI_0_ID, true);
+    init_transaction(&first, SPI_SCHEDULER_PRIORITY_LOW, command, sizeof(command), NULL);
+
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&first));
+    spi_scheduler_cancel(&first);
+    TEST_ASSERT_TRUE(spi_scheduler_submit(&first));
+    spi_scheduler_cancel(&first);
+
+    complete_transfer(SPI_0_ID, NULL, 0);
+    TEST_ASSERT_EQUAL(1, m_transfer_count);
+    TEST_ASSERT_EQUAL(0, m_done_count);
+    TEST_ASSERT_TRUE(spi_scheduler_is_idle(SPI_0_ID));
+}
@@ -13,13 +13,29 @@
 #include "adc_drv.h"
 #include <CC_Battery.h>
 #include <CC_MultilevelSensor_SensorHandlerTypes.h>
+#include "TickTime.h"
 
 #include "max6675.h"
 #include "st7565.h"
+#include "sensor_sample_cache.h"
 
 #define MY_BATTERY_SPEC_LEVEL_FULL         3000  // My battery's 100% level (millivolts)
 #define MY_BATTERY_SPEC_LEVEL_EMPTY        2400  // My battery's 0% level (millivolts)
 
+/**
+ * Last thermocouple sample, shared by all consumers and scales.
+ */
+typedef struct
+{
+  int              temperature_x100;
+  max6675_status_t status;
+  uint32_t         timestamp;  ///< Tick time of the read.
+  bool             valid;      ///< False until the first read.
+} sensor_sample_t;
+
+static sensor_sample_t m_sample = { 0 };
+static uint32_t m_sample_max_age_ms = SENSOR_SAMPLE_CACHE_MAX_AGE_MS;
+
 uint8_t
 CC_Battery_BatteryGet_handler(uint8_t endpoint)
 {
@@ -72,43 +88,84 @@ void app_hw_deep_sleep_wakeup_handler(void)
      from deep sleep. */
 }
 
+void sensor_sample_cache_set_max_age(uint32_t max_age_ms)
+{
+  m_sample_max_age_ms = max_age_ms;
+}
+
+uint32_t sensor_sample_cache_get_max_age(void)
+{
+  return m_sample_max_age_ms;
+}
+
+max6675_status_t sensor_sample_cache_acquire(void)
+{
+  return max6675_start_acquisition();
+}
+
+bool sensor_sample_cache_update(void)
+{
+  int temperature_x100 = 0;
+  max6675_status_t status = max6675_get_result(&temperature_x100);
+
+  bool changed = !m_sample.valid
+                 || (m_sample.status != status)
+                 || ((MAX6675_OK == status) && (m_sample.temperature_x100 != temperature_x100));
+
+  m_sample.status    = status;
+  m_sample.timestamp = getTickTime();
+  m_sample.valid     = true;
+
+  if (MAX6675_OK == status)
+  {
+    m_sample.temperature_x100 = temperature_x100;
+    // Only redraw when there is something new to show.
+    if (changed)
+    {
+      display_temperature(temperature_x100);
+    }
+  }
+  return changed;
+}
+
+max6675_status_t sensor_sample_cache_get(int *temperature_x100)
+{
+  if (!m_sample.valid || (getTickTimePassed(m_sample.timestamp) >= pdMS_TO_TICKS(m_sample_max_age_ms)))
+  {
+    // Served from what is cached, the fresh sample lands in the cache later.
+    (void)max6675_start_acquisition();
+  }
+
+  if (!m_sample.valid)
+  {
+    return MAX6675_ERROR;
+  }
+
+  if ((MAX6675_OK == m_sample.status) && (temperature_x100 != NULL))
+  {
+    *temperature_x100 = m_sample.temperature_x100;
+  }
+  return m_sample.status;
+}
+
 bool cc_multilevel_sensor_air_temperature_interface_read_value(sensor_read_result_t* o_result, uint8_t i_scale)
 {
 
   int temperature_x100;
-  max6675_status_t status = max6675_read_temperature(&temperature_x100);
+  max6675_status_t status = sensor_sample_cache_get(&temperature_x100);
 
   if (status != MAX6675_OK) {
-    return true;
+    return false;
   }
 
-  int  temperature_celsius = temperature_x100;
-
   if(o_result != NULL)
   {
-    memset(o_result, 0, sizeof(sensor_read_result_t));
-    o_result->precision  = SENSOR_READ_RESULT_PRECISION_2;
-    o_result->size_bytes = SENSOR_READ_RESULT_SIZE_4;
-
-    if(i_scale == SENSOR_SCALE_FAHRENHEIT)
-    {
-      float temperature_celsius_divided = (float)temperature_celsius/(float)100;
-      int temperature_fahrenheit = (int)((temperature_celsius_divided * ((float)9/(float)5) + (float)32)*100);
-
-      o_result->raw_result[3] = (uint8_t)(temperature_fahrenheit&0xFF);
-      o_result->raw_result[2] = (uint8_t)((temperature_fahrenheit>>8 )&0xFF);
-      o_result->raw_result[1] = (uint8_t)((temperature_fahrenheit>>16)&0xFF);
-      o_result->raw_result[0] = (uint8_t)((temperature_fahrenheit>>24)&0xFF);
-    }
-    else
-    {
-      o_result->raw_result[3] = (uint8_t)(temperature_celsius&0xFF);
-      o_result->raw_result[2] = (uint8_t)((temperature_celsius>>8 )&0xFF);
-      o_result->raw_result[1] = (uint8_t)((temperature_celsius>>16)&0xFF);
-      o_result->raw_result[0] = (uint8_t)((temperature_celsius>>24)&0xFF);
-    }
+    return (SENSOR_INTERFACE_RETURN_VALUE_OK == cc_multilevel_sensor_fill_read_result(o_result,
+                                                                                      SENSOR_NAME_AIR_TEMPERATURE,
+                                                                                      i_scale,
+                                                                                      temperature_x100,
+                                                                                      SENSOR_READ_RESULT_PRECISION_2));
   }
-  display_temperature(temperature_celsius);
 
   return true;
 }
@@ -0,0 +1,34 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_adc.c
+ *
+ * Host stand-in for adc_drv.c. The battery reads as a fixed, full supply.
+ */
+#include <stdint.h>
+#include "adc_drv.h"
+
+#define SIM_ADC_BATTERY_MV     3000
+#define SIM_ADC_TEMPERATURE_C  25
+
+void adc_init(void)
+{
+}
+
+void adc_enable(uint8_t state)
+{
+  (void)state;
+}
+
+void adc_get_voltage(uint32_t *pVoltage)
+{
+  *pVoltage = SIM_ADC_BATTERY_MV;
+}
+
+void adc_get_temp(int32_t *pTemp)
+{
+  *pTemp = SIM_ADC_TEMPERATURE_C;
+}
@@ -0,0 +1,57 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_devices.h
+ *
+ * Simulated parts behind the host SPI bus. sim_hal_spi.c routes SPI_0 to the
+ * thermocouple and SPI_1 to the display, like the DKNCZ20 wiring.
+ *
+ * The simulation is driven by environment variables:
+ *  - SIM_MAX6675_SCRIPT: temperature script, see sim_max6675.c.
+ *  - SIM_DISPLAY_CAPTURE: file the display frames are appended to.
+ *  - SIM_TRACE: file the timing trace is written to, stdout if unset.
+ */
+#ifndef SIM_DEVICES_H
+#define SIM_DEVICES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Clocks out a MAX6675 frame. Reading inside the conversion window returns
+ * the previous conversion again, like the real chip.
+ *
+ * @param[out] rx Received bytes.
+ * @param[in] length Number of bytes clocked.
+ */
+void sim_max6675_transfer(uint8_t *rx, uint16_t length);
+
+/**
+ * CS went high, the chip starts the next conversion.
+ */
+void sim_max6675_cs_released(void);
+
+/**
+ * Bytes sent to the ST7565.
+ *
+ * @param[in] bytes Bytes on the bus.
+ * @param[in] length Number of bytes.
+ * @param[in] is_data Level of the DC pin, data when high.
+ */
+void sim_st7565_write(const uint8_t *bytes, uint16_t length, bool is_data);
+
+/**
+ * The display bus went idle, i.e. a refresh chain finished. Captures the
+ * framebuffer if anything was drawn since the last capture.
+ */
+void sim_st7565_idle(void);
+
+/**
+ * @return Current output level of a simulated GPIO.
+ */
+bool sim_gpio_is_high(uint32_t pin);
+
+#endif /* SIM_DEVICES_H */
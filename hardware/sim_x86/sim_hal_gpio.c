@@ -0,0 +1,49 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_hal_gpio.c
+ *
+ * Output-only GPIO model, enough for the display DC and reset lines.
+ */
+#include "tr_hal_gpio.h"
+#include "sim_devices.h"
+
+static tr_hal_level_t m_output_level[TR_HAL_MAX_PIN_NUMBER];
+
+tr_hal_status_t tr_hal_gpio_init(tr_hal_gpio_pin_t pin, tr_hal_gpio_settings_t* gpio_settings)
+{
+  if ((pin.pin >= TR_HAL_MAX_PIN_NUMBER) || (NULL == gpio_settings))
+  {
+    return TR_HAL_ERROR_INVALID_PARAM;
+  }
+  m_output_level[pin.pin] = gpio_settings->output_level;
+  return TR_HAL_SUCCESS;
+}
+
+tr_hal_status_t tr_hal_gpio_set_output(tr_hal_gpio_pin_t pin, tr_hal_level_t level)
+{
+  if (pin.pin >= TR_HAL_MAX_PIN_NUMBER)
+  {
+    return TR_HAL_ERROR_INVALID_PARAM;
+  }
+  m_output_level[pin.pin] = level;
+  return TR_HAL_SUCCESS;
+}
+
+tr_hal_status_t tr_hal_gpio_get_output(tr_hal_gpio_pin_t pin, tr_hal_level_t* level)
+{
+  if ((pin.pin >= TR_HAL_MAX_PIN_NUMBER) || (NULL == level))
+  {
+    return TR_HAL_ERROR_INVALID_PARAM;
+  }
+  *level = m_output_level[pin.pin];
+  return TR_HAL_SUCCESS;
+}
+
+bool sim_gpio_is_high(uint32_t pin)
+{
+  return (pin < TR_HAL_MAX_PIN_NUMBER) && (TR_HAL_GPIO_LEVEL_HIGH == m_output_level[pin]);
+}
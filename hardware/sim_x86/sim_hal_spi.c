@@ -0,0 +1,181 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_hal_spi.c
+ *
+ * Host SPI controller. A transfer is handed to the simulated part at once,
+ * but its completion "interrupt" is delivered from a FreeRTOS timer after
+ * the time the bytes take on the wire, so drivers see the same
+ * asynchronous TX_EMPTY / rx_handler_function flow as on target.
+ */
+#include <string.h>
+#include <FreeRTOS.h>
+#include <timers.h>
+#include "tr_hal_spi.h"
+#include "st7565.h"
+#include "sim_devices.h"
+#include "sim_trace.h"
+
+// Both parts run at the 1 MHz default clock.
+#define SIM_SPI_CLOCK_HZ      1000000
+#define SIM_SPI_MAX_RX_BYTES  8
+
+typedef struct
+{
+  tr_hal_spi_settings_t settings;
+  bool                  initialized;
+  bool                  busy;
+  bool                  receive;
+  uint8_t               rx[SIM_SPI_MAX_RX_BYTES];
+  uint16_t              rx_length;
+  TimerHandle_t         irq_timer;
+  StaticTimer_t         irq_timer_buffer;
+} sim_spi_t;
+
+static sim_spi_t m_spi[TR_HAL_NUM_SPI];
+
+static void sim_spi_interrupt(TimerHandle_t timer)
+{
+  tr_hal_spi_id_t spi_id = (tr_hal_spi_id_t)(uintptr_t)pvTimerGetTimerID(timer);
+  sim_spi_t *spi = &m_spi[spi_id];
+  uint32_t event_bitmask = TR_HAL_SPI_EVENT_TX_EMPTY | TR_HAL_SPI_EVENT_TRANSFER_DONE;
+
+  spi->busy = false;
+
+  if (SPI_0_ID == spi_id)
+  {
+    sim_max6675_cs_released();
+  }
+
+  if (spi->receive && (spi->rx_length > 0) && (NULL != spi->settings.rx_handler_function))
+  {
+    spi->settings.rx_handler_function((uint8_t)spi->rx_length, spi->rx);
+    event_bitmask |= TR_HAL_SPI_EVENT_RX_TO_USER_FX;
+  }
+
+  if (NULL != spi->settings.event_handler_fx)
+  {
+    spi->settings.event_handler_fx(spi_id, event_bitmask);
+  }
+
+  // The handler chains the next segment right away, only an idle bus
+  // after it returned means the refresh is complete.
+  if ((SPI_1_ID == spi_id) && !spi->busy)
+  {
+    sim_st7565_idle();
+  }
+}
+
+static tr_hal_status_t sim_spi_transfer(tr_hal_spi_id_t spi_id,
+                                        const uint8_t*  bytes,
+                                        uint16_t        length,
+                                        bool            receive)
+{
+  sim_spi_t *spi = &m_spi[spi_id];
+
+  if (spi->busy)
+  {
+    return TR_HAL_TRANSMITTER_BUSY;
+  }
+
+  spi->busy = true;
+  spi->receive = receive;
+  spi->rx_length = 0;
+
+  if (SPI_0_ID == spi_id)
+  {
+    spi->rx_length = (length < SIM_SPI_MAX_RX_BYTES) ? length : SIM_SPI_MAX_RX_BYTES;
+    sim_max6675_transfer(spi->rx, spi->rx_length);
+  }
+  else
+  {
+    sim_st7565_write(bytes, length, sim_gpio_is_high(DISPLAY_DC_PIN));
+  }
+
+  uint32_t wire_time_us = ((uint32_t)length * 8U * 1000000U) / SIM_SPI_CLOCK_HZ;
+  TickType_t ticks = pdMS_TO_TICKS((wire_time_us + 999U) / 1000U);
+  if (0 == ticks)
+  {
+    ticks = 1;
+  }
+  sim_trace((SPI_0_ID == spi_id) ? "spi0.transfer_us" : "spi1.transfer_us", (int32_t)wire_time_us);
+  (void)xTimerChangePeriod(spi->irq_timer, ticks, 0);
+  return TR_HAL_SUCCESS;
+}
+
+tr_hal_status_t tr_hal_spi_init(tr_hal_spi_id_t spi_id, tr_hal_spi_settings_t* spi_settings)
+{
+  if ((spi_id >= TR_HAL_NUM_SPI) || (NULL == spi_settings))
+  {
+    return TR_HAL_ERROR_INVALID_PARAM;
+  }
+
+  sim_spi_t *spi = &m_spi[spi_id];
+  if (spi->initialized)
+  {
+    return TR_HAL_ERROR_ALREADY_INITIALIZED;
+  }
+
+  spi->settings = *spi_settings;
+  spi->irq_timer = xTimerCreateStatic("sim_spi",
+                                      1,
+                                      pdFALSE,
+                                      (void *)(uintptr_t)spi_id,
+                                      sim_spi_interrupt,
+                                      &spi->irq_timer_buffer);
+  spi->initialized = true;
+  return TR_HAL_SUCCESS;
+}
+
+tr_hal_status_t tr_hal_spi_raw_tx_buffer(tr_hal_spi_id_t spi_id,
+                                         uint8_t         chip_select_index_to_use,
+                                         char*           bytes_to_send,
+                                         uint16_t        num_bytes_to_send,
+                                         bool            receive_bytes)
+{
+  (void)chip_select_index_to_use;
+
+  if ((spi_id >= TR_HAL_NUM_SPI) || !m_spi[spi_id].initialized)
+  {
+    return TR_HAL_ERROR_NOT_INITIALIZED;
+  }
+  if (m_spi[spi_id].settings.tx_dma_enabled)
+  {
+    return TR_HAL_ERROR_DMA_HANDLES_TX;
+  }
+  return sim_spi_transfer(spi_id, (const uint8_t *)bytes_to_send, num_bytes_to_send, receive_bytes);
+}
+
+tr_hal_status_t tr_hal_spi_dma_tx_bytes_in_buffer(tr_hal_spi_id_t spi_id,
+                                                  uint8_t         chip_select_index_to_use,
+                                                  char*           bytes_to_send,
+                                                  uint16_t        num_bytes_to_send,
+                                                  bool            receive_bytes)
+{
+  (void)chip_select_index_to_use;
+
+  if ((spi_id >= TR_HAL_NUM_SPI) || !m_spi[spi_id].initialized)
+  {
+    return TR_HAL_ERROR_NOT_INITIALIZED;
+  }
+  if (!m_spi[spi_id].settings.tx_dma_enabled)
+  {
+    return TR_HAL_ERROR_DMA_NOT_ENABLED;
+  }
+  return sim_spi_transfer(spi_id, (const uint8_t *)bytes_to_send, num_bytes_to_send, receive_bytes);
+}
+
+tr_hal_status_t tr_hal_spi_clear_tx_busy(tr_hal_spi_id_t spi_id)
+{
+  if (spi_id >= TR_HAL_NUM_SPI)
+  {
+    return TR_HAL_ERROR_INVALID_PARAM;
+  }
+  // A completion still pending on the timer is dropped with the transfer.
+  (void)xTimerStop(m_spi[spi_id].irq_timer, 0);
+  m_spi[spi_id].busy = false;
+  return TR_HAL_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_max6675.c
+ *
+ * Scripted virtual thermocouple.
+ *
+ * SIM_MAX6675_SCRIPT names a text file with one "<tick ms> <value>" step per
+ * line, sorted by time. The value is the temperature in 1/100 degree
+ * Celsius, or "open" for a disconnected thermocouple. Lines starting with
+ * '#' are ignored. Without a script the temperature is a constant 25 C.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "TickTime.h"
+#include "max6675.h"
+#include "sim_devices.h"
+#include "sim_trace.h"
+
+#define SIM_MAX6675_MAX_STEPS      256
+#define SIM_MAX6675_DEFAULT_X100   2500
+#define SIM_MAX6675_OPEN           INT32_MIN
+#define SIM_MAX6675_OPEN_BIT       0x0004
+
+typedef struct
+{
+  uint32_t tick_ms;
+  int32_t  temperature_x100;  ///< SIM_MAX6675_OPEN when disconnected.
+} sim_max6675_step_t;
+
+static sim_max6675_step_t m_steps[SIM_MAX6675_MAX_STEPS];
+static uint16_t m_step_count = 0;
+static uint16_t m_current_step = 0;
+static bool m_script_loaded = false;
+
+// The last finished conversion and when the running one started.
+static uint16_t m_conversion = 0;
+static uint32_t m_conversion_start = 0;
+static bool m_converting = false;
+
+static void sim_max6675_load_script(void)
+{
+  m_script_loaded = true;
+
+  const char *path = getenv("SIM_MAX6675_SCRIPT");
+  FILE *script = (NULL != path) ? fopen(path, "r") : NULL;
+  if (NULL == script)
+  {
+    m_steps[0].tick_ms = 0;
+    m_steps[0].temperature_x100 = SIM_MAX6675_DEFAULT_X100;
+    m_step_count = 1;
+    return;
+  }
+
+  char line[64];
+  while ((m_step_count < SIM_MAX6675_MAX_STEPS) && (NULL != fgets(line, sizeof(line), script)))
+  {
+    unsigned long tick_ms;
+    char value[16];
+    if (('#' == line[0]) || (2 != sscanf(line, "%lu %15s", &tick_ms, value)))
+    {
+      continue;
+    }
+    m_steps[m_step_count].tick_ms = (uint32_t)tick_ms;
+    m_steps[m_step_count].temperature_x100 = (0 == strcmp(value, "open")) ? SIM_MAX6675_OPEN : (int32_t)strtol(value, NULL, 10);
+    m_step_count++;
+  }
+  fclose(script);
+}
+
+static int32_t sim_max6675_temperature_now(void)
+{
+  if (!m_script_loaded)
+  {
+    sim_max6675_load_script();
+  }
+  if (0 == m_step_count)
+  {
+    return SIM_MAX6675_DEFAULT_X100;
+  }
+
+  uint32_t now_ms = getTickTime() * portTICK_PERIOD_MS;
+  while (((m_current_step + 1) < m_step_count) && (m_steps[m_current_step + 1].tick_ms <= now_ms))
+  {
+    m_current_step++;
+    if (SIM_MAX6675_OPEN == m_steps[m_current_step].temperature_x100)
+    {
+      sim_trace("max6675.open", 1);
+    }
+    else
+    {
+      sim_trace("max6675.step_x100", m_steps[m_current_step].temperature_x100);
+    }
+  }
+  return m_steps[m_current_step].temperature_x100;
+}
+
+static uint16_t sim_max6675_convert(int32_t temperature_x100)
+{
+  if (SIM_MAX6675_OPEN == temperature_x100)
+  {
+    return SIM_MAX6675_OPEN_BIT;
+  }
+
+  // 12 bit, 0.25 degree per LSB.
+  int32_t counts = temperature_x100 / 25;
+  if (counts < 0)
+  {
+    counts = 0;
+  }
+  else if (counts > 0x0FFF)
+  {
+    counts = 0x0FFF;
+  }
+  return (uint16_t)(counts << 3);
+}
+
+void sim_max6675_transfer(uint8_t *rx, uint16_t length)
+{
+  if (m_converting)
+  {
+    uint32_t elapsed_ms = getTickTimePassed(m_conversion_start) * portTICK_PERIOD_MS;
+    if (elapsed_ms >= MAX6675_CONVERSION_TIME_MS)
+    {
+      m_conversion = sim_max6675_convert(sim_max6675_temperature_now());
+    }
+    else
+    {
+      // CS low aborts the conversion, the old value is clocked out.
+      sim_trace("max6675.conversion_aborted_ms", (int32_t)elapsed_ms);
+    }
+  }
+  else
+  {
+    // First read after power up.
+    m_conversion = sim_max6675_convert(sim_max6675_temperature_now());
+  }
+  m_converting = false;
+
+  memset(rx, 0, length);
+  if (length >= 2)
+  {
+    rx[0] = (uint8_t)(m_conversion >> 8);
+    rx[1] = (uint8_t)(m_conversion & 0xFF);
+  }
+}
+
+void sim_max6675_cs_released(void)
+{
+  m_conversion_start = getTickTime();
+  m_converting = true;
+}
@@ -0,0 +1,114 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_st7565.c
+ *
+ * Framebuffer-capture model of the ST7565.
+ *
+ * Decodes the page/column addressing commands and stores data bytes in a
+ * 128x64 framebuffer. Every finished refresh is appended as ASCII art to
+ * the file named by SIM_DISPLAY_CAPTURE, if set, and traced with the number
+ * of bytes it took.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "TickTime.h"
+#include "st7565.h"
+#include "sim_devices.h"
+#include "sim_trace.h"
+
+#define ST7565_CMD_PAGE_ADDRESS     0xB0
+#define ST7565_CMD_COLUMN_HIGH      0x10
+#define ST7565_CMD_COLUMN_LOW       0x00
+#define ST7565_CMD_SET_CONTRAST     0x81
+
+static uint8_t m_framebuffer[LCD_PAGES][LCD_WIDTH];
+static uint8_t m_page = 0;
+static uint8_t m_column = 0;
+static bool m_contrast_follows = false;
+static bool m_dirty = false;
+static uint32_t m_bytes_since_capture = 0;
+static uint32_t m_frame_count = 0;
+
+static void sim_st7565_command(uint8_t command)
+{
+  if (m_contrast_follows)
+  {
+    // Second byte of the two byte contrast command.
+    m_contrast_follows = false;
+    return;
+  }
+
+  if (ST7565_CMD_SET_CONTRAST == command)
+  {
+    m_contrast_follows = true;
+  }
+  else if (ST7565_CMD_PAGE_ADDRESS == (command & 0xF0))
+  {
+    m_page = (uint8_t)((command & 0x0F) % LCD_PAGES);
+  }
+  else if (ST7565_CMD_COLUMN_HIGH == (command & 0xF0))
+  {
+    m_column = (uint8_t)((m_column & 0x0F) | ((command & 0x0F) << 4));
+  }
+  else if (ST7565_CMD_COLUMN_LOW == (command & 0xF0))
+  {
+    m_column = (uint8_t)((m_column & 0xF0) | (command & 0x0F));
+  }
+}
+
+void sim_st7565_write(const uint8_t *bytes, uint16_t length, bool is_data)
+{
+  m_bytes_since_capture += length;
+
+  for (uint16_t i = 0; i < length; i++)
+  {
+    if (!is_data)
+    {
+      sim_st7565_command(bytes[i]);
+      continue;
+    }
+    if (m_column < LCD_WIDTH)
+    {
+      m_framebuffer[m_page][m_column++] = bytes[i];
+      m_dirty = true;
+    }
+  }
+}
+
+void sim_st7565_idle(void)
+{
+  if (!m_dirty)
+  {
+    return;
+  }
+  m_dirty = false;
+  m_frame_count++;
+
+  sim_trace("display.frame_bytes", (int32_t)m_bytes_since_capture);
+  m_bytes_since_capture = 0;
+
+  const char *path = getenv("SIM_DISPLAY_CAPTURE");
+  FILE *capture = (NULL != path) ? fopen(path, "a") : NULL;
+  if (NULL == capture)
+  {
+    return;
+  }
+
+  fprintf(capture, "frame %lu tick %lu\n", (unsigned long)m_frame_count, (unsigned long)getTickTime());
+  for (uint8_t row = 0; row < LCD_HEIGHT; row++)
+  {
+    for (uint8_t column = 0; column < LCD_WIDTH; column++)
+    {
+      bool set = (m_framebuffer[row / 8][column] >> (row % 8)) & 1;
+      fputc(set ? '#' : '.', capture);
+    }
+    fputc('\n', capture);
+  }
+  fclose(capture);
+}
@@ -0,0 +1,44 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_trace.c
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "TickTime.h"
+#include "sysctrl.h"
+#include "sim_trace.h"
+
+static FILE *m_trace = NULL;
+
+void sim_trace(const char *event, int32_t value)
+{
+  if (NULL == m_trace)
+  {
+    const char *path = getenv("SIM_TRACE");
+    m_trace = (NULL != path) ? fopen(path, "w") : NULL;
+    if (NULL == m_trace)
+    {
+      m_trace = stdout;
+    }
+  }
+  fprintf(m_trace, "%lu %s %ld\n", (unsigned long)getTickTime(), event, (long)value);
+  fflush(m_trace);
+}
+
+void Delay_us(unsigned int us)
+{
+  sim_trace("task.blocked_us", (int32_t)us);
+  vTaskDelay(pdMS_TO_TICKS((us + 999) / 1000));
+}
+
+void Delay_ms(unsigned int ms)
+{
+  sim_trace("task.blocked_us", (int32_t)(ms * 1000));
+  vTaskDelay(pdMS_TO_TICKS(ms));
+}
@@ -0,0 +1,23 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sim_trace.h
+ *
+ * Trace of the simulated peripherals, one "<tick> <event> <value>" line per
+ * event. Written to the file named by SIM_TRACE, or stdout if it is unset.
+ *
+ * With the emulated tick the tick column is deterministic, so CI can diff
+ * report latency (thermocouple step to radio frame), task blocking time and
+ * reports per hour between runs.
+ */
+#ifndef SIM_TRACE_H
+#define SIM_TRACE_H
+
+#include <stdint.h>
+
+void sim_trace(const char *event, int32_t value);
+
+#endif /* SIM_TRACE_H */
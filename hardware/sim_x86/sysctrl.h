@@ -0,0 +1,19 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sysctrl.h
+ *
+ * Host stand-in for the T32CZ20 system control delays. Delays block the
+ * calling task for real and are traced, so the time the application task
+ * spends blocked in drivers shows up in the simulation trace.
+ */
+#ifndef SIM_SYSCTRL_H
+#define SIM_SYSCTRL_H
+
+void Delay_us(unsigned int us);
+void Delay_ms(unsigned int ms);
+
+#endif /* SIM_SYSCTRL_H */
@@ -0,0 +1,22 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file sysfun.h
+ *
+ * Host stand-in for the T32CZ20 critical section helpers. Simulated
+ * interrupts run in the FreeRTOS timer task, so a scheduler critical section
+ * gives the same guarantee as masking interrupts on target.
+ */
+#ifndef SIM_SYSFUN_H
+#define SIM_SYSFUN_H
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define enter_critical_section()    taskENTER_CRITICAL()
+#define leave_critical_section()    taskEXIT_CRITICAL()
+
+#endif /* SIM_SYSFUN_H */
@@ -0,0 +1,188 @@
+/// ***************************************************************************
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+/**
+ * @file tr_hal_platform.h
+ *
+ * Host stand-in for the T32CZ20 HAL platform header.
+ *
+ * Only carries the types and defines the multilevel_max6675 drivers use, so
+ * the unmodified app/custom drivers build against the simulated peripherals
+ * of the x86 platform.
+ */
+#ifndef TR_HAL_PLATFORM_H_
+#define TR_HAL_PLATFORM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "tr_hal_common.h"
+
+typedef struct
+{
+  uint32_t pin;
+} tr_hal_gpio_pin_t;
+
+typedef enum
+{
+  TR_HAL_INTERRUPT_PRIORITY_HIGHEST = 1,
+  TR_HAL_INTERRUPT_PRIORITY_1       = 1,
+  TR_HAL_INTERRUPT_PRIORITY_2       = 2,
+  TR_HAL_INTERRUPT_PRIORITY_3       = 3,
+  TR_HAL_INTERRUPT_PRIORITY_4       = 4,
+  TR_HAL_INTERRUPT_PRIORITY_5       = 5,
+  TR_HAL_INTERRUPT_PRIORITY_6       = 6,
+  TR_HAL_INTERRUPT_PRIORITY_7       = 7,
+  TR_HAL_INTERRUPT_PRIORITY_LOWEST  = 7,
+} tr_hal_int_pri_t;
+
+// ****************************************************************************
+// GPIO
+// ****************************************************************************
+#define TR_HAL_MAX_PIN_NUMBER (32)
+
+typedef enum
+{
+  TR_HAL_GPIO_DIRECTION_INPUT  = 0,
+  TR_HAL_GPIO_DIRECTION_OUTPUT = 1,
+} tr_hal_direction_t;
+
+typedef enum
+{
+  TR_HAL_GPIO_LEVEL_LOW  = 0,
+  TR_HAL_GPIO_LEVEL_HIGH = 1,
+} tr_hal_level_t;
+
+typedef enum
+{
+  TR_HAL_GPIO_TRIGGER_NONE = 0,
+} tr_hal_trigger_t;
+
+typedef enum
+{
+  TR_HAL_PULLOPT_PULL_NONE = 0,
+} tr_hal_pullopt_t;
+
+typedef enum
+{
+  TR_HAL_DRIVE_STRENGTH_DEFAULT = 0,
+} tr_hal_drive_strength_t;
+
+typedef enum
+{
+  TR_HAL_WAKE_MODE_NONE = 0,
+} tr_hal_wake_mode_t;
+
+typedef enum
+{
+  TR_HAL_GPIO_MODE_GPIO = 0,
+} tr_hal_pin_mode_t;
+
+typedef enum
+{
+  TR_HAL_DEBOUNCE_TIME_DEFAULT = 0,
+} tr_hal_debounce_time_t;
+
+typedef void (*tr_hal_gpio_event_callback_t) (tr_hal_gpio_pin_t pin, uint32_t event);
+
+typedef struct
+{
+  tr_hal_direction_t           direction;
+  tr_hal_level_t               output_level;
+  bool                         enable_open_drain;
+  tr_hal_drive_strength_t      drive_strength;
+  tr_hal_trigger_t             interrupt_trigger;
+  tr_hal_gpio_event_callback_t event_handler_fx;
+  tr_hal_pullopt_t             pull_mode;
+  bool                         enable_debounce;
+  tr_hal_wake_mode_t           wake_mode;
+} tr_hal_gpio_settings_t;
+
+#define DEFAULT_GPIO_OUTPUT_CONFIG                  \
+  {                                                 \
+    .direction = TR_HAL_GPIO_DIRECTION_OUTPUT,      \
+    .output_level = TR_HAL_GPIO_LEVEL_LOW,          \
+    .enable_open_drain = false,                     \
+    .drive_strength = TR_HAL_DRIVE_STRENGTH_DEFAULT,\
+    .interrupt_trigger = TR_HAL_GPIO_TRIGGER_NONE,  \
+    .event_handler_fx = NULL,                       \
+    .pull_mode = TR_HAL_PULLOPT_PULL_NONE,          \
+    .enable_debounce = false,                       \
+    .wake_mode = TR_HAL_WAKE_MODE_NONE,             \
+  }
+
+// ****************************************************************************
+// SPI
+// ****************************************************************************
+#define TR_HAL_NUM_SPI 2
+#define TR_HAL_SPI_TX_FIFO_SIZE 32
+#define TR_HAL_SPI_RX_FIFO_SIZE 32
+
+typedef enum
+{
+  SPI_0_ID = 0,
+  SPI_1_ID = 1,
+} tr_hal_spi_id_t;
+
+#define TR_HAL_SPI_EVENT_TX_EMPTY          0x00000001
+#define TR_HAL_SPI_EVENT_RX_FULL           0x00000008
+#define TR_HAL_SPI_EVENT_RX_HAS_MORE_DATA  0x00000010
+#define TR_HAL_SPI_EVENT_TRANSFER_DONE     0x00000020
+#define TR_HAL_SPI_EVENT_RX_TO_USER_FX     0x00000040
+#define TR_HAL_SPI_EVENT_RX_READY          0x00000080
+#define TR_HAL_SPI_EVENT_DMA_RX_TO_USER_FX 0x00000100
+#define TR_HAL_SPI_EVENT_DMA_RX_READY      0x00000200
+#define TR_HAL_SPI_EVENT_DMA_TX_COMPLETE   0x00000400
+
+typedef void (*tr_hal_spi_receive_callback_t) (uint8_t num_received_bytes, uint8_t* byte_buffer);
+typedef void (*tr_hal_spi_event_callback_t) (tr_hal_spi_id_t spi_id, uint32_t event_bitmask);
+
+// Pin and clock fields are accepted and ignored by the simulation.
+typedef struct
+{
+  bool                          run_as_controller;
+  tr_hal_gpio_pin_t             clock_pin;
+  tr_hal_gpio_pin_t             io_0_pin;
+  tr_hal_gpio_pin_t             io_1_pin;
+  tr_hal_gpio_pin_t             chip_select_0;
+  bool                          continuous_transfer;
+  bool                          rx_dma_enabled;
+  bool                          tx_dma_enabled;
+  uint8_t*                      rx_dma_buffer;
+  uint16_t                      rx_dma_buff_length;
+  uint8_t*                      raw_tx_buffer;
+  uint16_t                      raw_tx_buff_length;
+  tr_hal_spi_receive_callback_t rx_handler_function;
+  tr_hal_spi_event_callback_t   event_handler_fx;
+  bool                          enable_chip_interrupts;
+  tr_hal_int_pri_t              interrupt_priority;
+  bool                          wake_on_interrupt;
+} tr_hal_spi_settings_t;
+
+#define SPI_CONFIG_CONTROLLER_NORMAL_MODE                  \
+  {                                                        \
+    .run_as_controller = true,                             \
+    .clock_pin = (tr_hal_gpio_pin_t) { 0 },                \
+    .io_0_pin = (tr_hal_gpio_pin_t) { 0 },                 \
+    .io_1_pin = (tr_hal_gpio_pin_t) { 0 },                 \
+    .chip_select_0 = (tr_hal_gpio_pin_t) { 0 },            \
+    .continuous_transfer = true,                           \
+    .rx_dma_enabled = false,                               \
+    .tx_dma_enabled = false,                               \
+    .rx_dma_buffer = NULL,                                 \
+    .rx_dma_buff_length = 0,                               \
+    .raw_tx_buffer = NULL,                                 \
+    .raw_tx_buff_length = 0,                               \
+    .rx_handler_function = NULL,                           \
+    .event_handler_fx = NULL,                              \
+    .enable_chip_interrupts = true,                        \
+    .interrupt_priority = TR_HAL_INTERRUPT_PRIORITY_5,     \
+    .wake_on_interrupt = false,                            \
+  }
+
+// Chip specific on target, declared by T32CZ20_spi.h.
+tr_hal_status_t tr_hal_spi_clear_tx_busy(tr_hal_spi_id_t spi_id);
+
+#endif // TR_HAL_PLATFORM_H_
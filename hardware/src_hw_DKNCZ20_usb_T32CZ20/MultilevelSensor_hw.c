@@ -21,6 +21,7 @@
 #include <zaf_event_distributor_soc.h>
 #include <tr_board_DKNCZ20.h>
 #include "tr_hal_gpio.h"
+#include "sensor_aggregation.h"
 
 /*defines what gpios ids are used*/
 const uint8_t PB_LEARN_MODE                  = TR_BOARD_BTN_LEARN_MODE;
@@ -77,12 +78,38 @@ zpal_debug_config_t debug_port_cfg = &UART_CONFIG;
 
 #ifdef TR_CLI_ENABLED
 
+static int cli_cmd_app_aggregate(int  argc, char *argv[]);
+
 // Application specific CLI commands
 TR_CLI_COMMAND_TABLE(app_specific_commands) =
 {
+  { "aggregate", cli_cmd_app_aggregate, "Print min/max/mean over the aggregation window"   },
   TR_CLI_COMMAND_TABLE_END
 };
 
+static void cli_print_x100(const char *label, int32_t value_x100)
+{
+  uint32_t magnitude = (value_x100 < 0) ? (uint32_t)(-(int64_t)value_x100) : (uint32_t)value_x100;
+  tr_cli_common_printf("%s: %s%u.%02u C\n", label, (value_x100 < 0) ? "-" : "", (unsigned int)(magnitude / 100), (unsigned int)(magnitude % 100));
+}
+
+static int cli_cmd_app_aggregate(__attribute__((unused)) int  argc,__attribute__((unused))  char *argv[])
+{
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  tr_cli_common_printf("Window: %u s\n", (unsigned int)cc_multilevel_sensor_aggregation_get_window());
+  if (!sensor_aggregation_get(&aggregate))
+  {
+    tr_cli_common_printf("No samples\n");
+    return 0;
+  }
+  cli_print_x100("Min ", aggregate.min);
+  cli_print_x100("Max ", aggregate.max);
+  cli_print_x100("Mean", aggregate.mean);
+  tr_cli_common_printf("Samples: %u\n", aggregate.sample_count);
+  return 0;
+}
+
 #endif // #ifdef TR_CLI_ENABLED
 
 void app_hw_init(void)
@@ -61,6 +61,39 @@ size_t tr_ring_buffer_read(tr_ring_buffer_t *p_rb, uint8_t *p_data, size_t lengt
   return count;
 }
 
+static size_t ring_buffer_newest_index(tr_ring_buffer_t *p_rb)
+{
+  return (0 == p_rb->head) ? (p_rb->buffer_size - 1) : (p_rb->head - 1);
+}
+
+bool tr_ring_buffer_peek(tr_ring_buffer_t *p_rb, uint8_t *p_data)
+{
+  if (ring_buffer_is_empty(p_rb)) {
+    return false;
+  }
+  *p_data = p_rb->p_buffer[p_rb->tail];
+  return true;
+}
+
+bool tr_ring_buffer_peek_newest(tr_ring_buffer_t *p_rb, uint8_t *p_data)
+{
+  if (ring_buffer_is_empty(p_rb)) {
+    return false;
+  }
+  *p_data = p_rb->p_buffer[ring_buffer_newest_index(p_rb)];
+  return true;
+}
+
+bool tr_ring_buffer_drop_newest(tr_ring_buffer_t *p_rb)
+{
+  if (ring_buffer_is_empty(p_rb)) {
+    return false;
+  }
+  p_rb->head = ring_buffer_newest_index(p_rb);
+  p_rb->count--;
+  return true;
+}
+
 size_t tr_ring_buffer_get_available(tr_ring_buffer_t *p_rb)
 {
   return p_rb->count;
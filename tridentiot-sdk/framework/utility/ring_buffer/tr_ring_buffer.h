@@ -69,6 +69,38 @@ bool tr_ring_buffer_write(tr_ring_buffer_t *p_rb, uint8_t data);
  */
 size_t tr_ring_buffer_read(tr_ring_buffer_t *p_rb, uint8_t *p_data, size_t length);
 
+/**
+ * Reads the oldest byte without removing it from the ring buffer.
+ *
+ * @param[in]  p_rb   Address of a ring buffer object that has been initialized by tr_ring_buffer_init().
+ * @param[out] p_data Address where the byte must be written to.
+ *
+ * @return Returns `true` if a byte was read, and `false` if the ring buffer is empty.
+ */
+bool tr_ring_buffer_peek(tr_ring_buffer_t *p_rb, uint8_t *p_data);
+
+/**
+ * Reads the newest byte without removing it from the ring buffer.
+ *
+ * @param[in]  p_rb   Address of a ring buffer object that has been initialized by tr_ring_buffer_init().
+ * @param[out] p_data Address where the byte must be written to.
+ *
+ * @return Returns `true` if a byte was read, and `false` if the ring buffer is empty.
+ */
+bool tr_ring_buffer_peek_newest(tr_ring_buffer_t *p_rb, uint8_t *p_data);
+
+/**
+ * Removes the newest byte from the ring buffer, i.e. takes back the last write.
+ *
+ * Together with tr_ring_buffer_read() this lets the ring buffer be used as a
+ * double-ended queue.
+ *
+ * @param[in] p_rb Address of a ring buffer object that has been initialized by tr_ring_buffer_init().
+ *
+ * @return Returns `true` if a byte was removed, and `false` if the ring buffer is empty.
+ */
+bool tr_ring_buffer_drop_newest(tr_ring_buffer_t *p_rb);
+
 /**
  * Returns the number of occupied bytes in the ring buffer.
  *
@@ -20,6 +20,26 @@
 /*                     EXPORTED TYPES and DEFINITIONS                       */
 /****************************************************************************/
 
+/**
+ * Selects the CRC-16 implementation, trading flash for speed.
+ * - 0: Bit by bit, no table.
+ * - 1: Byte by byte with a 256 entry table (512 bytes).
+ * - 4: Four bytes at a time with four 256 entry tables (2 kB).
+ *
+ * All give the same result.
+ */
+#if !defined(CRC_CCITT_SLICES)
+#define CRC_CCITT_SLICES  1
+#endif /* !defined(CRC_CCITT_SLICES) */
+
+/**
+ * State of a CRC calculated over data received in parts.
+ */
+typedef struct SCrc16Stream
+{
+  uint16_t crc;
+} SCrc16Stream;
+
 /****************************************************************************/
 /*                              EXPORTED DATA                               */
 /****************************************************************************/
@@ -45,4 +65,32 @@ uint16_t CRC_CheckCrc16(
   uint16_t bDataLen
 );
 
+/**
+ * Starts a CRC calculation with CRC_INITAL_VALUE.
+ *
+ * @param pStream State of the calculation.
+ */
+void CRC_Crc16Init(SCrc16Stream *pStream);
+
+/**
+ * Adds the next part of the data to a CRC calculation.
+ *
+ * @param pStream State of the calculation.
+ * @param pDataAddr Pointer to the array of data.
+ * @param bDataLen Length of the data.
+ */
+void CRC_Crc16Update(
+  SCrc16Stream *pStream,
+  const uint8_t *pDataAddr,
+  uint16_t bDataLen
+);
+
+/**
+ * Returns the CRC of all the data added since CRC_Crc16Init().
+ *
+ * @param pStream State of the calculation.
+ * @return CRC value
+ */
+uint16_t CRC_Crc16Final(const SCrc16Stream *pStream);
+
 #endif /* _CRC_H_ */
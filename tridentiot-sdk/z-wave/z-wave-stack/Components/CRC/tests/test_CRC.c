@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file test_CRC.c
+ * @copyright 2024 Silicon Laboratories Inc.
+ */
+#include "unity.h"
+#include <CRC.h>
+#include <stdlib.h>
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * The bit by bit CRC-16 CCITT formerly used by both CRC_CheckCrc16() and the
+ * Data Link Layer.
+ */
+static uint16_t reference_crc16(uint16_t crc, const uint8_t *pData, uint16_t length)
+{
+  for (uint16_t i = 0; i < length; i++)
+  {
+    for (uint8_t bitMask = 0x80; bitMask != 0; bitMask >>= 1)
+    {
+      uint8_t newBit = ((pData[i] & bitMask) != 0) ^ ((crc & 0x8000) != 0);
+      crc = (uint16_t)(crc << 1);
+      if (newBit)
+      {
+        crc ^= 0x1021;
+      }
+    }
+  }
+  return crc;
+}
+
+static uint8_t test_data[1024];
+
+static void fill_test_data(unsigned int seed)
+{
+  srand(seed);
+  for (size_t i = 0; i < sizeof(test_data); i++)
+  {
+    test_data[i] = (uint8_t)rand();
+  }
+}
+
+void test_CRC_known_value(void)
+{
+  const uint8_t data[] = "123456789";
+
+  TEST_ASSERT_EQUAL_HEX16(0xE5CC, CRC_CheckCrc16(CRC_INITAL_VALUE, data, sizeof(data) - 1));
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, CRC_CheckCrc16(0xFFFF, data, sizeof(data) - 1));
+  TEST_ASSERT_EQUAL_HEX16(CRC_INITAL_VALUE, CRC_CheckCrc16(CRC_INITAL_VALUE, data, 0));
+}
+
+/**
+ * Verifies that the CRC is bit exact with the bit by bit calculation for every
+ * length up to a few frames, at every alignment and for any initial value.
+ */
+void test_CRC_matches_reference(void)
+{
+  fill_test_data(1);
+
+  for (uint16_t offset = 0; offset < 4; offset++)
+  {
+    for (uint16_t length = 0; length <= 300; length++)
+    {
+      uint16_t crc = (uint16_t)rand();
+      TEST_ASSERT_EQUAL_HEX16(reference_crc16(crc, &test_data[offset], length),
+                              CRC_CheckCrc16(crc, &test_data[offset], length));
+    }
+  }
+  TEST_ASSERT_EQUAL_HEX16(reference_crc16(CRC_INITAL_VALUE, test_data, sizeof(test_data)),
+                          CRC_CheckCrc16(CRC_INITAL_VALUE, test_data, sizeof(test_data)));
+}
+
+/**
+ * Verifies that a CRC calculated over data in parts equals the CRC calculated
+ * over all the data at once.
+ */
+void test_CRC_stream(void)
+{
+  SCrc16Stream stream;
+  const uint16_t parts[] = { 1, 3, 0, 7, 64, 2, 5, 100 };
+  uint16_t length = 0;
+
+  fill_test_data(2);
+
+  CRC_Crc16Init(&stream);
+  TEST_ASSERT_EQUAL_HEX16(CRC_INITAL_VALUE, CRC_Crc16Final(&stream));
+
+  for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++)
+  {
+    CRC_Crc16Update(&stream, &test_data[length], parts[i]);
+    length = (uint16_t)(length + parts[i]);
+    TEST_ASSERT_EQUAL_HEX16(reference_crc16(CRC_INITAL_VALUE, test_data, length),
+                            CRC_Crc16Final(&stream));
+  }
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file test_CRC_benchmark.c
+ *
+ * Prints the speed of the CRC-16 CCITT. Only built with UNIT_TEST_BENCHMARKS,
+ * as the timings depend on the host.
+ */
+#include "unity.h"
+#include <CRC.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * The bit by bit CRC-16 CCITT, see test_CRC.c.
+ */
+static uint16_t reference_crc16(uint16_t crc, const uint8_t *pData, uint16_t length)
+{
+  for (uint16_t i = 0; i < length; i++)
+  {
+    for (uint8_t bitMask = 0x80; bitMask != 0; bitMask >>= 1)
+    {
+      uint8_t newBit = ((pData[i] & bitMask) != 0) ^ ((crc & 0x8000) != 0);
+      crc = (uint16_t)(crc << 1);
+      if (newBit)
+      {
+        crc ^= 0x1021;
+      }
+    }
+  }
+  return crc;
+}
+
+static uint8_t test_data[1024];
+
+#define BENCHMARK_ROUNDS  2000
+
+/**
+ * Prints the speed of the implementation selected by CRC_CCITT_SLICES and of
+ * the bit by bit calculation. Bytes per cycle are only reported on x86.
+ */
+void test_CRC_benchmark(void)
+{
+  volatile uint16_t result = 0;
+  const uint32_t bytes = (uint32_t)BENCHMARK_ROUNDS * sizeof(test_data);
+
+  srand(3);
+  for (size_t i = 0; i < sizeof(test_data); i++)
+  {
+    test_data[i] = (uint8_t)rand();
+  }
+
+  for (uint8_t reference = 0; reference < 2; reference++)
+  {
+    clock_t start = clock();
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t start_cycles = __rdtsc();
+#endif
+    for (uint32_t i = 0; i < BENCHMARK_ROUNDS; i++)
+    {
+      result = reference ? reference_crc16(result, test_data, sizeof(test_data))
+                         : CRC_CheckCrc16(result, test_data, sizeof(test_data));
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t cycles = __rdtsc() - start_cycles;
+#endif
+    unsigned long us = (unsigned long)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+
+    if (reference)
+    {
+      printf("CRC16 bit by bit: ");
+    }
+    else
+    {
+      printf("CRC16 CRC_CCITT_SLICES=%u: ", (unsigned int)CRC_CCITT_SLICES);
+    }
+    printf("%lu bytes in %lu us", (unsigned long)bytes, us);
+#if defined(__x86_64__) || defined(__i386__)
+    printf(", %.3f bytes/cycle", (double)bytes / (double)cycles);
+#endif
+    printf("\n");
+  }
+}
@@ -46,6 +46,11 @@ ESwTimerStatus TimerStart(SSwTimer* pTimer, uint32_t iTimeout)
      return ESWTIMER_STATUS_FAILED;
   }
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return TimerLiaisonMultiplexedStart(pTimer->pLiaison, pTimer, pdMS_TO_TICKS(iTimeout), false) ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
+  }
+
   /*
    * Suspend the task scheduler while calling the xTimer API functions below. This is
    * to avoid switching back and forth between the calling task and the SW Timer task
@@ -86,6 +91,11 @@ ESwTimerStatus TimerStartFromISR(SSwTimer* pTimer, uint32_t iTimeout)
      return ESWTIMER_STATUS_FAILED;
   }
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return TimerLiaisonMultiplexedStart(pTimer->pLiaison, pTimer, pdMS_TO_TICKS(iTimeout), true) ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
+  }
+
   Status = xTimerStopFromISR(pTimer->TimerHandle, &xHigherPriorityTaskWoken);
   if (pdPASS == Status)
   {
@@ -121,6 +131,11 @@ ESwTimerStatus TimerRestart(SSwTimer* pTimer)
   ASSERT(pTimer);
   BaseType_t Status;
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return TimerLiaisonMultiplexedStart(pTimer->pLiaison, pTimer, 0, false) ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
+  }
+
   TimerLiaisonClearPendingTimerEvent(pTimer->pLiaison, pTimer->Id);
   Status = xTimerReset(pTimer->TimerHandle, 0);
   return Status == pdPASS ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
@@ -133,6 +148,11 @@ ESwTimerStatus TimerRestartFromISR(SSwTimer* pTimer)
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
   BaseType_t Status;
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return TimerLiaisonMultiplexedStart(pTimer->pLiaison, pTimer, 0, true) ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
+  }
+
   TimerLiaisonClearPendingTimerEventFromISR(pTimer->pLiaison, pTimer->Id);
   Status = xTimerResetFromISR(pTimer->TimerHandle, &xHigherPriorityTaskWoken);
 
@@ -161,6 +181,11 @@ ESwTimerStatus TimerStop(SSwTimer* pTimer)
      return ESWTIMER_STATUS_FAILED;
   }
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return TimerLiaisonMultiplexedStop(pTimer->pLiaison, pTimer, false) ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
+  }
+
   Status = xTimerStop(pTimer->TimerHandle, 0);
   if (pdFAIL != Status)
   {
@@ -183,6 +208,11 @@ ESwTimerStatus TimerStopFromISR(SSwTimer* pTimer)
      return ESWTIMER_STATUS_FAILED;
   }
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return TimerLiaisonMultiplexedStop(pTimer->pLiaison, pTimer, true) ? ESWTIMER_STATUS_SUCCESS : ESWTIMER_STATUS_FAILED;
+  }
+
   Status = xTimerStopFromISR(pTimer->TimerHandle, &xHigherPriorityTaskWoken);
   if (pdFAIL != Status)
   {
@@ -214,6 +244,12 @@ bool TimerIsActive(SSwTimer* pTimer)
      return false;
   }
 
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return ((TimerHasPendingCallback(pTimer))
+            || TimerLiaisonMultiplexedGetExpiry(pTimer->pLiaison, pTimer, NULL));
+  }
+
   BaseType_t Status = xTimerIsTimerActive(pTimer->TimerHandle);
 
   return ((TimerHasPendingCallback(pTimer)) || (Status == pdTRUE));
@@ -240,9 +276,24 @@ ESwTimerStatus TimerGetMsUntilTimeout(SSwTimer* pTimer, uint32_t refTaskTickCoun
      return ESWTIMER_STATUS_FAILED;
   }
 
-  if (xTimerIsTimerActive(pTimer->TimerHandle) != pdFALSE)
+  bool bActive;
+  TickType_t expiryTime = 0;
+
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    bActive = TimerLiaisonMultiplexedGetExpiry(pTimer->pLiaison, pTimer, &expiryTime);
+  }
+  else
+  {
+    bActive = (xTimerIsTimerActive(pTimer->TimerHandle) != pdFALSE);
+    if (bActive)
+    {
+      expiryTime = xTimerGetExpiryTime(pTimer->TimerHandle);
+    }
+  }
+
+  if (bActive)
   {
-    TickType_t expiryTime = xTimerGetExpiryTime(pTimer->TimerHandle);
 
     /* We assume one tick is equal to one millisecond
      * (FreeRTOS configTICK_RATE_HZ = 1000)
@@ -265,6 +316,10 @@ ESwTimerStatus TimerGetMsUntilTimeout(SSwTimer* pTimer, uint32_t refTaskTickCoun
 uint32_t TimerGetPeriod(SSwTimer *pTimer)
 {
   ASSERT(pTimer);
+  if (TimerLiaisonIsMultiplexed(pTimer->pLiaison))
+  {
+    return ((SSwTimerPrivate_t*)&pTimer->dummy)->Multiplexed.Period;
+  }
   return xTimerGetPeriod(pTimer->TimerHandle);
 }
 
@@ -78,12 +78,460 @@ void TimerLiaisonInit(
   pThis->pTimerList = pTimerPointerArray;  
   pThis->iTaskNotificationBitNumber = iTaskNotificationBitNumber;
   pThis->ReceiverTask = ReceiverTask;
+  pThis->pTimerHeap = NULL;
+  pThis->iTimerHeapCount = 0;
+  pThis->iPendingCount = 0;
+  pThis->pPendingHead = NULL;
+  pThis->pPendingTail = NULL;
+  pThis->pMultiplexTimer = NULL;
+  pThis->bReprogramFailed = false;
 
   pTimerLiaisonPrivate->ReceiverEventHandle = xEventGroupCreateStatic(&pTimerLiaisonPrivate->ReceiverEvent);
 }
 
+/****************************************************************************/
+/*                          MULTIPLEXED BACKEND                             */
+/****************************************************************************/
+
+static SSwTimerMultiplexed_t* MultiplexedState(SSwTimer* pTimer)
+{
+  return &((SSwTimerPrivate_t*)&pTimer->dummy)->Multiplexed;
+}
+
+static UBaseType_t MultiplexedLock(bool bFromISR)
+{
+  if (bFromISR)
+  {
+    return taskENTER_CRITICAL_FROM_ISR();
+  }
+  taskENTER_CRITICAL();
+  return 0;
+}
+
+static void MultiplexedUnlock(bool bFromISR, UBaseType_t SavedInterruptStatus)
+{
+  if (bFromISR)
+  {
+    taskEXIT_CRITICAL_FROM_ISR(SavedInterruptStatus);
+  }
+  else
+  {
+    taskEXIT_CRITICAL();
+  }
+}
+
+static TickType_t MultiplexedNow(bool bFromISR)
+{
+  return bFromISR ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+}
+
+/* Tick counts wrap, so compare the signed distance */
+static bool MultiplexedExpiresBefore(SSwTimer* pA, SSwTimer* pB)
+{
+  return (int32_t)(MultiplexedState(pA)->Expiry - MultiplexedState(pB)->Expiry) < 0;
+}
+
+static void MultiplexedHeapSet(SSwTimerLiaison* pThis, uint8_t Index, SSwTimer* pTimer)
+{
+  pThis->pTimerHeap[Index] = pTimer;
+  MultiplexedState(pTimer)->HeapIndex = Index;
+}
+
+static void MultiplexedHeapUp(SSwTimerLiaison* pThis, uint8_t Index)
+{
+  SSwTimer* pTimer = pThis->pTimerHeap[Index];
+
+  while (Index > 0)
+  {
+    uint8_t Parent = (uint8_t)((Index - 1) / 2);
+    if (!MultiplexedExpiresBefore(pTimer, pThis->pTimerHeap[Parent]))
+    {
+      break;
+    }
+    MultiplexedHeapSet(pThis, Index, pThis->pTimerHeap[Parent]);
+    Index = Parent;
+  }
+  MultiplexedHeapSet(pThis, Index, pTimer);
+}
+
+static void MultiplexedHeapDown(SSwTimerLiaison* pThis, uint8_t Index)
+{
+  SSwTimer* pTimer = pThis->pTimerHeap[Index];
+
+  for (;;)
+  {
+    uint32_t Child = 2 * (uint32_t)Index + 1;
+    if (Child >= pThis->iTimerHeapCount)
+    {
+      break;
+    }
+    if ((Child + 1 < pThis->iTimerHeapCount)
+        && MultiplexedExpiresBefore(pThis->pTimerHeap[Child + 1], pThis->pTimerHeap[Child]))
+    {
+      Child++;
+    }
+    if (!MultiplexedExpiresBefore(pThis->pTimerHeap[Child], pTimer))
+    {
+      break;
+    }
+    MultiplexedHeapSet(pThis, Index, pThis->pTimerHeap[Child]);
+    Index = (uint8_t)Child;
+  }
+  MultiplexedHeapSet(pThis, Index, pTimer);
+}
+
+static void MultiplexedHeapInsert(SSwTimerLiaison* pThis, SSwTimer* pTimer)
+{
+  ASSERT(pThis->iTimerHeapCount < pThis->iTimerListSize);
+  MultiplexedHeapSet(pThis, pThis->iTimerHeapCount, pTimer);
+  pThis->iTimerHeapCount++;
+  MultiplexedHeapUp(pThis, (uint8_t)(pThis->iTimerHeapCount - 1));
+}
+
+static void MultiplexedHeapRemove(SSwTimerLiaison* pThis, SSwTimer* pTimer)
+{
+  uint8_t Index = MultiplexedState(pTimer)->HeapIndex;
+
+  if (SWTIMER_MULTIPLEXED_NOT_RUNNING == Index)
+  {
+    return;
+  }
+  MultiplexedState(pTimer)->HeapIndex = SWTIMER_MULTIPLEXED_NOT_RUNNING;
+  pThis->iTimerHeapCount--;
+  if (Index != pThis->iTimerHeapCount)
+  {
+    // Move the last timer into the hole and restore the heap order from there
+    MultiplexedHeapSet(pThis, Index, pThis->pTimerHeap[pThis->iTimerHeapCount]);
+    MultiplexedHeapUp(pThis, Index);
+    MultiplexedHeapDown(pThis, MultiplexedState(pThis->pTimerHeap[Index])->HeapIndex);
+  }
+}
+
+static void MultiplexedPendingAppend(SSwTimerLiaison* pThis, SSwTimer* pTimer)
+{
+  SSwTimerMultiplexed_t* pState = MultiplexedState(pTimer);
+
+  if (pState->bPending)
+  {
+    return;
+  }
+  pState->bPending = true;
+  pState->pNextPending = NULL;
+  if (pThis->pPendingTail)
+  {
+    MultiplexedState(pThis->pPendingTail)->pNextPending = pTimer;
+  }
+  else
+  {
+    pThis->pPendingHead = pTimer;
+  }
+  pThis->pPendingTail = pTimer;
+  pThis->iPendingCount++;
+}
+
+static void MultiplexedPendingRemove(SSwTimerLiaison* pThis, SSwTimer* pTimer)
+{
+  SSwTimer* pPrevious = NULL;
+  SSwTimer* pIter = pThis->pPendingHead;
+
+  if (!MultiplexedState(pTimer)->bPending)
+  {
+    return;
+  }
+  while (pIter != pTimer)
+  {
+    pPrevious = pIter;
+    pIter = MultiplexedState(pIter)->pNextPending;
+  }
+  if (pPrevious)
+  {
+    MultiplexedState(pPrevious)->pNextPending = MultiplexedState(pTimer)->pNextPending;
+  }
+  else
+  {
+    pThis->pPendingHead = MultiplexedState(pTimer)->pNextPending;
+  }
+  if (pThis->pPendingTail == pTimer)
+  {
+    pThis->pPendingTail = pPrevious;
+  }
+  MultiplexedState(pTimer)->bPending = false;
+  pThis->iPendingCount--;
+}
+
+/**
+* Programs the shared FreeRTOS timer to the earliest expiry.
+*
+* The FreeRTOS timer API must not be called in a critical section, so the heap
+* may change between reading it and sending the command. Repeat until the
+* command sent last matches the heap.
+*
+* @retval true   The FreeRTOS timer matches the heap.
+* @retval false  The timer command queue was full. The timer is not reprogrammed.
+*/
+static bool MultiplexedReprogram(SSwTimerLiaison* pThis, bool bFromISR)
+{
+  TimerHandle_t MultiplexTimer = (TimerHandle_t)pThis->pMultiplexTimer->TimerHandle;
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  BaseType_t Status;
+  SSwTimer* pHead;
+  TickType_t Expiry = 0;
+  TickType_t Ticks = 0;
+  bool bChanged;
+
+  do
+  {
+    UBaseType_t SavedInterruptStatus = MultiplexedLock(bFromISR);
+    pHead = (pThis->iTimerHeapCount > 0) ? pThis->pTimerHeap[0] : NULL;
+    if (pHead)
+    {
+      Expiry = MultiplexedState(pHead)->Expiry;
+      Ticks = Expiry - MultiplexedNow(bFromISR);
+      if ((int32_t)Ticks < 1)
+      {
+        Ticks = 1;
+      }
+    }
+    MultiplexedUnlock(bFromISR, SavedInterruptStatus);
+
+    if (pHead)
+    {
+      if (bFromISR)
+      {
+        Status = xTimerChangePeriodFromISR(MultiplexTimer, Ticks, &xHigherPriorityTaskWoken);
+      }
+      else
+      {
+        Status = xTimerChangePeriod(MultiplexTimer, Ticks, 0);
+      }
+    }
+    else
+    {
+      if (bFromISR)
+      {
+        Status = xTimerStopFromISR(MultiplexTimer, &xHigherPriorityTaskWoken);
+      }
+      else
+      {
+        Status = xTimerStop(MultiplexTimer, 0);
+      }
+    }
+    if (pdPASS != Status)
+    {
+      DPRINTF("Multiplexed timer command failed - Liaison %08X\r\n", pThis);
+      break;
+    }
+
+    SavedInterruptStatus = MultiplexedLock(bFromISR);
+    bChanged = (pHead != ((pThis->iTimerHeapCount > 0) ? pThis->pTimerHeap[0] : NULL))
+               || (pHead && (Expiry != MultiplexedState(pHead)->Expiry));
+    MultiplexedUnlock(bFromISR, SavedInterruptStatus);
+  } while (bChanged);
+
+#ifdef __arm__
+  if (bFromISR)
+  {
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
+#endif
+  pThis->bReprogramFailed = (pdPASS != Status);
+  return (pdPASS == Status);
+}
+
+static void MultiplexedNotifyReceiver(SSwTimerLiaison* pThis)
+{
+  uint32_t TimerTaskNotification = 1 << pThis->iTaskNotificationBitNumber;
+  ASSERT(pThis->ReceiverTask);
+  uint32_t Status = xTaskNotify(pThis->ReceiverTask, TimerTaskNotification, eSetBits);
+
+  if (Status != pdPASS)
+  {
+    DPRINTF("Timer notification failed - Liaison %08X\r\n", pThis);
+  }
+}
+
+/* Runs in the FreeRTOS timer daemon task when the earliest timer expires */
+static void MultiplexedExpiredCallback(TimerHandle_t xTimer)
+{
+  SSwTimerLiaison* pThis = (SSwTimerLiaison*)pvTimerGetTimerID(xTimer);
+  bool bExpired = false;
+
+  taskENTER_CRITICAL();
+  TickType_t Now = xTaskGetTickCount();
+  while ((pThis->iTimerHeapCount > 0)
+         && ((int32_t)(MultiplexedState(pThis->pTimerHeap[0])->Expiry - Now) <= 0))
+  {
+    SSwTimer* pTimer = pThis->pTimerHeap[0];
+    SSwTimerMultiplexed_t* pState = MultiplexedState(pTimer);
+
+    MultiplexedHeapRemove(pThis, pTimer);
+    if (pState->bAutoReload)
+    {
+      pState->Expiry += pState->Period;
+      if ((int32_t)(pState->Expiry - Now) <= 0)
+      {
+        // Callbacks were delayed by more than a period. Don't try to catch up.
+        pState->Expiry = Now + pState->Period;
+      }
+      MultiplexedHeapInsert(pThis, pTimer);
+    }
+    MultiplexedPendingAppend(pThis, pTimer);
+    bExpired = true;
+  }
+  taskEXIT_CRITICAL();
+
+  // Nobody to report a failure to here, and the remaining timers would never expire
+  bool bReprogrammed = MultiplexedReprogram(pThis, false);
+  ASSERT(bReprogrammed);
+
+  if (bExpired)
+  {
+    MultiplexedNotifyReceiver(pThis);
+  }
+}
+
+static void MultiplexedNotificationHandler(SSwTimerLiaison* pThis)
+{
+  SSwTimer* pTimer;
+
+  /*
+   * Only handle the callbacks pending now. Timers expiring while the callbacks
+   * run are handled on the next notification.
+   */
+  taskENTER_CRITICAL();
+  uint8_t iCount = pThis->iPendingCount;
+  taskEXIT_CRITICAL();
+
+  for (; iCount > 0; iCount--)
+  {
+    taskENTER_CRITICAL();
+    pTimer = pThis->pPendingHead;
+    if (pTimer)
+    {
+      MultiplexedPendingRemove(pThis, pTimer);
+    }
+    taskEXIT_CRITICAL();
+
+    if (NULL == pTimer)
+    {
+      break;
+    }
+    ASSERT(pThis == pTimer->pLiaison);  // Check Timer and Liaison is matched
+    if (pTimer->pCallback != NULL)
+    {
+      pTimer->pCallback(pTimer);  // Perform callback
+    }
+  }
+}
+
+void TimerLiaisonInitMultiplexed(
+                        SSwTimerLiaison* pThis,
+                        uint32_t iTimerPointerArraySize,
+                        SSwTimer** pTimerPointerArray,
+                        SSwTimer** pTimerHeapArray,
+                        SSwTimer* pMultiplexTimer,
+                        uint8_t iTaskNotificationBitNumber,
+                        void* ReceiverTask
+                      )
+{
+  SSwTimerPrivate_t *pTimerPrivate = (SSwTimerPrivate_t*)&pMultiplexTimer->dummy;
+
+  ASSERT(iTimerPointerArraySize < SWTIMER_MULTIPLEXED_NOT_RUNNING);
+  pThis->iTimerCount = 0;
+  pThis->iTimerListSize = (uint8_t)iTimerPointerArraySize;
+  pThis->pTimerList = pTimerPointerArray;
+  pThis->iTaskNotificationBitNumber = iTaskNotificationBitNumber;
+  pThis->ReceiverTask = ReceiverTask;
+  pThis->pTimerHeap = pTimerHeapArray;
+  pThis->iTimerHeapCount = 0;
+  pThis->iPendingCount = 0;
+  pThis->pPendingHead = NULL;
+  pThis->pPendingTail = NULL;
+  pThis->pMultiplexTimer = pMultiplexTimer;
+  pThis->bReprogramFailed = false;
+
+  // The shared timer finds the liaison through its timer ID
+  pMultiplexTimer->TimerHandle = xTimerCreateStatic("",
+    1,
+    pdFALSE,
+    (void *)pThis, MultiplexedExpiredCallback,
+    &pTimerPrivate->xTimer
+    );
+  pMultiplexTimer->pLiaison = NULL;
+  pMultiplexTimer->pCallback = NULL;
+}
+
+bool TimerLiaisonIsMultiplexed(SSwTimerLiaison* pThis)
+{
+  return (NULL != pThis) && (NULL != pThis->pTimerHeap);
+}
+
+bool TimerLiaisonMultiplexedStart(SSwTimerLiaison* pThis, SSwTimer* pTimer, uint32_t iTicks, bool bFromISR)
+{
+  SSwTimerMultiplexed_t* pState = MultiplexedState(pTimer);
+
+  UBaseType_t SavedInterruptStatus = MultiplexedLock(bFromISR);
+  SSwTimer* pOldHead = (pThis->iTimerHeapCount > 0) ? pThis->pTimerHeap[0] : NULL;
+  TickType_t OldExpiry = pOldHead ? MultiplexedState(pOldHead)->Expiry : 0;
+  MultiplexedHeapRemove(pThis, pTimer);
+  MultiplexedPendingRemove(pThis, pTimer);
+  if (iTicks > 0)
+  {
+    pState->Period = iTicks;
+  }
+  pState->Expiry = MultiplexedNow(bFromISR) + pState->Period;
+  MultiplexedHeapInsert(pThis, pTimer);
+  bool bHeadChanged = (pOldHead != pThis->pTimerHeap[0])
+                      || (OldExpiry != MultiplexedState(pOldHead)->Expiry);
+  MultiplexedUnlock(bFromISR, SavedInterruptStatus);
+
+  // The FreeRTOS timer already runs to the earliest expiry unless that one changed
+  if (bHeadChanged || pThis->bReprogramFailed)
+  {
+    return MultiplexedReprogram(pThis, bFromISR);
+  }
+  return true;
+}
+
+bool TimerLiaisonMultiplexedStop(SSwTimerLiaison* pThis, SSwTimer* pTimer, bool bFromISR)
+{
+  UBaseType_t SavedInterruptStatus = MultiplexedLock(bFromISR);
+  bool bWasFirst = (pThis->iTimerHeapCount > 0) && (pThis->pTimerHeap[0] == pTimer);
+  MultiplexedHeapRemove(pThis, pTimer);
+  MultiplexedPendingRemove(pThis, pTimer);
+  MultiplexedUnlock(bFromISR, SavedInterruptStatus);
+
+  // A later expiry than programmed is handled by the callback, so only reprogram if needed
+  if (bWasFirst || pThis->bReprogramFailed)
+  {
+    return MultiplexedReprogram(pThis, bFromISR);
+  }
+  return true;
+}
+
+bool TimerLiaisonMultiplexedGetExpiry(SSwTimerLiaison* pThis, SSwTimer* pTimer, uint32_t* pExpiry)
+{
+  bool bRunning;
+
+  taskENTER_CRITICAL();
+  bRunning = (SWTIMER_MULTIPLEXED_NOT_RUNNING != MultiplexedState(pTimer)->HeapIndex);
+  if (bRunning && pExpiry)
+  {
+    *pExpiry = MultiplexedState(pTimer)->Expiry;
+  }
+  taskEXIT_CRITICAL();
+  (void)pThis;
+  return bRunning;
+}
+
 void TimerLiaisonNotificationHandler(SSwTimerLiaison* pThis)
 {
+  if (TimerLiaisonIsMultiplexed(pThis))
+  {
+    MultiplexedNotificationHandler(pThis);
+    return;
+  }
+
   SSwTimerLiaisonPrivate_t *pTimerLiaisonPrivate = (SSwTimerLiaisonPrivate_t *)&pThis->dummy;
   EventBits_t TimerEvents = xEventGroupClearBits(pTimerLiaisonPrivate->ReceiverEventHandle, 0x00FFFFFF);
   
@@ -108,6 +556,13 @@ void TimerLiaisonNotificationHandler(SSwTimerLiaison* pThis)
 
 void TimerLiaisonClearPendingTimerEvent(SSwTimerLiaison* pThis, uint32_t TimerId)
 {
+  if (TimerLiaisonIsMultiplexed(pThis))
+  {
+    taskENTER_CRITICAL();
+    MultiplexedPendingRemove(pThis, pThis->pTimerList[TimerId]);
+    taskEXIT_CRITICAL();
+    return;
+  }
   SSwTimerLiaisonPrivate_t *pTimerLiaisonPrivate = (SSwTimerLiaisonPrivate_t *)&pThis->dummy;
   ASSERT(TimerId < iEventGroupMaxEvents); // Only so many timers allowed - one timer per event group bit
   xEventGroupClearBits(pTimerLiaisonPrivate->ReceiverEventHandle, (1 << TimerId));
@@ -115,6 +570,13 @@ void TimerLiaisonClearPendingTimerEvent(SSwTimerLiaison* pThis, uint32_t TimerId
 
 void TimerLiaisonClearPendingTimerEventFromISR(SSwTimerLiaison* pThis, uint32_t TimerId)
 {
+  if (TimerLiaisonIsMultiplexed(pThis))
+  {
+    UBaseType_t SavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    MultiplexedPendingRemove(pThis, pThis->pTimerList[TimerId]);
+    taskEXIT_CRITICAL_FROM_ISR(SavedInterruptStatus);
+    return;
+  }
   SSwTimerLiaisonPrivate_t *pTimerLiaisonPrivate = (SSwTimerLiaisonPrivate_t *)&pThis->dummy;
   ASSERT(TimerId < iEventGroupMaxEvents); // Only so many timers allowed - one timer per event group bit
   xEventGroupClearBitsFromISR(pTimerLiaisonPrivate->ReceiverEventHandle, (1 << TimerId));
@@ -122,6 +584,10 @@ void TimerLiaisonClearPendingTimerEventFromISR(SSwTimerLiaison* pThis, uint32_t
 
 bool TimerLiaisonHasPendingTimerEvent(SSwTimerLiaison* pThis, uint32_t TimerId)
 {
+  if (TimerLiaisonIsMultiplexed(pThis))
+  {
+    return MultiplexedState(pThis->pTimerList[TimerId])->bPending;
+  }
   SSwTimerLiaisonPrivate_t *pTimerLiaisonPrivate = (SSwTimerLiaisonPrivate_t *)&pThis->dummy;
   ASSERT(TimerId < iEventGroupMaxEvents); // // Only so many timers allowed - one timer per event group bit
 
@@ -132,6 +598,10 @@ bool TimerLiaisonHasPendingTimerEvent(SSwTimerLiaison* pThis, uint32_t TimerId)
 
 bool TimerLiaisonHasPendingTimerEventFromISR(SSwTimerLiaison* pThis, uint32_t TimerId)
 {
+  if (TimerLiaisonIsMultiplexed(pThis))
+  {
+    return MultiplexedState(pThis->pTimerList[TimerId])->bPending;
+  }
   SSwTimerLiaisonPrivate_t *pTimerLiaisonPrivate = (SSwTimerLiaisonPrivate_t *)&pThis->dummy;
   ASSERT(TimerId < iEventGroupMaxEvents); // // Only so many timers allowed - one timer per event group bit
 
@@ -157,22 +627,42 @@ ESwTimerLiaisonStatus TimerLiaisonRegister(SSwTimerLiaison* pThis,
     return ESWTIMERLIAISON_STATUS_ALREADY_REGISTRERED;
   }
 
-  if (
-      (pThis->iTimerCount >= pThis->iTimerListSize) ||
-      (pThis->iTimerCount >= iEventGroupMaxEvents)
-     )
+  if (TimerLiaisonIsMultiplexed(pThis))
   {
-    return ESWTIMERLIAISON_STATUS_LIST_FULL;
+    if (pThis->iTimerCount >= pThis->iTimerListSize)
+    {
+      return ESWTIMERLIAISON_STATUS_LIST_FULL;
+    }
+
+    // No FreeRTOS timer of its own. The handle only tells that the timer is registered.
+    SSwTimerMultiplexed_t* pState = MultiplexedState(pTimer);
+    pState->Expiry = 0;
+    pState->Period = 1;
+    pState->pNextPending = NULL;
+    pState->HeapIndex = SWTIMER_MULTIPLEXED_NOT_RUNNING;
+    pState->bAutoReload = bAutoReload;
+    pState->bPending = false;
+    pTimer->TimerHandle = pTimer;
   }
+  else
+  {
+    if (
+        (pThis->iTimerCount >= pThis->iTimerListSize) ||
+        (pThis->iTimerCount >= iEventGroupMaxEvents)
+       )
+    {
+      return ESWTIMERLIAISON_STATUS_LIST_FULL;
+    }
 
-  // Period will be changed before timer start, but set to 1, as 0 is illegal.
-  // Throw away returned handle, its really pTimer.
-  pTimer->TimerHandle = xTimerCreateStatic("",
-    1,
-    bAutoReload ? pdTRUE : pdFALSE,
-    (void *)0, (TimerCallbackFunction_t)TimerLiaisonExpiredTimerCallback,
-    &pTimerPrivate->xTimer
-    );
+    // Period will be changed before timer start, but set to 1, as 0 is illegal.
+    // Throw away returned handle, its really pTimer.
+    pTimer->TimerHandle = xTimerCreateStatic("",
+      1,
+      bAutoReload ? pdTRUE : pdFALSE,
+      (void *)0, (TimerCallbackFunction_t)TimerLiaisonExpiredTimerCallback,
+      &pTimerPrivate->xTimer
+      );
+  }
   pTimer->pLiaison = pThis;
   pTimer->pCallback = pCallback;
   pTimer->Id = pThis->iTimerCount;
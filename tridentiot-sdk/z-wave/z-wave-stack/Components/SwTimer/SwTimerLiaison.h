@@ -50,6 +50,14 @@
 * The SwTimerLiaison contains a FreeRTOS static event group, and thus
 * uses no FreeRTOS heap.
 * 
+* A SwTimerLiaison initialized with TimerLiaisonInitMultiplexed uses another
+* backend, which is not limited to 24 timers. Its SwTimers have no FreeRTOS
+* timer of their own. The running timers are kept in a min-heap ordered by
+* expiry, and one FreeRTOS timer is programmed to the earliest expiry.
+* When it times out, the expired timers are moved to a pending callback list
+* and the receiver task is notified. TimerLiaisonNotificationHandler then only
+* visits the timers in that list.
+* The SwTimer API is the same for both backends.
 *
 */
 
@@ -103,6 +111,15 @@ typedef struct  SSwTimerLiaison
                                            task of pending timer event(range 0 - 31) */
   void* ReceiverTask;                 /**< Handle to task in which callbacks
                                            should be performed */
+  struct SSwTimer** pTimerHeap;       /**< Multiplexed only: running timers ordered by
+                                           expiry. NULL for the event group backend */
+  uint8_t iTimerHeapCount;            /**< Multiplexed only: number of timers in pTimerHeap */
+  uint8_t iPendingCount;              /**< Multiplexed only: number of timers with pending callback */
+  struct SSwTimer* pPendingHead;      /**< Multiplexed only: first timer with pending callback */
+  struct SSwTimer* pPendingTail;      /**< Multiplexed only: last timer with pending callback */
+  struct SSwTimer* pMultiplexTimer;   /**< Multiplexed only: holds the one FreeRTOS timer */
+  bool bReprogramFailed;              /**< Multiplexed only: the FreeRTOS timer may not match
+                                           pTimerHeap, as the last command failed */
 } SSwTimerLiaison;
 
 
@@ -130,6 +147,34 @@ void TimerLiaisonInit(
   );
 
 
+/**
+* Initialize TimerLiaison with the multiplexed backend.
+*
+* All registered timers share one FreeRTOS timer, so the number of timers is
+* only limited by the provided arrays (range 0 - 254).
+*
+* @param[in]     pThis                    Pointer to the TimerLiaison object
+* @param[in]     iTimerPointerArraySize   Number of entries in each of the provided arrays
+* @param[in]     pTimerPointerArray       Pointer to provided array of pointers to SwTimer objects
+* @param[in]     pTimerHeapArray          Pointer to provided array used to order the running timers
+* @param[in]     pMultiplexTimer          SwTimer object that holds the shared FreeRTOS timer.
+*                                         It must not be registered to any liaison.
+* @param[in]     iTaskNotificationBitNumber Number defines which bit to use when notifying
+*                                           receiver task of pending timer event (range 0 - 31)
+* @param[in]     ReceiverTask             Handle to FreeRTOS task that Timer callbacks Will be
+*                                         performed in. See TimerLiaisonInit.
+*/
+void TimerLiaisonInitMultiplexed(
+  SSwTimerLiaison* pThis,
+  uint32_t iTimerPointerArraySize,
+  SSwTimer** pTimerPointerArray,
+  SSwTimer** pTimerHeapArray,
+  SSwTimer* pMultiplexTimer,
+  uint8_t iTaskNotificationBitNumber,
+  void* ReceiverTask
+  );
+
+
 /**
 * Configures the Receiver task of callbacks.
 * 
@@ -226,6 +271,50 @@ bool TimerLiaisonHasPendingTimerEvent(SSwTimerLiaison* pThis, uint32_t TimerId);
 *                                         callback.
 */
 bool TimerLiaisonHasPendingTimerEventFromISR(SSwTimerLiaison* pThis, uint32_t TimerId);
+
+/**
+* Method provided for the SwTimers to call.
+*
+* @param[in]     pThis                    Pointer to the TimerLiaison object
+* @retval        true                     TimerLiaison uses the multiplexed backend.
+*/
+bool TimerLiaisonIsMultiplexed(SSwTimerLiaison* pThis);
+
+/**
+* Method provided for the SwTimers to call, on a multiplexed TimerLiaison only.
+*
+* (Re)starts a timer and clears its pending callback.
+*
+* @param[in]     pThis                    Pointer to the TimerLiaison object
+* @param[in]     pTimer                   Timer to start.
+* @param[in]     iTicks                   New timeout in ticks. Zero keeps the current one.
+* @param[in]     bFromISR                 Called from an Interrupt Service Routine.
+* @retval        false                    The shared FreeRTOS timer could not be reprogrammed.
+*/
+bool TimerLiaisonMultiplexedStart(SSwTimerLiaison* pThis, SSwTimer* pTimer, uint32_t iTicks, bool bFromISR);
+
+/**
+* Method provided for the SwTimers to call, on a multiplexed TimerLiaison only.
+*
+* Stops a timer and clears its pending callback.
+*
+* @param[in]     pThis                    Pointer to the TimerLiaison object
+* @param[in]     pTimer                   Timer to stop.
+* @param[in]     bFromISR                 Called from an Interrupt Service Routine.
+* @retval        false                    The shared FreeRTOS timer could not be reprogrammed.
+*/
+bool TimerLiaisonMultiplexedStop(SSwTimerLiaison* pThis, SSwTimer* pTimer, bool bFromISR);
+
+/**
+* Method provided for the SwTimers to call, on a multiplexed TimerLiaison only.
+*
+* @param[in]     pThis                    Pointer to the TimerLiaison object
+* @param[in]     pTimer                   Timer to query.
+* @param[out]    pExpiry                  Tick count at which the timer expires, if running.
+* @retval        true                     Timer is running.
+*/
+bool TimerLiaisonMultiplexedGetExpiry(SSwTimerLiaison* pThis, SSwTimer* pTimer, uint32_t* pExpiry);
+
 /**
  * @} // addtogroup SwTimerLiasions
  * @} // addtogroup SwTimer
@@ -17,6 +17,7 @@
 #include <task.h>
 #include <event_groups.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifndef COMPONENTS_SWTIMER_SWTIMERPRIVATE_H_
 #define COMPONENTS_SWTIMER_SWTIMERPRIVATE_H_
@@ -30,12 +31,33 @@
 * @{
 */
 
+/**
+* Value of SSwTimerMultiplexed_t::HeapIndex when the timer is not running.
+*/
+#define SWTIMER_MULTIPLEXED_NOT_RUNNING   0xFF
+
+/**
+* State of a timer registered to a multiplexed TimerLiaison.
+* It replaces the FreeRTOS timer, which such a timer does not have.
+*/
+typedef struct SSwTimerMultiplexed_t
+{
+  TickType_t Expiry;                    /**< Tick count at which the timer expires */
+  TickType_t Period;                    /**< Timeout in ticks */
+  struct SSwTimer* pNextPending;        /**< Next timer in the pending callback list */
+  uint8_t HeapIndex;                    /**< Position in the liaison heap, or
+                                             SWTIMER_MULTIPLEXED_NOT_RUNNING */
+  bool bAutoReload;                     /**< Restart the timer when it expires */
+  bool bPending;                        /**< Timer is in the pending callback list */
+} SSwTimerMultiplexed_t;
+
 /**
 * Timer Liaison object. All content is private.
 */
-typedef struct SSwTimerPrivate_t
+typedef union SSwTimerPrivate_t
 {
   StaticTimer_t xTimer;                 /**< Static buffer to store FreeRTOS timer */
+  SSwTimerMultiplexed_t Multiplexed;    /**< Used instead, if registered to a multiplexed liaison */
 } SSwTimerPrivate_t;
 
 /**
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file FreeRTOS.h
+ *
+ * Test stand-in for the FreeRTOS kernel API used by SwTimer and SwTimerLiaison.
+ * The test defines the functions. Critical sections are no-ops, as the test
+ * runs in one thread.
+ */
+#ifndef TEST_FREERTOS_H
+#define TEST_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE   ((BaseType_t)0)
+#define pdTRUE    ((BaseType_t)1)
+#define pdPASS    (pdTRUE)
+#define pdFAIL    (pdFALSE)
+
+#define configTICK_RATE_HZ  1000
+#define pdMS_TO_TICKS(xTimeInMs) \
+      ((TickType_t)(((uint64_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000))
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR()   ((UBaseType_t)0)
+#define taskEXIT_CRITICAL_FROM_ISR(x)   ((void)(x))
+
+/* Same size as the kernel objects on the 32 bit target, so the private buffers of SwTimer fit */
+typedef struct { uint32_t dummy[11]; } StaticTimer_t;
+typedef struct { uint32_t dummy[8]; } StaticEventGroup_t;
+
+#endif /* TEST_FREERTOS_H */
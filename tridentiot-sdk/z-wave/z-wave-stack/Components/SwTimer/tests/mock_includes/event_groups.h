@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file event_groups.h
+ *
+ * Test stand-in for the FreeRTOS event group API, see FreeRTOS.h.
+ */
+#ifndef TEST_EVENT_GROUPS_H
+#define TEST_EVENT_GROUPS_H
+
+#include <FreeRTOS.h>
+#include <timers.h>
+
+typedef void * EventGroupHandle_t;
+typedef TickType_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *pxEventGroupBuffer);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear);
+BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup);
+EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t xEventGroup);
+
+#endif /* TEST_EVENT_GROUPS_H */
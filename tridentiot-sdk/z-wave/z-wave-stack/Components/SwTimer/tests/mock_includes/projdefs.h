@@ -0,0 +1,10 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file projdefs.h
+ *
+ * Test stand-in, the definitions are in FreeRTOS.h.
+ */
+#include <FreeRTOS.h>
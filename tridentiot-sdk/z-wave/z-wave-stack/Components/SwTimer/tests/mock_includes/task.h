@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file task.h
+ *
+ * Test stand-in for the FreeRTOS task API, see FreeRTOS.h.
+ */
+#ifndef TEST_TASK_H
+#define TEST_TASK_H
+
+#include <FreeRTOS.h>
+
+typedef void * TaskHandle_t;
+
+typedef enum
+{
+  eNoAction = 0,
+  eSetBits
+} eNotifyAction;
+
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+
+#endif /* TEST_TASK_H */
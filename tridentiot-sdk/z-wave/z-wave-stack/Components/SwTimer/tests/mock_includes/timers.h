@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file timers.h
+ *
+ * Test stand-in for the FreeRTOS timer API, see FreeRTOS.h.
+ */
+#ifndef TEST_TIMERS_H
+#define TEST_TIMERS_H
+
+#include <FreeRTOS.h>
+
+typedef void * TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t xTimer);
+
+TimerHandle_t xTimerCreateStatic(const char * const pcTimerName,
+                                 const TickType_t xTimerPeriodInTicks,
+                                 const BaseType_t xAutoReload,
+                                 void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction,
+                                 StaticTimer_t *pxTimerBuffer);
+void *pvTimerGetTimerID(const TimerHandle_t xTimer);
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerReset(TimerHandle_t xTimer, TickType_t xTicksToWait);
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t xTicksToWait);
+BaseType_t xTimerStartFromISR(TimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xTimerStopFromISR(TimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xTimerResetFromISR(TimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xTimerChangePeriodFromISR(TimerHandle_t xTimer, TickType_t xNewPeriod, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer);
+TickType_t xTimerGetExpiryTime(TimerHandle_t xTimer);
+TickType_t xTimerGetPeriod(TimerHandle_t xTimer);
+
+#endif /* TEST_TIMERS_H */
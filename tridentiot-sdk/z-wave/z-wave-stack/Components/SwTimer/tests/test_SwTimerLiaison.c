@@ -0,0 +1,506 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file test_SwTimerLiaison.c
+ *
+ * Tests of the multiplexed SwTimerLiaison backend. The shared FreeRTOS timer
+ * is a stub that remembers when it was programmed to expire, and run_until()
+ * expires it like the timer daemon task would.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include <unity.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <timers.h>
+#include <event_groups.h>
+#include <SwTimer.h>
+#include <SwTimerLiaison.h>
+
+#define TIMER_COUNT         6
+#define AUTO_RELOAD_TIMER   (TIMER_COUNT - 1)
+#define START_TICK          1000
+
+static SSwTimerLiaison m_liaison;
+static SSwTimer* m_timer_list[TIMER_COUNT];
+static SSwTimer* m_timer_heap[TIMER_COUNT];
+static SSwTimer m_multiplex_timer;
+static SSwTimer m_timers[TIMER_COUNT];
+
+static TickType_t m_tick;
+static TimerCallbackFunction_t m_timer_callback;
+static void* m_timer_id;
+static bool m_timer_running;
+static TickType_t m_timer_expiry;
+static uint32_t m_timer_commands;
+static bool m_timer_commands_fail;
+static uint32_t m_notifications;
+
+static uint8_t m_expired_ids[16];
+static TickType_t m_expired_ticks[16];
+static uint8_t m_expired_count;
+
+/****************************************************************************/
+/*                            FREERTOS STUB                                 */
+/****************************************************************************/
+
+TickType_t xTaskGetTickCount(void)
+{
+  return m_tick;
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+  return m_tick;
+}
+
+BaseType_t xTaskNotify(__attribute__((unused)) TaskHandle_t xTaskToNotify,
+                       __attribute__((unused)) uint32_t ulValue,
+                       __attribute__((unused)) eNotifyAction eAction)
+{
+  m_notifications++;
+  return pdPASS;
+}
+
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+  return pdFALSE;
+}
+
+TimerHandle_t xTimerCreateStatic(__attribute__((unused)) const char * const pcTimerName,
+                                 __attribute__((unused)) const TickType_t xTimerPeriodInTicks,
+                                 const BaseType_t xAutoReload,
+                                 void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction,
+                                 StaticTimer_t *pxTimerBuffer)
+{
+  // Only the shared timer is a FreeRTOS timer, and it is a one-shot timer
+  TEST_ASSERT_EQUAL(pdFALSE, xAutoReload);
+  m_timer_callback = pxCallbackFunction;
+  m_timer_id = pvTimerID;
+  return (TimerHandle_t)pxTimerBuffer;
+}
+
+void *pvTimerGetTimerID(__attribute__((unused)) const TimerHandle_t xTimer)
+{
+  return m_timer_id;
+}
+
+static BaseType_t timer_command(bool bRunning, TickType_t xPeriod)
+{
+  m_timer_commands++;
+  if (m_timer_commands_fail)
+  {
+    return pdFAIL;
+  }
+  TEST_ASSERT_TRUE(!bRunning || (xPeriod > 0));
+  m_timer_running = bRunning;
+  m_timer_expiry = m_tick + xPeriod;
+  return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(__attribute__((unused)) TimerHandle_t xTimer,
+                              TickType_t xNewPeriod,
+                              __attribute__((unused)) TickType_t xTicksToWait)
+{
+  return timer_command(true, xNewPeriod);
+}
+
+BaseType_t xTimerChangePeriodFromISR(__attribute__((unused)) TimerHandle_t xTimer,
+                                     TickType_t xNewPeriod,
+                                     __attribute__((unused)) BaseType_t *pxHigherPriorityTaskWoken)
+{
+  return timer_command(true, xNewPeriod);
+}
+
+BaseType_t xTimerStop(__attribute__((unused)) TimerHandle_t xTimer,
+                      __attribute__((unused)) TickType_t xTicksToWait)
+{
+  return timer_command(false, 0);
+}
+
+BaseType_t xTimerStopFromISR(__attribute__((unused)) TimerHandle_t xTimer,
+                             __attribute__((unused)) BaseType_t *pxHigherPriorityTaskWoken)
+{
+  return timer_command(false, 0);
+}
+
+/* The rest is only used by the event group backend */
+
+BaseType_t xTimerStart(__attribute__((unused)) TimerHandle_t xTimer,
+                       __attribute__((unused)) TickType_t xTicksToWait)
+{
+  TEST_FAIL();
+  return pdFAIL;
+}
+
+BaseType_t xTimerReset(__attribute__((unused)) TimerHandle_t xTimer,
+                       __attribute__((unused)) TickType_t xTicksToWait)
+{
+  TEST_FAIL();
+  return pdFAIL;
+}
+
+BaseType_t xTimerStartFromISR(__attribute__((unused)) TimerHandle_t xTimer,
+                              __attribute__((unused)) BaseType_t *pxHigherPriorityTaskWoken)
+{
+  TEST_FAIL();
+  return pdFAIL;
+}
+
+BaseType_t xTimerResetFromISR(__attribute__((unused)) TimerHandle_t xTimer,
+                              __attribute__((unused)) BaseType_t *pxHigherPriorityTaskWoken)
+{
+  TEST_FAIL();
+  return pdFAIL;
+}
+
+BaseType_t xTimerIsTimerActive(__attribute__((unused)) TimerHandle_t xTimer)
+{
+  TEST_FAIL();
+  return pdFALSE;
+}
+
+TickType_t xTimerGetExpiryTime(__attribute__((unused)) TimerHandle_t xTimer)
+{
+  TEST_FAIL();
+  return 0;
+}
+
+TickType_t xTimerGetPeriod(__attribute__((unused)) TimerHandle_t xTimer)
+{
+  TEST_FAIL();
+  return 0;
+}
+
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *pxEventGroupBuffer)
+{
+  return (EventGroupHandle_t)pxEventGroupBuffer;
+}
+
+EventBits_t xEventGroupClearBits(__attribute__((unused)) EventGroupHandle_t xEventGroup,
+                                 __attribute__((unused)) const EventBits_t uxBitsToClear)
+{
+  TEST_FAIL();
+  return 0;
+}
+
+BaseType_t xEventGroupClearBitsFromISR(__attribute__((unused)) EventGroupHandle_t xEventGroup,
+                                       __attribute__((unused)) const EventBits_t uxBitsToClear)
+{
+  TEST_FAIL();
+  return pdFAIL;
+}
+
+EventBits_t xEventGroupSetBits(__attribute__((unused)) EventGroupHandle_t xEventGroup,
+                               __attribute__((unused)) const EventBits_t uxBitsToSet)
+{
+  TEST_FAIL();
+  return 0;
+}
+
+EventBits_t xEventGroupGetBits(__attribute__((unused)) EventGroupHandle_t xEventGroup)
+{
+  TEST_FAIL();
+  return 0;
+}
+
+EventBits_t xEventGroupGetBitsFromISR(__attribute__((unused)) EventGroupHandle_t xEventGroup)
+{
+  TEST_FAIL();
+  return 0;
+}
+
+/****************************************************************************/
+/*                               HELPERS                                    */
+/****************************************************************************/
+
+static void timer_callback(SSwTimer* pTimer)
+{
+  TEST_ASSERT_TRUE(m_expired_count < sizeof(m_expired_ids));
+  m_expired_ids[m_expired_count] = pTimer->Id;
+  m_expired_ticks[m_expired_count] = m_tick;
+  m_expired_count++;
+}
+
+/* Lets time pass until the tick count, expiring the FreeRTOS timer like the daemon task would */
+static void run_until(TickType_t tick)
+{
+  while (m_timer_running && ((int32_t)(m_timer_expiry - tick) <= 0))
+  {
+    m_tick = m_timer_expiry;
+    m_timer_running = false;
+    m_timer_callback((TimerHandle_t)&m_multiplex_timer);
+  }
+  m_tick = tick;
+}
+
+/* Does what the receiver task does on the task notification */
+static void handle_notification(void)
+{
+  if (m_notifications > 0)
+  {
+    m_notifications = 0;
+    TimerLiaisonNotificationHandler(&m_liaison);
+  }
+}
+
+/* Steps one tick at a time, so every callback runs at the tick its timer expires */
+static void run_and_handle_until(TickType_t tick)
+{
+  while ((int32_t)(m_tick - tick) < 0)
+  {
+    run_until(m_tick + 1);
+    handle_notification();
+  }
+}
+
+static void assert_expired(const uint8_t* pIds, const TickType_t* pTicks, uint8_t count)
+{
+  TEST_ASSERT_EQUAL_UINT8(count, m_expired_count);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(pIds, m_expired_ids, count);
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(pTicks, m_expired_ticks, count);
+}
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(&m_liaison, 0, sizeof(m_liaison));
+  memset(&m_multiplex_timer, 0, sizeof(m_multiplex_timer));
+  memset(m_timers, 0, sizeof(m_timers));
+  m_tick = START_TICK;
+  m_timer_running = false;
+  m_timer_commands = 0;
+  m_timer_commands_fail = false;
+  m_notifications = 0;
+  m_expired_count = 0;
+
+  TimerLiaisonInitMultiplexed(&m_liaison, TIMER_COUNT, m_timer_list, m_timer_heap,
+                              &m_multiplex_timer, 0, (void*)&m_liaison);
+  for (uint8_t i = 0; i < TIMER_COUNT; i++)
+  {
+    TEST_ASSERT_EQUAL(ESWTIMERLIAISON_STATUS_SUCCESS,
+                      TimerLiaisonRegister(&m_liaison, &m_timers[i], (AUTO_RELOAD_TIMER == i), timer_callback));
+    TEST_ASSERT_EQUAL_UINT8(i, m_timers[i].Id);
+  }
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                TESTS                                     */
+/****************************************************************************/
+
+/**
+ * Timers started in any order expire in the order of their timeouts, each at
+ * its own tick.
+ */
+void test_expiry_order(void)
+{
+  const uint32_t timeouts[] = { 50, 10, 40, 20, 30 };
+  const uint8_t ids[] = { 1, 3, 4, 2, 0 };
+  const TickType_t ticks[] = { 1010, 1020, 1030, 1040, 1050 };
+
+  for (uint8_t i = 0; i < sizeof(timeouts) / sizeof(timeouts[0]); i++)
+  {
+    TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerStart(&m_timers[i], timeouts[i]));
+  }
+
+  run_and_handle_until(START_TICK + 100);
+
+  assert_expired(ids, ticks, sizeof(ids));
+  TEST_ASSERT_FALSE(m_timer_running);
+  for (uint8_t i = 0; i < sizeof(timeouts) / sizeof(timeouts[0]); i++)
+  {
+    TEST_ASSERT_FALSE(TimerIsActive(&m_timers[i]));
+  }
+}
+
+/**
+ * The callbacks run in the receiver task, not in the timer daemon task.
+ */
+void test_callback_runs_on_notification(void)
+{
+  TimerStart(&m_timers[0], 10);
+
+  run_until(START_TICK + 10);
+  TEST_ASSERT_EQUAL_UINT32(1, m_notifications);
+  TEST_ASSERT_EQUAL_UINT8(0, m_expired_count);
+  TEST_ASSERT_TRUE(TimerHasPendingCallback(&m_timers[0]));
+  TEST_ASSERT_TRUE(TimerIsActive(&m_timers[0]));
+
+  handle_notification();
+  TEST_ASSERT_EQUAL_UINT8(1, m_expired_count);
+  TEST_ASSERT_FALSE(TimerHasPendingCallback(&m_timers[0]));
+}
+
+/**
+ * The shared FreeRTOS timer is only reprogrammed when the earliest expiry changes.
+ */
+void test_start_reprograms_only_for_new_head(void)
+{
+  TimerStart(&m_timers[0], 20);
+  TEST_ASSERT_EQUAL_UINT32(1, m_timer_commands);
+  TEST_ASSERT_EQUAL_UINT32(START_TICK + 20, m_timer_expiry);
+
+  TimerStart(&m_timers[1], 30);
+  TimerStart(&m_timers[2], 20);
+  TEST_ASSERT_EQUAL_UINT32(1, m_timer_commands);
+
+  TimerStart(&m_timers[3], 10);
+  TEST_ASSERT_EQUAL_UINT32(2, m_timer_commands);
+  TEST_ASSERT_EQUAL_UINT32(START_TICK + 10, m_timer_expiry);
+
+  // Restarting the earliest timer moves its expiry
+  run_until(START_TICK + 5);
+  TimerStart(&m_timers[3], 10);
+  TEST_ASSERT_EQUAL_UINT32(3, m_timer_commands);
+  TEST_ASSERT_EQUAL_UINT32(START_TICK + 15, m_timer_expiry);
+}
+
+/**
+ * Starting a running timer again moves it to its new expiry. TimerRestart()
+ * keeps the timeout it was started with.
+ */
+void test_restart_running_timer(void)
+{
+  const uint8_t ids[] = { 1, 0, 0 };
+  const TickType_t ticks[] = { 1020, 1035, 1070 };
+
+  TimerStart(&m_timers[0], 10);
+  TimerStart(&m_timers[1], 20);
+
+  run_and_handle_until(START_TICK + 5);
+  TimerStart(&m_timers[0], 30);
+  TEST_ASSERT_EQUAL_UINT32(START_TICK + 20, m_timer_expiry);
+
+  run_and_handle_until(START_TICK + 40);
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerRestart(&m_timers[0]));
+  run_and_handle_until(START_TICK + 100);
+
+  assert_expired(ids, ticks, sizeof(ids));
+}
+
+/**
+ * An auto-reload timer expires every period until it is stopped.
+ */
+void test_auto_reload(void)
+{
+  const uint8_t ids[] = { AUTO_RELOAD_TIMER, 0, AUTO_RELOAD_TIMER, AUTO_RELOAD_TIMER };
+  const TickType_t ticks[] = { 1010, 1015, 1020, 1030 };
+  uint32_t ms_until_timeout = 0;
+
+  TimerStart(&m_timers[AUTO_RELOAD_TIMER], 10);
+  TimerStart(&m_timers[0], 15);
+
+  run_and_handle_until(START_TICK + 35);
+  assert_expired(ids, ticks, sizeof(ids));
+  TEST_ASSERT_TRUE(TimerIsActive(&m_timers[AUTO_RELOAD_TIMER]));
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS,
+                    TimerGetMsUntilTimeout(&m_timers[AUTO_RELOAD_TIMER], m_tick, &ms_until_timeout));
+  TEST_ASSERT_EQUAL_UINT32(5, ms_until_timeout);
+
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerStop(&m_timers[AUTO_RELOAD_TIMER]));
+  TEST_ASSERT_FALSE(m_timer_running);
+  TEST_ASSERT_FALSE(TimerIsActive(&m_timers[AUTO_RELOAD_TIMER]));
+
+  run_and_handle_until(START_TICK + 100);
+  TEST_ASSERT_EQUAL_UINT8(sizeof(ids), m_expired_count);
+}
+
+/**
+ * Stopping the earliest timer reprograms the shared timer to the next one.
+ * Stopping any other timer does not touch it.
+ */
+void test_stop_head_timer(void)
+{
+  const uint8_t ids[] = { 2 };
+  const TickType_t ticks[] = { 1030 };
+
+  TimerStart(&m_timers[0], 10);
+  TimerStart(&m_timers[1], 20);
+  TimerStart(&m_timers[2], 30);
+  TEST_ASSERT_EQUAL_UINT32(1, m_timer_commands);
+
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerStop(&m_timers[1]));
+  TEST_ASSERT_EQUAL_UINT32(1, m_timer_commands);
+
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerStopFromISR(&m_timers[0]));
+  TEST_ASSERT_EQUAL_UINT32(2, m_timer_commands);
+  TEST_ASSERT_EQUAL_UINT32(START_TICK + 30, m_timer_expiry);
+
+  run_and_handle_until(START_TICK + 100);
+  assert_expired(ids, ticks, sizeof(ids));
+
+  // Stopping a timer that is not running changes nothing
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerStop(&m_timers[2]));
+  TEST_ASSERT_EQUAL_UINT32(3, m_timer_commands);
+}
+
+/**
+ * Pending callbacks run in the order the timers expired. Stopping or
+ * restarting a timer drops its pending callback.
+ */
+void test_pending_fifo(void)
+{
+  const uint8_t ids[] = { 1, 0 };
+  const TickType_t ticks[] = { 1040, 1040 };
+
+  TimerStart(&m_timers[0], 30);
+  TimerStart(&m_timers[1], 10);
+  TimerStart(&m_timers[2], 20);
+  TimerStart(&m_timers[3], 5);
+
+  // The receiver task is busy, so the callbacks of all four are pending
+  run_until(START_TICK + 40);
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    TEST_ASSERT_TRUE(TimerHasPendingCallback(&m_timers[i]));
+  }
+
+  TimerStop(&m_timers[2]);
+  TEST_ASSERT_FALSE(TimerHasPendingCallback(&m_timers[2]));
+  TimerStartFromISR(&m_timers[3], 100);
+  TEST_ASSERT_FALSE(TimerHasPendingCallback(&m_timers[3]));
+
+  handle_notification();
+  assert_expired(ids, ticks, sizeof(ids));
+  TEST_ASSERT_TRUE(TimerIsActive(&m_timers[3]));
+}
+
+/**
+ * A failed timer command is reported to the caller, and the next start
+ * reprograms the shared timer even if the earliest expiry did not change.
+ */
+void test_timer_command_failure(void)
+{
+  const uint8_t ids[] = { 0, 1 };
+  const TickType_t ticks[] = { 1010, 1020 };
+
+  m_timer_commands_fail = true;
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_FAILED, TimerStart(&m_timers[0], 10));
+  TEST_ASSERT_FALSE(m_timer_running);
+
+  m_timer_commands_fail = false;
+  TEST_ASSERT_EQUAL(ESWTIMER_STATUS_SUCCESS, TimerStart(&m_timers[1], 20));
+  TEST_ASSERT_TRUE(m_timer_running);
+  TEST_ASSERT_EQUAL_UINT32(START_TICK + 10, m_timer_expiry);
+
+  run_and_handle_until(START_TICK + 100);
+  assert_expired(ids, ticks, sizeof(ids));
+}
@@ -70,11 +70,11 @@ static void leftshift_onebit(const uint8_t * input, uint8_t * output)
 
 /**
  * @brief Generates two sub keys based on a given key.
- * @param key 128-bit key.
+ * @param ctx Expanded 128-bit key.
  * @param K1 128-bit first sub key.
  * @param K2 128-bit second sub key.
  */
-static void generate_subkey(const uint8_t * key, uint8_t * K1, uint8_t * K2)
+static void generate_subkey(const aes128_ctx * ctx, uint8_t * K1, uint8_t * K2)
 {
   uint8_t L[16];
   uint8_t tmp[16];
@@ -92,7 +92,7 @@ static void generate_subkey(const uint8_t * key, uint8_t * K1, uint8_t * K2)
   /*
    * L := AES-128(Key, const_Zero);
    */
-  AES128_ECB_encrypt((uint8_t *)const_Zero, key, L);
+  AES128_ctx_encrypt(ctx, const_Zero, L);
 
   if (0 == (L[0] & 0x80)) // if MSB(L) is equal to 0 then K1 := L << 1;
   {
@@ -154,8 +154,10 @@ void aes_cmac_calculate(
   uint8_t flag;
   uint8_t n; //int n;
   uint8_t i; //int i;
+  aes128_ctx ctx;
 
-  generate_subkey(key, K1, K2);
+  AES128_init_ctx(&ctx, key);
+  generate_subkey(&ctx, K1, K2);
 
   n = (message_length + 15) / 16; // n is number of rounds
 
@@ -194,11 +196,11 @@ void aes_cmac_calculate(
   for (i = 0; i < (n-1); i++)
   {
     xor_128(X, &message[16 * i], Y); /* Y := Mi (+) X  */
-    AES128_ECB_encrypt(Y, key, X); // X := AES-128(key, Y);
+    AES128_ctx_encrypt(&ctx, Y, X); // X := AES-128(key, Y);
   }
 
   xor_128(X, M_last, Y);
-  AES128_ECB_encrypt(Y, key, X); // X := AES-128(key, Y);
+  AES128_ctx_encrypt(&ctx, Y, X); // X := AES-128(key, Y);
 
   for (i = 0; i < 16; i++)
   {
@@ -89,10 +89,17 @@ static void AES_CTR_DRBG_Update(CTR_DRBG_CTX* ctx, uint8_t __data[SEEDLEN])
     int j = 0;
 #endif
 
-    //AJ_AES_Enable(ctx->k);
+#ifndef ZWAVE_PSA_AES
+    aes128_ctx aes;
+    AES128_init_ctx(&aes, ctx->k);
+#endif
     for (i = 0; i < SEEDLEN; i += OUTLEN) {
         AES_CTR_DRBG_Increment(ctx->v, OUTLEN); /*V= (V+ 1) mod 2 pow(outlen) */
+#ifdef ZWAVE_PSA_AES
         AJ_AES_ECB_128_ENCRYPT(ctx->k, ctx->v, t); /* output_block =  Block_Encrypt(Key, V). */
+#else
+        AES128_ctx_encrypt(&aes, ctx->v, t); /* output_block =  Block_Encrypt(Key, V). */
+#endif
         t += OUTLEN; /*temp = temp || ouput_block */
     }
 
@@ -168,10 +175,17 @@ void AES_CTR_DRBG_Generate(CTR_DRBG_CTX* ctx, uint8_t* rand)
 #endif
     // Reseed interval 2^32 (counter wraps to zero)
     // See section 10.2.1.5.1. Step 1 in "CTR_DRBG Generate Proces"
-    //AJ_AES_Enable(ctx->k);
+#ifndef ZWAVE_PSA_AES
+    aes128_ctx aes;
+    AES128_init_ctx(&aes, ctx->k);
+#endif
     while (size) {
         AES_CTR_DRBG_Increment(ctx->v, OUTLEN);
+#ifdef ZWAVE_PSA_AES
         AJ_AES_ECB_128_ENCRYPT(ctx->k, ctx->v, __data);
+#else
+        AES128_ctx_encrypt(&aes, ctx->v, __data);
+#endif
         copy = (size < OUTLEN) ? size : OUTLEN;
         memcpy(rand, __data, copy);
         rand += copy;
@@ -5,6 +5,10 @@
 
 #include <stdint.h>
 
+#ifndef DllExport
+#define DllExport extern
+#endif
+
 /**
  * \defgroup crypto S2 Cryptographic functions
  * This are all the cryptographic components used by S2
@@ -29,8 +33,56 @@
 
 
 
+/**
+ * Size of the expanded AES-128 key: 11 round keys of 16 bytes.
+ */
+#define AES128_ROUND_KEY_SIZE 176
+
+/**
+ * Expanded AES-128 key.
+ *
+ * The key schedule is computed once by AES128_init_ctx() and can then be used
+ * for any number of blocks. The context is only read when encrypting or
+ * decrypting, so it can be shared between callers.
+ */
+typedef struct aes128_ctx
+{
+  uint8_t round_key[AES128_ROUND_KEY_SIZE];
+} aes128_ctx;
+
+/**
+ * Expands a key into a context.
+ *
+ * @param[out] ctx Context to initialize.
+ * @param[in]  key 128-bit key.
+ */
+DllExport void AES128_init_ctx(aes128_ctx* ctx, const uint8_t* key);
+
+/**
+ * Encrypts one 16 byte block with an expanded key.
+ *
+ * @param[in]  ctx    Context initialized by AES128_init_ctx().
+ * @param[in]  input  Plain text block.
+ * @param[out] output Cipher text block. May be the same buffer as input.
+ */
+DllExport void AES128_ctx_encrypt(const aes128_ctx* ctx, const uint8_t* input, uint8_t* output);
+
+/**
+ * Decrypts one 16 byte block with an expanded key.
+ *
+ * @param[in]  ctx    Context initialized by AES128_init_ctx().
+ * @param[in]  input  Cipher text block.
+ * @param[out] output Plain text block. May be the same buffer as input.
+ */
+DllExport void AES128_ctx_decrypt(const aes128_ctx* ctx, const uint8_t* input, uint8_t* output);
+
+
 #if defined(ECB) && ECB
 
+/*
+ * Single block functions. The key is expanded on every call, use the
+ * aes128_ctx functions above when encrypting more than one block with a key.
+ */
 DllExport void AES128_ECB_encrypt(uint8_t* input, const uint8_t* key, uint8_t *output);
 DllExport void AES128_ECB_decrypt(uint8_t* input, const uint8_t* key, uint8_t *output);
 
@@ -39,6 +91,10 @@ DllExport void AES128_ECB_decrypt(uint8_t* input, const uint8_t* key, uint8_t *o
 
 #if defined(CBC) && CBC
 
+/*
+ * A key of 0 reuses the key of the previous call and an iv of 0 continues the
+ * chain of the previous call. These functions are therefore not reentrant.
+ */
 void AES128_CBC_encrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length, const uint8_t* key, const uint8_t* iv);
 void AES128_CBC_decrypt_buffer(uint8_t* output, uint8_t* input, uint32_t length, const uint8_t* key, const uint8_t* iv);
 
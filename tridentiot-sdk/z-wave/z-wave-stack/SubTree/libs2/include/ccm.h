@@ -20,20 +20,27 @@
  */
 #define CCM_TEST
 
+/**
+ * CCM parameters, see A.1 in NIST SP 800-38C.
+ */
+typedef struct ccm_params
+{
+  uint8_t q; ///< Octet length of the payload length field, 2 to 8
+  uint8_t n; ///< Octet length of the nonce, 15 - q
+  uint8_t t; ///< Octet length of the auth tag, 4 to 16 and even
+} ccm_params_t;
+
 /*
- * When we're testing with either unit test or on the 8051, we want to use
- * different values. Therefore the C51 must be defined and a test define must
- * not be defined for this to be true.
+ * The CCM parameters used by S2. The payload length is at most 2^16 octets,
+ * which covers the S2 work buffer (WORKBUF_SIZE).
  */
-#ifdef CCM_USE_PREDEFINED_VALUES
-#define KYO (2)
-#define Q_DEF KYO
-#define N_DEF (15 - KYO)
-#define T_DEF (8)
-#endif
+#define CCM_S2_Q (2)
+#define CCM_S2_N (15 - CCM_S2_Q)
+#define CCM_S2_T (8)
 
 /**
   * CCM Encrypt the text_to_encrypt and authenticate AAD, adding auth tag to ciphertext.
+  * The S2 parameters are used, see CCM_S2_Q, CCM_S2_N and CCM_S2_T.
   * \param key 16 bytes
   * \param nonce 16 bytes
   * \param aad Additional Authenticated Data (AAD)
@@ -56,6 +63,7 @@ uint32_t CCM_encrypt_and_auth(
 /**
   * Decrypt and authenticate received ciphertext and AAD.
   * The decryption is performed in-place on the plain_ciphertext buffer.
+  * The S2 parameters are used, see CCM_S2_Q, CCM_S2_N and CCM_S2_T.
   *
   * \return Length of plaintext if authentication OK or 0 when auth fails
   * \param key 16 bytes
@@ -75,11 +83,37 @@ uint16_t CCM_decrypt_and_auth(
    const uint32_t ciphertext_len
    );
 
-#ifndef CCM_USE_PREDEFINED_VALUES
-void set_q_n_t(uint8_t q_in, uint8_t n_in, uint8_t t_in);
-#endif
-void get_q_n_t(uint8_t * q_out, uint8_t * n_out, uint8_t * t_out);
-void get_q(uint8_t * q_out);
+/**
+  * CCM Encrypt and authenticate with other parameters than the S2 ones.
+  * \param params CCM parameters
+  * \see CCM_encrypt_and_auth
+  */
+DllExport
+uint32_t CCM_encrypt_and_auth_params(
+   const ccm_params_t *params,
+   const uint8_t *key,
+   const uint8_t *nonce,
+   const uint8_t *aad,
+   const uint32_t aad_len,
+   uint8_t *plain_ciphertext,
+   const uint16_t plaintext_len
+   );
+
+/**
+  * Decrypt and authenticate with other parameters than the S2 ones.
+  * \param params CCM parameters
+  * \see CCM_decrypt_and_auth
+  */
+DllExport
+uint16_t CCM_decrypt_and_auth_params(
+   const ccm_params_t *params,
+   const uint8_t *key,
+   const uint8_t *nonce,
+   const uint8_t *aad,
+   const uint32_t aad_len,
+   uint8_t *cipher_plaintext,
+   const uint32_t ciphertext_len
+   );
 
 /**
  * @}
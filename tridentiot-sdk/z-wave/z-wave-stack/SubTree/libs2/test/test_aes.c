@@ -0,0 +1,106 @@
+/* © 2024 Silicon Laboratories Inc.
+ */
+/**
+ * @file test_aes.c
+ * @brief Tests of the AES-128 context API.
+ */
+#include <stdint.h>
+#include <string.h>
+#include <unity.h>
+#include "aes.h"
+
+/* ECB-AES128 test vectors from NIST SP 800-38A, F.1.1 */
+static const uint8_t key[16] = {
+  0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static const uint8_t plain_text[64] = {
+  0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+  0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+  0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+  0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+};
+
+static const uint8_t cipher_text[64] = {
+  0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+  0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+  0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+  0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4
+};
+
+void test_ctx_encrypt_decrypt(void)
+{
+  aes128_ctx ctx;
+  uint8_t buf[64];
+
+  AES128_init_ctx(&ctx, key);
+
+  for (uint8_t i = 0; i < sizeof(buf); i += 16)
+  {
+    AES128_ctx_encrypt(&ctx, &plain_text[i], &buf[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(cipher_text, buf, sizeof(buf));
+
+  for (uint8_t i = 0; i < sizeof(buf); i += 16)
+  {
+    AES128_ctx_decrypt(&ctx, &cipher_text[i], &buf[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(plain_text, buf, sizeof(buf));
+}
+
+/**
+ * Verifies that a block can be encrypted and decrypted in place.
+ */
+void test_ctx_in_place(void)
+{
+  aes128_ctx ctx;
+  uint8_t buf[16];
+
+  AES128_init_ctx(&ctx, key);
+
+  memcpy(buf, plain_text, sizeof(buf));
+  AES128_ctx_encrypt(&ctx, buf, buf);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(cipher_text, buf, sizeof(buf));
+
+  AES128_ctx_decrypt(&ctx, buf, buf);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(plain_text, buf, sizeof(buf));
+}
+
+/**
+ * Verifies that contexts of different keys can be used interleaved and that
+ * the single block functions give the same result as the contexts.
+ */
+void test_ctx_interleaved_keys(void)
+{
+  const uint8_t other_key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+  /* FIPS-197, C.1 */
+  const uint8_t other_plain_text[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  const uint8_t other_cipher_text[16] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+  };
+  aes128_ctx ctx;
+  aes128_ctx other_ctx;
+  uint8_t buf[16];
+
+  AES128_init_ctx(&ctx, key);
+  AES128_init_ctx(&other_ctx, other_key);
+
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    AES128_ctx_encrypt(&ctx, &plain_text[16 * i], buf);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&cipher_text[16 * i], buf, sizeof(buf));
+
+    AES128_ctx_encrypt(&other_ctx, other_plain_text, buf);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(other_cipher_text, buf, sizeof(buf));
+
+    AES128_ECB_encrypt((uint8_t *)&plain_text[16 * i], key, buf);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&cipher_text[16 * i], buf, sizeof(buf));
+  }
+
+  AES128_ECB_decrypt((uint8_t *)other_cipher_text, other_key, buf);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(other_plain_text, buf, sizeof(buf));
+}
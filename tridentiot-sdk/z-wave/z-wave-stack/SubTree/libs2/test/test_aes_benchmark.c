@@ -0,0 +1,67 @@
+/* © 2024 Silicon Laboratories Inc.
+ */
+/**
+ * @file test_aes_benchmark.c
+ * @brief Benchmark of the AES-128 key schedule caching. Only built with
+ * UNIT_TEST_BENCHMARKS, as the timings depend on the host.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "aes.h"
+
+/* ECB-AES128 key and first block from NIST SP 800-38A, F.1.1 */
+static const uint8_t key[16] = {
+  0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static const uint8_t plain_text[16] = {
+  0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a
+};
+
+#define BENCHMARK_BLOCKS  100000
+
+/**
+ * Prints the speed of encrypting with the key expanded for every block, like
+ * AES128_ECB_encrypt() does, and with the key expanded once in a context.
+ */
+void test_aes_benchmark(void)
+{
+  aes128_ctx ctx;
+  uint8_t block[16];
+
+  memcpy(block, plain_text, sizeof(block));
+
+  for (uint8_t cached = 0; cached < 2; cached++)
+  {
+    clock_t start = clock();
+
+    if (cached)
+    {
+      AES128_init_ctx(&ctx, key);
+    }
+    for (uint32_t i = 0; i < BENCHMARK_BLOCKS; i++)
+    {
+      if (cached)
+      {
+        AES128_ctx_encrypt(&ctx, block, block);
+      }
+      else
+      {
+        AES128_ECB_encrypt(block, key, block);
+      }
+    }
+    unsigned long us = (unsigned long)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+
+    printf("AES-128 %s: %lu blocks in %lu us",
+           cached ? "key expanded once" : "key expanded per block",
+           (unsigned long)BENCHMARK_BLOCKS, us);
+    if (us)
+    {
+      printf(", %lu blocks/s", (unsigned long)((uint64_t)BENCHMARK_BLOCKS * 1000000 / us));
+    }
+    printf("\n");
+  }
+}
@@ -23,8 +23,10 @@ void test_subkey_generation(void)
   const uint8_t subkey2[] = {0xf7, 0xdd, 0xac, 0x30, 0x6a, 0xe2, 0x66, 0xcc, 0xf9, 0x0b, 0xc1, 0x1e, 0xe4, 0x6d, 0x51, 0x3b};
   uint8_t out1[16];
   uint8_t out2[16];
+  aes128_ctx ctx;
 
-  generate_subkey(key, out1, out2);
+  AES128_init_ctx(&ctx, key);
+  generate_subkey(&ctx, out1, out2);
 
   UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(subkey1, out1, 16, __LINE__, "");
   UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(subkey2, out2, 16, __LINE__, "");
@@ -24,11 +24,8 @@ void test_verify_handful_payload_lengths(void)
     int ret;
     int lengths[6] = {0, 10, 22, 54, 1279, 1280}; // Makes no sense to test for length 0 since the compare function will compare zero characters.
     //int lengths[6] = {1, 10, 22, 54, 1279, 1280};
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-    set_q_n_t(7, 8, 6);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 7, 8, 6 };
+    const uint8_t t = params.t;
 
     for(i = 0; i < 6; i++) {
         plaintext_len = text_to_encrypt_len = lengths[i];
@@ -64,7 +61,7 @@ void test_verify_handful_payload_lengths(void)
             text_to_encrypt_bkup[j] = j;
          }
         memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
-        ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+        ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
         if (ret == 0) {
             printf("verify_handful_payload_lengths TEST FAILED in encryption\n");
             goto out;
@@ -72,7 +69,7 @@ void test_verify_handful_payload_lengths(void)
              ciphertext_len = ret;
         }
 
-        ret = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+        ret = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
         if ((ret == 0) && (lengths[i] != 0)) {
             printf("verify_handlful_payload_lengths TEST FAILED in decryption\n");
             ret = 1;
@@ -125,11 +122,8 @@ void ignore_test_verify_all_payload_lengths(void)
     int i, j;
     int ret;
 
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-    set_q_n_t(7, 8, 6);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 7, 8, 6 };
+    const uint8_t t = params.t;
     /*
     q = 7; 
     t = 6;
@@ -169,7 +163,7 @@ void ignore_test_verify_all_payload_lengths(void)
             text_to_encrypt_bkup[j] = j;
          }
         memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
-        ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+        ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
         if (ret == 0) {
             printf("verify_all_payload_lengths TEST FAILED in encryption\n");
             goto out;
@@ -177,7 +171,7 @@ void ignore_test_verify_all_payload_lengths(void)
              ciphertext_len = ret;
         }
 
-        ret = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+        ret = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
         if (ret == 0) {
             printf("verify_all_payload_lengths TEST FAILED in decryption\n");
             ret = 1;
@@ -232,16 +226,11 @@ void test_example1(void)
     uint32_t ciphertext_len = CIPHERTEXT_LEN_DEF;
     int ret;
     uint8_t nist_cipher_and_auth_tag[16 + 6] = {0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62, 0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d, 0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd};
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-
-    set_q_n_t(7, 8, T_DEF);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 7, 8, T_DEF };
 
     memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
     printf("Refer to http://csrc.nist.gov/publications/nistpubs/800-38C/SP800-38C_updated-July20_2007.pdf page 17 Example 2\n");
-    ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+    ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
 
     UNITY_TEST_ASSERT((0 != ret), __LINE__, "Could not encrypt :(");
 
@@ -251,7 +240,7 @@ void test_example1(void)
 
     UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(nist_cipher_and_auth_tag, ciphertext, ciphertext_len, __LINE__, "Ciphertext does not match with NIST document.");
 
-    ret = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+    ret = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
 
     UNITY_TEST_ASSERT((0 != ret), __LINE__, "Could not decrypt :(");
 
@@ -277,11 +266,8 @@ void test_big_aad_example(void)
     uint8_t nist_cipher_and_auth_tag[32 + 14] = {0x69,0x91,0x5d,0xad,0x1e,0x84,0xc6,0x37,0x6a,0x68,0xc2,0x96,0x7e,0x4d,0xab,0x61,0x5a,0xe0,
                 0xfd,0x1f,0xae,0xc4,0x4c,0xc4,0x84,0x82,0x85,0x29,0x46,0x3c,0xcf,0x72,0xb4,0xac,0x6b,0xec,0x93,0xe8,0x59,0x8e,0x7f,0x0d,0xad,0xbc,0xea,0x5b};
 
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-    set_q_n_t(2, 13, 14);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 2, 13, 14 };
+    const uint8_t t = params.t;
     /*
     q = 2; 
     t = 14;
@@ -316,7 +302,7 @@ void test_big_aad_example(void)
     }
 
     memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
-    ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+    ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
     if (ret == 0) {
         printf("EXAMPLE4 TEST FAILED in encryption\n");
         goto out;
@@ -324,12 +310,9 @@ void test_big_aad_example(void)
         ciphertext_len = ret;
     }
         
-    if(memcmp(ciphertext, nist_cipher_and_auth_tag, ciphertext_len) != 0) {
-        printf("EXAMPLE4 ENCRYPTION TEST FAILED\n");
-        ret = 1;
-        goto out;
-    }
-    ret = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+    UNITY_TEST_ASSERT_EQUAL_UINT32(sizeof(nist_cipher_and_auth_tag), ciphertext_len, __LINE__, "Ciphertext length does not match with NIST document.");
+    UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(nist_cipher_and_auth_tag, ciphertext, ciphertext_len, __LINE__, "Ciphertext does not match with NIST document.");
+    ret = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
     if (ret == 0) {
         printf("test_big_aad_example TEST FAILED in decryption\n");
         ret = 1;
@@ -371,11 +354,8 @@ void test_handful_aad_lengths(void)
 
     int lengths[] = {0, 1, 10, 11, 12, 21, 22, 300};
 
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-    set_q_n_t(2, 13, 8);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 2, 13, 8 };
+    const uint8_t t = params.t;
     /*
     q = 2; 
     t = 8;
@@ -401,7 +381,7 @@ void test_handful_aad_lengths(void)
         }
 
         memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
-        ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+        ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
         if (ret == 0) {
             printf("test_all_aad_lengths TEST FAILED in encryption\n");
             goto out;
@@ -409,7 +389,7 @@ void test_handful_aad_lengths(void)
             ciphertext_len = ret;
         }
 
-        plaintext_len = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+        plaintext_len = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
         if (plaintext_len == 0) {
             printf("test_all_aad_lengths TEST FAILED in decryption\n");
             ret = 1;
@@ -438,6 +418,78 @@ free_aad:
     return;
 }
 
+/**
+ * Verifies that the S2 functions use the S2 parameters, and that a modified
+ * frame is rejected.
+ */
+void test_s2_params(void)
+{
+    const ccm_params_t params = { CCM_S2_Q, CCM_S2_N, CCM_S2_T };
+    uint8_t key[16]= {0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f};
+    uint8_t nonce[13] = {0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c};
+    uint8_t aad[8] = {0x02, 0x01, 0xaa, 0xbb, 0xcc, 0xdd, 0x02, 0x00};
+    uint8_t plaintext[40];
+    uint8_t frame[40 + CCM_S2_T];
+    uint8_t frame_params[40 + CCM_S2_T];
+    uint32_t frame_len;
+    size_t i;
+
+    for (i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = i;
+    }
+    memcpy(frame, plaintext, sizeof(plaintext));
+    memcpy(frame_params, plaintext, sizeof(plaintext));
+
+    frame_len = CCM_encrypt_and_auth(key, nonce, aad, sizeof(aad), frame, sizeof(plaintext));
+    UNITY_TEST_ASSERT_EQUAL_UINT32(sizeof(frame), frame_len, __LINE__, "");
+    CCM_encrypt_and_auth_params(&params, key, nonce, aad, sizeof(aad), frame_params, sizeof(plaintext));
+    UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(frame_params, frame, sizeof(frame), __LINE__, "");
+
+    for (i = 0; i < sizeof(frame); i++) {
+        memcpy(frame, frame_params, sizeof(frame));
+        frame[i] ^= 0x01;
+        UNITY_TEST_ASSERT_EQUAL_UINT32(0, CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), frame, frame_len), __LINE__, "Modified frame accepted");
+    }
+
+    memcpy(frame, frame_params, sizeof(frame));
+    UNITY_TEST_ASSERT_EQUAL_UINT32(sizeof(plaintext), CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), frame, frame_len), __LINE__, "");
+    UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, frame, sizeof(plaintext), __LINE__, "");
+}
+
+/**
+ * Verifies the S2 functions with an AAD longer than 255 bytes. The expected
+ * frame comes from an independent CCM implementation.
+ */
+void test_s2_large_aad(void)
+{
+    uint8_t key[16]= {0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f};
+    uint8_t nonce[13] = {0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c};
+    static uint8_t aad[1024];
+    uint8_t plaintext[40];
+    uint8_t frame[40 + CCM_S2_T];
+    const uint8_t expected_frame[40 + CCM_S2_T] = {
+        0x49,0xb1,0x7d,0x8d,0x3e,0xa4,0xe6,0x17,0x4a,0x48,0xe2,0xb6,
+        0x5e,0x6d,0x8b,0x41,0x7a,0xc0,0xdd,0x3f,0x8e,0xe4,0x6c,0xe4,
+        0xa4,0xa2,0xa5,0x09,0x66,0x1c,0xef,0x52,0x52,0x8c,0x1c,0xd9,
+        0x80,0x53,0x33,0xa5,0xbb,0xef,0xba,0xa2,0x14,0x91,0x27,0xb0
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(aad); i++) {
+        aad[i] = (uint8_t)i;
+    }
+    for (i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = (uint8_t)i;
+    }
+    memcpy(frame, plaintext, sizeof(plaintext));
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(sizeof(frame), CCM_encrypt_and_auth(key, nonce, aad, sizeof(aad), frame, sizeof(plaintext)), __LINE__, "");
+    UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, frame, sizeof(frame), __LINE__, "");
+
+    UNITY_TEST_ASSERT_EQUAL_UINT32(sizeof(plaintext), CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), frame, sizeof(frame)), __LINE__, "");
+    UNITY_TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, frame, sizeof(plaintext), __LINE__, "");
+}
+
 #ifdef NOT_USED
 static int test_all_aad_lengths()
 {
@@ -454,11 +506,8 @@ static int test_all_aad_lengths()
     uint32_t ciphertext_len;
     int ret;
 
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-    set_q_n_t(2, 13, 8);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 2, 13, 8 };
+    const uint8_t t = params.t;
 
     /*
     q = 2; 
@@ -485,7 +534,7 @@ static int test_all_aad_lengths()
         }
 
         memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
-        ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+        ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
         if (ret == 0) {
             printf("test_all_aad_lengths TEST FAILED in encryption\n");
             goto out;
@@ -493,7 +542,7 @@ static int test_all_aad_lengths()
             ciphertext_len = ret;
         }
 
-        plaintext_len = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+        plaintext_len = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
         if (plaintext_len == 0) {
             printf("test_all_aad_lengths TEST FAILED in decryption\n");
             ret = 1;
@@ -532,11 +581,8 @@ static int test_aad_len_smaller_than_12()
     uint8_t text_to_encrypt_bkup[24];
     int ret;
 
-    uint8_t q;
-    uint8_t n;
-    uint8_t t;
-    set_q_n_t(2, 13, 8);
-    get_q_n_t(&q, &n, &t);
+    const ccm_params_t params = { 2, 13, 8 };
+    const uint8_t t = params.t;
 
     /*
     q = 2;
@@ -552,7 +598,7 @@ static int test_aad_len_smaller_than_12()
 
     memcpy(ciphertext, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
     memcpy(text_to_encrypt_bkup, text_to_encrypt, text_to_encrypt_len); //in-place encryption, so pass ciphertext which is of size "text_to_encrypt_len + t"
-    ret = CCM_encrypt_and_auth(key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
+    ret = CCM_encrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, text_to_encrypt_len);
     if (ret == 0) {
         printf("test_aad_len_smaller_than_12 TEST FAILED in encryption\n");
         goto out;
@@ -560,7 +606,7 @@ static int test_aad_len_smaller_than_12()
         ciphertext_len = ret;
     }
 
-    ret = CCM_decrypt_and_auth(key, nonce, aad, aad_len, ciphertext, ciphertext_len);
+    ret = CCM_decrypt_and_auth_params(&params, key, nonce, aad, aad_len, ciphertext, ciphertext_len);
     if (ret == 0) {
         printf("test_aad_len_smaller_than_12 TEST FAILED in decryption\n");
         ret = 1;
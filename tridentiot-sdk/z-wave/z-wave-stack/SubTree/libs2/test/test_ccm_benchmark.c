@@ -0,0 +1,51 @@
+/* © 2014 Silicon Laboratories Inc.
+ */
+/**
+ * @file test_ccm_benchmark.c
+ * @brief Benchmark of the S2 CCM encryption. Only built with
+ * UNIT_TEST_BENCHMARKS, as the timings depend on the host.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "ccm.h"
+
+#define BENCHMARK_FRAMES 20000
+
+/**
+ * Prints the time to encrypt and decrypt an S2 frame of a typical and of the
+ * maximum payload length.
+ */
+void test_s2_frame_benchmark(void)
+{
+    uint8_t key[16]= {0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f};
+    uint8_t nonce[13] = {0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c};
+    uint8_t aad[8] = {0x02, 0x01, 0xaa, 0xbb, 0xcc, 0xdd, 0x02, 0x00};
+    static uint8_t frame[1280 + CCM_S2_T];
+    const uint16_t lengths[] = {40, 1280};
+    uint32_t frame_len = 0;
+    uint32_t decrypt_len = 0;
+    size_t i;
+    uint32_t j;
+
+    for (i = 0; i < sizeof(lengths)/sizeof(*lengths); i++) {
+        uint32_t frames = BENCHMARK_FRAMES * 40 / lengths[i];
+        clock_t start = clock();
+        for (j = 0; j < frames; j++) {
+            frame_len = CCM_encrypt_and_auth(key, nonce, aad, sizeof(aad), frame, lengths[i]);
+        }
+        clock_t middle = clock();
+        for (j = 0; j < frames; j++) {
+            /* The frame is modified by the first decryption, so only the time is of interest */
+            decrypt_len += CCM_decrypt_and_auth(key, nonce, aad, sizeof(aad), frame, frame_len);
+        }
+        clock_t end = clock();
+
+        printf("CCM S2 %u byte payload: encrypt %.2f us, decrypt %.2f us per frame\n",
+               (unsigned int)lengths[i],
+               (double)(middle - start) * 1000000 / CLOCKS_PER_SEC / frames,
+               (double)(end - middle) * 1000000 / CLOCKS_PER_SEC / frames);
+    }
+    (void)decrypt_len;
+}
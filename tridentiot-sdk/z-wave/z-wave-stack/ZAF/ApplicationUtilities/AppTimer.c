@@ -38,6 +38,17 @@ void AppTimerInit(uint8_t iTaskNotificationBitNumber, void * ReceiverTask)
   memset(&g_AppTimer, 0, sizeof(g_AppTimer));
   g_deepSleepTimersLoaded = false;
 
+#if defined(ZAF_APP_TIMER_MULTIPLEXED)
+  TimerLiaisonInitMultiplexed(
+                    &g_AppTimer.TimerLiaison,
+                    sizeof_array(g_AppTimer.aTimerPointerArray),
+                    g_AppTimer.aTimerPointerArray,
+                    g_AppTimer.aTimerHeapArray,
+                    &g_AppTimer.MultiplexTimer,
+                    iTaskNotificationBitNumber,
+                    (TaskHandle_t) ReceiverTask
+                  );
+#else
   TimerLiaisonInit(    
                     &g_AppTimer.TimerLiaison,
                     sizeof_array(g_AppTimer.aTimerPointerArray),
@@ -45,6 +56,7 @@ void AppTimerInit(uint8_t iTaskNotificationBitNumber, void * ReceiverTask)
                     iTaskNotificationBitNumber,
                     (TaskHandle_t) ReceiverTask
                   );
+#endif /* defined(ZAF_APP_TIMER_MULTIPLEXED) */
 }
 
 
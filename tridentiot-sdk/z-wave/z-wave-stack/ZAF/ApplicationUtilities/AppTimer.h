@@ -38,8 +38,12 @@
 
 /**
  * Max number of application timers
+ *
+ * Can be at most 24 unless ZAF_APP_TIMER_MULTIPLEXED is defined.
  */
+#if !defined(MAX_NUM_APP_TIMERS)
 #define MAX_NUM_APP_TIMERS           12 // Max number of timers total. I.e. the sum of normal timers and persistent timers
+#endif /* !defined(MAX_NUM_APP_TIMERS) */
 #define MAX_NUM_PERSISTENT_APP_TIMERS 6 // Max number of persistent timers.
 #define APP_TIMER_RETENTION_REGISTER_RESERVED_COUNT (MAX_NUM_PERSISTENT_APP_TIMERS + 2) // Number of reserved retention registers.
 
@@ -52,11 +56,18 @@ typedef struct  SAppTimer
   SSwTimer* aTimerPointerArray[MAX_NUM_APP_TIMERS]; /**<  Array for TimerLiaison - for keeping registered timers */
   bool DeepSleepPersistent[MAX_NUM_APP_TIMERS];           /**<  Is timer persistent (persistent timers will be save/reloaded to/from retention registers during Deep Sleep hibernate) */
   void (*pDeepSleepCallback[MAX_NUM_APP_TIMERS])(SSwTimer* pTimer); /**< Holds the SSwTimer callback for Deep Sleep persistent timers. It will be called by AppTimerDeepSleepCallbackWrapper() */
+#if defined(ZAF_APP_TIMER_MULTIPLEXED)
+  SSwTimer* aTimerHeapArray[MAX_NUM_APP_TIMERS];    /**<  Array for TimerLiaison - running timers ordered by expiry */
+  SSwTimer MultiplexTimer;                          /**<  The one FreeRTOS timer all application timers run on */
+#endif /* defined(ZAF_APP_TIMER_MULTIPLEXED) */
 } SAppTimer;
 
 /**
 * Initialize AppTimer
 *
+* If ZAF_APP_TIMER_MULTIPLEXED is defined, all application timers share one
+* FreeRTOS timer. See TimerLiaisonInitMultiplexed().
+*
 * @param[in]     iTaskNotificationBitNumber Number defines which bit to use when notifying
 *                                           receiver task of pending timer event (range 0 - 31)
 * @param[in]     ReceiverTask               Handle to the Application task
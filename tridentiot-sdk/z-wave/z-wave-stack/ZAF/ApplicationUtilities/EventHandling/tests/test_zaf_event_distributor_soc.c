@@ -4,10 +4,12 @@
  * @copyright 2022 Silicon Laboratories Inc.
  *
  */
+#include <string.h>
 #include <zaf_event_distributor.h>
 #include <zaf_event_distributor_soc.h>
 #include <ZAF_ApplicationEvents.h>      // for EApplicationEvent
 #include <ev_man.h>                     // for EVENT_SYSTEM
+#include <ZW_classcmd.h>
 #include <queue_mock.h>
 #include <task_mock.h>
 #include <ZAF_Common_interface_mock.h>
@@ -1531,3 +1533,87 @@ void test_zaf_event_distributor_enqueue_cc_event_from_isr_fail(void)
   ret = zaf_event_distributor_enqueue_cc_event_from_isr(event_cc.command_class, event_cc.event, event_cc.data);
   TEST_ASSERT_FALSE(ret);
 }
+
+static uint8_t basic_handler_calls[2];
+static uint8_t switch_binary_handler_calls;
+
+static void
+handler_basic_1(const uint8_t event, __attribute__((unused)) const void *data)
+{
+  TEST_ASSERT_EQUAL_UINT8(0x02, event);
+  basic_handler_calls[0]++;
+}
+
+static void
+handler_switch_binary(const uint8_t event, __attribute__((unused)) const void *data)
+{
+  TEST_ASSERT_EQUAL_UINT8(0x03, event);
+  switch_binary_handler_calls++;
+}
+
+static void
+handler_basic_2(const uint8_t event, __attribute__((unused)) const void *data)
+{
+  TEST_ASSERT_EQUAL_UINT8(0x02, event);
+  basic_handler_calls[1]++;
+}
+
+/*
+ * Two handlers for the same command class with a handler of another command class
+ * registered in between, so the index range of COMMAND_CLASS_BASIC spans it.
+ */
+ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(COMMAND_CLASS_BASIC, handler_basic_1);
+ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(COMMAND_CLASS_SWITCH_BINARY, handler_switch_binary);
+ZAF_EVENT_DISTRIBUTOR_REGISTER_CC_EVENT_HANDLER(COMMAND_CLASS_BASIC, handler_basic_2);
+
+static void
+expect_cc_event(event_cc_t * event_cc)
+{
+  xQueueReceive_ExpectAndReturn(queue_handle, event_cc, 0, pdTRUE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+  xQueueReceive_ReturnMemThruPtr_pvBuffer(event_cc, sizeof(event_cc_t));
+}
+
+/**
+ * Test CC Event Manager
+ * Every handler registered for the command class of an event is called once, and no handler
+ * of another command class is called. An event of a command class without handlers calls none.
+ */
+void test_cc_event_handler_index(void)
+{
+  event_cc_t event_basic = {
+    .command_class = COMMAND_CLASS_BASIC,
+    .event = 0x02,
+    .data = NULL
+  };
+  event_cc_t event_switch_binary = {
+    .command_class = COMMAND_CLASS_SWITCH_BINARY,
+    .event = 0x03,
+    .data = NULL
+  };
+  event_cc_t event_no_handler = {
+    .command_class = COMMAND_CLASS_SWITCH_MULTILEVEL,
+    .event = 0x04,
+    .data = NULL
+  };
+
+  memset(basic_handler_calls, 0, sizeof(basic_handler_calls));
+  switch_binary_handler_calls = 0;
+
+  notification_pending = EAPPLICATIONEVENT_CC;
+
+  EventDistributorDistribute_StubWithCallback(EventDistributorDistribute_callback);
+
+  expect_cc_event(&event_basic);
+  expect_cc_event(&event_no_handler);
+  expect_cc_event(&event_switch_binary);
+
+  xQueueReceive_ExpectAndReturn(queue_handle, &event_basic, 0, pdFALSE);
+  xQueueReceive_IgnoreArg_pvBuffer(); // Used as output
+
+  zaf_event_distributor_distribute();
+
+  TEST_ASSERT_EQUAL_UINT8(1, basic_handler_calls[0]);
+  TEST_ASSERT_EQUAL_UINT8(1, basic_handler_calls[1]);
+  TEST_ASSERT_EQUAL_UINT8(1, switch_binary_handler_calls);
+}
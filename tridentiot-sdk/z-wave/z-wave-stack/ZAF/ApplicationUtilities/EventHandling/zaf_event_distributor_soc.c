@@ -3,6 +3,7 @@
  * @brief ZAF Event distributor source file
  * @copyright 2022 Silicon Laboratories Inc.
  */
+#include <string.h>
 #include <AppTimer.h>
 #include <EventDistributor.h>
 #include <SizeOf.h>
@@ -72,6 +73,21 @@ static QueueHandle_t m_CCEventQueue = { 0 };
 static bool learnModeInProgress;
 static bool resetInProgress;
 
+/**
+ * Marks a command class without CC event handler in the index tables.
+ */
+#define CC_EVENT_HANDLER_INDEX_NONE   0xFF
+
+/**
+ * Index of the first and last CC event handler per command class. Several handlers may be
+ * registered for the same command class, and they are all found between the two.
+ * Command classes above 0xFF are not indexed and are looked up by a scan.
+ */
+static uint8_t cc_event_handler_index_first[256];
+static uint8_t cc_event_handler_index_last[256];
+static bool cc_event_handler_index_ready;
+static bool cc_event_handler_index_valid;
+
 static void
 set_protocol_default(void)
 {
@@ -351,10 +367,47 @@ call_handler(zaf_event_distributor_cc_event_handler_map_latest_t const * const h
 }
 
 static void
-cc_handlers_for_each(cc_event_handler_invoker_callback_t callback, void* args)
+cc_event_handler_index_init(void)
+{
+  size_t count = (size_t)(&cc_event_handler_stop - &cc_event_handler_start);
+
+  memset(cc_event_handler_index_first, CC_EVENT_HANDLER_INDEX_NONE, sizeof(cc_event_handler_index_first));
+  memset(cc_event_handler_index_last, CC_EVENT_HANDLER_INDEX_NONE, sizeof(cc_event_handler_index_last));
+
+  cc_event_handler_index_valid = (count < CC_EVENT_HANDLER_INDEX_NONE);
+  for (size_t i = 0; cc_event_handler_index_valid && (i < count); i++) {
+    uint16_t command_class = (&cc_event_handler_start)[i].command_class;
+    if (command_class <= 0xFF) {
+      if (CC_EVENT_HANDLER_INDEX_NONE == cc_event_handler_index_first[command_class]) {
+        cc_event_handler_index_first[command_class] = (uint8_t)i;
+      }
+      cc_event_handler_index_last[command_class] = (uint8_t)i;
+    }
+  }
+  cc_event_handler_index_ready = true;
+}
+
+/**
+ * Invokes the callback for the handlers registered for a command class, in registration order.
+ */
+static void
+cc_handlers_for_each(uint16_t command_class, cc_event_handler_invoker_callback_t callback, void* args)
 {
   zaf_event_distributor_cc_event_handler_map_latest_t const * iter = &cc_event_handler_start;
-  for (; iter < &cc_event_handler_stop; ++iter) {
+  zaf_event_distributor_cc_event_handler_map_latest_t const * stop = &cc_event_handler_stop;
+
+  if (!cc_event_handler_index_ready) {
+    cc_event_handler_index_init();
+  }
+  if (cc_event_handler_index_valid && (command_class <= 0xFF)) {
+    if (CC_EVENT_HANDLER_INDEX_NONE == cc_event_handler_index_first[command_class]) {
+      return;
+    }
+    iter = &cc_event_handler_start + cc_event_handler_index_first[command_class];
+    stop = &cc_event_handler_start + cc_event_handler_index_last[command_class] + 1;
+  }
+
+  for (; iter < stop; ++iter) {
     callback(iter, args);
   }
 }
@@ -366,7 +419,7 @@ EventHandlerCC(void)
 
   while (xQueueReceive(m_CCEventQueue, (uint8_t*)(&event_cc), 0) == pdTRUE) {
     DPRINTF("CC:%d Event: %d\n", event_cc.command_class, event_cc.event);
-    cc_handlers_for_each(call_handler, &event_cc);
+    cc_handlers_for_each(event_cc.command_class, call_handler, &event_cc);
   }
 }
 
@@ -443,6 +496,7 @@ zaf_event_distributor_init(void)
   learnModeInProgress = false;
   resetInProgress = false;
 
+  cc_event_handler_index_init();
   EventQueueInit();
 
   EventDistributorConfig(&g_EventDistributor,
@@ -7,6 +7,7 @@
  * @copyright 2018 Silicon Laboratories Inc.
  */
 
+#include <string.h>
 #include "ZAF_TSE.h"
 #include "zaf_tse_config.h"
 #include "AppTimer.h"
@@ -27,14 +28,32 @@ typedef struct _s_zaf_tse_resource_t_
   /* Data pointer, the pointed struct must contain a RECEIVE_OPTIONS_TYPE_EX object first.
   see s_zaf_tse_data_input_template_t definition below */
   void* pData;
+  /* Endpoint that changed. Together with pCallback, the key of a pending trigger. */
+  uint8_t endpoint;
   /*
-   * Points to the current node in a list of nodes.
+   * Destinations of the trigger, without the source of the change. Destinations that need a
+   * Multi Channel source endpoint come first and are reported to one by one. The rest share
+   * the same encapsulation and are reported to with one multicast, see firstGroupNode.
+   * Unused entries are free, like in an association group.
    */
-  destination_info_t * pCurrentNode;
+  destination_info_t nodes[CC_ASSOCIATION_MAX_NODES_IN_GROUP];
   /*
-   * Holds the number of remaining nodes in an active True Status session.
+   * Index of the first destination reported to by the multicast.
    */
-  uint8_t remainingNodes;
+  uint8_t firstGroupNode;
+  /*
+   * Number of destinations in nodes.
+   */
+  uint8_t nodeCount;
+  /*
+   * Index of the next destination to report to in an active True Status session.
+   * Zero while the trigger is pending.
+   */
+  uint8_t nextNode;
+  /*
+   * Next trigger in the list of triggers to report, or in the list of free resources.
+   */
+  struct _s_zaf_tse_resource_t_ * pNext;
 }s_zaf_tse_resource_t;
 
 // Private function prototypes
@@ -45,9 +64,16 @@ static s_zaf_tse_resource_t TSE_ResourceArray[ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGG
 SSwTimer zaf_tse_timer = { 0 };
 
 /*
- * Points to the current trigger in the resource array.
+ * Triggers are reported in the order they came in. pCurrentTrigger is the first trigger in the
+ * list and the one being reported, pLastTrigger the last one.
  */
 static s_zaf_tse_resource_t * pCurrentTrigger;
+static s_zaf_tse_resource_t * pLastTrigger;
+
+/*
+ * List of unused resources.
+ */
+static s_zaf_tse_resource_t * pFreeTriggers;
 
 bool ZAF_TSE_Init(void)
 {
@@ -60,19 +86,38 @@ bool ZAF_TSE_Init(void)
     return false;
   }
 
-  /* Reset the resource array */
-  for (uint8_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
+  /* Reset the resource array and put all resources in the free list */
+  pFreeTriggers = NULL;
+  for (uint8_t i = ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i > 0; i--)
   {
     /* Reset the data in the array at the init */
-    TSE_ResourceArray[i].pCallback = NULL;
-    TSE_ResourceArray[i].pData = NULL;
+    TSE_ResourceArray[i - 1].pCallback = NULL;
+    TSE_ResourceArray[i - 1].pData = NULL;
+    TSE_ResourceArray[i - 1].pNext = pFreeTriggers;
+    pFreeTriggers = &TSE_ResourceArray[i - 1];
   }
 
   pCurrentTrigger = NULL;
+  pLastTrigger = NULL;
 
   return true;
 }
 
+/*
+ * Finds the trigger with the given key that has not started reporting yet.
+ */
+static s_zaf_tse_resource_t * FindPendingTrigger(zaf_tse_callback_t pCallback, uint8_t endpoint)
+{
+  for (s_zaf_tse_resource_t * pTrigger = pCurrentTrigger; NULL != pTrigger; pTrigger = pTrigger->pNext)
+  {
+    if (pTrigger->pCallback == pCallback && pTrigger->endpoint == endpoint && 0 == pTrigger->nextNode)
+    {
+      return pTrigger;
+    }
+  }
+  return NULL;
+}
+
 bool ZAF_TSE_Trigger(zaf_tse_callback_t pCallback,
                      void* pData,
                      bool overwrite_previous_trigger)
@@ -96,7 +141,6 @@ bool ZAF_TSE_Trigger(zaf_tse_callback_t pCallback,
     return true;
   }
 
-  /* If Lifeline is identical to the RxOption Source node, just ignore the trigger and return */
   MULTICHAN_NODE_ID* pList = NULL;
   uint8_t ListLen = 0;
   handleAssociationGetnodeList(ZAF_TSE_GROUP_ID, 0, &pList, &ListLen);
@@ -106,90 +150,104 @@ bool ZAF_TSE_Trigger(zaf_tse_callback_t pCallback,
     DPRINT("TSE Association Group ZAF_TSE_GROUP_ID empty. Ignoring trigger\r\n");
     return true;
   }
-  else if (1 == ListLen)
-  {
-    /* Verify here if the change was triggered by the only Association Group destinations */
-    if (RxOptions.sourceNode.nodeId == pList[0].node.nodeId &&
-        RxOptions.sourceNode.endpoint == pList[0].node.endpoint)
-    {
-      DPRINT("Association Group only destination triggered the change. Ignoring trigger\r\n");
-      return true;
-    }
-  }
 
-  /* Variable to search if pCallback is in the TSE Resource array */
-  uint8_t resourceIndex = 0;
-  bool pCallbackPresent = false;
+  /*
+   * CC:008E.02.00.21.008, CC:008E.03.00.11.001, CC:008E.03.00.21.002:
+   * A Root Device must not use Multi Channel encapsulation when
+   * communicating to another Root Device.
+   *
+   * A change on an endpoint is reported with that endpoint as the source only to Multi Channel
+   * Associations. Those are singled out, all other destinations are reported to at once.
+   */
+  destination_info_t nodes[CC_ASSOCIATION_MAX_NODES_IN_GROUP];
+  uint8_t singleNodeCount = 0;
+  uint8_t groupNodeCount = 0;
 
-  /* Find out if the callback is already in the array */
-  if(true == overwrite_previous_trigger)
+  if (ListLen > CC_ASSOCIATION_MAX_NODES_IN_GROUP)
+  {
+    ListLen = CC_ASSOCIATION_MAX_NODES_IN_GROUP;
+  }
+  for (uint8_t i = 0; i < ListLen; i++)
   {
-    if(TimerIsActive(&zaf_tse_timer))
+    /* Do not report the change back to where it came from */
+    if (RxOptions.sourceNode.nodeId == pList[i].node.nodeId &&
+        RxOptions.sourceNode.endpoint == pList[i].node.endpoint)
+    {
+      continue;
+    }
+    if (0 != RxOptions.destNode.endpoint && 1 == pList[i].nodeInfo.BitMultiChannelEncap)
     {
-      for (uint8_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
-      {
-        /* First look for the same callback function */
-        if (TSE_ResourceArray[i].pCallback == pCallback)
-        {
-          /* Then also verify that it is for the same End Point */
-          s_zaf_tse_data_input_template_t* pDataStored =
-          (s_zaf_tse_data_input_template_t*)(TSE_ResourceArray[i].pData);
-          RECEIVE_OPTIONS_TYPE_EX storedRxOptions = pDataStored->rxOptions;
-
-          if (storedRxOptions.destNode.endpoint == RxOptions.destNode.endpoint)
-          {
-            pCallbackPresent = true;
-            resourceIndex = i;
-            break;
-          }
-        }
-      }
+      /* Move the multicast destinations up to keep them in association order */
+      memmove(&nodes[singleNodeCount + 1], &nodes[singleNodeCount], groupNodeCount * sizeof(destination_info_t));
+      nodes[singleNodeCount++] = pList[i];
+    }
+    else
+    {
+      nodes[singleNodeCount + groupNodeCount++] = pList[i];
     }
   }
 
-  if (true == pCallbackPresent)
+  if (0 == singleNodeCount + groupNodeCount)
   {
-    DPRINT("Trigger already in the trigger list and overwrite_previous_trigger is enabled: restarting timer\r\n");
-    TimerRestart(&zaf_tse_timer);
+    DPRINT("Association Group only destination triggered the change. Ignoring trigger\r\n");
+    return true;
   }
-  else
+
+  /*
+   * A trigger that has not been reported yet is updated instead of queuing another report: the
+   * callback reads the state when the report is sent, so the latest trigger wins.
+   */
+  bool restartDelay = (true == overwrite_previous_trigger) && TimerIsActive(&zaf_tse_timer);
+  s_zaf_tse_resource_t * pTrigger = FindPendingTrigger(pCallback, RxOptions.destNode.endpoint);
+
+  if (NULL != pTrigger)
   {
-    /* The callback is not present in the resource array or overwrite_previous_trigger is false, find out if there is an available slot */
-    bool resourceIndexAvailable = false;
-    resourceIndex = 0 ;
-    for (uint8_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
+    DPRINT("Trigger already in the trigger list: updating it\r\n");
+    if (restartDelay)
     {
-      if (NULL == TSE_ResourceArray[i].pCallback)
-      {
-        resourceIndexAvailable = true;
-        resourceIndex = i;
-        DPRINTF("\r\nAssigned index: %u", resourceIndex);
-        break;
-      }
+      TimerRestart(&zaf_tse_timer);
     }
-    /* Add the pCallback in the resource array or return */
-    if (false == resourceIndexAvailable)
+  }
+  else
+  {
+    if (NULL == pFreeTriggers)
     {
       DPRINTF("ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS (%d) already active. Rejecting new trigger\r\n",
       ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS);
       return false;
     }
+
+    DPRINT("Trigger not in the trigger list: adding new callback\r\n");
+    pTrigger = pFreeTriggers;
+    pFreeTriggers = pTrigger->pNext;
+    pTrigger->pCallback = pCallback;
+    pTrigger->endpoint = RxOptions.destNode.endpoint;
+    pTrigger->nextNode = 0;
+    pTrigger->pNext = NULL;
+    if (NULL == pCurrentTrigger)
+    {
+      pCurrentTrigger = pTrigger;
+      TimerStart(&zaf_tse_timer, ZAF_TSE_DELAY_TRIGGER); /* Timer start also restarts an ongoing timer */
+    }
     else
     {
-      DPRINT("Trigger not in the trigger list: adding new callback and starting the timer\r\n");
-      TSE_ResourceArray[resourceIndex].pCallback = pCallback;
-      TSE_ResourceArray[resourceIndex].pData = pData;
-      TSE_ResourceArray[resourceIndex].pCurrentNode = pList;
-      TSE_ResourceArray[resourceIndex].remainingNodes = ListLen;
-      if (NULL == pCurrentTrigger)
-      {
-        pCurrentTrigger = &TSE_ResourceArray[resourceIndex];
-        TimerStart(&zaf_tse_timer, ZAF_TSE_DELAY_TRIGGER); /* Timer start also restarts an ongoing timer */
-      }
+      pLastTrigger->pNext = pTrigger;
     }
+    pLastTrigger = pTrigger;
   }
+
+  const uint8_t nodeCount = (uint8_t)(singleNodeCount + groupNodeCount);
+  pTrigger->pData = pData;
+  memcpy(pTrigger->nodes, nodes, nodeCount * sizeof(destination_info_t));
+  for (uint8_t i = nodeCount; i < CC_ASSOCIATION_MAX_NODES_IN_GROUP; i++)
+  {
+    pTrigger->nodes[i].node.nodeId = FREE_VALUE;
+  }
+  pTrigger->firstGroupNode = singleNodeCount;
+  pTrigger->nodeCount = nodeCount;
+
   DPRINTF("\r\nListLen: %u", ListLen);
-  DPRINTF("\r\nRemaining nodes: %u", TSE_ResourceArray[resourceIndex].remainingNodes);
+  DPRINTF("\r\nDestinations: %u", nodeCount);
 
   return true;
 }
@@ -201,35 +259,52 @@ static void InvokeRegisteredCallback(void)
   s_zaf_tse_data_input_template_t* pDataInput = (s_zaf_tse_data_input_template_t*)(pCurrentTrigger->pData);
   RECEIVE_OPTIONS_TYPE_EX RxOptions = pDataInput->rxOptions;
 
-  DPRINTF("\tTSE transmit call back for dest node %d endpoint %d\r\n",
-          pCurrentTrigger->pCurrentNode->node.nodeId, pCurrentTrigger->pCurrentNode->node.endpoint);
-
-  /**
-   * CC:008E.02.00.21.008, CC:008E.03.00.11.001, CC:008E.03.00.21.002:
-   * A Root Device must not use Multi Channel encapsulation when
-   * communicating to another Root Device.
-   *
-   * Set the Source Endpoint only if the Association is Multi Channel, to avoid
-   * incorrectly applying encapsulation for "plain" Associations later.
-   */
-  const uint8_t source_endpoint =
-    pCurrentTrigger->pCurrentNode->nodeInfo.BitMultiChannelEncap == 1
-    ? RxOptions.destNode.endpoint : 0;
-
   /* Build a txOptionEx */
-  zaf_tx_options_t tx_options;
+  zaf_tx_options_t tx_options = { 0 };
 
-  tx_options.dest_node_id = pCurrentTrigger->pCurrentNode->node.nodeId;
-  tx_options.dest_endpoint = pCurrentTrigger->pCurrentNode->node.endpoint;
-  tx_options.bit_addressing = pCurrentTrigger->pCurrentNode->node.BitAddress;
-  tx_options.security_key = pCurrentTrigger->pCurrentNode->nodeInfo.security;
-  tx_options.source_endpoint = source_endpoint;
   tx_options.tx_options = TRANSMIT_OPTION_ACK | TRANSMIT_OPTION_EXPLORE | ZWAVE_PLUS_TX_OPTIONS;
   if (RxOptions.rxStatus & RECEIVE_STATUS_LOW_POWER)
   {
     tx_options.tx_options |= TRANSMIT_OPTION_LOW_POWER;
   }
 
+  const uint8_t groupNodeCount = (uint8_t)(pCurrentTrigger->nodeCount - pCurrentTrigger->firstGroupNode);
+
+  if (pCurrentTrigger->nextNode == pCurrentTrigger->firstGroupNode && groupNodeCount > 1)
+  {
+    DPRINTF("\tTSE transmit call back for %d destinations\r\n", groupNodeCount);
+
+    /*
+     * One call for all remaining destinations. The transport layer sends a multicast
+     * followed by singlecasts, and calls back once they are all done. If destinations of
+     * the group were left out above, the multicast does not use the S2 group ID of the group.
+     */
+    tx_options.dest_node_id = 0;
+    tx_options.dest_node_list = &pCurrentTrigger->nodes[pCurrentTrigger->firstGroupNode];
+    tx_options.dest_node_list_length = groupNodeCount;
+    tx_options.source_endpoint = 0;
+    pCurrentTrigger->nextNode = pCurrentTrigger->nodeCount;
+  }
+  else
+  {
+    destination_info_t * pNode = &pCurrentTrigger->nodes[pCurrentTrigger->nextNode];
+
+    DPRINTF("\tTSE transmit call back for dest node %d endpoint %d\r\n",
+            pNode->node.nodeId, pNode->node.endpoint);
+
+    /*
+     * Set the Source Endpoint only if the Association is Multi Channel, to avoid
+     * incorrectly applying encapsulation for "plain" Associations later.
+     */
+    tx_options.dest_node_id = pNode->node.nodeId;
+    tx_options.dest_endpoint = pNode->node.endpoint;
+    tx_options.bit_addressing = pNode->node.BitAddress;
+    tx_options.security_key = pNode->nodeInfo.security;
+    tx_options.source_endpoint = pNode->nodeInfo.BitMultiChannelEncap == 1
+                                 ? RxOptions.destNode.endpoint : 0;
+    pCurrentTrigger->nextNode++;
+  }
+
   /*
    * Invoke the callback if it's different from NULL. We should never end up here with pCallback
    * set to NULL, but just in case.
@@ -250,86 +325,42 @@ void ZAF_TSE_TimerCallback(SSwTimer* pTimer)
     return ;
   }
 
-  s_zaf_tse_data_input_template_t* pDataInput = (s_zaf_tse_data_input_template_t*)(pCurrentTrigger->pData);
-  RECEIVE_OPTIONS_TYPE_EX RxOptions = pDataInput->rxOptions;
-  if (RxOptions.sourceNode.nodeId != pCurrentTrigger->pCurrentNode->node.nodeId ||
-      RxOptions.sourceNode.endpoint != pCurrentTrigger->pCurrentNode->node.endpoint)
-  {
-    InvokeRegisteredCallback();
-  }
-  else
-  {
-    DPRINT("\r\nSource == Destination");
-    ZAF_TSE_TXCallback(NULL);
-  }
+  InvokeRegisteredCallback();
 }
 
 void ZAF_TSE_TXCallback(__attribute__((unused)) transmission_result_t * pTransmissionResult)
 {
   DPRINTF("%s():\r\n", __func__);
 
-  RECEIVE_OPTIONS_TYPE_EX RxOptions;
+  if (NULL == pCurrentTrigger)
+  {
+    return;
+  }
 
-  do
+  DPRINTF("\r\nRemaining destinations: (%u)", pCurrentTrigger->nodeCount - pCurrentTrigger->nextNode);
+  if (pCurrentTrigger->nextNode >= pCurrentTrigger->nodeCount)
   {
-    pCurrentTrigger->remainingNodes--;
-    DPRINTF("\r\nRemaining nodes: (%u)", pCurrentTrigger->remainingNodes);
-    if (0 == pCurrentTrigger->remainingNodes)
-    {
-      // No more nodes left. Clear the trigger.
-      pCurrentTrigger->pCallback = NULL;
-      pCurrentTrigger->pData = NULL;
-      pCurrentTrigger->pCurrentNode = NULL;
-
-      // Find the current trigger in the array of triggers.
-      uint32_t currentTriggerIndex = 0;
-      uint32_t i;
-      for (i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
-      {
-        if (pCurrentTrigger == &TSE_ResourceArray[i])
-        {
-          // Found current trigger in array.
-          currentTriggerIndex = i;
-          break;
-        }
-      }
-
-      // Reset the current trigger so that we can check later if there was found a new current trigger.
-      pCurrentTrigger = NULL;
-      do
-      {
-        currentTriggerIndex = (currentTriggerIndex + 1) % ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS;
-        if (NULL != TSE_ResourceArray[currentTriggerIndex].pCallback)
-        {
-          // Break if we found a trigger that is set.
-          pCurrentTrigger = &TSE_ResourceArray[currentTriggerIndex];
-          break;
-        }
-      }
-      // Search the entire array until we hit the index where we started.
-      while (currentTriggerIndex != i);
-
-      if (NULL != pCurrentTrigger)
-      {
-        DPRINTF("\r\nNew trigger index: %u", currentTriggerIndex);
-      }
-    }
-    else
+    // No more nodes left. Clear the trigger and move it to the free list.
+    s_zaf_tse_resource_t * pDoneTrigger = pCurrentTrigger;
+
+    pCurrentTrigger = pDoneTrigger->pNext;
+    if (NULL == pCurrentTrigger)
     {
-      pCurrentTrigger->pCurrentNode++;
+      pLastTrigger = NULL;
     }
+
+    pDoneTrigger->pCallback = NULL;
+    pDoneTrigger->pData = NULL;
+    pDoneTrigger->nodeCount = 0;
+    pDoneTrigger->pNext = pFreeTriggers;
+    pFreeTriggers = pDoneTrigger;
+
     if (NULL == pCurrentTrigger)
     {
       // pCurrentTrigger being NULL means there are no more active triggers.
       return;
     }
-    s_zaf_tse_data_input_template_t* pDataInput = (s_zaf_tse_data_input_template_t*)(pCurrentTrigger->pData);
-    RxOptions = pDataInput->rxOptions;
   }
-  // If the destination node matches the source node, skip the node and repeat the above steps.
-  while(RxOptions.sourceNode.nodeId == pCurrentTrigger->pCurrentNode->node.nodeId &&
-        RxOptions.sourceNode.endpoint == pCurrentTrigger->pCurrentNode->node.endpoint);
 
   InvokeRegisteredCallback();
 }
-
@@ -49,8 +49,10 @@ typedef void (*zaf_tse_callback_t)(zaf_tx_options_t *txOptions,
 * The True Status engine will queue up the status reporting request into a queue
 * The status report are triggered after ZAF_TSE_DELAY_TRIGGER milliseconds
 *
-* If the pCallback was already in the queue and overwrite_previous_trigger is set to true, pData will be updated
-* and the timer waiting ZAF_TSE_DELAY_TRIGGER will be restarted.
+* Triggers are reported in the order they came in. While a trigger with the same pCallback and the same
+* source Endpoint in the pData waits in the queue, no new report is queued: pData of the waiting trigger is
+* updated, so only the latest state is reported. A trigger whose report is being sent is not updated, a new
+* report is queued after it instead.
 *
 * @param[in]     pCallback                      Pointer to the function to callback. The callback function must
 *                                               be a function taking the following arguments:
@@ -63,13 +65,14 @@ typedef void (*zaf_tse_callback_t)(zaf_tx_options_t *txOptions,
 *                                               about the received frame that triggered the change. Local changes
 *                                               must also include a RECEIVE_OPTIONS_TYPE_EX in the pData.
 *
-* @param[in]     overwrite_previous_trigger     Boolean parameter indicating if a previous trigger with the same
-*                                               pCallback and the same source Endpoint in the pData should be
-*                                               discarded or not. Set it to true for overwriting previous triggers
-*                                               and false to stack up all the trigger messages.
+* @param[in]     overwrite_previous_trigger     Boolean parameter indicating if the timer waiting ZAF_TSE_DELAY_TRIGGER
+*                                               should be restarted when a waiting trigger is updated. Set it to true
+*                                               to report once a series of changes has settled.
 *
 * @return                                       True if the pCallback / pData were queued in the engine
 *                                               False if the queue is full and the pCallback was not queued.
+*                                               The queue holds ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS different
+*                                               pCallback and source Endpoint pairs.
 */
 bool ZAF_TSE_Trigger(zaf_tse_callback_t pCallback,
                      void* pData,
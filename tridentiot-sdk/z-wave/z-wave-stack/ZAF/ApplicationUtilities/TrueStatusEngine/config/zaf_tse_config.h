@@ -22,9 +22,11 @@
 #define ZAF_TSE_GROUP_ID                        1
 
 // <o> Maximum number of queued status report waiting to be reported via the Association Group
-// <i> Note: This number should not be higher than the maximum number of frames that can be queued for transmission, which is set to 5
+// <i> Triggers for the same callback and endpoint share one entry until their report is sent, so one entry per reporting callback and endpoint avoids rejected triggers.
 // <i> Default: 3
+#if !defined(ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS)
 #define ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS   3
+#endif /* !defined(ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS) */
 
 // <o> Delay (in ms) between the status change and queuing the report command to the transmit queue.
 // <i> This setting should be as small as possible but not too small so that it would trigger network collisions.
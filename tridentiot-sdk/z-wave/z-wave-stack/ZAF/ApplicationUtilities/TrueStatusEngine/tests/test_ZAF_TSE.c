@@ -633,24 +633,35 @@ void cb_wait_for_tx_callback(zaf_tx_options_t *tx_options, __attribute__((unused
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected_destination_node_id, tx_options->dest_node_id, str);
 }
 
+static uint8_t expected_destination_count;
+static node_id_t excluded_node_id;
+
+void cb_wait_for_group_tx_callback(zaf_tx_options_t *tx_options, __attribute__((unused)) void* pData)
+{
+  cb_wait_for_tx_callback_count++;
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(0, tx_options->dest_node_id, "Group report has a destination node :(");
+  TEST_ASSERT_NOT_NULL_MESSAGE(tx_options->dest_node_list, "Group report has no destination list :(");
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected_destination_count, tx_options->dest_node_list_length, "Destination count did not match :(");
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(0, tx_options->source_endpoint, "Group report is Multi Channel encapsulated :(");
+  for (uint32_t i = 0; i < tx_options->dest_node_list_length; i++)
+  {
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(excluded_node_id, tx_options->dest_node_list[i].node.nodeId, "Source of the change got the report :(");
+  }
+}
+
 /*
- * Verifies that only one frame is sent at a time.
+ * Verifies that all Lifeline destinations are reported to with one transmission.
  *
- * Node ID 1 sends something to "this" node and with 5 nodes, including node ID 1, in Lifeline,
- * the following scenario with 4 destinations is verified.
+ * With 5 nodes in Lifeline and no source node among them, the following is verified.
  *
  * Triggering TSE twice is important to show that the session cleans up and is ready to be
  * triggered again.
  * 1.  Init TSE
  * 2.  Trigger TSE
- * 3.  Invoke timer callback => TX of 1. frame to node ID 2
- * 4.  Invoke tx callback    => TX of 2. frame to node ID 3
- * 5.  Invoke tx callback    => TX of 3. frame to node ID 4
- * 5.  Invoke tx callback    => TX of 4. frame to node ID 5
- * 6.  Invoke tx callback    => Do nothing
- * 7.  Trigger TSE
- * 8.  Invoke timer callback => TX of 1. frame to node ID 2
- * etc.
+ * 3.  Invoke timer callback => TX of 1 frame to node ID 1 to 5
+ * 4.  Invoke tx callback    => Do nothing
+ * 5.  Trigger TSE
+ * 6.  Invoke timer callback => TX of 1 frame to node ID 1 to 5
  */
 void test_ZAF_TSE_wait_for_tx_callback_one_trigger(void)
 {
@@ -664,7 +675,6 @@ void test_ZAF_TSE_wait_for_tx_callback_one_trigger(void)
   my_personalized_struct_t CCData;
   memset((uint8_t *)&CCData, 0, sizeof(my_personalized_struct_t));
 
-  // TODO: If setting the source node to X (higher than zero), node X must not receive a frame.
   CCData.rxOptions.sourceNode.nodeId = 0;
 
   init_tse(pMock, &zaf_tse_timer, &pTimerCallback);
@@ -677,30 +687,16 @@ void test_ZAF_TSE_wait_for_tx_callback_one_trigger(void)
 
   cb_wait_for_tx_callback_count = 0;
 
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, &CCData, true);
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, &CCData, true);
 
-  // Trigger the 1. invocation of cb_wait_for_tx_callback
-  expected_destination_node_id = 1;
+  expected_destination_count = NODE_COUNT;
+  excluded_node_id = 0;
   pTimerCallback(zaf_tse_timer);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count (1) did not match :(");
 
-  for (uint32_t i = 2; i <= NODE_COUNT; i++)
-  {
-    // Trigger the i-th invocation of cb_wait_for_tx_callback
-    expected_destination_node_id = i;
-    ZAF_TSE_TXCallback(NULL);
-    char str[100];
-    sprintf(str, "Callback count (%u) did not match :(", i);
-    TEST_ASSERT_EQUAL_UINT32_MESSAGE(i, cb_wait_for_tx_callback_count, str);
-  }
-
-  // Trigger callback from last transmission.
+  // Trigger callback from the transmission.
   ZAF_TSE_TXCallback(NULL);
-  /*
-   * Expect the number of callback counts to be the same because the last TX callback will not
-   * trigger a new transmission.
-   */
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(5, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
 
   /*********************************************************************************************
    * At this point we consider the True Status session to be done. Now let's trigger the same one
@@ -712,10 +708,8 @@ void test_ZAF_TSE_wait_for_tx_callback_one_trigger(void)
 
   cb_wait_for_tx_callback_count = 0;
 
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, &CCData, true);
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, &CCData, true);
 
-  // Trigger the 1. invocation of cb_wait_for_tx_callback
-  expected_destination_node_id = 1;
   pTimerCallback(zaf_tse_timer);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
@@ -723,16 +717,17 @@ void test_ZAF_TSE_wait_for_tx_callback_one_trigger(void)
   free(pNodelist_2);
   deinit_tse();
 
-  mock_calls_verify();}
+  mock_calls_verify();
+}
 
 /**
  * Verifies that 1 frame will be transmitted at a time even though 3 triggers were triggered.
  *
  * With 3 nodes in Lifeline and source nodes for each trigger being 1, 2 and 3, respectively,
- * We must expect 6 frames transmitted in total:
- * 1. trigger transmits frames to 2 and 3
- * 2. trigger transmits frames to 1 and 3
- * 3. trigger transmits frames to 1 and 2
+ * We must expect 3 transmissions to 2 nodes each:
+ * 1. trigger transmits a frame to 2 and 3
+ * 2. trigger transmits a frame to 1 and 3
+ * 3. trigger transmits a frame to 1 and 2
  */
 void test_ZAF_TSE_max_number_of_triggers(void)
 {
@@ -749,11 +744,12 @@ void test_ZAF_TSE_max_number_of_triggers(void)
 
   /*
    * Make sure that each of the triggers are "received" from a unique node so that we can
-   * distinguish them in the callback.
+   * distinguish them in the callback, and are for a unique endpoint so that they are not merged.
    */
   for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
   {
     (pCCData + i)->rxOptions.sourceNode.nodeId = i + 1;
+    (pCCData + i)->rxOptions.destNode.endpoint = i;
   }
 
   init_tse(pMock, &zaf_tse_timer, &pTimerCallback);
@@ -763,42 +759,31 @@ void test_ZAF_TSE_max_number_of_triggers(void)
   mock_call_use_as_stub(TO_STR(TimerStart));
 
   cb_wait_for_tx_callback_count = 0;
+  expected_destination_count = NODE_COUNT - 1;
 
   for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
   {
     pNodelists[i] = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
-    ZAF_TSE_Trigger(cb_wait_for_tx_callback, pCCData + i, false);
+    ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData + i, false);
   }
 
   /*
    * There is only one timer and this will trigger once starting transmission of the nodes in the
    * 1. trigger.
    */
-  expected_destination_node_id = 2;
+  excluded_node_id = 1;
   pTimerCallback(zaf_tse_timer);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
-  expected_destination_node_id = 3;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
   // Trigger 2
-  expected_destination_node_id = 1;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
-  expected_destination_node_id = 3;
+  excluded_node_id = 2;
   ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(4, cb_wait_for_tx_callback_count, "Callback count did not match :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
   // Trigger 3
-  expected_destination_node_id = 1;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(5, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
-  expected_destination_node_id = 2;
+  excluded_node_id = 3;
   ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(6, cb_wait_for_tx_callback_count, "Callback count did not match :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
   // Trigger callback from last transmission.
   ZAF_TSE_TXCallback(NULL);
@@ -806,7 +791,7 @@ void test_ZAF_TSE_max_number_of_triggers(void)
    * Expect the number of callback counts to be the same because the last TX callback will not
    * trigger a new transmission.
    */
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(6, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
 
   for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
   {
@@ -825,15 +810,12 @@ void test_ZAF_TSE_max_number_of_triggers(void)
  * With 3 nodes in Lifeline, the following applies:
  * 1. Init
  * 2. Trigger number 1.
- * 3. Invoke timer callback that transmits 1. frame (from trigger 1)
+ * 3. Invoke timer callback that transmits the frame of trigger 1
  * 4. Trigger number 2.
- * 5. Invoke TX callback that transmits 2. frame (from trigger 1)
- * 6. Trigger number 3.
- * 7. Invoke TX callback that transmits 1. frame (from trigger 2)
- * 8. Invoke TX callback that transmits 2. frame (from trigger 2)
- * 9. Invoke TX callback that transmits 1. frame (from trigger 3)
- * 10. Invoke TX callback that transmits 2. frame (from trigger 3)
- * 11. Invoke TX callback that does nothing.
+ * 5. Trigger number 3.
+ * 6. Invoke TX callback that transmits the frame of trigger 2
+ * 7. Invoke TX callback that transmits the frame of trigger 3
+ * 8. Invoke TX callback that does nothing.
  */
 void test_ZAF_TSE_trigger_while_transmitting(void)
 {
@@ -849,62 +831,50 @@ void test_ZAF_TSE_trigger_while_transmitting(void)
 
   /*
    * Make sure that each of the triggers are "received" from a unique node so that we can
-   * distinguish them in the callback.
+   * distinguish them in the callback, and are for a unique endpoint so that they are not merged.
    */
   for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
   {
     (pCCData + i)->rxOptions.sourceNode.nodeId = i + 1;
+    (pCCData + i)->rxOptions.destNode.endpoint = i;
   }
 
   init_tse(pMock, &zaf_tse_timer, &pTimerCallback);
 
   mock_call_use_as_stub(TO_STR(is_multicast));
-  //mock_call_use_as_stub(TO_STR(TimerIsActive));
-  //mock_call_use_as_stub(TO_STR(TimerStart));
 
   cb_wait_for_tx_callback_count = 0;
+  expected_destination_count = NODE_COUNT - 1;
 
   destination_info_t *pNodelist_1 = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
   mock_call_expect(TO_STR(TimerStart), &pMock);
   pMock->compare_rule_arg[0] = COMPARE_ANY;
   pMock->compare_rule_arg[1] = COMPARE_ANY;
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, pCCData, false);
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData, false);
 
   /*
    * There is only one timer and this will trigger once starting transmission of the nodes in the
    * 1. trigger.
    */
-  expected_destination_node_id = 2;
+  excluded_node_id = 1;
   pTimerCallback(zaf_tse_timer);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
   destination_info_t *pNodelist_2 = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, pCCData + 1, false);
-
-  expected_destination_node_id = 3;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, cb_wait_for_tx_callback_count, "Callback count did not match :(");
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData + 1, false);
 
   destination_info_t *pNodelist_3 = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, pCCData + 2, false);
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData + 2, false);
 
   // Trigger 2
-  expected_destination_node_id = 1;
+  excluded_node_id = 2;
   ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
-  expected_destination_node_id = 3;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(4, cb_wait_for_tx_callback_count, "Callback count did not match :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
   // Trigger 3
-  expected_destination_node_id = 1;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(5, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
-  expected_destination_node_id = 2;
+  excluded_node_id = 3;
   ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(6, cb_wait_for_tx_callback_count, "Callback count did not match :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
   // Trigger callback from last transmission.
   ZAF_TSE_TXCallback(NULL);
@@ -912,7 +882,7 @@ void test_ZAF_TSE_trigger_while_transmitting(void)
    * Expect the number of callback counts to be the same because the last TX callback will not
    * trigger a new transmission.
    */
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(6, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
 
   free(pNodelist_1);
   free(pNodelist_2);
@@ -953,6 +923,8 @@ void test_ZAF_TSE_trigger_while_transmitting_overwrite(void)
   mock_call_use_as_stub(TO_STR(is_multicast));
 
   cb_wait_for_tx_callback_count = 0;
+  expected_destination_count = NODE_COUNT - 1;
+  excluded_node_id = 1;
 
   destination_info_t *pNodelist_1 = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
 
@@ -963,13 +935,12 @@ void test_ZAF_TSE_trigger_while_transmitting_overwrite(void)
   mock_call_expect(TO_STR(TimerStart), &pMock);
   pMock->compare_rule_arg[0] = COMPARE_ANY;
   pMock->compare_rule_arg[1] = COMPARE_ANY;
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, pCCData, true);
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData, true);
 
   /*
    * There is only one timer and this will trigger once starting transmission of the nodes in the
    * 1. trigger.
    */
-  expected_destination_node_id = 2;
   pTimerCallback(zaf_tse_timer);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
@@ -978,27 +949,18 @@ void test_ZAF_TSE_trigger_while_transmitting_overwrite(void)
   mock_call_expect(TO_STR(TimerIsActive), &pMock);
   pMock->compare_rule_arg[0] = COMPARE_ANY;
   pMock->return_code.v = false;
-  ZAF_TSE_Trigger(cb_wait_for_tx_callback, pCCData, true);
+  ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData, true);
 
-  expected_destination_node_id = 3;
   ZAF_TSE_TXCallback(NULL);
   TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, cb_wait_for_tx_callback_count, "Callback count did not match :(");
 
-  expected_destination_node_id = 2;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
-  expected_destination_node_id = 3;
-  ZAF_TSE_TXCallback(NULL);
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(4, cb_wait_for_tx_callback_count, "Callback count did not match :(");
-
   // Trigger callback from last transmission.
   ZAF_TSE_TXCallback(NULL);
   /*
    * Expect the number of callback counts to be the same because the last TX callback will not
    * trigger a new transmission.
    */
-  TEST_ASSERT_EQUAL_UINT32_MESSAGE(4, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
 
   free(pNodelist_1);
   free(pNodelist_2);
@@ -1007,3 +969,207 @@ void test_ZAF_TSE_trigger_while_transmitting_overwrite(void)
 
   mock_calls_verify();
 }
+
+static uint32_t multi_channel_callback_count;
+
+void cb_multi_channel_destinations(zaf_tx_options_t *tx_options, __attribute__((unused)) void* pData)
+{
+  multi_channel_callback_count++;
+  if (1 == multi_channel_callback_count)
+  {
+    // The Multi Channel Association is reported to first, from the endpoint.
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(1, tx_options->dest_node_id, "Node ID did not match :(");
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(2, tx_options->source_endpoint, "Source endpoint did not match :(");
+    TEST_ASSERT_NULL_MESSAGE(tx_options->dest_node_list, "Singlecast has a destination list :(");
+  }
+  else
+  {
+    // All plain Associations at once, from the Root Device.
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(0, tx_options->dest_node_id, "Group report has a destination node :(");
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(0, tx_options->source_endpoint, "Group report is Multi Channel encapsulated :(");
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(2, tx_options->dest_node_list_length, "Destination count did not match :(");
+    TEST_ASSERT_EQUAL_UINT16(2, tx_options->dest_node_list[0].node.nodeId);
+    TEST_ASSERT_EQUAL_UINT16(3, tx_options->dest_node_list[1].node.nodeId);
+  }
+}
+
+/**
+ * Verifies that a change on an endpoint is reported to Multi Channel Associations one by one and
+ * to the rest with one transmission.
+ */
+void test_ZAF_TSE_multi_channel_destinations_reported_separately(void)
+{
+  mock_t * pMock = NULL;
+  SSwTimer* zaf_tse_timer;
+  void (*pTimerCallback)(SSwTimer*);
+  mock_calls_clear();
+
+  const uint8_t NODE_COUNT = 3;
+
+  my_personalized_struct_t CCData;
+  memset((uint8_t *)&CCData, 0, sizeof(my_personalized_struct_t));
+  CCData.rxOptions.destNode.endpoint = 2;
+
+  init_tse(pMock, &zaf_tse_timer, &pTimerCallback);
+
+  mock_call_use_as_stub(TO_STR(is_multicast));
+  mock_call_use_as_stub(TO_STR(TimerIsActive));
+  mock_call_use_as_stub(TO_STR(TimerStart));
+
+  destination_info_t *pNodelist = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
+  pNodelist[0].nodeInfo.BitMultiChannelEncap = 1;
+
+  multi_channel_callback_count = 0;
+
+  ZAF_TSE_Trigger(cb_multi_channel_destinations, &CCData, true);
+
+  pTimerCallback(zaf_tse_timer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, multi_channel_callback_count, "Callback count did not match :(");
+
+  ZAF_TSE_TXCallback(NULL);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, multi_channel_callback_count, "Callback count did not match :(");
+
+  ZAF_TSE_TXCallback(NULL);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, multi_channel_callback_count, "Callback count unexpectedly increased :(");
+
+  free(pNodelist);
+  deinit_tse();
+
+  mock_calls_verify();
+}
+
+/**
+ * Verifies that triggers for the same callback and endpoint are merged while they wait, and that
+ * the report is made from the latest trigger.
+ */
+void test_ZAF_TSE_pending_triggers_merged(void)
+{
+  mock_t * pMock = NULL;
+  SSwTimer* zaf_tse_timer;
+  void (*pTimerCallback)(SSwTimer*);
+  mock_calls_clear();
+
+  const uint8_t NODE_COUNT = 3;
+  const uint8_t TRIGGER_COUNT = 3;
+  destination_info_t *pNodelists[3];
+
+  my_personalized_struct_t * pCCData = calloc(TRIGGER_COUNT, sizeof(my_personalized_struct_t));
+  for (uint32_t i = 0; i < TRIGGER_COUNT; i++)
+  {
+    (pCCData + i)->rxOptions.sourceNode.nodeId = i + 1;
+  }
+
+  init_tse(pMock, &zaf_tse_timer, &pTimerCallback);
+
+  mock_call_use_as_stub(TO_STR(is_multicast));
+
+  // Only the first trigger starts the timer.
+  mock_call_expect(TO_STR(TimerStart), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_ANY;
+  pMock->compare_rule_arg[1] = COMPARE_ANY;
+
+  for (uint32_t i = 0; i < TRIGGER_COUNT; i++)
+  {
+    pNodelists[i] = Mock_handleAssociationGetnodeList(pMock, NODE_COUNT);
+    TEST_ASSERT_TRUE_MESSAGE(ZAF_TSE_Trigger(cb_wait_for_group_tx_callback, pCCData + i, false), "Trigger was rejected");
+  }
+
+  cb_wait_for_tx_callback_count = 0;
+  expected_destination_count = NODE_COUNT - 1;
+  excluded_node_id = TRIGGER_COUNT;
+  pTimerCallback(zaf_tse_timer);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count did not match :(");
+
+  ZAF_TSE_TXCallback(NULL);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, cb_wait_for_tx_callback_count, "Callback count unexpectedly increased :(");
+
+  for (uint32_t i = 0; i < TRIGGER_COUNT; i++)
+  {
+    free(pNodelists[i]);
+  }
+  free(pCCData);
+  deinit_tse();
+
+  mock_calls_verify();
+}
+
+static uint8_t reported_endpoints[ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS + 1];
+static uint32_t reported_endpoint_count;
+
+void cb_record_endpoint(__attribute__((unused)) zaf_tx_options_t *tx_options, void* pData)
+{
+  my_personalized_struct_t * pCCData = (my_personalized_struct_t *)pData;
+  if (reported_endpoint_count < sizeof(reported_endpoints))
+  {
+    reported_endpoints[reported_endpoint_count] = pCCData->rxOptions.destNode.endpoint;
+  }
+  reported_endpoint_count++;
+}
+
+/**
+ * Verifies that a burst of changes on several endpoints gives one report per endpoint, in the
+ * order the endpoints were first triggered.
+ */
+void test_ZAF_TSE_burst_on_several_endpoints(void)
+{
+  mock_t * pMock = NULL;
+  SSwTimer* zaf_tse_timer;
+  void (*pTimerCallback)(SSwTimer*);
+  mock_calls_clear();
+
+  const uint8_t NODE_COUNT = 2;
+  const uint8_t CHANGES_PER_ENDPOINT = 4;
+  destination_info_t *pNodelist;
+
+  my_personalized_struct_t * pCCData = calloc(ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS, sizeof(my_personalized_struct_t));
+  for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
+  {
+    (pCCData + i)->rxOptions.destNode.endpoint = ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS - i;
+  }
+
+  init_tse(pMock, &zaf_tse_timer, &pTimerCallback);
+
+  mock_call_use_as_stub(TO_STR(is_multicast));
+  mock_call_use_as_stub(TO_STR(TimerIsActive));
+  mock_call_use_as_stub(TO_STR(TimerStart));
+  mock_call_use_as_stub(TO_STR(TimerRestart));
+
+  pNodelist = malloc(sizeof(destination_info_t) * NODE_COUNT);
+  memset((uint8_t *)pNodelist, 0, sizeof(destination_info_t) * NODE_COUNT);
+  pNodelist[0].node.nodeId = 1;
+  pNodelist[1].node.nodeId = 2;
+
+  for (uint32_t change = 0; change < CHANGES_PER_ENDPOINT; change++)
+  {
+    for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
+    {
+      mock_call_expect(TO_STR(handleAssociationGetnodeList), &pMock);
+      pMock->compare_rule_arg[0] = COMPARE_ANY;
+      pMock->compare_rule_arg[1] = COMPARE_ANY;
+      pMock->compare_rule_arg[2] = COMPARE_ANY;
+      pMock->compare_rule_arg[3] = COMPARE_ANY;
+      pMock->output_arg[2].p = pNodelist;
+      pMock->output_arg[3].v = NODE_COUNT;
+
+      TEST_ASSERT_TRUE_MESSAGE(ZAF_TSE_Trigger(cb_record_endpoint, pCCData + i, true), "Trigger was rejected");
+    }
+  }
+
+  reported_endpoint_count = 0;
+  pTimerCallback(zaf_tse_timer);
+  for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
+  {
+    ZAF_TSE_TXCallback(NULL);
+  }
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS, reported_endpoint_count, "Report count did not match :(");
+  for (uint32_t i = 0; i < ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS; i++)
+  {
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS - i, reported_endpoints[i], "Report order did not match :(");
+  }
+
+  free(pNodelist);
+  free(pCCData);
+  deinit_tse();
+
+  mock_calls_verify();
+}
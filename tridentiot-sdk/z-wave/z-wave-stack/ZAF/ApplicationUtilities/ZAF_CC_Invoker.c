@@ -5,6 +5,7 @@
 /**
  * @copyright 2021 Silicon Laboratories Inc.
  */
+#include <string.h>
 #include "ZAF_CC_Invoker.h"
 #include "Assert.h"
 
@@ -27,6 +28,68 @@ extern const  zaf_cc_config_entry_latest_t __stop_zw_zaf_cc_config;
 #define cc_config_start __start_zw_zaf_cc_config
 #define cc_config_stop __stop_zw_zaf_cc_config
 
+/**
+ * Marks a command class without entry in the index tables.
+ */
+#define CC_INDEX_NONE   0xFF
+
+/**
+ * Index of the first CC handler per command class.
+ *
+ * Command classes above 0xFF are not indexed and are looked up by a scan. This also applies to
+ * all command classes if the linker section holds CC_INDEX_NONE entries or more.
+ */
+static uint8_t cc_handler_index[256];
+
+static bool cc_index_ready;
+static bool cc_handler_index_valid;
+
+static void cc_index_build_if_needed(void)
+{
+  if (!cc_index_ready) {
+    ZAF_CC_index_init();
+  }
+}
+
+static CC_handler_map_latest_t const * cc_handler_find(uint16_t cmdClass)
+{
+  CC_handler_map_latest_t const * iter = &cc_handlers_start;
+
+  cc_index_build_if_needed();
+
+  if (cc_handler_index_valid && (cmdClass <= 0xFF)) {
+    if (CC_INDEX_NONE == cc_handler_index[cmdClass]) {
+      return NULL;
+    }
+    return &cc_handlers_start + cc_handler_index[cmdClass];
+  }
+
+  for ( ; iter < &cc_handlers_stop; ++iter) {
+    if (iter->CC == cmdClass) {
+      return iter;
+    }
+  }
+  return NULL;
+}
+
+void ZAF_CC_index_init(void)
+{
+  size_t handler_count = (size_t) ((&cc_handlers_stop) - (&cc_handlers_start));
+
+  memset(cc_handler_index, CC_INDEX_NONE, sizeof(cc_handler_index));
+
+  // Walk backwards so that the first entry wins, like the scan does.
+  cc_handler_index_valid = (handler_count < CC_INDEX_NONE);
+  for (size_t i = handler_count; cc_handler_index_valid && (i > 0); i--) {
+    uint16_t cc = (&cc_handlers_start)[i - 1].CC;
+    if (cc <= 0xFF) {
+      cc_handler_index[cc] = (uint8_t)(i - 1);
+    }
+  }
+
+  cc_index_ready = true;
+}
+
 received_frame_status_t ZAF_CC_invoke_specific(CC_handler_map_latest_t const * const p_cc_entry,
                                                cc_handler_input_t *input,
                                                cc_handler_output_t *output)
@@ -59,36 +122,29 @@ received_frame_status_t ZAF_CC_invoke_specific(CC_handler_map_latest_t const * c
 received_frame_status_t invoke_cc_handler(cc_handler_input_t * input,
                                           cc_handler_output_t * output)
 {
-  CC_handler_map_latest_t const * iter = &cc_handlers_start;
-  for ( ; iter < &cc_handlers_stop; ++iter)
-  {
-    if (iter->CC == input->frame->ZW_Common.cmdClass) {
-      return ZAF_CC_invoke_specific(iter, input, output);
-    }
-  }
+  CC_handler_map_latest_t const * p_cc_entry = cc_handler_find(input->frame->ZW_Common.cmdClass);
 
-  return RECEIVED_FRAME_STATUS_CC_NOT_FOUND;
+  if (NULL == p_cc_entry) {
+    return RECEIVED_FRAME_STATUS_CC_NOT_FOUND;
+  }
+  return ZAF_CC_invoke_specific(p_cc_entry, input, output);
 }
 
 void ZAF_CC_init_specific(uint8_t cmdClass)
 {
-  CC_handler_map_latest_t const * iter = &cc_handlers_start;
-  for ( ; iter < &cc_handlers_stop; ++iter) {
-    if ((iter->CC == cmdClass) && (NULL != iter->init)) {
-      iter->init();
-      break;
-    }
+  CC_handler_map_latest_t const * p_cc_entry = cc_handler_find(cmdClass);
+
+  if ((NULL != p_cc_entry) && (NULL != p_cc_entry->init)) {
+    p_cc_entry->init();
   }
 }
 
 void ZAF_CC_reset_specific(uint8_t cmdClass)
 {
-  CC_handler_map_latest_t const * iter = &cc_handlers_start;
-  for ( ; iter < &cc_handlers_stop; ++iter) {
-    if ((iter->CC == cmdClass) && (NULL != iter->reset)) {
-      iter->reset();
-      break;
-    }
+  CC_handler_map_latest_t const * p_cc_entry = cc_handler_find(cmdClass);
+
+  if ((NULL != p_cc_entry) && (NULL != p_cc_entry->reset)) {
+    p_cc_entry->reset();
   }
 }
 
@@ -24,6 +24,15 @@
  * @{
  */
 
+/**
+ * Builds the lookup index of the registered CC handlers.
+ *
+ * The index makes invoke_cc_handler(), ZAF_CC_init_specific() and ZAF_CC_reset_specific() find
+ * the handler of a command class without scanning the linker section. It is called by
+ * ZAF_Init(). If a lookup happens before, the index is built then.
+ */
+void ZAF_CC_index_init(void);
+
 /**
  * Invokes the handler with the correct arguments for a given command class entry.
  *
@@ -69,6 +69,9 @@ void ZAF_Init(TaskHandle_t AppTaskHandle, SApplicationHandles *pAppHandles)
   ZAF_setAppHandle(pAppHandles);
   m_AppTaskHandle = AppTaskHandle;
 
+  // Index the registered command classes before any frame can be dispatched.
+  ZAF_CC_index_init();
+
   zafi_cc_list_generator_generate();
 
   // Convert from zaf_cc_list_t to SCommandClassSet_t which is the type
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file test_ZAF_CC_Invoker.c
+ */
+#include <unity.h>
+#include <ZAF_CC_Invoker.h>
+
+void setUpSuite(void) {
+
+}
+
+void tearDownSuite(void) {
+
+}
+
+static uint8_t last_handler;
+static uint8_t init_count;
+static uint8_t reset_count;
+
+static received_frame_status_t handler_basic(__attribute__((unused)) cc_handler_input_t * input,
+                                             __attribute__((unused)) cc_handler_output_t * output)
+{
+  last_handler = COMMAND_CLASS_BASIC;
+  return RECEIVED_FRAME_STATUS_SUCCESS;
+}
+
+static received_frame_status_t handler_binary_switch(__attribute__((unused)) cc_handler_input_t * input,
+                                                     __attribute__((unused)) cc_handler_output_t * output)
+{
+  last_handler = COMMAND_CLASS_SWITCH_BINARY;
+  return RECEIVED_FRAME_STATUS_FAIL;
+}
+
+static void init_binary_switch(void)
+{
+  init_count++;
+}
+
+static void reset_binary_switch(void)
+{
+  reset_count++;
+}
+
+REGISTER_CC_V5(COMMAND_CLASS_BASIC, 2, handler_basic, NULL, NULL, NULL, 0, NULL, NULL);
+REGISTER_CC_V5(COMMAND_CLASS_SWITCH_BINARY, 2, handler_binary_switch, NULL, NULL, NULL, 0, init_binary_switch, reset_binary_switch);
+
+static received_frame_status_t invoke(uint8_t cmdClass)
+{
+  ZW_APPLICATION_TX_BUFFER frame = { 0 };
+  RECEIVE_OPTIONS_TYPE_EX rx_options = { 0 };
+  cc_handler_input_t input = {
+    .rx_options = &rx_options,
+    .frame = &frame,
+    .length = 2
+  };
+  cc_handler_output_t output = { 0 };
+
+  frame.ZW_Common.cmdClass = cmdClass;
+  last_handler = 0;
+  return invoke_cc_handler(&input, &output);
+}
+
+/**
+ * Verifies that frames are dispatched by command class, also before the index is built by
+ * ZAF_CC_index_init().
+ */
+void test_invoke_cc_handler(void)
+{
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, invoke(COMMAND_CLASS_BASIC));
+    TEST_ASSERT_EQUAL_UINT8(COMMAND_CLASS_BASIC, last_handler);
+
+    TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_FAIL, invoke(COMMAND_CLASS_SWITCH_BINARY));
+    TEST_ASSERT_EQUAL_UINT8(COMMAND_CLASS_SWITCH_BINARY, last_handler);
+
+    TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_CC_NOT_FOUND, invoke(COMMAND_CLASS_SWITCH_MULTILEVEL));
+    TEST_ASSERT_EQUAL_UINT8(0, last_handler);
+
+    // The dummy entry registered by the invoker has no handler.
+    TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_NO_SUPPORT, invoke(0xFF));
+
+    ZAF_CC_index_init();
+  }
+}
+
+void test_init_and_reset_specific(void)
+{
+  init_count = 0;
+  reset_count = 0;
+
+  ZAF_CC_init_specific(COMMAND_CLASS_SWITCH_BINARY);
+  ZAF_CC_init_specific(COMMAND_CLASS_BASIC);
+  ZAF_CC_init_specific(COMMAND_CLASS_SWITCH_MULTILEVEL);
+  TEST_ASSERT_EQUAL_UINT8(1, init_count);
+  TEST_ASSERT_EQUAL_UINT8(0, reset_count);
+
+  ZAF_CC_reset_specific(COMMAND_CLASS_SWITCH_BINARY);
+  ZAF_CC_reset_specific(COMMAND_CLASS_BASIC);
+  TEST_ASSERT_EQUAL_UINT8(1, init_count);
+  TEST_ASSERT_EQUAL_UINT8(1, reset_count);
+}
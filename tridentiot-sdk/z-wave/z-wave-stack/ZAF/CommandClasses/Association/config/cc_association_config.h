@@ -43,5 +43,24 @@
 
 /**@}*/ /* \addtogroup cc_association_group_nodes_configuration */
 
+/**
+ * \defgroup cc_association_nvm_configuration Command Class Association - NVM configuration
+ * Command Class Association - NVM configuration
+ *
+ * \addtogroup cc_association_nvm_configuration
+ * @{
+ */
+
+/**
+ * Delay of the NVM write in milliseconds <0..10000:1>
+ *
+ * Association changes made within the delay are written to NVM at once. 0 writes after every change.
+ */
+#if !defined(CC_ASSOCIATION_NVM_WRITE_DELAY_MS)
+#define CC_ASSOCIATION_NVM_WRITE_DELAY_MS  1000
+#endif /* !defined(CC_ASSOCIATION_NVM_WRITE_DELAY_MS) */
+
+/**@}*/ /* \addtogroup cc_association_nvm_configuration */
+
 /**@}*/ /* \addtogroup configuration */
 #endif /* _CC_ASSOCIATION_CONFIG_H_ */
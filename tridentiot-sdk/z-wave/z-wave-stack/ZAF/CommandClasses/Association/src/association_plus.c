@@ -24,6 +24,11 @@
 #include <ZAF_nvm.h>
 #include "cc_agi_config_api.h"
 #include "misc.h"
+#if (0 < CC_ASSOCIATION_NVM_WRITE_DELAY_MS)
+#include <AppTimer.h>
+#include <SwTimer.h>
+#include <zpal_power_manager.h>
+#endif
 
 /****************************************************************************/
 /*                             PARAMETER CHECK                              */
@@ -85,6 +90,12 @@ ASSOCIATION_NODE_LIST;
 #define ENDPOINT_VALUE_VALID_MIN              1
 #define IS_BIT_ADDRESSING_ENDPOINT(endpoint)  ((endpoint >= ENDPOINT_VALUE_VALID_MIN) && (endpoint <= ENDPOINT_VALUE_VALID_MAX))
 
+/*
+ * Extra time to stay awake after the NVM write delay, so that a sleeping node does not go to
+ * sleep before the write.
+ */
+#define ASSOCIATION_NVM_WRITE_AWAKE_MARGIN_MS  100
+
 /****************************************************************************/
 /*                              PRIVATE DATA                                */
 /****************************************************************************/
@@ -97,6 +108,21 @@ uint8_t numberOfGroupMappingEntries = 0;
 
 static uint8_t m_lastActiveGroupId = 1;
 
+/*
+ * Image of the association file in NVM. Static rather than on the stack, as it can become large.
+ */
+static SAssociationInfo m_associationFile;
+
+/*
+ * Set when the groups differ from the association file in NVM.
+ */
+static bool m_associationDirty = false;
+
+#if (0 < CC_ASSOCIATION_NVM_WRITE_DELAY_MS)
+static SSwTimer m_associationWriteTimer;
+static zpal_pm_handle_t m_associationPowerLock = NULL;
+#endif
+
 /****************************************************************************/
 /*                              EXPORTED DATA                               */
 /****************************************************************************/
@@ -129,6 +155,10 @@ static inline bool IsFree(destination_info_t * pNode)
 
 static inline void Free(destination_info_t * pNode)
 {
+  if (!IsFree(pNode))
+  {
+    m_associationDirty = true;
+  }
   pNode->node.nodeId = FREE_VALUE;
 }
 
@@ -475,6 +505,7 @@ AssociationAddNode(
   indx++;
   pCurrentNode = GetNode(endpoint, groupID, (uint8_t)indx);  // This returns an empty node.
   memcpy((uint8_t *)pCurrentNode, (uint8_t*)&newNode, sizeof(destination_info_t)); // Place the new node in list.
+  m_associationDirty = true;
   return true;
 }
 
@@ -727,8 +758,9 @@ NVM_Action(NVM_ACTION action)
   zpal_status_t status = ZPAL_STATUS_FAIL;
   size_t   dataLen = 0;
   bool     forceClearMem = false;
-  SAssociationInfo associationInfo = { 0 };  // This can become a large allocation on the stack
-  SAssociationInfo* pSource = &associationInfo;
+  SAssociationInfo* pSource = &m_associationFile;
+
+  memset(&m_associationFile, 0, sizeof(m_associationFile));
 
   switch(action)
   {
@@ -749,19 +781,19 @@ NVM_Action(NVM_ACTION action)
        */
       if ((ZPAL_STATUS_OK != status) || (ZAF_FILE_SIZE_ASSOCIATIONINFO != dataLen) || (true == forceClearMem))
       {
-        generateAssociationAndWrite(action, &associationInfo);
+        generateAssociationAndWrite(action, &m_associationFile);
       }
       else
       {
         // Make sure that free nodeIds are not set to legacy zero value
-	  ZAF_nvm_read(ZAF_FILE_ID_ASSOCIATIONINFO, &associationInfo, sizeof(SAssociationInfo));
+	  ZAF_nvm_read(ZAF_FILE_ID_ASSOCIATIONINFO, &m_associationFile, sizeof(SAssociationInfo));
 
-        generateAssociationAndWrite(action, &associationInfo);
+        generateAssociationAndWrite(action, &m_associationFile);
       }
       // Fall through
     case NVM_ACTION_READ_DATA:
 
-      ZAF_nvm_read(ZAF_FILE_ID_ASSOCIATIONINFO, &associationInfo, sizeof(SAssociationInfo));
+      ZAF_nvm_read(ZAF_FILE_ID_ASSOCIATIONINFO, &m_associationFile, sizeof(SAssociationInfo));
 
       for(i = 0; i < CC_ASSOCIATION_MAX_GROUPS_PER_ENDPOINT; i++)
       {
@@ -795,9 +827,9 @@ NVM_Action(NVM_ACTION action)
         {
           for(k = 0; k < CC_ASSOCIATION_MAX_NODES_IN_GROUP; k++)
           {
-            associationInfo.Groups[j][i].subGrp[k].node.nodeId     = (uint8_t)groups[j][i].subGrp[k].node.nodeId;     //1Byte
-            associationInfo.Groups[j][i].subGrp[k].node.endpoint   = groups[j][i].subGrp[k].node.endpoint;   //7bits
-            associationInfo.Groups[j][i].subGrp[k].node.BitAddress = groups[j][i].subGrp[k].node.BitAddress; //1bit
+            m_associationFile.Groups[j][i].subGrp[k].node.nodeId     = (uint8_t)groups[j][i].subGrp[k].node.nodeId;     //1Byte
+            m_associationFile.Groups[j][i].subGrp[k].node.endpoint   = groups[j][i].subGrp[k].node.endpoint;   //7bits
+            m_associationFile.Groups[j][i].subGrp[k].node.BitAddress = groups[j][i].subGrp[k].node.BitAddress; //1bit
 
             /*
              * Ignore bitfield conversion warnings as there is no good solution other than stop
@@ -805,16 +837,16 @@ NVM_Action(NVM_ACTION action)
              */
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
-            associationInfo.Groups[j][i].subGrp[k].nodeInfoPacked.BitMultiChannelEncap = groups[j][i].subGrp[k].nodeInfo.BitMultiChannelEncap; //uint8_t to 1 bit
-            associationInfo.Groups[j][i].subGrp[k].nodeInfoPacked.security             = (uint8_t)groups[j][i].subGrp[k].nodeInfo.security;  //enum to 4bits
+            m_associationFile.Groups[j][i].subGrp[k].nodeInfoPacked.BitMultiChannelEncap = groups[j][i].subGrp[k].nodeInfo.BitMultiChannelEncap; //uint8_t to 1 bit
+            m_associationFile.Groups[j][i].subGrp[k].nodeInfoPacked.security             = (uint8_t)groups[j][i].subGrp[k].nodeInfo.security;  //enum to 4bits
 #pragma GCC diagnostic pop
 
-            DPRINTF("associationInfo.Groups[%d][%d].subGrp[%d].node.nodeId: %d\r\n", j,i,k, associationInfo.Groups[j][i].subGrp[k].node.nodeId);
+            DPRINTF("m_associationFile.Groups[%d][%d].subGrp[%d].node.nodeId: %d\r\n", j,i,k, m_associationFile.Groups[j][i].subGrp[k].node.nodeId);
           }
         }
       }
 
-      ZAF_nvm_write(ZAF_FILE_ID_ASSOCIATIONINFO, &associationInfo, sizeof(SAssociationInfo));
+      ZAF_nvm_write(ZAF_FILE_ID_ASSOCIATIONINFO, &m_associationFile, sizeof(SAssociationInfo));
       break;
 
     default:
@@ -823,13 +855,65 @@ NVM_Action(NVM_ACTION action)
 }
 
 
+/**
+ * @brief Writes the associations to the NVM if they were changed.
+ */
+static void
+AssociationFlush(void)
+{
+  if (m_associationDirty)
+  {
+    NVM_Action(NVM_ACTION_WRITE_DATA);
+    m_associationDirty = false;
+  }
+}
+
+#if (0 < CC_ASSOCIATION_NVM_WRITE_DELAY_MS)
+static void
+ZCB_AssociationWriteTimer(__attribute__((unused)) SSwTimer* pTimer)
+{
+  AssociationFlush();
+  zpal_pm_cancel(m_associationPowerLock);
+}
+#endif
+
 /**
  * @brief Stores all associations in the NVM.
+ *
+ * The write is delayed by CC_ASSOCIATION_NVM_WRITE_DELAY_MS, so that a controller
+ * setting up several associations in a row causes a single write.
  */
 static void
 AssociationStoreAll(void)
 {
-  NVM_Action(NVM_ACTION_WRITE_DATA);
+  if (!m_associationDirty)
+  {
+    return;
+  }
+#if (0 < CC_ASSOCIATION_NVM_WRITE_DELAY_MS)
+  TimerStart(&m_associationWriteTimer, CC_ASSOCIATION_NVM_WRITE_DELAY_MS);
+  zpal_pm_stay_awake(m_associationPowerLock, CC_ASSOCIATION_NVM_WRITE_DELAY_MS + ASSOCIATION_NVM_WRITE_AWAKE_MARGIN_MS);
+#else
+  AssociationFlush();
+#endif
+}
+
+/**
+ * @brief Drops a pending write, as the associations are about to be read from or written to NVM.
+ */
+static void
+AssociationCancelStore(void)
+{
+#if (0 < CC_ASSOCIATION_NVM_WRITE_DELAY_MS)
+  if (NULL == m_associationPowerLock)
+  {
+    AppTimerRegister(&m_associationWriteTimer, false, ZCB_AssociationWriteTimer);
+    m_associationPowerLock = zpal_pm_register(ZPAL_PM_TYPE_USE_RADIO);
+  }
+  TimerStop(&m_associationWriteTimer);
+  zpal_pm_cancel(m_associationPowerLock);
+#endif
+  m_associationDirty = false;
 }
 
 
@@ -837,12 +921,14 @@ void
 CC_Association_Init(void)
 {
   m_lastActiveGroupId = 1;
+  AssociationCancelStore();
   NVM_Action(NVM_ACTION_INIT_CORRECT_INVALID_NODEID);
 }
 
 void
 CC_Association_Reset(void)
 {
+  AssociationCancelStore();
   NVM_Action(NVM_ACTION_INIT_FORCE_CLEAR_MEM);
 }
 
@@ -0,0 +1,150 @@
+/**
+ * @file test_association_plus_nvm_write.c
+ * @copyright 2024 Silicon Laboratories Inc.
+ */
+#include <unity.h>
+#include <string.h>
+#include "association_plus_base.h"
+#include "association_plus_file.h"
+#include "ZW_classcmd.h"
+#include "ZAF_nvm_mock.h"
+#include "CC_AssociationGroupInfo_mock.h"
+#include "ZAF_Common_interface_mock.h"
+#include "ZW_TransportSecProtocol_mock.h"
+#include "AppTimer_mock.h"
+#include "SwTimer_mock.h"
+#include "zpal_power_manager_mock.h"
+
+static SAssociationInfo file;
+static uint32_t write_count;
+static void (*write_timer_callback)(SSwTimer* pTimer);
+
+static zpal_status_t ZAF_nvm_write_Callback(__attribute__((unused)) zpal_nvm_object_key_t key, const void* object, size_t object_size, __attribute__((unused)) int cmock_num_calls)
+{
+  memcpy(&file, object, object_size);
+  write_count++;
+  return ZPAL_STATUS_OK;
+}
+
+static zpal_status_t ZAF_nvm_read_Callback(__attribute__((unused)) zpal_nvm_object_key_t key, void* object, size_t object_size, __attribute__((unused)) int cmock_num_calls)
+{
+  memcpy(object, &file, object_size);
+  return ZPAL_STATUS_OK;
+}
+
+static bool AppTimerRegister_Callback(__attribute__((unused)) SSwTimer* pTimer,
+                                      __attribute__((unused)) bool bAutoReload,
+                                      void(*pCallback)(SSwTimer* pTimer),
+                                      __attribute__((unused)) int cmock_num_calls)
+{
+  write_timer_callback = pCallback;
+  return true;
+}
+
+void setUpSuite(void)
+{
+  ZAF_nvm_get_object_size_IgnoreAndReturn(ZPAL_STATUS_OK);
+  ZAF_nvm_write_Stub(ZAF_nvm_write_Callback);
+  ZAF_nvm_read_Stub(ZAF_nvm_read_Callback);
+  AppTimerRegister_Stub(AppTimerRegister_Callback);
+  TimerStart_IgnoreAndReturn(ESWTIMER_STATUS_SUCCESS);
+  TimerStop_IgnoreAndReturn(ESWTIMER_STATUS_SUCCESS);
+  zpal_pm_register_IgnoreAndReturn(NULL);
+  zpal_pm_stay_awake_Ignore();
+  zpal_pm_cancel_Ignore();
+  CC_AGI_groupCount_handler_IgnoreAndReturn(1);
+  ZAF_GetInclusionMode_IgnoreAndReturn(EINCLUSIONMODE_ZWAVE_CLS);
+  ZAF_GetSecurityKeys_IgnoreAndReturn(0);
+  GetHighestSecureLevel_IgnoreAndReturn(0);
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(&file, 0, sizeof(file));
+  CC_Association_Init();
+  write_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+static void association_set(uint8_t nodeId)
+{
+  uint8_t frame[] = { COMMAND_CLASS_ASSOCIATION, ASSOCIATION_SET, LIFELINE_GROUP_ID, nodeId };
+
+  TEST_ASSERT_EQUAL(E_CMD_HANDLER_RETURN_CODE_HANDLED,
+                    handleAssociationSet(0, (ZW_MULTI_CHANNEL_ASSOCIATION_SET_1BYTE_V2_FRAME *)frame,
+                                         sizeof(frame), COMMAND_CLASS_ASSOCIATION));
+}
+
+static void association_remove(uint8_t nodeId)
+{
+  uint8_t frame[] = { COMMAND_CLASS_ASSOCIATION, ASSOCIATION_REMOVE, LIFELINE_GROUP_ID, nodeId };
+
+  TEST_ASSERT_EQUAL(E_CMD_HANDLER_RETURN_CODE_HANDLED,
+                    AssociationRemove(LIFELINE_GROUP_ID, 0, (ZW_MULTI_CHANNEL_ASSOCIATION_REMOVE_1BYTE_V2_FRAME *)frame,
+                                      sizeof(frame)));
+}
+
+/**
+ * Verifies that several Association Sets in a row cause one NVM write, when the timer expires.
+ */
+void test_sets_are_written_once(void)
+{
+  TEST_ASSERT_NOT_NULL(write_timer_callback);
+
+  association_set(2);
+  association_set(3);
+  association_set(4);
+  TEST_ASSERT_EQUAL_UINT32(0, write_count);
+
+  write_timer_callback(NULL);
+  TEST_ASSERT_EQUAL_UINT32(1, write_count);
+  TEST_ASSERT_EQUAL_UINT8(2, file.Groups[0][0].subGrp[0].node.nodeId);
+  TEST_ASSERT_EQUAL_UINT8(3, file.Groups[0][0].subGrp[1].node.nodeId);
+  TEST_ASSERT_EQUAL_UINT8(4, file.Groups[0][0].subGrp[2].node.nodeId);
+  TEST_ASSERT_EQUAL_UINT8(FREE_VALUE, file.Groups[0][0].subGrp[3].node.nodeId);
+
+  // Nothing changed since the write.
+  write_timer_callback(NULL);
+  TEST_ASSERT_EQUAL_UINT32(1, write_count);
+}
+
+/**
+ * Verifies that Sets and Removes that do not change the associations are not written.
+ */
+void test_unchanged_associations_are_not_written(void)
+{
+  association_set(2);
+  write_timer_callback(NULL);
+  TEST_ASSERT_EQUAL_UINT32(1, write_count);
+
+  association_set(2);
+  association_remove(5);
+  write_timer_callback(NULL);
+  TEST_ASSERT_EQUAL_UINT32(1, write_count);
+
+  association_remove(2);
+  write_timer_callback(NULL);
+  TEST_ASSERT_EQUAL_UINT32(2, write_count);
+  TEST_ASSERT_EQUAL_UINT8(FREE_VALUE, file.Groups[0][0].subGrp[0].node.nodeId);
+}
+
+/**
+ * Verifies that a reset drops a pending write.
+ */
+void test_reset_drops_pending_write(void)
+{
+  association_set(2);
+  CC_Association_Reset();
+  TEST_ASSERT_EQUAL_UINT32(1, write_count); // The cleared file
+
+  write_timer_callback(NULL);
+  TEST_ASSERT_EQUAL_UINT32(1, write_count);
+  TEST_ASSERT_EQUAL_UINT8(FREE_VALUE, file.Groups[0][0].subGrp[0].node.nodeId);
+}
@@ -116,6 +116,15 @@ typedef enum
 } 
 cc_config_configuration_set_return_value;
 
+/**
+ * RAM copy of a parameter value.
+ */
+typedef struct
+{
+  cc_config_parameter_value_t value; ///< Current value
+  bool dirty;                        ///< True if the value is not yet written to NVM
+} cc_config_parameter_cache_t;
+
 /**
  * Defines all data related to the Configuration CC.
  */
@@ -123,6 +132,12 @@ typedef struct
 {
   uint16_t numberOfParameters;
   const cc_config_parameter_metadata_t* parameters;
+  /**
+   * RAM copy of the values, one entry per parameter. Gets of writable parameters are served
+   * from here and Sets are written to NVM in batches. If NULL, every Get and Set goes to NVM.
+   * Read only parameters always go to NVM.
+   */
+  cc_config_parameter_cache_t* cache;
 } cc_configuration_t;
 
 /**
@@ -28,6 +28,11 @@
 #include <cc_configuration_config_api.h>
 #include <cc_configuration_io.h>
 #include "zaf_transport_tx.h"
+#if (0 < CC_CONFIGURATION_NVM_WRITE_DELAY_MS)
+#include <AppTimer.h>
+#include <SwTimer.h>
+#include <zpal_power_manager.h>
+#endif
 
 //#define DEBUGPRINT
 #include "DebugPrint.h"
@@ -38,6 +43,11 @@
 #define SLI_CC_CONFIGURATION_MAX_STR_LENGTH (256)
 #define DEFAULT_FLAG (0x80)
 #define HANDSHAKE_FLAG (0x40)
+/*
+ * Extra time to stay awake after the NVM write delay, so that a sleeping node does not go to
+ * sleep before the write.
+ */
+#define NVM_WRITE_AWAKE_MARGIN_MS (100)
 // -----------------------------------------------------------------------------
 //              Static Function Declarations
 // -----------------------------------------------------------------------------
@@ -331,6 +341,53 @@ cc_configuration_is_valid_size(cc_config_parameter_size_t size_value);
 
 static size_t
 cc_configuration_strnlen(const char *str, size_t maxlen);
+
+/**
+ * Check, whether the value of a parameter is kept in the cache
+ * @param[in] parameter_ix index of the parameter in the configuration pool
+ * @return true if cached, false if the parameter is read from and written to NVM directly
+*/
+static bool
+cc_configuration_is_cached(uint16_t parameter_ix);
+
+/**
+ * Reads the current value of a parameter, from the cache if the parameter is cached
+ * @param[in] parameter_ix index of the parameter in the configuration pool
+ * @param[out] value the current value
+ * @return true if the value was read, false otherwise
+*/
+static bool
+cc_configuration_read_value(uint16_t parameter_ix, cc_config_parameter_value_t* value);
+
+/**
+ * Changes the value of a parameter. A cached parameter is only written to NVM by
+ * cc_configuration_commit().
+ * @param[in] parameter_ix index of the parameter in the configuration pool
+ * @param[in] value the new value
+ * @return true if the value was changed, false otherwise
+*/
+static bool
+cc_configuration_write_value(uint16_t parameter_ix, cc_config_parameter_value_t const* value);
+
+/**
+ * Writes the changed parameters to NVM, now or after CC_CONFIGURATION_NVM_WRITE_DELAY_MS
+ * @return false if a write failed, true otherwise
+*/
+static bool
+cc_configuration_commit(void);
+
+/**
+ * Writes the changed parameters to NVM
+ * @return false if a write failed, true otherwise
+*/
+static bool
+cc_configuration_flush(void);
+
+/**
+ * Drops a pending write, as the parameters are about to be read from NVM.
+*/
+static void
+cc_configuration_cancel_commit(void);
 // -----------------------------------------------------------------------------
 //                Global Variables
 // -----------------------------------------------------------------------------
@@ -340,6 +397,10 @@ cc_configuration_strnlen(const char *str, size_t maxlen);
 // -----------------------------------------------------------------------------
 /**< cc_configuration_t pointer to the meta data of the parameters */
 static cc_configuration_t const* configuration_pool;
+#if (0 < CC_CONFIGURATION_NVM_WRITE_DELAY_MS)
+static SSwTimer nvm_write_timer;
+static zpal_pm_handle_t nvm_write_power_lock = NULL;
+#endif
 // -----------------------------------------------------------------------------
 //              Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -351,6 +412,8 @@ init_and_reset(void)
   cc_config_parameter_buffer_t parameter_buffer = { 0 };
   configuration_pool = cc_configuration_get_configuration();
 
+  cc_configuration_cancel_commit();
+
   for(uint16_t loop_cnt = 0; loop_cnt < configuration_pool->numberOfParameters ; loop_cnt++)
   {
     is_migrated = false;
@@ -364,6 +427,7 @@ init_and_reset(void)
     if(retval == false)
     {
       /*Parameter is not stored, let's write it*/
+      parameter_buffer.data_buffer = configuration_pool->parameters[loop_cnt].attributes.default_value;
       retval = cc_configuration_io_write( parameter_buffer.metadata->file_id,
                                             (const uint8_t*)&configuration_pool->parameters[loop_cnt].attributes.default_value,
                                             sizeof(cc_config_parameter_value_t));
@@ -380,6 +444,12 @@ init_and_reset(void)
                                             (const uint8_t*)&parameter_buffer.data_buffer,
                                             sizeof(cc_config_parameter_value_t));
     }
+
+    if(configuration_pool->cache != NULL)
+    {
+      configuration_pool->cache[loop_cnt].value = parameter_buffer.data_buffer;
+      configuration_pool->cache[loop_cnt].dirty = false;
+    }
   }
 
   ASSERT(retval == true);
@@ -827,6 +897,11 @@ cc_configuration_command_set(   __attribute__((unused)) RECEIVE_OPTIONS_TYPE_EX
     }
   }
 
+  if(false == cc_configuration_commit())
+  {
+    frame_status = RECEIVED_FRAME_STATUS_FAIL;
+  }
+
   return frame_status;
 }
 
@@ -1168,6 +1243,12 @@ cc_configuration_command_bulk_set(RECEIVE_OPTIONS_TYPE_EX *pRxOpt,
 
   }
 
+  /*All parameters of the frame are written to NVM in one go*/
+  if(false == cc_configuration_commit())
+  {
+    frame_status = RECEIVED_FRAME_STATUS_FAIL;
+  }
+
   if(handshake == true)
   {
     frame_status = cc_configuration_command_send_bulk_report(pRxOpt,
@@ -1367,16 +1448,15 @@ cc_configuration_command_default_reset( __attribute__((unused)) RECEIVE_OPTIONS_
 
   for(uint16_t parameter_ix = 0 ; parameter_ix < configuration_pool->numberOfParameters ; parameter_ix++)
   {
-    write_success = cc_configuration_io_write( configuration_pool->parameters[parameter_ix].file_id,
-                                                        (const uint8_t*)&configuration_pool->parameters[parameter_ix].attributes.default_value,
-                                                          sizeof(cc_config_parameter_value_t));
+    write_success = cc_configuration_write_value(parameter_ix,
+                                                 &configuration_pool->parameters[parameter_ix].attributes.default_value);
     if(false == write_success)
     {
       return RECEIVED_FRAME_STATUS_FAIL;
     }
 
   }
-  return RECEIVED_FRAME_STATUS_SUCCESS;
+  return cc_configuration_commit() ? RECEIVED_FRAME_STATUS_SUCCESS : RECEIVED_FRAME_STATUS_FAIL;
 }
 
 static cc_config_configuration_set_return_value
@@ -1402,9 +1482,7 @@ cc_configuration_set(uint16_t parameter_number,  cc_config_parameter_value_t* ne
         {
           break;
         }
-        io_transaction_result = cc_configuration_io_read( configuration_pool->parameters[parameter_ix].file_id,
-                                                            (uint8_t*)&parameter_buffer.data_buffer,
-                                                            sizeof(cc_config_parameter_value_t));
+        io_transaction_result = cc_configuration_read_value(parameter_ix, &parameter_buffer.data_buffer);
 
         if(io_transaction_result == false)
         {
@@ -1419,9 +1497,7 @@ cc_configuration_set(uint16_t parameter_number,  cc_config_parameter_value_t* ne
                   (const void*)new_value->as_uint8_array,
                   sizeof(cc_config_parameter_value_t));
 
-            io_transaction_result = cc_configuration_io_write( configuration_pool->parameters[parameter_ix].file_id,
-                                                            (const uint8_t*)&parameter_buffer.data_buffer,
-                                                            sizeof(cc_config_parameter_value_t));
+            io_transaction_result = cc_configuration_write_value(parameter_ix, &parameter_buffer.data_buffer);
         } else {
           return_value = CC_CONFIG_RETURN_CODE_NOT_SUPPORTED;
         }
@@ -1449,9 +1525,7 @@ cc_configuration_get(uint16_t parameter_number, cc_config_parameter_buffer_t* pa
        if(configuration_pool->parameters[parameter_ix].number == parameter_number)
        {
          parameter_buffer->metadata = &configuration_pool->parameters[parameter_ix];
-         io_transaction_result = cc_configuration_io_read( configuration_pool->parameters[parameter_ix].file_id,
-                                                             (uint8_t*)&parameter_buffer->data_buffer,
-                                                             sizeof(cc_config_parameter_value_t));
+         io_transaction_result = cc_configuration_read_value(parameter_ix, &parameter_buffer->data_buffer);
          break;
        }
      }
@@ -1481,9 +1555,8 @@ cc_configuration_reset_to_default_value(uint16_t parameter_number)
   {
     if(configuration_pool->parameters[parameter_ix].number == parameter_number)
     {
-      io_transaction_result = cc_configuration_io_write( configuration_pool->parameters[parameter_ix].file_id,
-                                                          (const uint8_t*)&configuration_pool->parameters[parameter_ix].attributes.default_value,
-                                                           sizeof(cc_config_parameter_value_t));
+      io_transaction_result = cc_configuration_write_value(parameter_ix,
+                                                           &configuration_pool->parameters[parameter_ix].attributes.default_value);
 
       break;
     }
@@ -1538,6 +1611,134 @@ cc_configuration_strnlen(const char *str, size_t maxlen)
   return i;
 }
 
+static bool
+cc_configuration_is_cached(uint16_t parameter_ix)
+{
+  /*Read only parameters may be served by the application on every read*/
+  return (configuration_pool->cache != NULL) &&
+         (configuration_pool->parameters[parameter_ix].attributes.flags.read_only == false);
+}
+
+static bool
+cc_configuration_read_value(uint16_t parameter_ix, cc_config_parameter_value_t* value)
+{
+  if(true == cc_configuration_is_cached(parameter_ix))
+  {
+    *value = configuration_pool->cache[parameter_ix].value;
+    return true;
+  }
+  return cc_configuration_io_read( configuration_pool->parameters[parameter_ix].file_id,
+                                   (uint8_t*)value,
+                                   sizeof(cc_config_parameter_value_t));
+}
+
+static bool
+cc_configuration_write_value(uint16_t parameter_ix, cc_config_parameter_value_t const* value)
+{
+  if(true == cc_configuration_is_cached(parameter_ix))
+  {
+    cc_config_parameter_cache_t * p_entry = &configuration_pool->cache[parameter_ix];
+
+    if(0 != memcmp(&p_entry->value, value, sizeof(cc_config_parameter_value_t)))
+    {
+      p_entry->value = *value;
+      p_entry->dirty = true;
+    }
+    return true;
+  }
+  return cc_configuration_io_write( configuration_pool->parameters[parameter_ix].file_id,
+                                    (const uint8_t*)value,
+                                    sizeof(cc_config_parameter_value_t));
+}
+
+static bool
+cc_configuration_flush(void)
+{
+  bool write_success = true;
+
+  if(configuration_pool->cache == NULL)
+  {
+    return true;
+  }
+
+  for(uint16_t parameter_ix = 0 ; parameter_ix < configuration_pool->numberOfParameters ; parameter_ix++)
+  {
+    cc_config_parameter_cache_t * p_entry = &configuration_pool->cache[parameter_ix];
+
+    if(p_entry->dirty == false)
+    {
+      continue;
+    }
+    if(true == cc_configuration_io_write( configuration_pool->parameters[parameter_ix].file_id,
+                                          (const uint8_t*)&p_entry->value,
+                                          sizeof(cc_config_parameter_value_t)))
+    {
+      p_entry->dirty = false;
+    }
+    else
+    {
+      /*Stays dirty, the next commit tries again*/
+      write_success = false;
+    }
+  }
+  return write_success;
+}
+
+#if (0 < CC_CONFIGURATION_NVM_WRITE_DELAY_MS)
+static void
+cc_configuration_nvm_write_timer_callback(__attribute__((unused)) SSwTimer* pTimer)
+{
+  (void)cc_configuration_flush();
+  zpal_pm_cancel(nvm_write_power_lock);
+}
+#endif
+
+static bool
+cc_configuration_commit(void)
+{
+  bool is_dirty = false;
+
+  if(configuration_pool->cache == NULL)
+  {
+    return true;
+  }
+
+  for(uint16_t parameter_ix = 0 ; (parameter_ix < configuration_pool->numberOfParameters) && (is_dirty == false) ; parameter_ix++)
+  {
+    is_dirty = configuration_pool->cache[parameter_ix].dirty;
+  }
+  if(is_dirty == false)
+  {
+    return true;
+  }
+
+#if (0 < CC_CONFIGURATION_NVM_WRITE_DELAY_MS)
+  TimerStart(&nvm_write_timer, CC_CONFIGURATION_NVM_WRITE_DELAY_MS);
+  zpal_pm_stay_awake(nvm_write_power_lock, CC_CONFIGURATION_NVM_WRITE_DELAY_MS + NVM_WRITE_AWAKE_MARGIN_MS);
+  return true;
+#else
+  return cc_configuration_flush();
+#endif
+}
+
+static void
+cc_configuration_cancel_commit(void)
+{
+  if(configuration_pool->cache == NULL)
+  {
+    return;
+  }
+#if (0 < CC_CONFIGURATION_NVM_WRITE_DELAY_MS)
+  if(nvm_write_power_lock == NULL)
+  {
+    AppTimerRegister(&nvm_write_timer, false, cc_configuration_nvm_write_timer_callback);
+    nvm_write_power_lock = zpal_pm_register(ZPAL_PM_TYPE_USE_RADIO);
+  }
+  TimerStop(&nvm_write_timer);
+  zpal_pm_cancel(nvm_write_power_lock);
+#endif
+}
+
 static bool
 cc_configuration_is_valid_size(cc_config_parameter_size_t size_value)
 {
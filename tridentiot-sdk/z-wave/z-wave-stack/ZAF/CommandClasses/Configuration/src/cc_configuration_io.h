@@ -30,6 +30,16 @@
  * @{
  */
 
+/**
+ * Delay in milliseconds from a Set of a parameter to the write of it to NVM.
+ *
+ * Parameters set within the delay are written at once. 0 writes at the end of each Set, Bulk Set
+ * and Default Reset command.
+ */
+#if !defined(CC_CONFIGURATION_NVM_WRITE_DELAY_MS)
+#define CC_CONFIGURATION_NVM_WRITE_DELAY_MS  1000
+#endif /* !defined(CC_CONFIGURATION_NVM_WRITE_DELAY_MS) */
+
 /**
  * Write a specific amount data to nvm
  *
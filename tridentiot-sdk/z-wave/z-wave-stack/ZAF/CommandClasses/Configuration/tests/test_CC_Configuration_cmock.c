@@ -159,12 +159,24 @@ static cc_configuration_t default_configuration = {
   .parameters         = &configuration_pool[0]
 };
 
+static cc_config_parameter_cache_t parameter_cache[sizeof_array(configuration_pool)];
+
+static cc_configuration_t cached_configuration = {
+  .numberOfParameters = sizeof_array(configuration_pool),
+  .parameters         = &configuration_pool[0],
+  .cache              = parameter_cache
+};
+
+static uint32_t nvm_read_count;
+static uint32_t nvm_write_count;
+
 /*
  * Serves a as a fake for reading files.
  */
 static zpal_status_t callback_ZAF_nvm_read(zpal_nvm_object_key_t key, void* object, size_t object_size, int call_count)
 {
   *((uint32_t*)(object)) = files[key];
+  nvm_read_count++;
   return ZPAL_STATUS_OK;
 }
 
@@ -175,6 +187,7 @@ static zpal_status_t callback_ZAF_nvm_write(zpal_nvm_object_key_t key, const voi
 {
   cc_config_parameter_value_t value = *((cc_config_parameter_value_t*)(object));
   files[key] = value.as_int32;
+  nvm_write_count++;
   return ZPAL_STATUS_OK;
 }
 
@@ -1460,3 +1473,47 @@ void test_cc_configuration_handler_info_report_multiframe(void)
   test_common_command_handler_input_free(p_chi);
 }
 
+/*
+ * This test verifies that a cached configuration serves Gets from RAM, writes the parameters of
+ * a Bulk Set once, after the frame, and does not write values that did not change.
+ */
+void test_cc_configuration_cached_bulk_set(void)
+{
+  const cc_config_parameter_value_t PARAMETERS[] = {
+    {
+      .as_int32 = -91000 // Random, but valid value.
+    },
+    {
+      .as_int32 = -71000 // Random, but valid value.
+    }
+  };
+  cc_config_parameter_buffer_t parameter_buffer;
+
+  cc_configuration_get_configuration_ExpectAndReturn(&cached_configuration);
+  ZAF_CC_init_specific(COMMAND_CLASS_CONFIGURATION_V4);
+
+  nvm_read_count = 0;
+  nvm_write_count = 0;
+
+  command_handler_input_t * p_chi = create_configuration_bulk_set(1,
+                                                                  sizeof_array(PARAMETERS),
+                                                                  CC_CONFIG_PARAMETER_SIZE_32_BIT,
+                                                                  false,
+                                                                  false,
+                                                                  PARAMETERS[0],
+                                                                  PARAMETERS[1]);
+
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, CC_Configuration_handler(p_chi));
+  TEST_ASSERT_EQUAL_UINT32(2, nvm_write_count);
+  TEST_ASSERT_EQUAL_INT32(PARAMETERS[0].as_int32, (int32_t)files[0]);
+  TEST_ASSERT_EQUAL_INT32(PARAMETERS[1].as_int32, (int32_t)files[1]);
+
+  // The same values again do not reach NVM.
+  TEST_ASSERT_EQUAL(RECEIVED_FRAME_STATUS_SUCCESS, CC_Configuration_handler(p_chi));
+  TEST_ASSERT_EQUAL_UINT32(2, nvm_write_count);
+  test_common_command_handler_input_free(p_chi);
+
+  TEST_ASSERT_TRUE(cc_configuration_get(2, &parameter_buffer));
+  TEST_ASSERT_EQUAL_INT32(PARAMETERS[1].as_int32, parameter_buffer.data_buffer.as_int32);
+  TEST_ASSERT_EQUAL_UINT32(0, nvm_read_count);
+}
@@ -20,7 +20,10 @@
 // -----------------------------------------------------------------------------
 //                   Includes
 // -----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
 #include "cc_multilevel_sensor_support_config.h"
+#include "zaf_transport_tx.h"
 
 /**
  * @addtogroup CC
@@ -45,9 +48,68 @@
 /**
  * This function will report the registered sensor's measured datas
  * to the Lifeline group.
+ *
+ * All sensors are reported from one True Status trigger. Per destination the
+ * reports are packed into Multi Command Encapsulation frames if
+ * cc_multilevel_sensor_destination_supports_multi_cmd() allows it, otherwise
+ * they are sent one after the other.
  */
 void cc_multilevel_sensor_send_sensor_data(void);
 
+/**
+ * Changes the period of the lifeline autoreport timer.
+ *
+ * The autoreport timer is deep sleep persistent and is meant to be the only
+ * periodic clock of a sensor application: each expiry first calls
+ * cc_multilevel_sensor_autoreport_acquire() and then reports all sensors.
+ *
+ * Calling this before ZAF_Init() makes the first period use the new value.
+ * Calling it afterwards restarts the running timer.
+ *
+ * @param[in] period_ms New period in milliseconds. 0 is ignored.
+ */
+void cc_multilevel_sensor_set_autoreport_period(uint32_t period_ms);
+
+/**
+ * Returns the current period of the lifeline autoreport timer.
+ * @return Period in milliseconds.
+ */
+uint32_t cc_multilevel_sensor_get_autoreport_period(void);
+
+/**
+ * Called on every autoreport timer expiry, right before the sensors are read
+ * and reported. The application can take its samples here so the reports
+ * are served from a fresh measurement.
+ *
+ * @note Weak, the default implementation does nothing.
+ */
+void cc_multilevel_sensor_autoreport_acquire(void);
+
+/**
+ * Called on every autoreport timer expiry after
+ * cc_multilevel_sensor_autoreport_acquire(). Lets the application skip the
+ * lifeline report, e.g. when the value did not change enough to be worth the
+ * airtime. The timer keeps running either way.
+ *
+ * @note Weak, the default implementation always reports.
+ * @return true to send the reports, false to skip them this period.
+ */
+bool cc_multilevel_sensor_autoreport_is_due(void);
+
+/**
+ * Tells whether a lifeline destination supports Multi Command, so the
+ * reports of all sensors can go out in one frame. The CC cannot discover
+ * this itself; an application that knows it, e.g. from the Association Data
+ * Store, overrides this function.
+ *
+ * @note Weak, the default implementation returns false.
+ * @param[in] tx_options Transmit options of the destination. dest_node_id is
+ * zero if the reports go to several lifeline destinations at once, listed in
+ * dest_node_list; return true only if all of them support Multi Command.
+ * @return true to batch the reports into Multi Command Encapsulation.
+ */
+bool cc_multilevel_sensor_destination_supports_multi_cmd(const zaf_tx_options_t *tx_options);
+
 /**
  * @}
  * @}
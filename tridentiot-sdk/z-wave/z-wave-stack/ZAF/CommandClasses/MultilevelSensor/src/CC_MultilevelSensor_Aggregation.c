@@ -0,0 +1,468 @@
+/// ***************************************************************************
+///
+/// @file CC_MultilevelSensor_Aggregation.c
+///
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+
+// -----------------------------------------------------------------------------
+//                   Includes
+// -----------------------------------------------------------------------------
+#include <string.h>
+#include <stdbool.h>
+#include "Assert.h"
+#include "TickTime.h"
+#include "AppTimer.h"
+#include "ZAF_retention_register.h"
+#include <zpal_retention_register.h>
+#include <ZW_system_startup_api.h>
+#include "tr_ring_buffer.h"
+#include "CC_MultilevelSensor_SensorHandler.h"
+#include "CC_MultilevelSensor_Aggregation.h"
+//#define DEBUGPRINT
+#include "DebugPrint.h"
+// -----------------------------------------------------------------------------
+//                Macros and Typedefs
+// -----------------------------------------------------------------------------
+// The ring buffer counts up to 255 entries, the queues hold sample slots.
+STATIC_ASSERT((MULTILEVEL_SENSOR_AGGREGATION_SAMPLES > 0) && (MULTILEVEL_SENSOR_AGGREGATION_SAMPLES <= 0xFF),
+              STATIC_ASSERT_FAILED_aggregation_samples_out_of_range);
+STATIC_ASSERT((MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S > 0)
+              && (MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S <= MULTILEVEL_SENSOR_AGGREGATION_MAX_WINDOW_S),
+              STATIC_ASSERT_FAILED_aggregation_default_window_out_of_range);
+
+#define AGGREGATION_WINDOW_COUNT  MULTILEVEL_SENSOR_REGISTERED_SENSOR_NUMBER_LIMIT
+
+/**
+ * Retention register layout of a window summary, as offsets from the first
+ * register of the window.
+ */
+#define AGGREGATION_RETENTION_HEADER   0 ///< Magic, sensor type and sample count, 0 if empty
+#define AGGREGATION_RETENTION_NEWEST   1 ///< Task tick of the newest sample
+#define AGGREGATION_RETENTION_MIN      2
+#define AGGREGATION_RETENTION_MAX      3
+#define AGGREGATION_RETENTION_MEAN     4
+
+#define AGGREGATION_RETENTION_MAGIC    0xA5U
+
+#define AGGREGATION_HEADER(sensor_type, count) \
+  (((uint32_t)AGGREGATION_RETENTION_MAGIC << 24) | ((uint32_t)(sensor_type) << 16) | (uint32_t)(count))
+#define AGGREGATION_HEADER_MAGIC(header)        ((uint8_t)((header) >> 24))
+#define AGGREGATION_HEADER_SENSOR_TYPE(header)  ((uint8_t)((header) >> 16))
+#define AGGREGATION_HEADER_COUNT(header)        ((uint16_t)(header))
+
+/**
+ * Aggregate of the samples taken before Deep Sleep. It is merged as a whole
+ * and leaves the window together with its newest sample.
+ */
+typedef struct _aggregation_summary {
+  bool     valid;
+  int32_t  min;
+  int32_t  max;
+  int64_t  sum;
+  uint16_t count;
+  uint32_t newest_timestamp;
+}aggregation_summary_t;
+
+/**
+ * Samples are stored in slots that are used round robin. The ring buffers
+ * hold slot numbers: all samples from oldest to newest, and the slots the
+ * min and max can still come from, with the current min and max first.
+ */
+typedef struct _aggregation_window {
+  int32_t               values[MULTILEVEL_SENSOR_AGGREGATION_SAMPLES];
+  uint32_t              timestamps[MULTILEVEL_SENSOR_AGGREGATION_SAMPLES];
+  uint8_t               samples_buffer[MULTILEVEL_SENSOR_AGGREGATION_SAMPLES];
+  uint8_t               min_buffer[MULTILEVEL_SENSOR_AGGREGATION_SAMPLES];
+  uint8_t               max_buffer[MULTILEVEL_SENSOR_AGGREGATION_SAMPLES];
+  tr_ring_buffer_t      samples;
+  tr_ring_buffer_t      min_queue;
+  tr_ring_buffer_t      max_queue;
+  int64_t               sum;
+  uint8_t               next_slot;
+  aggregation_summary_t summary;
+}aggregation_window_t;
+// -----------------------------------------------------------------------------
+//              Static Function Declarations
+// -----------------------------------------------------------------------------
+static void aggregation_save_all(void);
+// -----------------------------------------------------------------------------
+//                Static Variables
+// -----------------------------------------------------------------------------
+static aggregation_window_t aggregation_windows[AGGREGATION_WINDOW_COUNT];
+static uint32_t aggregation_window_ms = MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S * 1000U;
+static bool aggregation_initialized = false;
+/**< The retention registers are not written before the summaries were loaded. */
+static bool aggregation_loaded = false;
+// -----------------------------------------------------------------------------
+//              Static Function Definitions
+// -----------------------------------------------------------------------------
+static void
+aggregation_clear_window(aggregation_window_t* window)
+{
+  memset(window, 0, sizeof(aggregation_window_t));
+
+  window->samples.p_buffer      = window->samples_buffer;
+  window->samples.buffer_size   = MULTILEVEL_SENSOR_AGGREGATION_SAMPLES;
+  window->min_queue.p_buffer    = window->min_buffer;
+  window->min_queue.buffer_size = MULTILEVEL_SENSOR_AGGREGATION_SAMPLES;
+  window->max_queue.p_buffer    = window->max_buffer;
+  window->max_queue.buffer_size = MULTILEVEL_SENSOR_AGGREGATION_SAMPLES;
+
+  (void)tr_ring_buffer_init(&window->samples);
+  (void)tr_ring_buffer_init(&window->min_queue);
+  (void)tr_ring_buffer_init(&window->max_queue);
+}
+
+static void
+aggregation_init_once(void)
+{
+  if(!aggregation_initialized)
+  {
+    for(uint8_t ix = 0; ix < AGGREGATION_WINDOW_COUNT; ix++)
+    {
+      aggregation_clear_window(&aggregation_windows[ix]);
+    }
+    aggregation_initialized = true;
+  }
+}
+
+/**
+ * Windows are kept in the order the sensor interfaces were registered.
+ */
+static aggregation_window_t*
+aggregation_find_window(const sensor_interface_t* i_interface)
+{
+  sensor_interface_iterator_t* sensor_interface_iterator;
+  uint8_t ix = 0;
+
+  if(i_interface == NULL)
+  {
+    return NULL;
+  }
+
+  aggregation_init_once();
+  cc_multilevel_sensor_init_iterator(&sensor_interface_iterator);
+  while((sensor_interface_iterator != NULL) && (ix < AGGREGATION_WINDOW_COUNT))
+  {
+    if(sensor_interface_iterator == i_interface)
+    {
+      return &aggregation_windows[ix];
+    }
+    ix++;
+    cc_multilevel_sensor_next_iterator(&sensor_interface_iterator);
+  }
+  return NULL;
+}
+
+static void
+aggregation_drop_oldest(aggregation_window_t* window)
+{
+  uint8_t slot;
+  uint8_t front;
+
+  if(1 != tr_ring_buffer_read(&window->samples, &slot, 1))
+  {
+    return;
+  }
+  window->sum -= window->values[slot];
+
+  // The oldest sample is at the front of a queue, or it was pushed out by a newer one already.
+  if(tr_ring_buffer_peek(&window->min_queue, &front) && (front == slot))
+  {
+    (void)tr_ring_buffer_read(&window->min_queue, &front, 1);
+  }
+  if(tr_ring_buffer_peek(&window->max_queue, &front) && (front == slot))
+  {
+    (void)tr_ring_buffer_read(&window->max_queue, &front, 1);
+  }
+}
+
+static void
+aggregation_expire(aggregation_window_t* window, uint32_t now)
+{
+  uint8_t slot;
+
+  while(tr_ring_buffer_peek(&window->samples, &slot)
+        && ((uint32_t)(now - window->timestamps[slot]) >= aggregation_window_ms))
+  {
+    aggregation_drop_oldest(window);
+  }
+
+  if(window->summary.valid
+     && ((uint32_t)(now - window->summary.newest_timestamp) >= aggregation_window_ms))
+  {
+    window->summary.valid = false;
+  }
+}
+
+static int32_t
+aggregation_divide_rounded(int64_t sum, uint32_t count)
+{
+  int64_t half = (int64_t)(count / 2);
+
+  if(sum >= 0)
+  {
+    return (int32_t)((sum + half) / (int64_t)count);
+  }
+  return (int32_t)((sum - half) / (int64_t)count);
+}
+
+static bool
+aggregation_compute(aggregation_window_t* window, cc_multilevel_sensor_aggregate_t* o_aggregate, uint32_t* o_newest_timestamp)
+{
+  uint8_t slot;
+  uint32_t count = (uint32_t)tr_ring_buffer_get_available(&window->samples);
+  int64_t sum = window->sum;
+
+  if(count > 0)
+  {
+    (void)tr_ring_buffer_peek(&window->min_queue, &slot);
+    o_aggregate->min = window->values[slot];
+    (void)tr_ring_buffer_peek(&window->max_queue, &slot);
+    o_aggregate->max = window->values[slot];
+    (void)tr_ring_buffer_peek_newest(&window->samples, &slot);
+    *o_newest_timestamp = window->timestamps[slot];
+  }
+
+  if(window->summary.valid)
+  {
+    if((count == 0) || (window->summary.min < o_aggregate->min))
+    {
+      o_aggregate->min = window->summary.min;
+    }
+    if((count == 0) || (window->summary.max > o_aggregate->max))
+    {
+      o_aggregate->max = window->summary.max;
+    }
+    if(count == 0)
+    {
+      *o_newest_timestamp = window->summary.newest_timestamp;
+    }
+    count += window->summary.count;
+    sum += window->summary.sum;
+  }
+
+  if(count == 0)
+  {
+    return false;
+  }
+
+  o_aggregate->mean = aggregation_divide_rounded(sum, count);
+  o_aggregate->sample_count = (count > UINT16_MAX) ? UINT16_MAX : (uint16_t)count;
+  return true;
+}
+
+/**
+ * Writes the summary of the first windows to the retention registers.
+ * Like the Deep Sleep persistent app timers, it is updated on every change
+ * so that nothing has to be done at power down.
+ */
+static void
+aggregation_save_all(void)
+{
+  sensor_interface_iterator_t* sensor_interface_iterator;
+  uint32_t now = getTickTime();
+  uint8_t ix = 0;
+
+  if(!aggregation_loaded)
+  {
+    return;
+  }
+
+  cc_multilevel_sensor_init_iterator(&sensor_interface_iterator);
+  while((sensor_interface_iterator != NULL) && (ix < MULTILEVEL_SENSOR_AGGREGATION_RETAINED_WINDOWS) && (ix < AGGREGATION_WINDOW_COUNT))
+  {
+    uint32_t reg = MULTILEVEL_SENSOR_AGGREGATION_FIRST_RETENTION_REGISTER
+                   + ((uint32_t)ix * MULTILEVEL_SENSOR_AGGREGATION_RETENTION_REGISTERS_PER_WINDOW);
+    cc_multilevel_sensor_aggregate_t aggregate;
+    uint32_t newest_timestamp = 0;
+
+    if((reg + MULTILEVEL_SENSOR_AGGREGATION_RETENTION_REGISTERS_PER_WINDOW) > ZAF_retention_register_count())
+    {
+      break;
+    }
+
+    aggregation_expire(&aggregation_windows[ix], now);
+    if(aggregation_compute(&aggregation_windows[ix], &aggregate, &newest_timestamp))
+    {
+      ZAF_retention_register_write(reg + AGGREGATION_RETENTION_HEADER,
+                                   AGGREGATION_HEADER(sensor_interface_iterator->sensor_type->value, aggregate.sample_count));
+      ZAF_retention_register_write(reg + AGGREGATION_RETENTION_NEWEST, newest_timestamp);
+      ZAF_retention_register_write(reg + AGGREGATION_RETENTION_MIN, (uint32_t)aggregate.min);
+      ZAF_retention_register_write(reg + AGGREGATION_RETENTION_MAX, (uint32_t)aggregate.max);
+      ZAF_retention_register_write(reg + AGGREGATION_RETENTION_MEAN, (uint32_t)aggregate.mean);
+    }
+    else
+    {
+      ZAF_retention_register_write(reg + AGGREGATION_RETENTION_HEADER, 0);
+    }
+
+    ix++;
+    cc_multilevel_sensor_next_iterator(&sensor_interface_iterator);
+  }
+}
+// -----------------------------------------------------------------------------
+//              Public Function Definitions
+// -----------------------------------------------------------------------------
+cc_multilevel_sensor_return_value
+cc_multilevel_sensor_aggregation_add_sample(const sensor_interface_t* i_interface, int32_t value)
+{
+  aggregation_window_t* window = aggregation_find_window(i_interface);
+  uint32_t now = getTickTime();
+  uint8_t slot;
+  uint8_t back;
+
+  if(window == NULL)
+  {
+    return CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND;
+  }
+
+  aggregation_expire(window, now);
+  if(MULTILEVEL_SENSOR_AGGREGATION_SAMPLES == tr_ring_buffer_get_available(&window->samples))
+  {
+    aggregation_drop_oldest(window);
+  }
+
+  slot = window->next_slot;
+  window->next_slot = (uint8_t)((slot + 1U) % MULTILEVEL_SENSOR_AGGREGATION_SAMPLES);
+  window->values[slot] = value;
+  window->timestamps[slot] = now;
+
+  // Samples that can no longer become the min or max leave the queues.
+  while(tr_ring_buffer_peek_newest(&window->min_queue, &back) && (window->values[back] >= value))
+  {
+    (void)tr_ring_buffer_drop_newest(&window->min_queue);
+  }
+  (void)tr_ring_buffer_write(&window->min_queue, slot);
+
+  while(tr_ring_buffer_peek_newest(&window->max_queue, &back) && (window->values[back] <= value))
+  {
+    (void)tr_ring_buffer_drop_newest(&window->max_queue);
+  }
+  (void)tr_ring_buffer_write(&window->max_queue, slot);
+
+  (void)tr_ring_buffer_write(&window->samples, slot);
+  window->sum += value;
+
+  aggregation_save_all();
+  return CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK;
+}
+
+cc_multilevel_sensor_return_value
+cc_multilevel_sensor_aggregation_get(const sensor_interface_t* i_interface, cc_multilevel_sensor_aggregate_t* o_aggregate)
+{
+  aggregation_window_t* window = aggregation_find_window(i_interface);
+  uint32_t newest_timestamp;
+
+  if((window == NULL) || (o_aggregate == NULL))
+  {
+    return CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND;
+  }
+
+  aggregation_expire(window, getTickTime());
+  if(!aggregation_compute(window, o_aggregate, &newest_timestamp))
+  {
+    return CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND;
+  }
+  return CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK;
+}
+
+bool
+cc_multilevel_sensor_aggregation_set_window(uint32_t window_s)
+{
+  if((window_s == 0) || (window_s > MULTILEVEL_SENSOR_AGGREGATION_MAX_WINDOW_S))
+  {
+    return false;
+  }
+  aggregation_window_ms = window_s * 1000U;
+  return true;
+}
+
+uint32_t
+cc_multilevel_sensor_aggregation_get_window(void)
+{
+  return aggregation_window_ms / 1000U;
+}
+
+void
+cc_multilevel_sensor_aggregation_reset(void)
+{
+  aggregation_initialized = false;
+  aggregation_init_once();
+  aggregation_save_all();
+}
+
+void
+cc_multilevel_sensor_aggregation_load(zpal_reset_reason_t reset_reason)
+{
+  sensor_interface_iterator_t* sensor_interface_iterator;
+  uint32_t tick_at_power_down = 0;
+  uint32_t sleep_duration_ms;
+  uint8_t ix = 0;
+
+  aggregation_init_once();
+
+  if((ZPAL_RESET_REASON_DEEP_SLEEP_EXT_INT != reset_reason) && (ZPAL_RESET_REASON_DEEP_SLEEP_WUT != reset_reason))
+  {
+    // Whatever is in the registers is from before a reset, drop it.
+    aggregation_loaded = true;
+    aggregation_save_all();
+    return;
+  }
+
+  // Written by the app timers at power down.
+  zpal_retention_register_read(AppTimerDeepSleepGetFirstRetentionRegister(), &tick_at_power_down);
+  sleep_duration_ms = GetCompletedSleepDurationMs();
+
+  cc_multilevel_sensor_init_iterator(&sensor_interface_iterator);
+  while((sensor_interface_iterator != NULL) && (ix < MULTILEVEL_SENSOR_AGGREGATION_RETAINED_WINDOWS) && (ix < AGGREGATION_WINDOW_COUNT))
+  {
+    uint32_t reg = MULTILEVEL_SENSOR_AGGREGATION_FIRST_RETENTION_REGISTER
+                   + ((uint32_t)ix * MULTILEVEL_SENSOR_AGGREGATION_RETENTION_REGISTERS_PER_WINDOW);
+    aggregation_summary_t* summary = &aggregation_windows[ix].summary;
+    uint32_t header = 0;
+    uint32_t newest_timestamp = 0;
+    uint32_t min = 0;
+    uint32_t max = 0;
+    uint32_t mean = 0;
+    uint32_t age_ms;
+
+    if((reg + MULTILEVEL_SENSOR_AGGREGATION_RETENTION_REGISTERS_PER_WINDOW) > ZAF_retention_register_count())
+    {
+      break;
+    }
+
+    if((ZPAL_STATUS_OK == ZAF_retention_register_read(reg + AGGREGATION_RETENTION_HEADER, &header))
+       && (AGGREGATION_RETENTION_MAGIC == AGGREGATION_HEADER_MAGIC(header))
+       && (sensor_interface_iterator->sensor_type->value == AGGREGATION_HEADER_SENSOR_TYPE(header))
+       && (0 < AGGREGATION_HEADER_COUNT(header))
+       && (ZPAL_STATUS_OK == ZAF_retention_register_read(reg + AGGREGATION_RETENTION_NEWEST, &newest_timestamp))
+       && (ZPAL_STATUS_OK == ZAF_retention_register_read(reg + AGGREGATION_RETENTION_MIN, &min))
+       && (ZPAL_STATUS_OK == ZAF_retention_register_read(reg + AGGREGATION_RETENTION_MAX, &max))
+       && (ZPAL_STATUS_OK == ZAF_retention_register_read(reg + AGGREGATION_RETENTION_MEAN, &mean)))
+    {
+      // The task tick started over at wake up.
+      age_ms = (uint32_t)(tick_at_power_down - newest_timestamp) + sleep_duration_ms;
+      DPRINTF("Aggregation %d: %d samples, newest %u ms old\n", ix, AGGREGATION_HEADER_COUNT(header), age_ms);
+
+      if(age_ms < aggregation_window_ms)
+      {
+        summary->valid = true;
+        summary->min = (int32_t)min;
+        summary->max = (int32_t)max;
+        summary->count = AGGREGATION_HEADER_COUNT(header);
+        // Only the mean was kept, the sum is rebuilt from it.
+        summary->sum = (int64_t)(int32_t)mean * summary->count;
+        summary->newest_timestamp = 0U - age_ms;
+      }
+    }
+
+    ix++;
+    cc_multilevel_sensor_next_iterator(&sensor_interface_iterator);
+  }
+
+  aggregation_loaded = true;
+  aggregation_save_all();
+}
@@ -0,0 +1,156 @@
+/// ***************************************************************************
+///
+/// @file CC_MultilevelSensor_Aggregation.h
+///
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+#ifndef CC_MULTILEVELSENSOR_AGGREGATION_H
+#define CC_MULTILEVELSENSOR_AGGREGATION_H
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <zpal_init.h>
+#include "CC_MultilevelSensor_SensorHandlerTypes.h"
+
+/**
+ * @addtogroup CC
+ * @{
+ * @addtogroup MultilevelSensor
+ * @{
+ *
+ * Aggregation windows keep the min, max and mean of the recent samples of
+ * each registered sensor interface, so a controller can read a trend at once
+ * instead of polling for every sample.
+ *
+ * Every window is a ring of timestamped samples. Samples older than the
+ * window length are dropped when the window is updated or read. Min and max
+ * are kept in monotonic queues next to the ring and the mean from a running
+ * sum, so adding a sample and reading the aggregate are amortized O(1).
+ *
+ * The windows live in RAM. Across Deep Sleep a summary of the first windows
+ * is kept in retention registers: the aggregate and the time of its newest
+ * sample. On wake up it is merged into the new samples until the window has
+ * moved past it.
+ */
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+/**
+ * Number of samples a window holds <1..255:1>
+ *
+ * When a window is full the oldest sample is dropped, even if it is still
+ * within the window length.
+ */
+#if !defined(MULTILEVEL_SENSOR_AGGREGATION_SAMPLES)
+#define MULTILEVEL_SENSOR_AGGREGATION_SAMPLES  32
+#endif /* !defined(MULTILEVEL_SENSOR_AGGREGATION_SAMPLES) */
+
+/**
+ * Default window length in seconds <1..86400:1>
+ */
+#if !defined(MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S)
+#define MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S  3600
+#endif /* !defined(MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S) */
+
+/**
+ * Longest window length in seconds.
+ */
+#define MULTILEVEL_SENSOR_AGGREGATION_MAX_WINDOW_S  86400
+
+/**
+ * First application retention register used for the Deep Sleep summary,
+ * see ZAF_retention_register_read().
+ */
+#if !defined(MULTILEVEL_SENSOR_AGGREGATION_FIRST_RETENTION_REGISTER)
+#define MULTILEVEL_SENSOR_AGGREGATION_FIRST_RETENTION_REGISTER  0
+#endif /* !defined(MULTILEVEL_SENSOR_AGGREGATION_FIRST_RETENTION_REGISTER) */
+
+/**
+ * Number of windows, in registration order, kept across Deep Sleep <0..20:1>
+ *
+ * Every window takes MULTILEVEL_SENSOR_AGGREGATION_RETENTION_REGISTERS_PER_WINDOW
+ * registers.
+ */
+#if !defined(MULTILEVEL_SENSOR_AGGREGATION_RETAINED_WINDOWS)
+#define MULTILEVEL_SENSOR_AGGREGATION_RETAINED_WINDOWS  1
+#endif /* !defined(MULTILEVEL_SENSOR_AGGREGATION_RETAINED_WINDOWS) */
+
+#define MULTILEVEL_SENSOR_AGGREGATION_RETENTION_REGISTERS_PER_WINDOW  5
+
+/**
+ * Aggregate of the samples within a window. The values use the unit and
+ * precision the samples were added with.
+ */
+typedef struct _cc_multilevel_sensor_aggregate {
+  int32_t  min;          ///< Smallest sample
+  int32_t  max;          ///< Largest sample
+  int32_t  mean;         ///< Mean, rounded half away from zero
+  uint16_t sample_count; ///< Number of samples the aggregate is made of
+}cc_multilevel_sensor_aggregate_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/**
+ * Adds a sample to the window of a registered sensor interface.
+ * @param[in] i_interface Pointer to a registered sensor interface
+ * @param[in] value Sample value, e.g. a temperature in 1/100 degree
+ * @return CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK if added, CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND if
+ * the interface is not registered.
+ */
+cc_multilevel_sensor_return_value
+cc_multilevel_sensor_aggregation_add_sample(const sensor_interface_t* i_interface, int32_t value);
+
+/**
+ * Gets the aggregate of the samples within the window of a sensor interface.
+ * @param[in] i_interface Pointer to a registered sensor interface
+ * @param[out] o_aggregate Filled with the aggregate
+ * @return CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK if the window holds any sample,
+ * CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND if it is empty or the interface is not registered.
+ */
+cc_multilevel_sensor_return_value
+cc_multilevel_sensor_aggregation_get(const sensor_interface_t* i_interface, cc_multilevel_sensor_aggregate_t* o_aggregate);
+
+/**
+ * Sets the window length of all windows. Samples already older than the new
+ * length are dropped on the next update or read.
+ * @param[in] window_s Window length in seconds, 1..MULTILEVEL_SENSOR_AGGREGATION_MAX_WINDOW_S
+ * @return true if the length was valid and set.
+ */
+bool
+cc_multilevel_sensor_aggregation_set_window(uint32_t window_s);
+
+/**
+ * @return Window length in seconds.
+ */
+uint32_t
+cc_multilevel_sensor_aggregation_get_window(void);
+
+/**
+ * Empties all windows, including the summaries kept for Deep Sleep.
+ */
+void
+cc_multilevel_sensor_aggregation_reset(void);
+
+/**
+ * Restores the summaries kept across Deep Sleep. Until this is called
+ * nothing is written to the retention registers, so it must be called once
+ * at start up, after the sensor interfaces are registered.
+ * @param[in] reset_reason Reset reason, nothing is restored unless the device
+ * woke up from Deep Sleep.
+ */
+void
+cc_multilevel_sensor_aggregation_load(zpal_reset_reason_t reset_reason);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif  // CC_MULTILEVELSENSOR_AGGREGATION_H
@@ -25,6 +25,20 @@
 // -----------------------------------------------------------------------------
 //                Macros and Typedefs
 // -----------------------------------------------------------------------------
+/**< Highest precision the Sensor Multilevel Report can carry (3 bit field). */
+#define SENSOR_PRECISION_MAX  7
+
+/**
+ * Linear conversion from the canonical unit (scale 0) of a sensor type:
+ * value = canonical * numerator / denominator + offset
+ */
+typedef struct _sensor_scale_conversion {
+  sensor_name_t sensor_name;
+  uint8_t       scale;
+  int32_t       numerator;
+  int32_t       denominator;
+  int32_t       offset;       ///< In whole units of the target scale.
+} sensor_scale_conversion_t;
 
 // -----------------------------------------------------------------------------
 //              Static Function Declarations
@@ -48,6 +62,18 @@ static const sensor_type_t sensor_types[] = {
   [SENSOR_NAME_ACCELERATION_Y]  = {.value = 0x35, .byte_offset = 7, .bit_mask = 4, .max_scale_value = 0x00},
   [SENSOR_NAME_ACCELERATION_Z]  = {.value = 0x36, .byte_offset = 7, .bit_mask = 5, .max_scale_value = 0x00},
 };
+
+/**< Scales which can be derived from the canonical one. Scales that measure
+ * something else (e.g. Lux vs. percentage) are not listed and must be read
+ * by the driver itself. */
+static const sensor_scale_conversion_t sensor_scale_conversions[] = {
+  {.sensor_name = SENSOR_NAME_AIR_TEMPERATURE, .scale = SENSOR_SCALE_FAHRENHEIT, .numerator = 9,     .denominator = 5,     .offset = 32},
+  {.sensor_name = SENSOR_NAME_POWER,           .scale = SENSOR_SCALE_BTU_H,      .numerator = 34121, .denominator = 10000, .offset = 0},
+};
+
+static const int32_t sensor_precision_factors[SENSOR_PRECISION_MAX + 1] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000
+};
 // -----------------------------------------------------------------------------
 //              Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -116,6 +142,96 @@ cc_multilevel_sensor_add_supported_scale_interface(sensor_interface_t* i_instanc
   return retval;
 }
 
+sensor_interface_return_value_t
+cc_multilevel_sensor_convert_scale(sensor_name_t i_sensor_name,
+                                   uint8_t i_scale,
+                                   int32_t i_value,
+                                   uint8_t i_precision,
+                                   int32_t* o_value)
+{
+  if((o_value == NULL) || (i_precision > SENSOR_PRECISION_MAX))
+  {
+    return SENSOR_INTERFACE_RETURN_VALUE_ERROR;
+  }
+
+  if(i_scale == SENSOR_SCALE_DEFAULT)
+  {
+    *o_value = i_value;
+    return SENSOR_INTERFACE_RETURN_VALUE_OK;
+  }
+
+  for(uint8_t i = 0; i < (sizeof(sensor_scale_conversions) / sizeof(sensor_scale_conversions[0])); i++)
+  {
+    const sensor_scale_conversion_t* conversion = &sensor_scale_conversions[i];
+    if((conversion->sensor_name != i_sensor_name) || (conversion->scale != i_scale))
+    {
+      continue;
+    }
+
+    int64_t dividend = (int64_t)i_value * conversion->numerator;
+    int64_t half     = conversion->denominator / 2;
+    // Round half away from zero, C division truncates towards zero.
+    int64_t result   = ((dividend < 0) ? (dividend - half) : (dividend + half)) / conversion->denominator;
+    result += (int64_t)conversion->offset * sensor_precision_factors[i_precision];
+
+    if((result > INT32_MAX) || (result < INT32_MIN))
+    {
+      return SENSOR_INTERFACE_RETURN_VALUE_ERROR;
+    }
+    *o_value = (int32_t)result;
+    return SENSOR_INTERFACE_RETURN_VALUE_OK;
+  }
+
+  return SENSOR_INTERFACE_RETURN_VALUE_INVALID_SCALE_VALUE;
+}
+
+sensor_interface_return_value_t
+cc_multilevel_sensor_fill_read_result(sensor_read_result_t* o_result,
+                                      sensor_name_t i_sensor_name,
+                                      uint8_t i_scale,
+                                      int32_t i_value,
+                                      uint8_t i_precision)
+{
+  int32_t value;
+
+  if(o_result == NULL)
+  {
+    return SENSOR_INTERFACE_RETURN_VALUE_ERROR;
+  }
+
+  sensor_interface_return_value_t retval = cc_multilevel_sensor_convert_scale(i_sensor_name, i_scale, i_value, i_precision, &value);
+  if(retval != SENSOR_INTERFACE_RETURN_VALUE_OK)
+  {
+    return retval;
+  }
+
+  memset(o_result, 0, sizeof(sensor_read_result_t));
+  o_result->precision = (sensor_read_result_precision)i_precision;
+
+  if((value >= INT8_MIN) && (value <= INT8_MAX))
+  {
+    o_result->size_bytes = SENSOR_READ_RESULT_SIZE_1;
+  }
+  else if((value >= INT16_MIN) && (value <= INT16_MAX))
+  {
+    o_result->size_bytes = SENSOR_READ_RESULT_SIZE_2;
+  }
+  else
+  {
+    o_result->size_bytes = SENSOR_READ_RESULT_SIZE_4;
+  }
+
+  // The CC copies size_bytes from the start of raw_result, MSB first.
+  uint32_t raw = (uint32_t)value;
+  for(uint8_t i = 0; i < o_result->size_bytes; i++)
+  {
+    o_result->raw_result[o_result->size_bytes - 1 - i] = (uint8_t)(raw & 0xFF);
+    raw >>= 8;
+  }
+
+  return SENSOR_INTERFACE_RETURN_VALUE_OK;
+}
+
 // -----------------------------------------------------------------------------
 //              Static Function Definitions
 // -----------------------------------------------------------------------------
@@ -182,6 +182,49 @@ cc_multilevel_sensor_init_interface(sensor_interface_t* i_instance, sensor_name_
 sensor_interface_return_value_t
 cc_multilevel_sensor_add_supported_scale_interface(sensor_interface_t* i_instance, uint8_t i_scale);
 
+/**
+ * Converts a value from the canonical unit of a sensor type (scale 0, e.g.
+ * Celsius or Watt) to one of its other scales, in integer arithmetic only.
+ * The result keeps the precision of the input and is rounded half away from
+ * zero.
+ *
+ * @param[in] i_sensor_name Sensor type of the value.
+ * @param[in] i_scale Scale to convert to.
+ * @param[in] i_value Canonical value multiplied by 10^i_precision.
+ * @param[in] i_precision Number of decimals in i_value, 0 to 7.
+ * @param[out] o_value Converted value multiplied by 10^i_precision.
+ *
+ * @return SENSOR_INTERFACE_RETURN_VALUE_INVALID_SCALE_VALUE if the scale
+ *         cannot be derived from the canonical unit.
+ */
+sensor_interface_return_value_t
+cc_multilevel_sensor_convert_scale(sensor_name_t i_sensor_name,
+                                   uint8_t i_scale,
+                                   int32_t i_value,
+                                   uint8_t i_precision,
+                                   int32_t* o_value);
+
+/**
+ * Fills a read result from a value in the canonical unit of the sensor type.
+ * Converts it to the requested scale, then packs it big endian into the
+ * smallest size that holds it. Drivers only have to supply the canonical
+ * value from their read_value interface.
+ *
+ * @param[out] o_result Read result to fill.
+ * @param[in] i_sensor_name Sensor type of the value.
+ * @param[in] i_scale Requested scale.
+ * @param[in] i_value Canonical value multiplied by 10^i_precision.
+ * @param[in] i_precision Number of decimals in i_value, 0 to 7.
+ *
+ * @return SENSOR_INTERFACE_RETURN_VALUE_OK on success.
+ */
+sensor_interface_return_value_t
+cc_multilevel_sensor_fill_read_result(sensor_read_result_t* o_result,
+                                      sensor_name_t i_sensor_name,
+                                      uint8_t i_scale,
+                                      int32_t i_value,
+                                      uint8_t i_precision);
+
 /**
  * @}
  * @}
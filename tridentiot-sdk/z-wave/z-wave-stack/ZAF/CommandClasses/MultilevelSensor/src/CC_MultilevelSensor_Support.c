@@ -28,6 +28,8 @@
 #include <CC_Supervision.h>
 #include <Assert.h>
 #include <ZW_typedefs.h>
+#include <ZAF_Common_interface.h>
+#include <zaf_transport_tx.h>
 #include "ZW_TransportEndpoint.h"
 #include "CC_MultilevelSensor_Support.h"
 #include "CC_MultilevelSensor_SensorHandler.h"
@@ -74,6 +76,10 @@ cc_multilevel_sensor_cmd_sensor_multilevel_get_supported_scale( RECEIVE_OPTIONS_
 // -----------------------------------------------------------------------------
 /**< Software timer instance which handles the periodic reporting to the lifeline. */
 static SSwTimer cc_multilevel_sensor_autoreport_timer = { 0 };
+/**< Period of the autoreport timer, can be changed by the application. */
+static uint32_t cc_multilevel_sensor_autoreport_period_ms = MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS;
+/**< Set once the autoreport timer has been registered during CC init. */
+static bool cc_multilevel_sensor_autoreport_registered = false;
 // -----------------------------------------------------------------------------
 //              Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -110,16 +116,51 @@ static void cc_multilevel_sensor_init(void)
   cc_multilevel_sensor_config_register_instances();
   cc_multilevel_sensor_init_all_sensor();
   AppTimerDeepSleepPersistentRegister(&cc_multilevel_sensor_autoreport_timer, false, cc_multilevel_sensor_autoreport_callback);
-  AppTimerDeepSleepPersistentStart(&cc_multilevel_sensor_autoreport_timer, MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS);
+  cc_multilevel_sensor_autoreport_registered = true;
+  AppTimerDeepSleepPersistentStart(&cc_multilevel_sensor_autoreport_timer, cc_multilevel_sensor_autoreport_period_ms);
 }
 
 typedef struct tse_data_t {
   RECEIVE_OPTIONS_TYPE_EX zaf_tse_local_actuation;
-  sensor_interface_iterator_t* sensor_interface;
 } tse_data_t;
 
+/**
+ * One encoded Sensor Multilevel Report.
+ */
+typedef struct
+{
+  uint8_t length;
+  uint8_t frame[sizeof(ZW_SENSOR_MULTILEVEL_REPORT_4BYTE_V11_FRAME)];
+} multilevel_sensor_report_t;
+
+/**
+ * Reports of all sensors for the lifeline destination currently served by
+ * the TSE. They go out as Multi Command encapsulated batches, or one by one
+ * if the destination does not support Multi Command.
+ */
+typedef struct
+{
+  multilevel_sensor_report_t reports[MULTILEVEL_SENSOR_REGISTERED_SENSOR_NUMBER_LIMIT];
+  uint8_t report_count;
+  uint8_t next_report;          ///< First report not sent yet.
+  bool use_multi_cmd;
+  zaf_tx_options_t tx_options;  ///< Copy of the TSE options, used for the follow-up frames.
+} multilevel_sensor_batch_t;
+
+// Multi Command Encapsulation header: class, command and number of commands.
+#define MULTI_CMD_ENCAP_HEADER_SIZE     3
+// Headers zaf_transport_tx() puts around the batch frame: Supervision Get,
+// and Multi Channel Command Encapsulation when sent from an endpoint.
+#define SUPERVISION_ENCAP_HEADER_SIZE   4
+#define MULTI_CHANNEL_ENCAP_HEADER_SIZE 4
+
+/**
+ * All sensors are reported from a single TSE trigger, so the number of
+ * sensors does not count against ZAF_TSE_MAXIMUM_SIMULTANEOUS_TRIGGERS.
+ */
+static tse_data_t tse_data = {0};
 
-static tse_data_t tse_data[MULTILEVEL_SENSOR_REGISTERED_SENSOR_NUMBER_LIMIT] = {0};
+static multilevel_sensor_batch_t cc_multilevel_sensor_batch = {0};
 
 /**
  * This is a callback for the autoreport timer to trigger periodically the lifeline
@@ -128,55 +169,171 @@ static tse_data_t tse_data[MULTILEVEL_SENSOR_REGISTERED_SENSOR_NUMBER_LIMIT] = {
  */
 static void cc_multilevel_sensor_autoreport_callback(__attribute__((unused)) SSwTimer *pTimer)
 {
-  cc_multilevel_sensor_send_sensor_data();
-  AppTimerDeepSleepPersistentStart(&cc_multilevel_sensor_autoreport_timer, MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS);
+  cc_multilevel_sensor_autoreport_acquire();
+  if (true == cc_multilevel_sensor_autoreport_is_due())
+  {
+    cc_multilevel_sensor_send_sensor_data();
+  }
+  AppTimerDeepSleepPersistentStart(&cc_multilevel_sensor_autoreport_timer, cc_multilevel_sensor_autoreport_period_ms);
 }
 
 /**
- * Sends Multilevel Sensor report when TSE was triggered
- * @param[in] txOptions TxOptions, filled in by TSE
- * @param[in] pData this parameter is not used in this case
+ * Reads all sensors and encodes their reports into the batch.
+ * Sensors that fail to read are left out.
  */
-static void
-cc_multilevel_sensor_operation_report_stx(zaf_tx_options_t *tx_options, void* pData)
+static void cc_multilevel_sensor_batch_read_all(void)
 {
-  if (NULL == pData)
+  sensor_interface_iterator_t* sensor_interface_iterator;
+
+  cc_multilevel_sensor_batch.report_count = 0;
+  cc_multilevel_sensor_batch.next_report  = 0;
+
+  cc_multilevel_sensor_init_iterator(&sensor_interface_iterator);
+  while ((NULL != sensor_interface_iterator) &&
+         (cc_multilevel_sensor_batch.report_count < MULTILEVEL_SENSOR_REGISTERED_SENSOR_NUMBER_LIMIT))
   {
-    ASSERT(0);  // this only for debugging purpose.
+    if (sensor_interface_iterator->read_value != NULL)
+    {
+      uint8_t scale;
+      sensor_read_result_t read_result;
+      scale = cc_multilevel_sensor_check_scale(sensor_interface_iterator, 0);
+      if (true == sensor_interface_iterator->read_value(&read_result, scale))
+      {
+        multilevel_sensor_report_t *report = &cc_multilevel_sensor_batch.reports[cc_multilevel_sensor_batch.report_count];
+        ZW_SENSOR_MULTILEVEL_REPORT_4BYTE_V11_FRAME *frame = (ZW_SENSOR_MULTILEVEL_REPORT_4BYTE_V11_FRAME *)report->frame;
+
+        frame->cmdClass   = COMMAND_CLASS_SENSOR_MULTILEVEL_V11;
+        frame->cmd        = SENSOR_MULTILEVEL_REPORT_V11;
+        frame->sensorType = sensor_interface_iterator->sensor_type->value;
+        frame->level      = (uint8_t)(read_result.precision << 5) |
+                            (uint8_t)(scale << 3) |
+                            (uint8_t)read_result.size_bytes;
+        memcpy(&frame->sensorValue1, read_result.raw_result, read_result.size_bytes);
+        report->length = (uint8_t)(sizeof(ZW_SENSOR_MULTILEVEL_REPORT_1BYTE_V11_FRAME) - 1 + read_result.size_bytes);
+        cc_multilevel_sensor_batch.report_count++;
+      }
+    }
+    cc_multilevel_sensor_next_iterator(&sensor_interface_iterator);
+  }
+}
+
+static void cc_multilevel_sensor_batch_tx_callback(transmission_result_t * pTransmissionResult);
+
+/**
+ * Sends the next frame of the batch: as many reports as fit into one Multi
+ * Command Encapsulation, or a single plain report.
+ * Hands back to the TSE once the batch is done or a frame cannot be queued.
+ * @param[in] pTransmissionResult Result of the previous frame, passed on to the TSE.
+ */
+static void cc_multilevel_sensor_batch_send_next(transmission_result_t * pTransmissionResult)
+{
+  multilevel_sensor_batch_t *batch = &cc_multilevel_sensor_batch;
+
+  if (batch->next_report >= batch->report_count)
+  {
+    ZAF_TSE_TXCallback(pTransmissionResult);
     return;
   }
 
-  sensor_interface_iterator_t *sensor_interface_iterator = ((tse_data_t *)pData)->sensor_interface;
-  if (NULL == sensor_interface_iterator) {
-    ASSERT(0);  // this only for debugging purpose.
+  // Build the frame directly in a transport buffer to save the copy.
+  ZW_APPLICATION_TX_BUFFER *pTxBuf = zaf_transport_tx_frame_alloc(batch->tx_options.priority);
+  if (NULL == pTxBuf)
+  {
+    // Drop the rest for this destination and let the TSE move on.
+    batch->next_report = batch->report_count;
+    ZAF_TSE_TXCallback(NULL);
     return;
   }
 
-  ZW_APPLICATION_TX_BUFFER txBuf = {
-    .ZW_SensorMultilevelReport1byteV11Frame.cmdClass = COMMAND_CLASS_SENSOR_MULTILEVEL_V11,
-    .ZW_SensorMultilevelReport1byteV11Frame.cmd = SENSOR_MULTILEVEL_REPORT_V11,
-    .ZW_SensorMultilevelReport1byteV11Frame.sensorType = sensor_interface_iterator->sensor_type->value
-  };
+  uint8_t *frame = (uint8_t *)pTxBuf;
+  uint8_t frame_length = 0;
+  uint8_t reports_in_frame = 0;
 
-  if (sensor_interface_iterator->read_value != NULL)
+  if ((true == batch->use_multi_cmd) && ((batch->report_count - batch->next_report) > 1))
   {
-    uint8_t scale;
-    sensor_read_result_t read_result;
-    scale = cc_multilevel_sensor_check_scale(sensor_interface_iterator, 0);
-    if (true == sensor_interface_iterator->read_value(&read_result, scale))
+    uint16_t payload_limit = ZAF_getAppHandle()->pNetworkInfo->MaxPayloadSize;
+    uint16_t encap_size = 0;
+    if (true == batch->tx_options.use_supervision)
+    {
+      encap_size += SUPERVISION_ENCAP_HEADER_SIZE;
+    }
+    if (0 != batch->tx_options.source_endpoint)
+    {
+      encap_size += MULTI_CHANNEL_ENCAP_HEADER_SIZE;
+    }
+    payload_limit = (payload_limit > encap_size) ? (uint16_t)(payload_limit - encap_size) : 0;
+    if (payload_limit > sizeof(ZW_APPLICATION_TX_BUFFER))
+    {
+      payload_limit = sizeof(ZW_APPLICATION_TX_BUFFER);
+    }
+
+    frame[0]     = COMMAND_CLASS_MULTI_CMD;
+    frame[1]     = MULTI_CMD_ENCAP;
+    frame_length = MULTI_CMD_ENCAP_HEADER_SIZE;
+
+    while (batch->next_report < batch->report_count)
     {
-      txBuf.ZW_SensorMultilevelReport1byteV11Frame.level = (uint8_t)(read_result.precision << 5) |
-                                                           (uint8_t)(scale << 3) |
-                                                           (uint8_t)read_result.size_bytes;
-      memcpy(&txBuf.ZW_SensorMultilevelReport1byteV11Frame.sensorValue1, read_result.raw_result, read_result.size_bytes);
-      tx_options->use_supervision = true;
-
-      (void) zaf_transport_tx((uint8_t *)&txBuf,
-                              sizeof(ZW_SENSOR_MULTILEVEL_REPORT_1BYTE_V11_FRAME) - 1 + read_result.size_bytes,
-                              ZAF_TSE_TXCallback,
-                              tx_options);
+      const multilevel_sensor_report_t *report = &batch->reports[batch->next_report];
+      if ((frame_length + 1 + report->length) > payload_limit)
+      {
+        break;
+      }
+      frame[frame_length++] = report->length;
+      memcpy(&frame[frame_length], report->frame, report->length);
+      frame_length = (uint8_t)(frame_length + report->length);
+      batch->next_report++;
+      reports_in_frame++;
     }
+    frame[2] = reports_in_frame;
+  }
+
+  if (reports_in_frame < 2)
+  {
+    // Not batching, or only one report fits: send it without the Multi
+    // Command overhead.
+    batch->next_report = (uint8_t)(batch->next_report - reports_in_frame);
+    const multilevel_sensor_report_t *report = &batch->reports[batch->next_report++];
+    memcpy(frame, report->frame, report->length);
+    frame_length = report->length;
   }
+
+  zaf_tx_options_t tx_options = batch->tx_options;
+  if (false == zaf_transport_tx_frame_send(pTxBuf, frame_length, cc_multilevel_sensor_batch_tx_callback, &tx_options))
+  {
+    // Drop the rest for this destination and let the TSE move on.
+    batch->next_report = batch->report_count;
+    ZAF_TSE_TXCallback(NULL);
+  }
+}
+
+static void cc_multilevel_sensor_batch_tx_callback(transmission_result_t * pTransmissionResult)
+{
+  cc_multilevel_sensor_batch_send_next(pTransmissionResult);
+}
+
+/**
+ * Sends the Multilevel Sensor reports of all sensors when TSE was triggered.
+ * Called once per lifeline destination, or once for all destinations that
+ * share the same encapsulation.
+ * @param[in] txOptions TxOptions, filled in by TSE
+ * @param[in] pData this parameter is not used in this case
+ */
+static void
+cc_multilevel_sensor_operation_report_stx(zaf_tx_options_t *tx_options, void* pData)
+{
+  if (NULL == pData)
+  {
+    ASSERT(0);  // this only for debugging purpose.
+    return;
+  }
+
+  cc_multilevel_sensor_batch_read_all();
+
+  tx_options->use_supervision = true;
+  cc_multilevel_sensor_batch.tx_options    = *tx_options;
+  cc_multilevel_sensor_batch.use_multi_cmd = cc_multilevel_sensor_destination_supports_multi_cmd(tx_options);
+
+  cc_multilevel_sensor_batch_send_next(NULL);
 }
 
 static received_frame_status_t
@@ -314,20 +471,56 @@ void cc_multilevel_sensor_send_sensor_data(void)
     */
   sensor_interface_iterator_t* sensor_interface_iterator;
   cc_multilevel_sensor_init_iterator(&sensor_interface_iterator);
-  uint8_t i = 0;
-  while(sensor_interface_iterator)
+  if (NULL == sensor_interface_iterator)
   {
-    tse_data[i].sensor_interface = sensor_interface_iterator;
-    ZAF_TSE_Trigger(cc_multilevel_sensor_operation_report_stx, (void*)&tse_data[i], false);
-    cc_multilevel_sensor_next_iterator(&sensor_interface_iterator);
-    i++;
+    return;
+  }
+  // The sensors are read when the TSE serves each destination, so a pending
+  // trigger already covers this request.
+  ZAF_TSE_Trigger(cc_multilevel_sensor_operation_report_stx, (void*)&tse_data, true);
+}
+
+void cc_multilevel_sensor_set_autoreport_period(uint32_t period_ms)
+{
+  if ((0 == period_ms) || (period_ms == cc_multilevel_sensor_autoreport_period_ms))
+  {
+    return;
+  }
+  cc_multilevel_sensor_autoreport_period_ms = period_ms;
+
+  if (true == cc_multilevel_sensor_autoreport_registered)
+  {
+    AppTimerDeepSleepPersistentStart(&cc_multilevel_sensor_autoreport_timer, cc_multilevel_sensor_autoreport_period_ms);
   }
 }
 
+uint32_t cc_multilevel_sensor_get_autoreport_period(void)
+{
+  return cc_multilevel_sensor_autoreport_period_ms;
+}
+
 ZW_WEAK void
 cc_multilevel_sensor_config_register_instances(void)
 {
 
 }
 
+ZW_WEAK void
+cc_multilevel_sensor_autoreport_acquire(void)
+{
+
+}
+
+ZW_WEAK bool
+cc_multilevel_sensor_autoreport_is_due(void)
+{
+  return true;
+}
+
+ZW_WEAK bool
+cc_multilevel_sensor_destination_supports_multi_cmd(__attribute__((unused)) const zaf_tx_options_t *tx_options)
+{
+  return false;
+}
+
 REGISTER_CC_V4(COMMAND_CLASS_SENSOR_MULTILEVEL_V11, SENSOR_MULTILEVEL_VERSION_V11, CC_MultilevelSensor_handler, NULL, NULL, lifeline_reporting, 0, cc_multilevel_sensor_init, NULL);
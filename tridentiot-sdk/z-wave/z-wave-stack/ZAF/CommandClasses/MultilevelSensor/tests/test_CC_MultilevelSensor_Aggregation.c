@@ -0,0 +1,332 @@
+/// ***************************************************************************
+///
+/// @file test_CC_MultilevelSensor_Aggregation.c
+///
+/// SPDX-License-Identifier: LicenseRef-TridentMSLA
+/// SPDX-FileCopyrightText: 2025 Trident IoT, LLC <https://www.tridentiot.com>
+/// ***************************************************************************
+// -----------------------------------------------------------------------------
+//                   Includes
+// -----------------------------------------------------------------------------
+#include <string.h>
+#include <stdbool.h>
+#include <unity.h>
+#include <mock_control.h>
+#include "TickTime.h"
+#include "ZAF_retention_register.h"
+#include "CC_MultilevelSensor_SensorHandler.h"
+#include "CC_MultilevelSensor_SensorHandlerTypes.h"
+#include "CC_MultilevelSensor_Aggregation.h"
+// -----------------------------------------------------------------------------
+//                Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define TEST_RETENTION_REGISTER_COUNT   8
+#define TEST_TICK_AT_POWER_DOWN_REGISTER 16
+// -----------------------------------------------------------------------------
+//              Static Function Declarations
+// -----------------------------------------------------------------------------
+static bool sensor_interface_read(sensor_read_result_t* o_result, uint8_t i_scale);
+// -----------------------------------------------------------------------------
+//                Static Variables
+// -----------------------------------------------------------------------------
+static sensor_interface_t test_sensor_interface_temperature;
+static sensor_interface_t test_sensor_interface_humidity;
+static sensor_interface_t test_sensor_interface_not_registered;
+
+static uint32_t test_tick;
+static uint32_t test_retention_registers[TEST_RETENTION_REGISTER_COUNT];
+static uint32_t test_tick_at_power_down;
+static uint32_t test_sleep_duration_ms;
+// -----------------------------------------------------------------------------
+//              Fakes
+// -----------------------------------------------------------------------------
+TickType_t xTaskGetTickCount(void)
+{
+  return test_tick;
+}
+
+zpal_status_t ZAF_retention_register_read(uint32_t index, uint32_t *data)
+{
+  if ((index >= TEST_RETENTION_REGISTER_COUNT) || (data == NULL))
+  {
+    return ZPAL_STATUS_INVALID_ARGUMENT;
+  }
+  *data = test_retention_registers[index];
+  return ZPAL_STATUS_OK;
+}
+
+zpal_status_t ZAF_retention_register_write(uint32_t index, uint32_t value)
+{
+  if (index >= TEST_RETENTION_REGISTER_COUNT)
+  {
+    return ZPAL_STATUS_INVALID_ARGUMENT;
+  }
+  test_retention_registers[index] = value;
+  return ZPAL_STATUS_OK;
+}
+
+size_t ZAF_retention_register_count(void)
+{
+  return TEST_RETENTION_REGISTER_COUNT;
+}
+
+zpal_status_t zpal_retention_register_read(uint32_t index, uint32_t *data)
+{
+  TEST_ASSERT_EQUAL_UINT32(TEST_TICK_AT_POWER_DOWN_REGISTER, index);
+  *data = test_tick_at_power_down;
+  return ZPAL_STATUS_OK;
+}
+
+uint32_t AppTimerDeepSleepGetFirstRetentionRegister(void)
+{
+  return TEST_TICK_AT_POWER_DOWN_REGISTER;
+}
+
+uint32_t GetCompletedSleepDurationMs(void)
+{
+  return test_sleep_duration_ms;
+}
+// -----------------------------------------------------------------------------
+//              Public Function Definitions
+// -----------------------------------------------------------------------------
+
+void setUpSuite(void)
+{
+  cc_multilevel_sensor_init_interface(&test_sensor_interface_temperature, SENSOR_NAME_AIR_TEMPERATURE);
+  cc_multilevel_sensor_add_supported_scale_interface(&test_sensor_interface_temperature, SENSOR_SCALE_CELSIUS);
+  test_sensor_interface_temperature.read_value = sensor_interface_read;
+  cc_multilevel_sensor_registration(&test_sensor_interface_temperature);
+
+  cc_multilevel_sensor_init_interface(&test_sensor_interface_humidity, SENSOR_NAME_HUMIDITY);
+  cc_multilevel_sensor_add_supported_scale_interface(&test_sensor_interface_humidity, SENSOR_SCALE_PERCENTAGE);
+  test_sensor_interface_humidity.read_value = sensor_interface_read;
+  cc_multilevel_sensor_registration(&test_sensor_interface_humidity);
+
+  cc_multilevel_sensor_init_interface(&test_sensor_interface_not_registered, SENSOR_NAME_ILLUMINANCE);
+}
+
+void tearDownSuite(void)
+{
+
+}
+
+void setUp(void)
+{
+  test_tick = 1000;
+  memset(test_retention_registers, 0, sizeof(test_retention_registers));
+  test_tick_at_power_down = 0;
+  test_sleep_duration_ms = 0;
+
+  cc_multilevel_sensor_aggregation_set_window(MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S);
+  cc_multilevel_sensor_aggregation_load(ZPAL_RESET_REASON_PIN);
+  cc_multilevel_sensor_aggregation_reset();
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_cc_multilevel_sensor_aggregation_empty_window(void)
+{
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                                  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate),
+                                  "[Aggregation] An empty window has no aggregate");
+}
+
+void test_cc_multilevel_sensor_aggregation_not_registered(void)
+{
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                                  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_not_registered, 100),
+                                  "[Aggregation] Sample added for an unregistered interface");
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                                  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_not_registered, &aggregate),
+                                  "[Aggregation] Aggregate of an unregistered interface");
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                                  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, NULL),
+                                  "[Aggregation] NULL output accepted");
+}
+
+void test_cc_multilevel_sensor_aggregation_min_max_mean(void)
+{
+  const int32_t samples[] = { 2150, -300, 2475, 1800, -301 };
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  for (uint8_t ix = 0; ix < sizeof(samples) / sizeof(samples[0]); ix++)
+  {
+    TEST_ASSERT_EQUAL_UINT8(CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK,
+                            cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, samples[ix]));
+    test_tick += 1000;
+  }
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_humidity, 5000);
+
+  TEST_ASSERT_EQUAL_UINT8(CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK,
+                          cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate));
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(-301, aggregate.min, "[Aggregation] Wrong min");
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(2475, aggregate.max, "[Aggregation] Wrong max");
+  // 5824 / 5 = 1164.8
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(1165, aggregate.mean, "[Aggregation] Wrong mean");
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(5, aggregate.sample_count, "[Aggregation] Wrong sample count");
+
+  // The windows are kept apart.
+  TEST_ASSERT_EQUAL_UINT8(CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK,
+                          cc_multilevel_sensor_aggregation_get(&test_sensor_interface_humidity, &aggregate));
+  TEST_ASSERT_EQUAL_INT32(5000, aggregate.min);
+  TEST_ASSERT_EQUAL_INT32(5000, aggregate.max);
+  TEST_ASSERT_EQUAL_UINT16(1, aggregate.sample_count);
+}
+
+void test_cc_multilevel_sensor_aggregation_negative_mean_rounding(void)
+{
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, -100);
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, -101);
+
+  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate);
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(-101, aggregate.mean, "[Aggregation] Mean must round half away from zero");
+}
+
+void test_cc_multilevel_sensor_aggregation_window_expiry(void)
+{
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  TEST_ASSERT_TRUE(cc_multilevel_sensor_aggregation_set_window(10));
+  TEST_ASSERT_EQUAL_UINT32(10, cc_multilevel_sensor_aggregation_get_window());
+
+  // Min and max first, then values in between.
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 100);
+  test_tick += 2000;
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 900);
+  test_tick += 2000;
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 500);
+  test_tick += 2000;
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 300);
+
+  // 10 s after the first sample it leaves the window.
+  test_tick += 4000;
+  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate);
+  TEST_ASSERT_EQUAL_UINT16(3, aggregate.sample_count);
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(300, aggregate.min, "[Aggregation] Expired min still reported");
+  TEST_ASSERT_EQUAL_INT32(900, aggregate.max);
+  TEST_ASSERT_EQUAL_INT32(567, aggregate.mean);
+
+  test_tick += 2000;
+  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate);
+  TEST_ASSERT_EQUAL_UINT16(2, aggregate.sample_count);
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(500, aggregate.max, "[Aggregation] Expired max still reported");
+
+  test_tick += 4000;
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                                  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate),
+                                  "[Aggregation] All samples should have expired");
+}
+
+void test_cc_multilevel_sensor_aggregation_full_window(void)
+{
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  // A falling ramp, every new sample is the new min.
+  for (int32_t value = MULTILEVEL_SENSOR_AGGREGATION_SAMPLES + 9; value >= 0; value--)
+  {
+    cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, value);
+    test_tick += 10;
+  }
+
+  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(MULTILEVEL_SENSOR_AGGREGATION_SAMPLES, aggregate.sample_count,
+                                   "[Aggregation] The oldest sample must be dropped when full");
+  TEST_ASSERT_EQUAL_INT32(0, aggregate.min);
+  TEST_ASSERT_EQUAL_INT32_MESSAGE(MULTILEVEL_SENSOR_AGGREGATION_SAMPLES - 1, aggregate.max,
+                                  "[Aggregation] Dropped sample still reported as max");
+}
+
+void test_cc_multilevel_sensor_aggregation_set_window_invalid(void)
+{
+  TEST_ASSERT_FALSE(cc_multilevel_sensor_aggregation_set_window(0));
+  TEST_ASSERT_FALSE(cc_multilevel_sensor_aggregation_set_window(MULTILEVEL_SENSOR_AGGREGATION_MAX_WINDOW_S + 1));
+  TEST_ASSERT_EQUAL_UINT32(MULTILEVEL_SENSOR_AGGREGATION_DEFAULT_WINDOW_S, cc_multilevel_sensor_aggregation_get_window());
+}
+
+void test_cc_multilevel_sensor_aggregation_deep_sleep(void)
+{
+  uint32_t saved_registers[TEST_RETENTION_REGISTER_COUNT];
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  TEST_ASSERT_TRUE(cc_multilevel_sensor_aggregation_set_window(60));
+
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 2000);
+  test_tick += 5000;
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 2200);
+  test_tick += 5000;
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 2100);
+  // Only the first window is retained.
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_humidity, 4000);
+
+  // Power down 10 s after the newest sample, sleep for 30 s.
+  test_tick_at_power_down = test_tick + 10000;
+  test_sleep_duration_ms = 30000;
+  memcpy(saved_registers, test_retention_registers, sizeof(saved_registers));
+
+  // RAM is lost, the retention registers are not.
+  cc_multilevel_sensor_aggregation_reset();
+  memcpy(test_retention_registers, saved_registers, sizeof(saved_registers));
+  test_tick = 0;
+
+  cc_multilevel_sensor_aggregation_load(ZPAL_RESET_REASON_DEEP_SLEEP_WUT);
+
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_OK,
+                                  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate),
+                                  "[Aggregation] Window lost in Deep Sleep");
+  TEST_ASSERT_EQUAL_UINT16(3, aggregate.sample_count);
+  TEST_ASSERT_EQUAL_INT32(2000, aggregate.min);
+  TEST_ASSERT_EQUAL_INT32(2200, aggregate.max);
+  TEST_ASSERT_EQUAL_INT32(2100, aggregate.mean);
+  TEST_ASSERT_EQUAL_UINT8(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                          cc_multilevel_sensor_aggregation_get(&test_sensor_interface_humidity, &aggregate));
+
+  // Merged with the samples taken after wake up.
+  test_tick += 1000;
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 1800);
+  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate);
+  TEST_ASSERT_EQUAL_UINT16(4, aggregate.sample_count);
+  TEST_ASSERT_EQUAL_INT32(1800, aggregate.min);
+  TEST_ASSERT_EQUAL_INT32(2025, aggregate.mean);
+
+  // The newest retained sample was 40 s old at wake up, it leaves the window 20 s later.
+  test_tick += 19000;
+  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(1, aggregate.sample_count, "[Aggregation] Retained samples did not expire");
+  TEST_ASSERT_EQUAL_INT32(1800, aggregate.max);
+}
+
+void test_cc_multilevel_sensor_aggregation_no_restore_after_reset(void)
+{
+  uint32_t saved_registers[TEST_RETENTION_REGISTER_COUNT];
+  cc_multilevel_sensor_aggregate_t aggregate;
+
+  cc_multilevel_sensor_aggregation_add_sample(&test_sensor_interface_temperature, 2000);
+  memcpy(saved_registers, test_retention_registers, sizeof(saved_registers));
+
+  cc_multilevel_sensor_aggregation_reset();
+  memcpy(test_retention_registers, saved_registers, sizeof(saved_registers));
+  cc_multilevel_sensor_aggregation_load(ZPAL_RESET_REASON_PIN);
+
+  TEST_ASSERT_EQUAL_UINT8_MESSAGE(CC_MULTILEVEL_SENSOR_RETURN_VALUE_NOT_FOUND,
+                                  cc_multilevel_sensor_aggregation_get(&test_sensor_interface_temperature, &aggregate),
+                                  "[Aggregation] Restored after a reset that was not a wake up");
+  TEST_ASSERT_EQUAL_UINT32(0, test_retention_registers[0]);
+}
+// -----------------------------------------------------------------------------
+//              Static Function Definitions
+// -----------------------------------------------------------------------------
+static bool sensor_interface_read(sensor_read_result_t* o_result, uint8_t i_scale)
+{
+  (void)o_result;
+  (void)i_scale;
+  return true;
+}
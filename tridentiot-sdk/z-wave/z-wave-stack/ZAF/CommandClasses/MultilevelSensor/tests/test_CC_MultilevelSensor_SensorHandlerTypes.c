@@ -153,6 +153,103 @@ void test_cc_multilevel_sensor_add_supported_scale_wrong_parameter(void)
 
 }
 
+void test_cc_multilevel_sensor_convert_scale_fahrenheit_max6675_range(void)
+{
+  sensor_interface_return_value_t return_value;
+  int32_t fahrenheit_x100;
+
+  // The MAX6675 reports 0 to 1023.75 degree Celsius in 0.25 degree steps.
+  for(int32_t celsius_x100 = 0; celsius_x100 <= 102375; celsius_x100 += 25)
+  {
+    return_value = cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT,
+                                                      celsius_x100, SENSOR_READ_RESULT_PRECISION_2, &fahrenheit_x100);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(SENSOR_INTERFACE_RETURN_VALUE_OK, return_value,
+      "[Sensor interface handler types] Scale conversion failed");
+
+    // Same as the float path the driver used, rounded instead of truncated.
+    double expected = (((double)celsius_x100 / 100.0) * 9.0 / 5.0 + 32.0) * 100.0;
+    int32_t expected_rounded = (int32_t)(expected + 0.5);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(expected_rounded, fahrenheit_x100,
+      "[Sensor interface handler types] Fahrenheit differs from float conversion");
+  }
+}
+
+void test_cc_multilevel_sensor_convert_scale_negative_rounding(void)
+{
+  int32_t fahrenheit;
+
+  cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, -4000, 2, &fahrenheit);
+  TEST_ASSERT_EQUAL_INT32(-4000, fahrenheit);
+
+  // -0.01 C is 31.982 F
+  cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, -1, 2, &fahrenheit);
+  TEST_ASSERT_EQUAL_INT32(3198, fahrenheit);
+
+  // -20.3 C is -4.54 F, rounded half away from zero to -4.5
+  cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, -203, 1, &fahrenheit);
+  TEST_ASSERT_EQUAL_INT32(-45, fahrenheit);
+
+  // -25 C is -13 F, no precision
+  cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, -25, 0, &fahrenheit);
+  TEST_ASSERT_EQUAL_INT32(-13, fahrenheit);
+}
+
+void test_cc_multilevel_sensor_convert_scale_invalid(void)
+{
+  sensor_interface_return_value_t return_value;
+  int32_t value = 0x55;
+
+  // Absolute humidity cannot be derived from a percentage.
+  return_value = cc_multilevel_sensor_convert_scale(SENSOR_NAME_HUMIDITY, SENSOR_SCALE_ABSOLUTE_HUMIDITY, 3000, 2, &value);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_INTERFACE_RETURN_VALUE_INVALID_SCALE_VALUE, return_value);
+  TEST_ASSERT_EQUAL_INT32(0x55, value);
+
+  return_value = cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, 100, 8, &value);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_INTERFACE_RETURN_VALUE_ERROR, return_value);
+
+  return_value = cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, 100, 2, NULL);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_INTERFACE_RETURN_VALUE_ERROR, return_value);
+
+  // Would not fit a 32 bit report value.
+  return_value = cc_multilevel_sensor_convert_scale(SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, INT32_MAX, 2, &value);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_INTERFACE_RETURN_VALUE_ERROR, return_value);
+}
+
+void test_cc_multilevel_sensor_fill_read_result_size_selection(void)
+{
+  sensor_read_result_t result;
+  sensor_interface_return_value_t return_value;
+
+  // 1.00 C fits one byte
+  return_value = cc_multilevel_sensor_fill_read_result(&result, SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_CELSIUS, 100, 2);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_INTERFACE_RETURN_VALUE_OK, return_value);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_READ_RESULT_SIZE_1, result.size_bytes);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_READ_RESULT_PRECISION_2, result.precision);
+  TEST_ASSERT_EQUAL_UINT8(100, result.raw_result[0]);
+
+  // -0.01 C, sign must survive in one byte
+  cc_multilevel_sensor_fill_read_result(&result, SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_CELSIUS, -1, 2);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_READ_RESULT_SIZE_1, result.size_bytes);
+  TEST_ASSERT_EQUAL_UINT8(0xFF, result.raw_result[0]);
+
+  // 25.75 C is 0x0A0F
+  cc_multilevel_sensor_fill_read_result(&result, SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_CELSIUS, 2575, 2);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_READ_RESULT_SIZE_2, result.size_bytes);
+  TEST_ASSERT_EQUAL_UINT8(0x0A, result.raw_result[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x0F, result.raw_result[1]);
+
+  // 1023.75 C is 1874.75 F = 187475 = 0x0002DC53
+  cc_multilevel_sensor_fill_read_result(&result, SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_FAHRENHEIT, 102375, 2);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_READ_RESULT_SIZE_4, result.size_bytes);
+  TEST_ASSERT_EQUAL_UINT8(0x00, result.raw_result[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x02, result.raw_result[1]);
+  TEST_ASSERT_EQUAL_UINT8(0xDC, result.raw_result[2]);
+  TEST_ASSERT_EQUAL_UINT8(0x53, result.raw_result[3]);
+
+  return_value = cc_multilevel_sensor_fill_read_result(NULL, SENSOR_NAME_AIR_TEMPERATURE, SENSOR_SCALE_CELSIUS, 100, 2);
+  TEST_ASSERT_EQUAL_UINT8(SENSOR_INTERFACE_RETURN_VALUE_ERROR, return_value);
+}
+
 // -----------------------------------------------------------------------------
 //              Static Function Definitions
 // -----------------------------------------------------------------------------
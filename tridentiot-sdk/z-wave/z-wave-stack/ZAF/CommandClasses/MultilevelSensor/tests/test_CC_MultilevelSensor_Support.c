@@ -30,6 +30,9 @@
 #include "CC_MultilevelSensor_SensorHandlerTypes.h"
 #include "QueueNotifying.h"
 #include "ZAF_CC_Invoker.h"
+#include <AppTimer.h>
+#include <ZW_application_transport_interface.h>
+#include "zaf_transport_tx_mock.h"
 
 // -----------------------------------------------------------------------------
 //                Macros and Typedefs
@@ -37,6 +40,19 @@
 #define SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_CELSIUS   0xA5
 #define SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PRECISION SENSOR_READ_RESULT_PRECISION_1
 #define SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_SIZE      SENSOR_READ_RESULT_SIZE_1
+#define SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PERCENTAGE 0x2A
+#define SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_WATT       0x11
+
+// Sensor Multilevel Report with a 1 byte value, as sent in a batch.
+#define BATCH_REPORT_LENGTH   5
+// Multi Command Encapsulation header, then a length octet per command.
+#define BATCH_ENCAP_LENGTH(n) (3 + (n) * (1 + BATCH_REPORT_LENGTH))
+// Supervision Get and Multi Channel Command Encapsulation headers, added by
+// the transport around a batch frame.
+#define BATCH_SUPERVISION_LENGTH   4
+#define BATCH_MULTI_CHANNEL_LENGTH 4
+#define BATCH_SENSOR_COUNT    3
+#define BATCH_MAX_FRAMES      4
 // -----------------------------------------------------------------------------
 //              Static Function Declarations
 // -----------------------------------------------------------------------------
@@ -44,6 +60,9 @@ static bool init_sensor_interface(void);
 static bool deinit_sensor_interface(void);
 static bool sensor_interface_read(sensor_read_result_t* o_result, uint8_t i_scale);
 static void multilevel_sensor_register_interface_for_test(void);
+static bool sensor_interface_read_percentage(sensor_read_result_t* o_result, uint8_t i_scale);
+static bool sensor_interface_read_watt(sensor_read_result_t* o_result, uint8_t i_scale);
+static void multilevel_sensor_register_batch_for_test(void);
 // -----------------------------------------------------------------------------
 //                Global Variables
 // -----------------------------------------------------------------------------
@@ -53,6 +72,20 @@ static void multilevel_sensor_register_interface_for_test(void);
 // -----------------------------------------------------------------------------
 
 static sensor_interface_t test_sensor_interface_A;
+static sensor_interface_t test_sensor_interface_B;
+static sensor_interface_t test_sensor_interface_C;
+
+static bool destination_supports_multi_cmd = false;
+
+// Frames passed to zaf_transport_tx_frame_send() by a batch.
+static ZW_APPLICATION_TX_BUFFER batch_tx_buffer;
+static uint8_t batch_frames[BATCH_MAX_FRAMES][ZW_MAX_PAYLOAD_SIZE];
+static uint8_t batch_frame_lengths[BATCH_MAX_FRAMES];
+static uint8_t batch_frame_count;
+static zaf_tx_callback_t batch_tx_callback;
+static bool batch_supervision;
+static uint8_t batch_source_endpoint;
+static bool batch_tx_buffer_free;
 // -----------------------------------------------------------------------------
 //              Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -65,6 +98,45 @@ void tearDownSuite(void)
 {
 }
 
+bool cc_multilevel_sensor_destination_supports_multi_cmd(__attribute__((unused)) const zaf_tx_options_t *tx_options)
+{
+  return destination_supports_multi_cmd;
+}
+
+static ZW_APPLICATION_TX_BUFFER *
+zaf_transport_tx_frame_alloc_batch_stub(zaf_transport_priority_t priority,
+                                        __attribute__((unused)) int cmock_num_calls)
+{
+  // Lifeline reports are unsolicited.
+  TEST_ASSERT_EQUAL(ZAF_TRANSPORT_PRIORITY_LOW, priority);
+  if (false == batch_tx_buffer_free)
+  {
+    return NULL;
+  }
+  batch_tx_buffer_free = false;
+  memset(&batch_tx_buffer, 0, sizeof(batch_tx_buffer));
+  return &batch_tx_buffer;
+}
+
+static bool
+zaf_transport_tx_frame_send_batch_stub(ZW_APPLICATION_TX_BUFFER *frame, uint8_t frame_length,
+                                       zaf_tx_callback_t callback,
+                                       zaf_tx_options_t* zaf_tx_options, __attribute__((unused)) int cmock_num_calls)
+{
+  TEST_ASSERT_EQUAL_PTR(&batch_tx_buffer, frame);
+  TEST_ASSERT_TRUE(batch_frame_count < BATCH_MAX_FRAMES);
+  TEST_ASSERT_TRUE(frame_length <= ZW_MAX_PAYLOAD_SIZE);
+  memcpy(batch_frames[batch_frame_count], frame, frame_length);
+  batch_frame_lengths[batch_frame_count] = frame_length;
+  batch_frame_count++;
+  batch_tx_callback = callback;
+  batch_supervision = zaf_tx_options->use_supervision;
+  batch_source_endpoint = zaf_tx_options->source_endpoint;
+  // The transport gives the buffer back once the frame is sent.
+  batch_tx_buffer_free = true;
+  return true;
+}
+
 void test_cc_multilevel_get_sensor_default_branch(void)
 {
   received_frame_status_t handler_return_value;
@@ -398,6 +470,391 @@ void test_cc_multilevel_sensor_send_sensor_data(void)
   cc_multilevel_sensor_send_sensor_data();
 }
 
+void test_cc_multilevel_sensor_send_sensor_data_single_trigger(void)
+{
+  mock_t* pMock = NULL;
+  mock_calls_clear();
+
+  multilevel_sensor_register_interface_for_test();
+
+  // One trigger covers all sensors, a second request while it is pending
+  // must overwrite it instead of taking another TSE slot.
+  mock_call_expect(TO_STR(ZAF_TSE_Trigger), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->compare_rule_arg[1] = COMPARE_NOT_NULL;
+  pMock->expect_arg[2].v     = true;
+  pMock->return_code.v       = true;
+
+  cc_multilevel_sensor_send_sensor_data();
+
+  mock_calls_verify();
+}
+
+void test_cc_multilevel_sensor_set_autoreport_period(void)
+{
+  mock_t* pMock = NULL;
+  mock_calls_clear();
+
+  // Initialize the CC here, so the result does not depend on whether an
+  // earlier test did. The init registers and starts the autoreport timer.
+  mock_call_expect(TO_STR(AppTimerDeepSleepPersistentRegister), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->expect_arg[1].v     = false;
+  pMock->compare_rule_arg[2] = COMPARE_NOT_NULL;
+  pMock->return_code.v       = true;
+
+  mock_call_expect(TO_STR(AppTimerDeepSleepPersistentStart), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->expect_arg[1].v     = MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS;
+  pMock->return_code.v       = ESWTIMER_STATUS_SUCCESS;
+
+  ZAF_CC_init_specific(COMMAND_CLASS_SENSOR_MULTILEVEL_V11);
+  TEST_ASSERT_EQUAL_UINT32(MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS, cc_multilevel_sensor_get_autoreport_period());
+
+  // 0 is not a valid period and must be ignored. Setting the current period
+  // again must not restart the timer either.
+  cc_multilevel_sensor_set_autoreport_period(0);
+  cc_multilevel_sensor_set_autoreport_period(MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS);
+  TEST_ASSERT_EQUAL_UINT32(MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS, cc_multilevel_sensor_get_autoreport_period());
+
+  // A new period restarts the running timer with it.
+  mock_call_expect(TO_STR(AppTimerDeepSleepPersistentStart), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->expect_arg[1].v     = 30000;
+  pMock->return_code.v       = ESWTIMER_STATUS_SUCCESS;
+
+  cc_multilevel_sensor_set_autoreport_period(30000);
+  TEST_ASSERT_EQUAL_UINT32(30000, cc_multilevel_sensor_get_autoreport_period());
+
+  mock_call_expect(TO_STR(AppTimerDeepSleepPersistentStart), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->expect_arg[1].v     = MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS;
+  pMock->return_code.v       = ESWTIMER_STATUS_SUCCESS;
+
+  cc_multilevel_sensor_set_autoreport_period(MULTILEVEL_SENSOR_DEFAULT_AUTOREPORT_PEDIOD_MS);
+
+  mock_calls_verify();
+}
+
+/**
+ * Triggers a lifeline report and returns the TSE callback serving one
+ * destination, with its data.
+ */
+static zaf_tse_callback_t batch_trigger(void** pData)
+{
+  mock_t* pMock = NULL;
+
+  mock_call_expect(TO_STR(ZAF_TSE_Trigger), &pMock);
+  pMock->compare_rule_arg[0] = COMPARE_NOT_NULL;
+  pMock->compare_rule_arg[1] = COMPARE_NOT_NULL;
+  pMock->expect_arg[2].v     = true;
+  pMock->return_code.v       = true;
+
+  cc_multilevel_sensor_send_sensor_data();
+
+  *pData = pMock->actual_arg[1].p;
+  return (zaf_tse_callback_t)pMock->actual_arg[0].p;
+}
+
+static void batch_expect_max_payload_size(SApplicationHandles* pAppHandles, SNetworkInfo* pNetworkInfo, uint16_t max_payload_size)
+{
+  mock_t* pMock = NULL;
+
+  pAppHandles->pNetworkInfo    = pNetworkInfo;
+  pNetworkInfo->MaxPayloadSize = max_payload_size;
+
+  mock_call_expect(TO_STR(ZAF_getAppHandle), &pMock);
+  pMock->return_code.p = pAppHandles;
+}
+
+static void batch_serve_from_endpoint(zaf_tse_callback_t cb, void* pData, uint8_t source_endpoint)
+{
+  zaf_tx_options_t tx_options;
+
+  batch_frame_count = 0;
+  batch_tx_callback = NULL;
+  batch_tx_buffer_free = true;
+  zaf_transport_tx_frame_alloc_Stub(zaf_transport_tx_frame_alloc_batch_stub);
+  zaf_transport_tx_frame_send_Stub(zaf_transport_tx_frame_send_batch_stub);
+
+  memset(&tx_options, 0, sizeof(tx_options));
+  tx_options.dest_node_id = 1;
+  tx_options.source_endpoint = source_endpoint;
+  cb(&tx_options, pData);
+}
+
+static void batch_serve(zaf_tse_callback_t cb, void* pData)
+{
+  batch_serve_from_endpoint(cb, pData, 0);
+}
+
+static void batch_expected_report(uint8_t* report, const sensor_interface_t* sensor_interface, uint8_t value)
+{
+  report[0] = COMMAND_CLASS_SENSOR_MULTILEVEL_V11;
+  report[1] = SENSOR_MULTILEVEL_REPORT_V11;
+  report[2] = sensor_interface->sensor_type->value;
+  report[3] = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PRECISION << 5 |
+              SENSOR_SCALE_CELSIUS << 3                                 |
+              SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_SIZE;
+  report[4] = value;
+}
+
+/**
+ * Builds the Multi Command Encapsulation of the reports of the batch sensors
+ * from first to first + count - 1.
+ */
+static uint8_t batch_expected_encap(uint8_t* frame, uint8_t first, uint8_t count)
+{
+  const sensor_interface_t* sensor_interfaces[BATCH_SENSOR_COUNT] = {
+    &test_sensor_interface_A, &test_sensor_interface_B, &test_sensor_interface_C
+  };
+  const uint8_t values[BATCH_SENSOR_COUNT] = {
+    SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_CELSIUS,
+    SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PERCENTAGE,
+    SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_WATT
+  };
+  uint8_t length = 3;
+
+  frame[0] = COMMAND_CLASS_MULTI_CMD;
+  frame[1] = MULTI_CMD_ENCAP;
+  frame[2] = count;
+  for (uint8_t i = first; i < (first + count); i++)
+  {
+    frame[length++] = BATCH_REPORT_LENGTH;
+    batch_expected_report(&frame[length], sensor_interfaces[i], values[i]);
+    length += BATCH_REPORT_LENGTH;
+  }
+  return length;
+}
+
+/**
+ * All reports fit into one Multi Command Encapsulation. The TSE moves on to
+ * the next destination with the result of that frame.
+ */
+void test_cc_multilevel_sensor_batch_multi_cmd_encapsulation(void)
+{
+  mock_t* pMock = NULL;
+  SApplicationHandles app_handles;
+  SNetworkInfo network_info;
+  transmission_result_t tx_result;
+  uint8_t expected_frame[ZW_MAX_PAYLOAD_SIZE];
+  uint8_t expected_length;
+  void* pData;
+  mock_calls_clear();
+
+  multilevel_sensor_register_batch_for_test();
+  destination_supports_multi_cmd = true;
+
+  zaf_tse_callback_t cb = batch_trigger(&pData);
+  batch_expect_max_payload_size(&app_handles, &network_info, BATCH_SUPERVISION_LENGTH + BATCH_ENCAP_LENGTH(BATCH_SENSOR_COUNT));
+  batch_serve(cb, pData);
+
+  expected_length = batch_expected_encap(expected_frame, 0, BATCH_SENSOR_COUNT);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+  TEST_ASSERT_EQUAL_UINT8(expected_length, batch_frame_lengths[0]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, batch_frames[0], expected_length);
+  TEST_ASSERT_TRUE(batch_supervision);
+  TEST_ASSERT_NOT_NULL(batch_tx_callback);
+
+  mock_call_expect(TO_STR(ZAF_TSE_TXCallback), &pMock);
+  pMock->expect_arg[0].p = &tx_result;
+
+  batch_tx_callback(&tx_result);
+
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+  destination_supports_multi_cmd = false;
+  mock_calls_verify();
+}
+
+/**
+ * The reports that do not fit into MaxPayloadSize go into the next frame. A
+ * single report left over is sent without the encapsulation.
+ */
+void test_cc_multilevel_sensor_batch_size_limit(void)
+{
+  mock_t* pMock = NULL;
+  SApplicationHandles app_handles;
+  SNetworkInfo network_info;
+  transmission_result_t tx_result;
+  uint8_t expected_frame[ZW_MAX_PAYLOAD_SIZE];
+  uint8_t expected_length;
+  void* pData;
+  mock_calls_clear();
+
+  multilevel_sensor_register_batch_for_test();
+  destination_supports_multi_cmd = true;
+
+  // One octet short of all three reports.
+  zaf_tse_callback_t cb = batch_trigger(&pData);
+  batch_expect_max_payload_size(&app_handles, &network_info, BATCH_SUPERVISION_LENGTH + BATCH_ENCAP_LENGTH(BATCH_SENSOR_COUNT) - 1);
+  batch_serve(cb, pData);
+
+  expected_length = batch_expected_encap(expected_frame, 0, 2);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+  TEST_ASSERT_EQUAL_UINT8(expected_length, batch_frame_lengths[0]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, batch_frames[0], expected_length);
+
+  // The last report goes out alone, MaxPayloadSize is not needed for it.
+  batch_tx_callback(&tx_result);
+
+  batch_expected_encap(expected_frame, 2, 1);
+  TEST_ASSERT_EQUAL_UINT8(2, batch_frame_count);
+  TEST_ASSERT_EQUAL_UINT8(BATCH_REPORT_LENGTH, batch_frame_lengths[1]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(&expected_frame[4], batch_frames[1], BATCH_REPORT_LENGTH);
+  TEST_ASSERT_TRUE(batch_supervision);
+
+  mock_call_expect(TO_STR(ZAF_TSE_TXCallback), &pMock);
+  pMock->expect_arg[0].p = &tx_result;
+
+  batch_tx_callback(&tx_result);
+
+  TEST_ASSERT_EQUAL_UINT8(2, batch_frame_count);
+  destination_supports_multi_cmd = false;
+  mock_calls_verify();
+}
+
+/**
+ * The Supervision and Multi Channel headers the transport adds count against
+ * MaxPayloadSize. A batch sent from an endpoint that only just fits goes out
+ * in one frame, one octet less splits it.
+ */
+void test_cc_multilevel_sensor_batch_encapsulation_overhead(void)
+{
+  mock_t* pMock = NULL;
+  SApplicationHandles app_handles;
+  SNetworkInfo network_info;
+  transmission_result_t tx_result;
+  uint8_t expected_frame[ZW_MAX_PAYLOAD_SIZE];
+  uint8_t expected_length;
+  void* pData;
+  const uint16_t max_payload_size = BATCH_SUPERVISION_LENGTH +
+                                    BATCH_MULTI_CHANNEL_LENGTH +
+                                    BATCH_ENCAP_LENGTH(BATCH_SENSOR_COUNT);
+  mock_calls_clear();
+
+  multilevel_sensor_register_batch_for_test();
+  destination_supports_multi_cmd = true;
+
+  zaf_tse_callback_t cb = batch_trigger(&pData);
+  batch_expect_max_payload_size(&app_handles, &network_info, max_payload_size);
+  batch_serve_from_endpoint(cb, pData, 1);
+
+  expected_length = batch_expected_encap(expected_frame, 0, BATCH_SENSOR_COUNT);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+  TEST_ASSERT_EQUAL_UINT8(expected_length, batch_frame_lengths[0]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, batch_frames[0], expected_length);
+  TEST_ASSERT_TRUE(batch_supervision);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_source_endpoint);
+
+  mock_call_expect(TO_STR(ZAF_TSE_TXCallback), &pMock);
+  pMock->expect_arg[0].p = &tx_result;
+  batch_tx_callback(&tx_result);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+
+  cb = batch_trigger(&pData);
+  batch_expect_max_payload_size(&app_handles, &network_info, max_payload_size - 1);
+  batch_serve_from_endpoint(cb, pData, 1);
+
+  expected_length = batch_expected_encap(expected_frame, 0, 2);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+  TEST_ASSERT_EQUAL_UINT8(expected_length, batch_frame_lengths[0]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, batch_frames[0], expected_length);
+
+  batch_tx_callback(&tx_result);
+  TEST_ASSERT_EQUAL_UINT8(2, batch_frame_count);
+  TEST_ASSERT_EQUAL_UINT8(BATCH_REPORT_LENGTH, batch_frame_lengths[1]);
+
+  mock_call_expect(TO_STR(ZAF_TSE_TXCallback), &pMock);
+  pMock->expect_arg[0].p = &tx_result;
+  batch_tx_callback(&tx_result);
+
+  destination_supports_multi_cmd = false;
+  mock_calls_verify();
+}
+
+/**
+ * Without Multi Command support, or if not even two reports fit into one
+ * frame, every report is sent on its own, each from the callback of the
+ * previous one.
+ */
+void test_cc_multilevel_sensor_batch_per_report_fallback(void)
+{
+  mock_t* pMock = NULL;
+  SApplicationHandles app_handles;
+  SNetworkInfo network_info;
+  transmission_result_t tx_result;
+  uint8_t expected_frame[ZW_MAX_PAYLOAD_SIZE];
+  void* pData;
+  mock_calls_clear();
+
+  multilevel_sensor_register_batch_for_test();
+  batch_expected_encap(expected_frame, 0, BATCH_SENSOR_COUNT);
+
+  for (uint8_t supports_multi_cmd = 0; supports_multi_cmd < 2; supports_multi_cmd++)
+  {
+    destination_supports_multi_cmd = supports_multi_cmd;
+
+    zaf_tse_callback_t cb = batch_trigger(&pData);
+    if (destination_supports_multi_cmd)
+    {
+      // Room for one encapsulated report only.
+      batch_expect_max_payload_size(&app_handles, &network_info, BATCH_SUPERVISION_LENGTH + BATCH_ENCAP_LENGTH(2) - 1);
+    }
+    batch_serve(cb, pData);
+
+    for (uint8_t i = 0; i < BATCH_SENSOR_COUNT; i++)
+    {
+      TEST_ASSERT_EQUAL_UINT8(i + 1, batch_frame_count);
+      TEST_ASSERT_EQUAL_UINT8(BATCH_REPORT_LENGTH, batch_frame_lengths[i]);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(&expected_frame[4 + i * (1 + BATCH_REPORT_LENGTH)],
+                                    batch_frames[i],
+                                    BATCH_REPORT_LENGTH);
+
+      if (i == (BATCH_SENSOR_COUNT - 1))
+      {
+        mock_call_expect(TO_STR(ZAF_TSE_TXCallback), &pMock);
+        pMock->expect_arg[0].p = &tx_result;
+      }
+      else if (destination_supports_multi_cmd && (i < (BATCH_SENSOR_COUNT - 2)))
+      {
+        batch_expect_max_payload_size(&app_handles, &network_info, BATCH_SUPERVISION_LENGTH + BATCH_ENCAP_LENGTH(2) - 1);
+      }
+      batch_tx_callback(&tx_result);
+    }
+    TEST_ASSERT_EQUAL_UINT8(BATCH_SENSOR_COUNT, batch_frame_count);
+  }
+
+  destination_supports_multi_cmd = false;
+  mock_calls_verify();
+}
+
+/**
+ * When no transport buffer is free, the rest of the batch for this
+ * destination is dropped, and the TSE moves on.
+ */
+void test_cc_multilevel_sensor_batch_tx_refused(void)
+{
+  mock_t* pMock = NULL;
+  transmission_result_t tx_result;
+  void* pData;
+  mock_calls_clear();
+
+  multilevel_sensor_register_batch_for_test();
+
+  zaf_tse_callback_t cb = batch_trigger(&pData);
+  batch_serve(cb, pData);
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+
+  batch_tx_buffer_free = false;
+  mock_call_expect(TO_STR(ZAF_TSE_TXCallback), &pMock);
+  pMock->expect_arg[0].p = NULL;
+
+  batch_tx_callback(&tx_result);
+
+  TEST_ASSERT_EQUAL_UINT8(1, batch_frame_count);
+  mock_calls_verify();
+}
+
 // -----------------------------------------------------------------------------
 //              Static Function Definitions
 // -----------------------------------------------------------------------------
@@ -434,3 +891,43 @@ static void multilevel_sensor_register_interface_for_test(void)
 
   cc_multilevel_sensor_registration(&test_sensor_interface_A);
 }
+
+static bool sensor_interface_read_percentage(sensor_read_result_t* o_result, __attribute__((unused)) uint8_t i_scale)
+{
+  memset(o_result, 0, sizeof(sensor_read_result_t));
+  o_result->precision     = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PRECISION;
+  o_result->size_bytes    = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_SIZE;
+  o_result->raw_result[0] = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PERCENTAGE;
+  return true;
+}
+
+static bool sensor_interface_read_watt(sensor_read_result_t* o_result, __attribute__((unused)) uint8_t i_scale)
+{
+  memset(o_result, 0, sizeof(sensor_read_result_t));
+  o_result->precision     = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_PRECISION;
+  o_result->size_bytes    = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_SIZE;
+  o_result->raw_result[0] = SLI_TEST_CC_MULTILEVELSENSOR_SUPPORT_EXPECTED_WATT;
+  return true;
+}
+
+/**
+ * Registers three sensors whose reports all use scale 0 and a 1 byte value.
+ */
+static void multilevel_sensor_register_batch_for_test(void)
+{
+  multilevel_sensor_register_interface_for_test();
+
+  cc_multilevel_sensor_init_interface(&test_sensor_interface_B, SENSOR_NAME_HUMIDITY);
+  cc_multilevel_sensor_add_supported_scale_interface(&test_sensor_interface_B, SENSOR_SCALE_PERCENTAGE);
+  test_sensor_interface_B.init       = init_sensor_interface;
+  test_sensor_interface_B.deinit     = deinit_sensor_interface;
+  test_sensor_interface_B.read_value = sensor_interface_read_percentage;
+  cc_multilevel_sensor_registration(&test_sensor_interface_B);
+
+  cc_multilevel_sensor_init_interface(&test_sensor_interface_C, SENSOR_NAME_POWER);
+  cc_multilevel_sensor_add_supported_scale_interface(&test_sensor_interface_C, SENSOR_SCALE_WATT);
+  test_sensor_interface_C.init       = init_sensor_interface;
+  test_sensor_interface_C.deinit     = deinit_sensor_interface;
+  test_sensor_interface_C.read_value = sensor_interface_read_watt;
+  cc_multilevel_sensor_registration(&test_sensor_interface_C);
+}
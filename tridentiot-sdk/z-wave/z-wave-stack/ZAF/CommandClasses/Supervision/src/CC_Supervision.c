@@ -404,14 +404,17 @@ CmdClassSupervisionReportSend(
   cc_supervision_status_t status,
   uint8_t duration)
 {
-  ZW_APPLICATION_TX_BUFFER txBuf = {
-    .ZW_SupervisionReportFrame.cmdClass = COMMAND_CLASS_SUPERVISION,
-    .ZW_SupervisionReportFrame.cmd = SUPERVISION_REPORT,
-    .ZW_SupervisionReportFrame.properties1 = properties,
-    .ZW_SupervisionReportFrame.status = status,
-    .ZW_SupervisionReportFrame.duration = duration
-  };
-  return zaf_transport_tx((uint8_t *)&txBuf, sizeof(ZW_SUPERVISION_REPORT_FRAME), NULL, tx_options);
+  /* Build the report directly in a transport buffer to save the copy. */
+  ZW_APPLICATION_TX_BUFFER *pTxBuf = zaf_transport_tx_frame_alloc(tx_options->priority);
+  if (NULL == pTxBuf) {
+    return false;
+  }
+  pTxBuf->ZW_SupervisionReportFrame.cmdClass = COMMAND_CLASS_SUPERVISION;
+  pTxBuf->ZW_SupervisionReportFrame.cmd = SUPERVISION_REPORT;
+  pTxBuf->ZW_SupervisionReportFrame.properties1 = properties;
+  pTxBuf->ZW_SupervisionReportFrame.status = status;
+  pTxBuf->ZW_SupervisionReportFrame.duration = duration;
+  return zaf_transport_tx_frame_send(pTxBuf, sizeof(ZW_SUPERVISION_REPORT_FRAME), NULL, tx_options);
 }
 
 void CommandClassSupervisionGetAdd(ZW_SUPERVISION_GET_FRAME* pbuf)
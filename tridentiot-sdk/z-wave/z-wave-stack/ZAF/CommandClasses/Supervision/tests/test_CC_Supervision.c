@@ -73,6 +73,22 @@ static const uint8_t DURATION_TEST_VALUE = 10;
 static uint8_t howManyTimesWasGetHandled; // Remember to reset this before use.
 static uint8_t howManyTimesWasReportHandled;
 
+/* Transport buffer handed out by the zaf_transport_tx_frame_alloc() mock */
+static ZW_APPLICATION_TX_BUFFER tx_buffer;
+
+/**
+ * Expects a Supervision Report to be built in tx_buffer and sent. The priority comes from
+ * zaf_transport_rx_to_tx_options(), which is mocked, so it is not checked here.
+ */
+static void supervision_report_send_expect(void)
+{
+  memset(&tx_buffer, 0, sizeof(tx_buffer));
+  zaf_transport_tx_frame_alloc_ExpectAndReturn(ZAF_TRANSPORT_PRIORITY_HIGH, &tx_buffer);
+  zaf_transport_tx_frame_alloc_IgnoreArg_priority();
+  zaf_transport_tx_frame_send_ExpectAndReturn(&tx_buffer, SUPERVISION_REPORT_FRAME_SIZE, NULL, NULL, true);
+  zaf_transport_tx_frame_send_IgnoreArg_zaf_tx_options();
+}
+
 static RECEIVE_OPTIONS_TYPE_EX rxOpt;
 
 void GetReceivedHandler(SUPERVISION_GET_RECEIVED_HANDLER_ARGS * pArgs,
@@ -200,10 +216,10 @@ void test_receptionOfSupervisionGetSinglecast(void)
 
     uint8_t expected_frame[] = {0x6C, 0x02, sessionId, 0xff, 20};
 
-    zaf_transport_tx_ExpectAndReturn(expected_frame, SUPERVISION_REPORT_FRAME_SIZE, NULL, NULL, true);
-    zaf_transport_tx_IgnoreArg_zaf_tx_options();
+    supervision_report_send_expect();
 
     handleCommandClassSupervision(&rxOpt, (ZW_APPLICATION_TX_BUFFER *)pCmd, cmdLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, (uint8_t *)&tx_buffer, SUPERVISION_REPORT_FRAME_SIZE);
   }while(sessionId < runs);
 
   TEST_ASSERT_EQUAL_UINT8_MESSAGE(sessionId, howManyTimesWasGetHandled, "Error number of runs");
@@ -276,10 +292,10 @@ void test_receptionOfSupervisionGetSinglecast_no_CommandClassSupervisionInit(voi
 
     uint8_t expected_frame[] = {0x6C, 0x02, sessionId, 0xff, 0}; // CC:006C.01.01.11.006 check sessionId
 
-    zaf_transport_tx_ExpectAndReturn(expected_frame, SUPERVISION_REPORT_FRAME_SIZE, NULL, NULL, true);
-    zaf_transport_tx_IgnoreArg_zaf_tx_options();
+    supervision_report_send_expect();
 
     handleCommandClassSupervision(&rxOpt, (ZW_APPLICATION_TX_BUFFER *)pCmd, cmdLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, (uint8_t *)&tx_buffer, SUPERVISION_REPORT_FRAME_SIZE);
 
     /*Second single-cast discarded!*/
     handleCommandClassSupervision(&rxOpt, (ZW_APPLICATION_TX_BUFFER *)pCmd, cmdLength);
@@ -365,11 +381,11 @@ void test_receptionOfSupervisionGetMulticastAndSinglecast(void)
 
     uint8_t expected_frame[] = {0x6C, 0x02, sessionId, 0xff, 20};
 
-    zaf_transport_tx_ExpectAndReturn(expected_frame, SUPERVISION_REPORT_FRAME_SIZE, NULL, NULL, true);
-    zaf_transport_tx_IgnoreArg_zaf_tx_options();
+    supervision_report_send_expect();
 
     // Call the command handler second time - now with singlecast.
     handleCommandClassSupervision(&rxOpt, (ZW_APPLICATION_TX_BUFFER *)pCmd, cmdLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, (uint8_t *)&tx_buffer, SUPERVISION_REPORT_FRAME_SIZE);
 
     TEST_ASSERT_EQUAL_UINT8_MESSAGE(sessionId, howManyTimesWasGetHandled, "Get handler wasn't called :(");
 
@@ -454,11 +470,11 @@ void test_receptionOfSupervisionGetMulticastAndSinglecast_no_CommandClassSupervi
 
     uint8_t expected_frame[] = {0x6C, 0x02, sessionId, 0xff, 0};
 
-    zaf_transport_tx_ExpectAndReturn(expected_frame, SUPERVISION_REPORT_FRAME_SIZE, NULL, NULL, true);
-    zaf_transport_tx_IgnoreArg_zaf_tx_options();
+    supervision_report_send_expect();
 
     // Call the command handler second time - now with singlecast.
     handleCommandClassSupervision(&rxOpt, (ZW_APPLICATION_TX_BUFFER *)pCmd, cmdLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, (uint8_t *)&tx_buffer, SUPERVISION_REPORT_FRAME_SIZE);
 
   }while(sessionId < runs);
 
@@ -758,7 +774,8 @@ void test_CmdClassSupervisionReportSend(void)
   tx_options.dest_endpoint = 0;
   tx_options.dest_node_id = 2;
   tx_options.security_key = 0;
-  
+  tx_options.priority = ZAF_TRANSPORT_PRIORITY_HIGH;
+
   properties = CC_SUPERVISION_ADD_MORE_STATUS_UPDATE(0) | CC_SUPERVISION_ADD_SESSION_ID(0x3F);
   status = CC_SUPERVISION_STATUS_SUCCESS;
   duration = 0xff;
@@ -771,12 +788,14 @@ void test_CmdClassSupervisionReportSend(void)
       duration
   };
 
-  zaf_transport_tx_ExpectAndReturn(expectedFrame, sizeof(expectedFrame), NULL, NULL, true);
-  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+  zaf_transport_tx_frame_alloc_ExpectAndReturn(ZAF_TRANSPORT_PRIORITY_HIGH, &tx_buffer);
+  zaf_transport_tx_frame_send_ExpectAndReturn(&tx_buffer, sizeof(expectedFrame), NULL, NULL, true);
+  zaf_transport_tx_frame_send_IgnoreArg_zaf_tx_options();
 
   TEST_ASSERT_TRUE_MESSAGE(
       CmdClassSupervisionReportSend(&tx_options, properties, status, duration ),
       "Command job CmdClassSupervisionReportSend failed");
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedFrame, (uint8_t *)&tx_buffer, sizeof(expectedFrame));
 
   properties = CC_SUPERVISION_ADD_MORE_STATUS_UPDATE(1) | CC_SUPERVISION_ADD_SESSION_ID(1);
   status = CC_SUPERVISION_STATUS_SUCCESS;
@@ -790,12 +809,14 @@ void test_CmdClassSupervisionReportSend(void)
       duration
   };
 
-  zaf_transport_tx_ExpectAndReturn(expectedFrame2, sizeof(expectedFrame2), NULL, NULL, true);
-  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+  zaf_transport_tx_frame_alloc_ExpectAndReturn(ZAF_TRANSPORT_PRIORITY_HIGH, &tx_buffer);
+  zaf_transport_tx_frame_send_ExpectAndReturn(&tx_buffer, sizeof(expectedFrame2), NULL, NULL, true);
+  zaf_transport_tx_frame_send_IgnoreArg_zaf_tx_options();
 
   TEST_ASSERT_TRUE_MESSAGE(
       CmdClassSupervisionReportSend(&tx_options, properties, status, duration ),
       "Command job CmdClassSupervisionReportSend failed");
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedFrame2, (uint8_t *)&tx_buffer, sizeof(expectedFrame2));
 
   mock_calls_verify();
 }
@@ -957,10 +978,10 @@ void test_CC_Get__Report_Supervision_fail_report(void)
 
   uint8_t expected_frame[] = {0x6C, 0x02, sessionId, CC_SUPERVISION_STATUS_FAIL, 00};
 
-  zaf_transport_tx_ExpectAndReturn(expected_frame, SUPERVISION_REPORT_FRAME_SIZE, NULL, NULL, true);
-  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+  supervision_report_send_expect();
 
   handleCommandClassSupervision(&rxOpt, (ZW_APPLICATION_TX_BUFFER *)pCmd, cmdLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_frame, (uint8_t *)&tx_buffer, SUPERVISION_REPORT_FRAME_SIZE);
   mock_calls_verify();
 }
 
@@ -1064,11 +1085,7 @@ void test_SUPERVISION_GET_ignore_identical_session_ids(void)
       zaf_transport_rx_to_tx_options_IgnoreArg_rx_options();
       zaf_transport_rx_to_tx_options_IgnoreArg_tx_options();
 
-      zaf_transport_tx_ExpectAndReturn(NULL, 0, NULL, NULL, true);
-      zaf_transport_tx_IgnoreArg_frame();
-      zaf_transport_tx_IgnoreArg_frame_length();
-      zaf_transport_tx_IgnoreArg_callback();
-      zaf_transport_tx_IgnoreArg_zaf_tx_options();
+      supervision_report_send_expect();
     }
 
     received_frame_status_t status;
@@ -1188,11 +1205,7 @@ void test_SUPERVISION_GET_no_response_to_followup_after_broadcast(void)
       zaf_transport_rx_to_tx_options_IgnoreArg_rx_options();
       zaf_transport_rx_to_tx_options_IgnoreArg_tx_options();
 
-      zaf_transport_tx_ExpectAndReturn(NULL, 0, NULL, NULL, true);
-      zaf_transport_tx_IgnoreArg_frame();
-      zaf_transport_tx_IgnoreArg_frame_length();
-      zaf_transport_tx_IgnoreArg_callback();
-      zaf_transport_tx_IgnoreArg_zaf_tx_options();
+      supervision_report_send_expect();
     }
 
     received_frame_status_t status;
@@ -1275,15 +1288,14 @@ void test_SUPERVISION_GET_command_handler_status_fail(void)
       2, // Status = FAIL
       0 // Duration
   };
-  zaf_transport_tx_ExpectAndReturn(EXPECTED_FRAME, sizeof(EXPECTED_FRAME), NULL, NULL, true);
-  zaf_transport_tx_IgnoreArg_callback();
-  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+  supervision_report_send_expect();
 
   received_frame_status_t status;
   status = handleCommandClassSupervision(
       &chi_supervision_get.rxOptions,
       &chi_supervision_get.frame.as_zw_application_tx_buffer,
       chi_supervision_get.frameLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_FRAME, (uint8_t *)&tx_buffer, sizeof(EXPECTED_FRAME));
   TEST_ASSERT_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS == status, "Wrong receive status :(");
 
   mock_calls_verify();
@@ -1356,15 +1368,14 @@ void test_SUPERVISION_GET_cc_not_supported(void)
       CC_SUPERVISION_STATUS_NOT_SUPPORTED,
       0 // Duration
   };
-  zaf_transport_tx_ExpectAndReturn(EXPECTED_FRAME, sizeof(EXPECTED_FRAME), NULL, NULL, true);
-  zaf_transport_tx_IgnoreArg_callback();
-  zaf_transport_tx_IgnoreArg_zaf_tx_options();
+  supervision_report_send_expect();
 
   received_frame_status_t status;
   status = handleCommandClassSupervision(
       &chi_supervision_get.rxOptions,
       &chi_supervision_get.frame.as_zw_application_tx_buffer,
       chi_supervision_get.frameLength);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED_FRAME, (uint8_t *)&tx_buffer, sizeof(EXPECTED_FRAME));
 
   TEST_ASSERT_MESSAGE(RECEIVED_FRAME_STATUS_SUCCESS == status, "Wrong receive status :(");
   TEST_ASSERT_FALSE_MESSAGE(SUPERVISION_GET_cc_not_supported_was_called, "The Supervision Get handler was called!");
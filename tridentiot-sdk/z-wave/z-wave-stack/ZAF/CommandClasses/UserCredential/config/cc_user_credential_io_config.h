@@ -49,6 +49,16 @@
 #define U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS  20
 #endif /* !defined(U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS) */
 
+/**
+ * [SoC NVM driver] Credential index size <0..65534:1>
+ *
+ * Number of Credentials held in the RAM index used for finding duplicate Credentials.
+ * If the database holds more Credentials, duplicates are searched in NVM. 0 disables the index.
+ */
+#if !defined(U3C_CREDENTIAL_INDEX_SIZE)
+#define U3C_CREDENTIAL_INDEX_SIZE  20
+#endif /* !defined(U3C_CREDENTIAL_INDEX_SIZE) */
+
 /**@}*/ /* \addtogroup command_class_user_credential_io_configuration */
 
 /**@}*/ /* \addtogroup configuration */
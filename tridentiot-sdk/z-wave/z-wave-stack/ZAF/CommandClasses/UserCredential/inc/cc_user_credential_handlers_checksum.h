@@ -15,6 +15,7 @@
 #define CC_USER_CREDENTIAL_HANDLERS_CHECKSUM_H
 
 #include "CC_UserCredential.h"
+#include "cc_user_credential_io.h"
 #include "zaf_transport_tx.h"
 
 /**
@@ -47,4 +48,65 @@ received_frame_status_t CC_UserCredential_CredentialChecksumGet_handler(
   const cc_handler_input_t * input
   );
 
+/**
+ * @brief Clears the cached checksums.
+ *
+ * The checksums are cached only if the database reports every change through
+ * @ref CC_UserCredential_checksum_invalidate_user and
+ * @ref CC_UserCredential_checksum_invalidate_credential. Otherwise they are
+ * calculated from the database on every request.
+ *
+ * @param[in] enable true if the database reports its changes.
+ */
+void CC_UserCredential_checksum_cache_reset(bool enable);
+
+/**
+ * @brief Invalidates the checksums covering a User.
+ *
+ * Must be called when a User is added, modified or deleted.
+ *
+ * @param[in] uuid User Unique Identifier of the changed User.
+ */
+void CC_UserCredential_checksum_invalidate_user(uint16_t uuid);
+
+/**
+ * @brief Invalidates the checksums covering a Credential.
+ *
+ * Must be called when a Credential is added, modified, deleted or moved
+ * (for both the source and the destination User).
+ *
+ * @param[in] type Type of the changed Credential.
+ * @param[in] uuid User Unique Identifier of the User owning the Credential.
+ */
+void CC_UserCredential_checksum_invalidate_credential(
+  u3c_credential_type type, uint16_t uuid);
+
+/**
+ * @brief Gets the checksum of all Users and their Credentials.
+ *
+ * @param[out] checksum The checksum, 0 if there are no Users.
+ * @return U3C_DB_OPERATION_RESULT_SUCCESS or U3C_DB_OPERATION_RESULT_ERROR.
+ */
+u3c_db_operation_result CC_UserCredential_get_all_users_checksum(uint16_t * checksum);
+
+/**
+ * @brief Gets the checksum of a User and its Credentials.
+ *
+ * @param[in] uuid User Unique Identifier.
+ * @param[out] checksum The checksum, 0 if the User does not exist.
+ * @return The result of reading the User from the database.
+ */
+u3c_db_operation_result CC_UserCredential_get_user_checksum(
+  uint16_t uuid, uint16_t * checksum);
+
+/**
+ * @brief Gets the checksum of all Credentials of a type.
+ *
+ * @param[in] type Credential Type.
+ * @param[out] checksum The checksum, 0 if there are no Credentials of the type.
+ * @return U3C_DB_OPERATION_RESULT_SUCCESS or U3C_DB_OPERATION_RESULT_ERROR.
+ */
+u3c_db_operation_result CC_UserCredential_get_credential_checksum(
+  u3c_credential_type type, uint16_t * checksum);
+
 #endif // CC_USER_CREDENTIAL_HANDLERS_CHECKSUM_H
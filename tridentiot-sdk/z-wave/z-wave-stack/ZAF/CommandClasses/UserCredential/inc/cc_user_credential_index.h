@@ -0,0 +1,88 @@
+/**
+ * @file
+ * RAM index of the Credentials for Command Class User Credential.
+ *
+ * @details The index maps the type and a digest of the data of each Credential
+ * to its slot. It lets @ref find_existing_credential find a duplicate Credential
+ * with one lookup and one read of the database, instead of reading every
+ * Credential of the type.
+ *
+ * The index can only be used with a database implementation that reports every
+ * change of a Credential. It is built when the database is loaded, see
+ * @ref CC_UserCredential_index_reset.
+ *
+ * @copyright 2024 Silicon Laboratories Inc.
+ */
+
+#ifndef CC_USER_CREDENTIAL_INDEX_H
+#define CC_USER_CREDENTIAL_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "CC_UserCredential.h"
+
+/**
+ * Empties the index.
+ *
+ * @param[in] enable true if the database adds all its Credentials to the index
+ *                   and reports every change of them.
+ */
+void CC_UserCredential_index_reset(bool enable);
+
+/**
+ * Marks the index as not holding every Credential of the database, e.g. after
+ * a failed write. The database must be searched until the index is reset.
+ */
+void CC_UserCredential_index_invalidate(void);
+
+/**
+ * Adds a Credential to the index, or updates its data if the slot is indexed.
+ *
+ * @param[in] type   Credential Type.
+ * @param[in] slot   Credential Slot.
+ * @param[in] p_data Credential data.
+ * @param[in] length Length of the Credential data.
+ */
+void CC_UserCredential_index_add(
+  u3c_credential_type type, uint16_t slot, const uint8_t * p_data,
+  uint8_t length);
+
+/**
+ * Removes a Credential from the index.
+ *
+ * @param[in] type Credential Type.
+ * @param[in] slot Credential Slot.
+ */
+void CC_UserCredential_index_remove(u3c_credential_type type, uint16_t slot);
+
+/**
+ * Updates the slot of a moved Credential.
+ *
+ * @param[in] type             Credential Type.
+ * @param[in] source_slot      Credential Slot before the move.
+ * @param[in] destination_slot Credential Slot after the move.
+ */
+void CC_UserCredential_index_move(
+  u3c_credential_type type, uint16_t source_slot, uint16_t destination_slot);
+
+/**
+ * @return true if the index holds every Credential of the database.
+ */
+bool CC_UserCredential_index_is_complete(void);
+
+/**
+ * Finds the indexed Credentials that may have the same type and data as a
+ * given Credential. Different data can have the same digest, so the data of
+ * each result must be compared.
+ *
+ * @param[in]     p_credential Credential to look for.
+ * @param[in,out] p_position   Position of the search. Must be 0 on the first call.
+ * @param[out]    p_slot       Slot of the next possible match.
+ *
+ * @return true if a possible match was found.
+ */
+bool CC_UserCredential_index_find_next(
+  const u3c_credential_t * const p_credential, uint16_t * p_position,
+  uint16_t * p_slot);
+
+#endif // CC_USER_CREDENTIAL_INDEX_H
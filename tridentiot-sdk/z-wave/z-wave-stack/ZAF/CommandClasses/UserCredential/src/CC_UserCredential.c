@@ -16,6 +16,7 @@
 #include "cc_user_credential_handlers_capabilities.h"
 #include "cc_user_credential_handlers_checksum.h"
 #include "cc_user_credential_handlers_database.h"
+#include "cc_user_credential_index.h"
 #include "CC_Notification.h"
 #include "zaf_event_distributor_soc.h"
 #include "Assert.h"
@@ -34,12 +35,21 @@ STATIC_ASSERT(U3C_CREDENTIAL_TYPE_PIN_CODE_MAX_LENGTH_REQUIREMENT >= AC_MAX_LENG
 
 static void init(void)
 {
+  /**
+   * Checksums are calculated and duplicate Credentials are searched in the
+   * database on every request, unless the database enables the checksum cache
+   * and the Credential index while it initializes.
+   */
+  CC_UserCredential_checksum_cache_reset(false);
+  CC_UserCredential_index_reset(false);
   CC_UserCredential_init_database();
   credential_learn_reset();
 }
 
 static void reset(void)
 {
+  CC_UserCredential_checksum_cache_reset(false);
+  CC_UserCredential_index_reset(false);
   CC_UserCredential_factory_reset();
 }
 
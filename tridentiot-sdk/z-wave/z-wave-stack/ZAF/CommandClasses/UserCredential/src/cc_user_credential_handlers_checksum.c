@@ -12,8 +12,39 @@
 #include "cc_user_credential_io_config.h"
 #include "cc_user_credential_io.h"
 #include "cc_user_credential_tx.h"
+#include <string.h>
+#include "Assert.h"
 #include "CRC.h" // CC:0083.01.15.11.000 & CC:0083.01.17.11.000 & CC:0083.01.19.11.001
 
+/****************************************************************************/
+/*                             STATIC VARIABLES                             */
+/****************************************************************************/
+
+/**
+ * Checksum of a User, valid until the User or one of its Credentials changes.
+ */
+typedef struct user_checksum_t_ {
+  uint16_t uuid; ///< 0 if the entry is free
+  uint16_t checksum;
+} user_checksum_t;
+
+/**
+ * Checksums calculated since the last change of the data they cover.
+ *
+ * The checksums can only be cached with a database implementation that
+ * reports every change it makes, see @ref CC_UserCredential_checksum_cache_reset.
+ * Otherwise every checksum is calculated from the database.
+ */
+static bool is_cache_enabled = false;
+static bool is_all_users_checksum_valid = false;
+static uint16_t all_users_checksum = 0;
+static user_checksum_t user_checksums[U3C_BUFFER_SIZE_USER_DESCRIPTORS];
+static uint32_t valid_credential_checksums = 0; // One bit per Credential Type
+static uint16_t credential_checksums[CREDENTIAL_TYPE_NUMBER_OF_TYPES];
+
+STATIC_ASSERT(CREDENTIAL_TYPE_NUMBER_OF_TYPES <= 32,
+              valid_credential_checksums_must_have_a_bit_per_credential_type);
+
 /****************************************************************************/
 /*                             PRIVATE FUNCTIONS                            */
 /****************************************************************************/
@@ -59,35 +90,22 @@ static void calculate_credentials_checksum_for_uuid(
   }
 }
 
-/****************************************************************************/
-/*                             PUBLIC FUNCTIONS                             */
-/****************************************************************************/
-
-ZW_WEAK received_frame_status_t CC_UserCredential_AllUsersChecksumGet_handler(const cc_handler_input_t * input)
+static u3c_db_operation_result calculate_all_users_checksum(uint16_t * checksum)
 {
-  /**
-   * This command MUST be ignored by a node advertising no support for the All Users Checksum
-   * functionality in the User Capabilities Report Command.
-   * CC:0083.01.14.11.000
-   */
-  if (!cc_user_credential_is_all_users_checksum_supported()) {
-    return RECEIVED_FRAME_STATUS_NO_SUPPORT;
-  }
-
   u3c_user_t user = { 0 };
   uint8_t name[UINT8_MAX] = { 0 };
   uint8_t uuid_msb = 0;
   uint8_t uuid_lsb = 0;
   bool user_is_available = false;
 
-  uint16_t checksum = CRC_INITAL_VALUE; // CC:0083.01.15.11.000
+  *checksum = CRC_INITAL_VALUE; // CC:0083.01.15.11.000
   uint16_t user_uid = CC_UserCredential_get_next_user(0);
 
   while (user_uid) {
     user_is_available = true;
     if (CC_UserCredential_get_user(user_uid, &user, name) != U3C_DB_OPERATION_RESULT_SUCCESS) {
       // Driver error or database corruption
-      return RECEIVED_FRAME_STATUS_FAIL;
+      return U3C_DB_OPERATION_RESULT_ERROR;
     } else {
       /**
        * User Unique Identifier (16 bits) | User Type (8 bits) | User Active State (8 bits) |
@@ -98,16 +116,16 @@ ZW_WEAK received_frame_status_t CC_UserCredential_AllUsersChecksumGet_handler(co
        */
       uuid_msb = (user_uid >> 8);
       uuid_lsb = user_uid & 0xFF;
-      checksum = CRC_CheckCrc16(checksum, &uuid_msb, 1);
-      checksum = CRC_CheckCrc16(checksum, &uuid_lsb, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.type, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.active, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.credential_rule, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.name_encoding, 1);
-      checksum = CRC_CheckCrc16(checksum, &user.name_length, 1);
-      checksum = CRC_CheckCrc16(checksum, name, user.name_length);
-
-      calculate_credentials_checksum_for_uuid(user_uid, &checksum);
+      *checksum = CRC_CheckCrc16(*checksum, &uuid_msb, 1);
+      *checksum = CRC_CheckCrc16(*checksum, &uuid_lsb, 1);
+      *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.type, 1);
+      *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.active, 1);
+      *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.credential_rule, 1);
+      *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.name_encoding, 1);
+      *checksum = CRC_CheckCrc16(*checksum, &user.name_length, 1);
+      *checksum = CRC_CheckCrc16(*checksum, name, user.name_length);
+
+      calculate_credentials_checksum_for_uuid(user_uid, checksum);
     }
     user_uid = CC_UserCredential_get_next_user(user_uid);
   }
@@ -117,35 +135,18 @@ ZW_WEAK received_frame_status_t CC_UserCredential_AllUsersChecksumGet_handler(co
    * the checksum MUST be set to 0x0000.
    * CC:0083.01.15.11.006
    */
-  checksum = user_is_available ? checksum : 0;
-
-  /**
-   * All Users Checksum Report command must be returned if this functionality is supported.
-   * CC:0083.01.14.11.001
-   */
-  CC_UserCredential_AllUsersChecksumReport_tx(checksum, input->rx_options);
+  *checksum = user_is_available ? *checksum : 0;
 
-  return RECEIVED_FRAME_STATUS_SUCCESS;
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
 }
 
-ZW_WEAK received_frame_status_t CC_UserCredential_UserChecksumGet_handler(const cc_handler_input_t * input)
+static u3c_db_operation_result calculate_user_checksum(
+  uint16_t uuid, uint16_t * checksum)
 {
-  /**
-   * This command MUST be ignored by a node advertising no support for the User Checksum functionality
-   * in the User Capabilities Report Command.
-   * CC:0083.01.16.11.000
-   */
-  if (!cc_user_credential_is_user_checksum_supported()) {
-    return RECEIVED_FRAME_STATUS_NO_SUPPORT;
-  }
-
   u3c_user_t user = { 0 };
   uint8_t name[UINT8_MAX] = { 0 };
 
-  uint16_t uuid = (uint16_t)(input->frame->ZW_UserChecksumGetFrame.userUniqueIdentifier1 << 8
-                             | input->frame->ZW_UserChecksumGetFrame.userUniqueIdentifier2);
-
-  uint16_t checksum = CRC_INITAL_VALUE; // CC:0083.01.17.11.000
+  *checksum = CRC_INITAL_VALUE; // CC:0083.01.17.11.000
 
   u3c_db_operation_result result = CC_UserCredential_get_user(uuid, &user, name);
 
@@ -156,57 +157,40 @@ ZW_WEAK received_frame_status_t CC_UserCredential_UserChecksumGet_handler(const
      * CC:0083.01.17.11.001
      * CC:0083.01.17.11.002
      */
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.type, 1);
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.active, 1);
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.credential_rule, 1);
-    checksum = CRC_CheckCrc16(checksum, (uint8_t*)&user.name_encoding, 1);
-    checksum = CRC_CheckCrc16(checksum, &user.name_length, 1); // CC:0083.01.17.11.004
-    checksum = CRC_CheckCrc16(checksum, name, user.name_length);
-
-    calculate_credentials_checksum_for_uuid(uuid, &checksum);
+    *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.type, 1);
+    *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.active, 1);
+    *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.credential_rule, 1);
+    *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)&user.name_encoding, 1);
+    *checksum = CRC_CheckCrc16(*checksum, &user.name_length, 1); // CC:0083.01.17.11.004
+    *checksum = CRC_CheckCrc16(*checksum, name, user.name_length);
+
+    calculate_credentials_checksum_for_uuid(uuid, checksum);
   } else if (result == U3C_DB_OPERATION_RESULT_FAIL_DNE) {
     /**
      * If there is no User data (and thus no Credentials data) set at the node for a User Unique Identifier,
      * the checksum MUST be set to 0x0000.
      * CC:0083.01.17.11.006
      */
-    checksum = 0;
-  } else {
-    // Driver error or database corruption
-    return RECEIVED_FRAME_STATUS_FAIL;
+    *checksum = 0;
   }
 
-  /**
-   * User Checksum Report command must be returned if this functionality is supported.
-   * CC:0083.01.16.11.001
-   */
-  CC_UserCredential_UserChecksumReport_tx(uuid, checksum, input->rx_options);
-
-  return RECEIVED_FRAME_STATUS_SUCCESS;
+  return result;
 }
 
-ZW_WEAK received_frame_status_t CC_UserCredential_CredentialChecksumGet_handler(const cc_handler_input_t * input)
+static u3c_db_operation_result calculate_credential_checksum(
+  u3c_credential_type searched_type, uint16_t * checksum)
 {
-  /**
-   * This command MUST be ignored by a node advertising no support for the Credential Checksum
-   * functionality in the Credential Capabilities Report Command.
-   * CC:0083.01.18.11.000
-   */
-  if (!cc_user_credential_is_credential_checksum_supported()) {
-    return RECEIVED_FRAME_STATUS_NO_SUPPORT;
-  }
-
-  u3c_credential_type searched_type = input->frame->ZW_CredentialChecksumGetFrame.credentialType;
   uint16_t next_slot = 0;
   uint8_t next_slot_msb = 0;
   uint8_t next_slot_lsb = 0;
   u3c_credential_type next_type = CREDENTIAL_TYPE_NONE;
-  uint16_t checksum = CRC_INITAL_VALUE; // CC:0083.01.19.11.001
   bool credential_is_available = false;
 
   u3c_credential_metadata_t metadata = { 0 };
   uint8_t e_data[U3C_BUFFER_SIZE_CREDENTIAL_DATA] = { 0 };
 
+  *checksum = CRC_INITAL_VALUE; // CC:0083.01.19.11.001
+
   while (CC_UserCredential_get_next_credential(0, searched_type, next_slot, &next_type, &next_slot)) {
     /**
      * Credential Slot (16 bits) | Credential Length (8 bits) |
@@ -223,13 +207,13 @@ ZW_WEAK received_frame_status_t CC_UserCredential_CredentialChecksumGet_handler(
       next_slot_msb = next_slot >> 8;
       next_slot_lsb = next_slot & 0xFF;
 
-      checksum = CRC_CheckCrc16(checksum, &next_slot_msb, 1);
-      checksum = CRC_CheckCrc16(checksum, &next_slot_lsb, 1);
-      checksum = CRC_CheckCrc16(checksum, &metadata.length, 1);
-      checksum = CRC_CheckCrc16(checksum, (uint8_t*)e_data, metadata.length);
+      *checksum = CRC_CheckCrc16(*checksum, &next_slot_msb, 1);
+      *checksum = CRC_CheckCrc16(*checksum, &next_slot_lsb, 1);
+      *checksum = CRC_CheckCrc16(*checksum, &metadata.length, 1);
+      *checksum = CRC_CheckCrc16(*checksum, (uint8_t*)e_data, metadata.length);
     } else {
       // Driver error or database corruption
-      return RECEIVED_FRAME_STATUS_FAIL;
+      return U3C_DB_OPERATION_RESULT_ERROR;
     }
   }
 
@@ -238,7 +222,190 @@ ZW_WEAK received_frame_status_t CC_UserCredential_CredentialChecksumGet_handler(
    * set to 0x0000.
    * CC:0083.01.19.11.006
    */
-  checksum = credential_is_available ? checksum : 0;
+  *checksum = credential_is_available ? *checksum : 0;
+
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
+}
+
+static user_checksum_t * find_user_checksum(uint16_t uuid)
+{
+  for (uint16_t i = 0; i < U3C_BUFFER_SIZE_USER_DESCRIPTORS; ++i) {
+    if (user_checksums[i].uuid == uuid) {
+      return &user_checksums[i];
+    }
+  }
+  return NULL;
+}
+
+/****************************************************************************/
+/*                             PUBLIC FUNCTIONS                             */
+/****************************************************************************/
+
+void CC_UserCredential_checksum_cache_reset(bool enable)
+{
+  is_cache_enabled = enable;
+  is_all_users_checksum_valid = false;
+  valid_credential_checksums = 0;
+  memset(user_checksums, 0, sizeof(user_checksums));
+}
+
+void CC_UserCredential_checksum_invalidate_user(uint16_t uuid)
+{
+  is_all_users_checksum_valid = false;
+
+  user_checksum_t * p_entry = find_user_checksum(uuid);
+  if (p_entry && uuid) {
+    p_entry->uuid = 0;
+  }
+}
+
+void CC_UserCredential_checksum_invalidate_credential(
+  u3c_credential_type type, uint16_t uuid)
+{
+  if (type < CREDENTIAL_TYPE_NUMBER_OF_TYPES) {
+    valid_credential_checksums &= ~((uint32_t)1 << type);
+  } else {
+    valid_credential_checksums = 0;
+  }
+  CC_UserCredential_checksum_invalidate_user(uuid);
+}
+
+u3c_db_operation_result CC_UserCredential_get_all_users_checksum(uint16_t * checksum)
+{
+  if (is_cache_enabled && is_all_users_checksum_valid) {
+    *checksum = all_users_checksum;
+    return U3C_DB_OPERATION_RESULT_SUCCESS;
+  }
+
+  u3c_db_operation_result result = calculate_all_users_checksum(checksum);
+  if (is_cache_enabled && (result == U3C_DB_OPERATION_RESULT_SUCCESS)) {
+    all_users_checksum = *checksum;
+    is_all_users_checksum_valid = true;
+  }
+  return result;
+}
+
+u3c_db_operation_result CC_UserCredential_get_user_checksum(
+  uint16_t uuid, uint16_t * checksum)
+{
+  user_checksum_t * p_entry = NULL;
+
+  if (is_cache_enabled && uuid) {
+    p_entry = find_user_checksum(uuid);
+    if (p_entry) {
+      *checksum = p_entry->checksum;
+      return U3C_DB_OPERATION_RESULT_SUCCESS;
+    }
+  }
+
+  u3c_db_operation_result result = calculate_user_checksum(uuid, checksum);
+  if (is_cache_enabled && uuid && (result == U3C_DB_OPERATION_RESULT_SUCCESS)) {
+    // There is an entry for every User the database can hold.
+    p_entry = find_user_checksum(0);
+    if (p_entry) {
+      p_entry->uuid = uuid;
+      p_entry->checksum = *checksum;
+    }
+  }
+  return result;
+}
+
+u3c_db_operation_result CC_UserCredential_get_credential_checksum(
+  u3c_credential_type type, uint16_t * checksum)
+{
+  bool is_cacheable = is_cache_enabled && (type < CREDENTIAL_TYPE_NUMBER_OF_TYPES);
+
+  if (is_cacheable && (valid_credential_checksums & ((uint32_t)1 << type))) {
+    *checksum = credential_checksums[type];
+    return U3C_DB_OPERATION_RESULT_SUCCESS;
+  }
+
+  u3c_db_operation_result result = calculate_credential_checksum(type, checksum);
+  if (is_cacheable && (result == U3C_DB_OPERATION_RESULT_SUCCESS)) {
+    credential_checksums[type] = *checksum;
+    valid_credential_checksums |= ((uint32_t)1 << type);
+  }
+  return result;
+}
+
+ZW_WEAK received_frame_status_t CC_UserCredential_AllUsersChecksumGet_handler(const cc_handler_input_t * input)
+{
+  /**
+   * This command MUST be ignored by a node advertising no support for the All Users Checksum
+   * functionality in the User Capabilities Report Command.
+   * CC:0083.01.14.11.000
+   */
+  if (!cc_user_credential_is_all_users_checksum_supported()) {
+    return RECEIVED_FRAME_STATUS_NO_SUPPORT;
+  }
+
+  uint16_t checksum = 0;
+
+  if (CC_UserCredential_get_all_users_checksum(&checksum) != U3C_DB_OPERATION_RESULT_SUCCESS) {
+    // Driver error or database corruption
+    return RECEIVED_FRAME_STATUS_FAIL;
+  }
+
+  /**
+   * All Users Checksum Report command must be returned if this functionality is supported.
+   * CC:0083.01.14.11.001
+   */
+  CC_UserCredential_AllUsersChecksumReport_tx(checksum, input->rx_options);
+
+  return RECEIVED_FRAME_STATUS_SUCCESS;
+}
+
+ZW_WEAK received_frame_status_t CC_UserCredential_UserChecksumGet_handler(const cc_handler_input_t * input)
+{
+  /**
+   * This command MUST be ignored by a node advertising no support for the User Checksum functionality
+   * in the User Capabilities Report Command.
+   * CC:0083.01.16.11.000
+   */
+  if (!cc_user_credential_is_user_checksum_supported()) {
+    return RECEIVED_FRAME_STATUS_NO_SUPPORT;
+  }
+
+  uint16_t uuid = (uint16_t)(input->frame->ZW_UserChecksumGetFrame.userUniqueIdentifier1 << 8
+                             | input->frame->ZW_UserChecksumGetFrame.userUniqueIdentifier2);
+
+  uint16_t checksum = 0;
+
+  u3c_db_operation_result result = CC_UserCredential_get_user_checksum(uuid, &checksum);
+
+  if ((result != U3C_DB_OPERATION_RESULT_SUCCESS)
+      && (result != U3C_DB_OPERATION_RESULT_FAIL_DNE)) {
+    // Driver error or database corruption
+    return RECEIVED_FRAME_STATUS_FAIL;
+  }
+
+  /**
+   * User Checksum Report command must be returned if this functionality is supported.
+   * CC:0083.01.16.11.001
+   */
+  CC_UserCredential_UserChecksumReport_tx(uuid, checksum, input->rx_options);
+
+  return RECEIVED_FRAME_STATUS_SUCCESS;
+}
+
+ZW_WEAK received_frame_status_t CC_UserCredential_CredentialChecksumGet_handler(const cc_handler_input_t * input)
+{
+  /**
+   * This command MUST be ignored by a node advertising no support for the Credential Checksum
+   * functionality in the Credential Capabilities Report Command.
+   * CC:0083.01.18.11.000
+   */
+  if (!cc_user_credential_is_credential_checksum_supported()) {
+    return RECEIVED_FRAME_STATUS_NO_SUPPORT;
+  }
+
+  u3c_credential_type searched_type = input->frame->ZW_CredentialChecksumGetFrame.credentialType;
+  uint16_t checksum = 0;
+
+  if (CC_UserCredential_get_credential_checksum(searched_type, &checksum) != U3C_DB_OPERATION_RESULT_SUCCESS) {
+    // Driver error or database corruption
+    return RECEIVED_FRAME_STATUS_FAIL;
+  }
 
   /**
    * Credential Checksum Report command must be returned if this functionality is supported.
@@ -0,0 +1,235 @@
+/**
+ * @file
+ * @brief RAM index of the Credentials for Command Class User Credential.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SPDX-FileCopyrightText: 2024 Silicon Laboratories Inc.
+ */
+
+#include "cc_user_credential_index.h"
+#include "cc_user_credential_io_config.h"
+#include "CRC.h"
+
+#if (0 < U3C_CREDENTIAL_INDEX_SIZE)
+
+/****************************************************************************/
+/*                          CONSTANTS and TYPEDEFS                          */
+/****************************************************************************/
+
+#define INDEX_END  UINT16_MAX
+
+/**
+ * Indexed Credential, chained to the other Credentials in the same bucket.
+ */
+typedef struct index_entry_t_ {
+  uint16_t slot;   ///< 0 if the entry is free
+  uint16_t digest;
+  uint16_t next;   ///< Next entry in the bucket or INDEX_END
+  uint8_t type;
+} index_entry_t;
+
+/****************************************************************************/
+/*                             STATIC VARIABLES                             */
+/****************************************************************************/
+
+static bool is_enabled = false;
+static bool is_complete = false;
+static uint16_t buckets[U3C_CREDENTIAL_INDEX_SIZE];
+static index_entry_t entries[U3C_CREDENTIAL_INDEX_SIZE];
+
+/****************************************************************************/
+/*                             PRIVATE FUNCTIONS                            */
+/****************************************************************************/
+
+static uint16_t calculate_digest(
+  u3c_credential_type type, const uint8_t * p_data, uint8_t length)
+{
+  uint8_t type_byte = (uint8_t)type;
+  uint16_t digest = CRC_CheckCrc16(CRC_INITAL_VALUE, &type_byte, 1);
+  digest = CRC_CheckCrc16(digest, &length, 1);
+  return CRC_CheckCrc16(digest, (uint8_t *)p_data, length);
+}
+
+static uint16_t * get_bucket(uint16_t digest)
+{
+  return &buckets[digest % U3C_CREDENTIAL_INDEX_SIZE];
+}
+
+static uint16_t find_entry(u3c_credential_type type, uint16_t slot)
+{
+  for (uint16_t i = 0; i < U3C_CREDENTIAL_INDEX_SIZE; ++i) {
+    if (entries[i].slot == slot && entries[i].type == type) {
+      return i;
+    }
+  }
+  return INDEX_END;
+}
+
+static uint16_t find_free_entry(void)
+{
+  for (uint16_t i = 0; i < U3C_CREDENTIAL_INDEX_SIZE; ++i) {
+    if (entries[i].slot == 0) {
+      return i;
+    }
+  }
+  return INDEX_END;
+}
+
+static void unlink_entry(uint16_t index)
+{
+  uint16_t * p_link = get_bucket(entries[index].digest);
+  while (*p_link != index) {
+    p_link = &entries[*p_link].next;
+  }
+  *p_link = entries[index].next;
+}
+
+/****************************************************************************/
+/*                             PUBLIC FUNCTIONS                             */
+/****************************************************************************/
+
+void CC_UserCredential_index_reset(bool enable)
+{
+  is_enabled = enable;
+  is_complete = enable;
+  for (uint16_t i = 0; i < U3C_CREDENTIAL_INDEX_SIZE; ++i) {
+    buckets[i] = INDEX_END;
+    entries[i].slot = 0;
+  }
+}
+
+void CC_UserCredential_index_invalidate(void)
+{
+  is_complete = false;
+}
+
+void CC_UserCredential_index_add(
+  u3c_credential_type type, uint16_t slot, const uint8_t * p_data,
+  uint8_t length)
+{
+  if (!is_enabled || slot == 0) {
+    return;
+  }
+
+  uint16_t index = find_entry(type, slot);
+  if (index != INDEX_END) {
+    unlink_entry(index);
+  } else {
+    index = find_free_entry();
+    if (index == INDEX_END) {
+      // The database holds more Credentials than the index.
+      is_complete = false;
+      return;
+    }
+  }
+
+  entries[index].slot = slot;
+  entries[index].type = (uint8_t)type;
+  entries[index].digest = calculate_digest(type, p_data, length);
+
+  uint16_t * p_bucket = get_bucket(entries[index].digest);
+  entries[index].next = *p_bucket;
+  *p_bucket = index;
+}
+
+void CC_UserCredential_index_remove(u3c_credential_type type, uint16_t slot)
+{
+  if (!is_enabled || slot == 0) {
+    return;
+  }
+
+  uint16_t index = find_entry(type, slot);
+  if (index != INDEX_END) {
+    unlink_entry(index);
+    entries[index].slot = 0;
+  }
+}
+
+void CC_UserCredential_index_move(
+  u3c_credential_type type, uint16_t source_slot, uint16_t destination_slot)
+{
+  if (!is_enabled || source_slot == 0) {
+    return;
+  }
+
+  uint16_t index = find_entry(type, source_slot);
+  if (index != INDEX_END) {
+    // The data is unchanged, hence also the bucket.
+    entries[index].slot = destination_slot;
+  }
+}
+
+bool CC_UserCredential_index_is_complete(void)
+{
+  return is_complete;
+}
+
+bool CC_UserCredential_index_find_next(
+  const u3c_credential_t * const p_credential, uint16_t * p_position,
+  uint16_t * p_slot)
+{
+  uint16_t digest = calculate_digest(p_credential->metadata.type,
+                                     p_credential->data,
+                                     p_credential->metadata.length);
+  // The position is one past the entry returned last, or 0 to start.
+  uint16_t index = (*p_position == 0)
+                   ? *get_bucket(digest)
+                   : entries[*p_position - 1].next;
+
+  while (index != INDEX_END) {
+    if (entries[index].digest == digest
+        && entries[index].type == (uint8_t)p_credential->metadata.type) {
+      *p_position = (uint16_t)(index + 1);
+      *p_slot = entries[index].slot;
+      return true;
+    }
+    index = entries[index].next;
+  }
+  return false;
+}
+
+#else // (0 < U3C_CREDENTIAL_INDEX_SIZE)
+
+void CC_UserCredential_index_reset(__attribute__((unused)) bool enable)
+{
+}
+
+void CC_UserCredential_index_invalidate(void)
+{
+}
+
+void CC_UserCredential_index_add(
+  __attribute__((unused)) u3c_credential_type type,
+  __attribute__((unused)) uint16_t slot,
+  __attribute__((unused)) const uint8_t * p_data,
+  __attribute__((unused)) uint8_t length)
+{
+}
+
+void CC_UserCredential_index_remove(
+  __attribute__((unused)) u3c_credential_type type,
+  __attribute__((unused)) uint16_t slot)
+{
+}
+
+void CC_UserCredential_index_move(
+  __attribute__((unused)) u3c_credential_type type,
+  __attribute__((unused)) uint16_t source_slot,
+  __attribute__((unused)) uint16_t destination_slot)
+{
+}
+
+bool CC_UserCredential_index_is_complete(void)
+{
+  return false;
+}
+
+bool CC_UserCredential_index_find_next(
+  __attribute__((unused)) const u3c_credential_t * const p_credential,
+  __attribute__((unused)) uint16_t * p_position,
+  __attribute__((unused)) uint16_t * p_slot)
+{
+  return false;
+}
+
+#endif // (0 < U3C_CREDENTIAL_INDEX_SIZE)
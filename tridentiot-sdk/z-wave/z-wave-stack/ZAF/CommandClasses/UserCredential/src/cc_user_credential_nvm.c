@@ -16,6 +16,8 @@
 #include "ZAF_file_ids.h"
 #include "ZAF_nvm.h"
 #include "cc_user_credential_config_api.h"
+#include "cc_user_credential_handlers_checksum.h"
+#include "cc_user_credential_index.h"
 #include "assert.h"
 #include <string.h>
 #include <stdint.h>
@@ -272,10 +274,46 @@ static void ordered_insert_credential_descriptor(credential_descriptor_t * crede
   ++n_credentials;
 }
 
+/**
+ * Adds every stored Credential to the Credential index.
+ */
+static void build_credential_index(void)
+{
+  CC_UserCredential_index_reset(true);
+  if (n_credentials < 1) {
+    return;
+  }
+
+  credential_descriptor_t credentials[U3C_BUFFER_SIZE_CREDENTIAL_DESCRIPTORS];
+  if (!nvm(U3C_READ, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
+    CC_UserCredential_index_invalidate();
+    return;
+  }
+
+  for (uint16_t i = 0; i < n_credentials; ++i) {
+    credential_metadata_nvm_t metadata = { 0 };
+    uint8_t data[U3C_BUFFER_SIZE_CREDENTIAL_DATA] = { 0 };
+
+    if (!nvm(U3C_READ, AREA_CREDENTIAL_METADATA, credentials[i].object_offset,
+             &metadata, 0)
+        || !nvm(U3C_READ, AREA_CREDENTIAL_DATA, credentials[i].object_offset,
+                data, metadata.length)) {
+      CC_UserCredential_index_invalidate();
+      return;
+    }
+    CC_UserCredential_index_add(credentials[i].credential_type,
+                                credentials[i].credential_slot, data,
+                                metadata.length);
+  }
+}
+
 void init_database_variables(void)
 {
   users_buffer_head = 0;
   credentials_buffer_head = 0;
+  // Every change of the database is reported to the checksum cache below.
+  CC_UserCredential_checksum_cache_reset(true);
+  build_credential_index();
   max_users = cc_user_credential_get_max_user_unique_idenfitiers();
   max_credentials = MAX_CREDENTIAL_OBJECTS;
 
@@ -530,6 +568,8 @@ u3c_db_operation_result CC_UserCredential_add_user(
     }
 
     if (available) {
+      CC_UserCredential_checksum_invalidate_user(user->unique_identifier);
+
       // Write User object and name in NVM
       if (!nvm(U3C_WRITE, AREA_USERS, object_offset, user, 0)
           || !nvm(U3C_WRITE, AREA_USER_NAMES, object_offset, name,
@@ -583,6 +623,8 @@ u3c_db_operation_result CC_UserCredential_modify_user(
         return U3C_DB_OPERATION_RESULT_FAIL_IDENTICAL;
       }
 
+      CC_UserCredential_checksum_invalidate_user(user->unique_identifier);
+
       bool write_successful = true;
       // Overwrite User object in NVM
       write_successful &= nvm(U3C_WRITE, AREA_USERS, object_offset, user, 0);
@@ -621,6 +663,7 @@ u3c_db_operation_result CC_UserCredential_delete_user(
   // Find User
   for (uint16_t i = 0; i < n_users; ++i) {
     if (users[i].unique_identifier == user_unique_identifier) {
+      CC_UserCredential_checksum_invalidate_user(user_unique_identifier);
       --n_users;
 
       // If the deleted User was not the last in the list
@@ -834,6 +877,9 @@ u3c_db_operation_result CC_UserCredential_add_credential(
     }
 
     if (available) {
+      CC_UserCredential_checksum_invalidate_credential(
+        p_credential->metadata.type, p_credential->metadata.uuid);
+
       credential_metadata_nvm_t metadata;
       convert_credential_metadata_to_nvm(&metadata, &p_credential->metadata);
 
@@ -851,6 +897,9 @@ u3c_db_operation_result CC_UserCredential_add_credential(
       if (
         nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)
         && nvm(U3C_WRITE, AREA_NUMBER_OF_CREDENTIALS, 0, &n_credentials, 0)) {
+        CC_UserCredential_index_add(p_credential->metadata.type,
+                                    p_credential->metadata.slot,
+                                    p_credential->data, metadata.length);
         return U3C_DB_OPERATION_RESULT_SUCCESS;
       } else {
         --n_credentials;
@@ -900,6 +949,9 @@ u3c_db_operation_result CC_UserCredential_modify_credential(
         return U3C_DB_OPERATION_RESULT_FAIL_IDENTICAL;
       }
 
+      CC_UserCredential_checksum_invalidate_credential(
+        credentials[i].credential_type, credentials[i].user_unique_identifier);
+
       credential_metadata_nvm_t metadata;
       convert_credential_metadata_to_nvm(&metadata, &p_credential->metadata);
 
@@ -909,6 +961,15 @@ u3c_db_operation_result CC_UserCredential_modify_credential(
       // Overwrite Credential data in NVM
       nvm_success &= nvm(U3C_WRITE, AREA_CREDENTIAL_DATA, object_offset,
                          p_credential->data, p_credential->metadata.length);
+      if (nvm_success) {
+        CC_UserCredential_index_add(p_credential->metadata.type,
+                                    p_credential->metadata.slot,
+                                    p_credential->data,
+                                    p_credential->metadata.length);
+      } else {
+        // The stored data is unknown
+        CC_UserCredential_index_invalidate();
+      }
       return nvm_success ? U3C_DB_OPERATION_RESULT_SUCCESS : U3C_DB_OPERATION_RESULT_ERROR_IO;
     }
   }
@@ -936,6 +997,8 @@ u3c_db_operation_result CC_UserCredential_delete_credential(
   for (uint16_t i = 0; i < n_credentials; ++i) {
     if (credentials[i].credential_type == credential_type
         && credentials[i].credential_slot == credential_slot) {
+      CC_UserCredential_checksum_invalidate_credential(
+        credential_type, credentials[i].user_unique_identifier);
       --n_credentials;
 
       // If the deleted Credential was not the last in the list
@@ -961,6 +1024,7 @@ u3c_db_operation_result CC_UserCredential_delete_credential(
         credentials_buffer_head = 0;
       }
 
+      CC_UserCredential_index_remove(credential_type, credential_slot);
       return U3C_DB_OPERATION_RESULT_SUCCESS;
     }
   }
@@ -1023,6 +1087,11 @@ u3c_db_operation_result CC_UserCredential_move_credential(
 
   uint16_t object_offset = credentials[source_index].object_offset;
 
+  CC_UserCredential_checksum_invalidate_credential(
+    credential_type, credentials[source_index].user_unique_identifier);
+  CC_UserCredential_checksum_invalidate_credential(
+    credential_type, destination_user_uid);
+
   if (!same_uuid) {
     // Change the associated UUID in the stored credential metadata
     credential_metadata_nvm_t metadata = { 0 };
@@ -1051,11 +1120,14 @@ u3c_db_operation_result CC_UserCredential_move_credential(
   };
   ordered_insert_credential_descriptor(credentials, &credential, object_offset);
 
-  return (
-    // Overwrite Credential descriptor table in NVM
-    nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0))
-         ? U3C_DB_OPERATION_RESULT_SUCCESS
-         : U3C_DB_OPERATION_RESULT_ERROR_IO;
+  // Overwrite Credential descriptor table in NVM
+  if (!nvm(U3C_WRITE, AREA_CREDENTIAL_DESCRIPTORS, 0, &credentials, 0)) {
+    return U3C_DB_OPERATION_RESULT_ERROR_IO;
+  }
+
+  CC_UserCredential_index_move(credential_type, source_credential_slot,
+                               destination_credential_slot);
+  return U3C_DB_OPERATION_RESULT_SUCCESS;
 }
 
 u3c_db_operation_result CC_UserCredential_get_admin_code_info(
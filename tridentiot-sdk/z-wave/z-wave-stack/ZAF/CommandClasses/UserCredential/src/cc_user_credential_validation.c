@@ -14,6 +14,7 @@
 #include "cc_user_credential_config_api.h"
 #include "cc_user_credential_io_config.h"
 #include "cc_user_credential_tx.h"
+#include "cc_user_credential_index.h"
 #include "assert.h"
 #include <string.h>
 
@@ -126,6 +127,27 @@ ZW_WEAK bool find_existing_credential(
   const u3c_credential_t * const p_credential,
   u3c_credential_metadata_t * p_existing_metadata)
 {
+  if (CC_UserCredential_index_is_complete()) {
+    // Only read the Credentials with the same type and digest of the data
+    uint16_t position = 0;
+    uint16_t slot = 0;
+
+    while (CC_UserCredential_index_find_next(p_credential, &position, &slot)) {
+      uint8_t e_data[U3C_BUFFER_SIZE_CREDENTIAL_DATA] = { 0 };
+
+      if (CC_UserCredential_get_credential(
+            0, p_credential->metadata.type, slot, p_existing_metadata, e_data)
+          == U3C_DB_OPERATION_RESULT_SUCCESS
+          && p_existing_metadata->length == p_credential->metadata.length
+          && (memcmp(e_data, p_credential->data, p_existing_metadata->length)
+              == 0)
+          ) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // Iterate through each User
   uint16_t uuid = CC_UserCredential_get_next_user(0);
   while (uuid) {
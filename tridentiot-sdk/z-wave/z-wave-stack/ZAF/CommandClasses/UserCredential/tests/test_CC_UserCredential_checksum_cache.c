@@ -0,0 +1,263 @@
+/**
+ * @file test_CC_UserCredential_checksum_cache.c
+ * @copyright 2024 Silicon Laboratories Inc.
+ */
+#include "unity.h"
+#include <stdbool.h>
+#include <string.h>
+#include "ZW_classcmd.h"
+#include "cc_user_credential_config_api_mock.h"
+#include "ZAF_nvm_mock.h"
+#include "cc_user_credential_io.h"
+#include "cc_user_credential_handlers_checksum.h"
+
+/*
+   A RAM backed NVM, so the NVM database can be used as is.
+ */
+#define TEST_NVM_OBJECTS      64
+#define TEST_NVM_OBJECT_SIZE  256
+
+typedef struct {
+  zpal_nvm_object_key_t key;
+  size_t size;
+  uint8_t data[TEST_NVM_OBJECT_SIZE];
+} test_nvm_object_t;
+
+static test_nvm_object_t nvm_objects[TEST_NVM_OBJECTS];
+static uint8_t nvm_object_count;
+static uint32_t nvm_read_count;
+
+static test_nvm_object_t * find_nvm_object(zpal_nvm_object_key_t key)
+{
+  for (uint8_t i = 0; i < nvm_object_count; i++) {
+    if (nvm_objects[i].key == key) {
+      return &nvm_objects[i];
+    }
+  }
+  return NULL;
+}
+
+static zpal_status_t ZAF_nvm_write_Callback(zpal_nvm_object_key_t key, const void* object, size_t object_size,
+                                            __attribute__((unused)) int cmock_num_calls)
+{
+  test_nvm_object_t * p_object = find_nvm_object(key);
+
+  TEST_ASSERT_LESS_OR_EQUAL(TEST_NVM_OBJECT_SIZE, object_size);
+  if (p_object == NULL) {
+    TEST_ASSERT_LESS_THAN(TEST_NVM_OBJECTS, nvm_object_count);
+    p_object = &nvm_objects[nvm_object_count++];
+    p_object->key = key;
+  }
+  memcpy(p_object->data, object, object_size);
+  p_object->size = object_size;
+  return ZPAL_STATUS_OK;
+}
+
+static zpal_status_t ZAF_nvm_read_Callback(zpal_nvm_object_key_t key, void* object, size_t object_size,
+                                           __attribute__((unused)) int cmock_num_calls)
+{
+  test_nvm_object_t * p_object = find_nvm_object(key);
+
+  nvm_read_count++;
+  if (p_object == NULL) {
+    return ZPAL_STATUS_FAIL;
+  }
+  memcpy(object, p_object->data, (object_size < p_object->size) ? object_size : p_object->size);
+  return ZPAL_STATUS_OK;
+}
+
+/*
+   COMMON TEST VARIABLES
+ */
+static const uint16_t uuids[] = { 1, 2, 3 };
+static const u3c_credential_type types[] = {
+  CREDENTIAL_TYPE_PIN_CODE, CREDENTIAL_TYPE_PASSWORD, CREDENTIAL_TYPE_RFID_CODE
+};
+
+typedef struct {
+  uint16_t all_users;
+  uint16_t users[sizeof(uuids) / sizeof(uuids[0])];
+  uint16_t credentials[sizeof(types) / sizeof(types[0])];
+} test_checksums_t;
+
+void setUpSuite(void)
+{
+  ZAF_nvm_write_Stub(ZAF_nvm_write_Callback);
+  ZAF_nvm_read_Stub(ZAF_nvm_read_Callback);
+  cc_user_credential_get_max_user_unique_idenfitiers_IgnoreAndReturn(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS);
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(nvm_objects, 0, sizeof(nvm_objects));
+  nvm_object_count = 0;
+  CC_UserCredential_init_database();
+}
+
+void tearDown(void)
+{
+}
+
+static void add_user(uint16_t uuid, const char * name)
+{
+  u3c_user_t user = {
+    .unique_identifier = uuid,
+    .active = true,
+    .type = USER_TYPE_GENERAL,
+    .credential_rule = CREDENTIAL_RULE_SINGLE,
+    .name_encoding = USER_NAME_ENCODING_STANDARD_ASCII,
+    .name_length = (uint8_t)strlen(name),
+  };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_add_user(&user, (uint8_t *)name));
+}
+
+static void add_credential(uint16_t uuid, u3c_credential_type type, uint16_t slot, const char * data)
+{
+  u3c_credential_t credential = {
+    .metadata = {
+      .uuid = uuid,
+      .slot = slot,
+      .type = type,
+      .length = (uint8_t)strlen(data),
+    },
+    .data = (uint8_t *)data
+  };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_add_credential(&credential));
+}
+
+static void get_checksums(test_checksums_t * p_checksums)
+{
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_get_all_users_checksum(&p_checksums->all_users));
+  for (uint8_t i = 0; i < sizeof(uuids) / sizeof(uuids[0]); i++) {
+    uint32_t read_count = nvm_read_count;
+    if (CC_UserCredential_get_user_checksum(uuids[i], &p_checksums->users[i])
+        == U3C_DB_OPERATION_RESULT_FAIL_DNE) {
+      // Nothing is cached for a User that does not exist.
+      nvm_read_count = read_count;
+    }
+  }
+  for (uint8_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+    TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                      CC_UserCredential_get_credential_checksum(types[i], &p_checksums->credentials[i]));
+  }
+}
+
+/**
+ * Gets every checksum twice from the cache and compares them to checksums
+ * calculated from scratch. The cache is left filled.
+ */
+static void assert_cached_checksums_are_correct(void)
+{
+  test_checksums_t cached;
+  test_checksums_t cached_again;
+  test_checksums_t calculated;
+
+  get_checksums(&cached);
+  nvm_read_count = 0;
+  get_checksums(&cached_again);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, nvm_read_count, "Cached checksums were read from NVM");
+
+  CC_UserCredential_checksum_cache_reset(false);
+  get_checksums(&calculated);
+  CC_UserCredential_checksum_cache_reset(true);
+
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(&calculated, &cached, sizeof(calculated) / sizeof(uint16_t));
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(&calculated, &cached_again, sizeof(calculated) / sizeof(uint16_t));
+
+  // Fill the cache again, so the next change must invalidate it.
+  get_checksums(&cached);
+}
+
+void test_checksum_cache_empty_database(void)
+{
+  test_checksums_t checksums;
+
+  get_checksums(&checksums);
+  TEST_ASSERT_EQUAL_UINT16(0, checksums.all_users);
+  TEST_ASSERT_EQUAL_UINT16(0, checksums.users[0]);
+  TEST_ASSERT_EQUAL_UINT16(0, checksums.credentials[0]);
+  assert_cached_checksums_are_correct();
+}
+
+/**
+ * Verifies that every change of the database invalidates the checksums it affects.
+ */
+void test_checksum_cache_follows_database_changes(void)
+{
+  add_user(uuids[0], "Alice");
+  assert_cached_checksums_are_correct();
+
+  add_user(uuids[1], "Bob");
+  add_credential(uuids[0], CREDENTIAL_TYPE_PIN_CODE, 1, "1234");
+  assert_cached_checksums_are_correct();
+
+  add_credential(uuids[1], CREDENTIAL_TYPE_PIN_CODE, 2, "5678");
+  assert_cached_checksums_are_correct();
+
+  add_credential(uuids[0], CREDENTIAL_TYPE_RFID_CODE, 1, "RFID-TAG-0001");
+  assert_cached_checksums_are_correct();
+
+  // Modify User
+  u3c_user_t user = { 0 };
+  uint8_t name[UINT8_MAX] = { 0 };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_get_user(uuids[1], &user, name));
+  user.active = false;
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_modify_user(&user, name));
+  assert_cached_checksums_are_correct();
+
+  // Modify Credential
+  uint8_t data[] = "4321";
+  u3c_credential_t credential = {
+    .metadata = { .uuid = uuids[0], .slot = 1, .type = CREDENTIAL_TYPE_PIN_CODE, .length = 4 },
+    .data = data
+  };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_modify_credential(&credential));
+  assert_cached_checksums_are_correct();
+
+  // Move Credential to another User and slot
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_move_credential(CREDENTIAL_TYPE_PIN_CODE, 1, uuids[1], 3));
+  assert_cached_checksums_are_correct();
+
+  // Delete Credential
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_delete_credential(CREDENTIAL_TYPE_RFID_CODE, 1));
+  assert_cached_checksums_are_correct();
+
+  // Delete User
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_delete_user(uuids[0]));
+  assert_cached_checksums_are_correct();
+
+  // Rejected operations do not change anything
+  add_user(uuids[2], "Carol");
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_FAIL_OCCUPIED,
+                    CC_UserCredential_move_credential(CREDENTIAL_TYPE_PIN_CODE, 2, uuids[2], 3));
+  assert_cached_checksums_are_correct();
+}
+
+/**
+ * Verifies that the checksums survive a reboot, i.e. they are calculated from NVM
+ * when the database is loaded.
+ */
+void test_checksum_cache_init_database(void)
+{
+  test_checksums_t before;
+  test_checksums_t after;
+
+  add_user(uuids[0], "Alice");
+  add_credential(uuids[0], CREDENTIAL_TYPE_PASSWORD, 1, "secret");
+  get_checksums(&before);
+
+  CC_UserCredential_init_database();
+  get_checksums(&after);
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(&before, &after, sizeof(before) / sizeof(uint16_t));
+  TEST_ASSERT_NOT_EQUAL(0, after.credentials[1]);
+  assert_cached_checksums_are_correct();
+}
@@ -0,0 +1,256 @@
+/**
+ * @file test_CC_UserCredential_credential_index.c
+ * @copyright 2024 Silicon Laboratories Inc.
+ */
+#include "unity.h"
+#include <stdbool.h>
+#include <string.h>
+#include "ZW_classcmd.h"
+#include "cc_user_credential_config_api_mock.h"
+#include "ZAF_nvm_mock.h"
+#include "cc_user_credential_io.h"
+#include "cc_user_credential_index.h"
+#include "cc_user_credential_validation.h"
+
+/*
+   A RAM backed NVM, so the NVM database can be used as is.
+ */
+#define TEST_NVM_OBJECTS      64
+#define TEST_NVM_OBJECT_SIZE  256
+
+typedef struct {
+  zpal_nvm_object_key_t key;
+  size_t size;
+  uint8_t data[TEST_NVM_OBJECT_SIZE];
+} test_nvm_object_t;
+
+static test_nvm_object_t nvm_objects[TEST_NVM_OBJECTS];
+static uint8_t nvm_object_count;
+static uint32_t nvm_read_count;
+
+static test_nvm_object_t * find_nvm_object(zpal_nvm_object_key_t key)
+{
+  for (uint8_t i = 0; i < nvm_object_count; i++) {
+    if (nvm_objects[i].key == key) {
+      return &nvm_objects[i];
+    }
+  }
+  return NULL;
+}
+
+static zpal_status_t ZAF_nvm_write_Callback(zpal_nvm_object_key_t key, const void* object, size_t object_size,
+                                            __attribute__((unused)) int cmock_num_calls)
+{
+  test_nvm_object_t * p_object = find_nvm_object(key);
+
+  TEST_ASSERT_LESS_OR_EQUAL(TEST_NVM_OBJECT_SIZE, object_size);
+  if (p_object == NULL) {
+    TEST_ASSERT_LESS_THAN(TEST_NVM_OBJECTS, nvm_object_count);
+    p_object = &nvm_objects[nvm_object_count++];
+    p_object->key = key;
+  }
+  memcpy(p_object->data, object, object_size);
+  p_object->size = object_size;
+  return ZPAL_STATUS_OK;
+}
+
+static zpal_status_t ZAF_nvm_read_Callback(zpal_nvm_object_key_t key, void* object, size_t object_size,
+                                           __attribute__((unused)) int cmock_num_calls)
+{
+  test_nvm_object_t * p_object = find_nvm_object(key);
+
+  nvm_read_count++;
+  if (p_object == NULL) {
+    return ZPAL_STATUS_FAIL;
+  }
+  memcpy(object, p_object->data, (object_size < p_object->size) ? object_size : p_object->size);
+  return ZPAL_STATUS_OK;
+}
+
+void setUpSuite(void)
+{
+  ZAF_nvm_write_Stub(ZAF_nvm_write_Callback);
+  ZAF_nvm_read_Stub(ZAF_nvm_read_Callback);
+  cc_user_credential_get_max_user_unique_idenfitiers_IgnoreAndReturn(CC_USER_CREDENTIAL_MAX_USER_UNIQUE_IDENTIFIERS);
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(nvm_objects, 0, sizeof(nvm_objects));
+  nvm_object_count = 0;
+  CC_UserCredential_init_database();
+}
+
+void tearDown(void)
+{
+}
+
+static void add_user(uint16_t uuid)
+{
+  uint8_t name[] = "User";
+  u3c_user_t user = {
+    .unique_identifier = uuid,
+    .active = true,
+    .type = USER_TYPE_GENERAL,
+    .credential_rule = CREDENTIAL_RULE_SINGLE,
+    .name_encoding = USER_NAME_ENCODING_STANDARD_ASCII,
+    .name_length = sizeof(name) - 1,
+  };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_add_user(&user, name));
+}
+
+static void add_credential(uint16_t uuid, u3c_credential_type type, uint16_t slot, const char * data)
+{
+  u3c_credential_t credential = {
+    .metadata = {
+      .uuid = uuid,
+      .slot = slot,
+      .type = type,
+      .length = (uint8_t)strlen(data),
+    },
+    .data = (uint8_t *)data
+  };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_add_credential(&credential));
+}
+
+/**
+ * Looks for a Credential through the index kept up to date, by reading the whole
+ * database and through the index built from NVM, and checks that all give the
+ * expected result. The index is left built from NVM.
+ */
+static void assert_find(u3c_credential_type type, const char * data, bool expected, uint16_t expected_uuid,
+                        uint16_t expected_slot)
+{
+  u3c_credential_t credential = {
+    .metadata = { .type = type, .length = (uint8_t)strlen(data) },
+    .data = (uint8_t *)data
+  };
+  u3c_credential_metadata_t existing = { 0 };
+
+  for (uint8_t pass = 0; pass < 3; pass++) {
+    if (pass == 1) {
+      CC_UserCredential_index_invalidate();
+    } else if (pass == 2) {
+      // Build the index from NVM, like on boot
+      CC_UserCredential_init_database();
+    }
+    TEST_ASSERT_EQUAL(pass != 1, CC_UserCredential_index_is_complete());
+
+    memset(&existing, 0, sizeof(existing));
+    nvm_read_count = 0;
+    TEST_ASSERT_EQUAL(expected, find_existing_credential(&credential, &existing));
+    if (pass != 1 && !expected) {
+      // Nothing indexed under the digest
+      TEST_ASSERT_EQUAL_UINT32(0, nvm_read_count);
+    }
+    if (expected) {
+      TEST_ASSERT_EQUAL_UINT16(expected_uuid, existing.uuid);
+      TEST_ASSERT_EQUAL_UINT16(expected_slot, existing.slot);
+      TEST_ASSERT_EQUAL(type, existing.type);
+    }
+  }
+}
+
+/**
+ * Verifies that a duplicate is found with one read of a Credential, and that no
+ * Credential is read if there is no duplicate.
+ */
+void test_credential_index_lookup(void)
+{
+  u3c_credential_metadata_t existing = { 0 };
+  u3c_credential_t credential = {
+    .metadata = { .type = CREDENTIAL_TYPE_PIN_CODE, .length = 4 },
+    .data = (uint8_t *)"5678"
+  };
+
+  add_user(1);
+  add_user(2);
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 1, "1234");
+  add_credential(2, CREDENTIAL_TYPE_PIN_CODE, 2, "5678");
+  add_credential(1, CREDENTIAL_TYPE_PASSWORD, 1, "5678");
+  TEST_ASSERT_TRUE(CC_UserCredential_index_is_complete());
+
+  // Descriptor table, metadata and data of one Credential
+  nvm_read_count = 0;
+  TEST_ASSERT_TRUE(find_existing_credential(&credential, &existing));
+  TEST_ASSERT_EQUAL_UINT32(3, nvm_read_count);
+  TEST_ASSERT_EQUAL_UINT16(2, existing.uuid);
+  TEST_ASSERT_EQUAL_UINT16(2, existing.slot);
+
+  credential.data = (uint8_t *)"0000";
+  nvm_read_count = 0;
+  TEST_ASSERT_FALSE(find_existing_credential(&credential, &existing));
+  TEST_ASSERT_EQUAL_UINT32(0, nvm_read_count);
+
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "1234", true, 1, 1);
+  assert_find(CREDENTIAL_TYPE_PASSWORD, "5678", true, 1, 1);
+  assert_find(CREDENTIAL_TYPE_PASSWORD, "1234", false, 0, 0);
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "123", false, 0, 0);
+}
+
+/**
+ * Verifies that the index follows modified, moved and deleted Credentials.
+ */
+void test_credential_index_follows_database_changes(void)
+{
+  add_user(1);
+  add_user(2);
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 1, "1234");
+  add_credential(2, CREDENTIAL_TYPE_PIN_CODE, 2, "5678");
+
+  u3c_credential_t credential = {
+    .metadata = { .uuid = 1, .slot = 1, .type = CREDENTIAL_TYPE_PIN_CODE, .length = 4 },
+    .data = (uint8_t *)"4321"
+  };
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS, CC_UserCredential_modify_credential(&credential));
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "4321", true, 1, 1);
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "1234", false, 0, 0);
+
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_move_credential(CREDENTIAL_TYPE_PIN_CODE, 2, 1, 3));
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "5678", true, 1, 3);
+
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_delete_credential(CREDENTIAL_TYPE_PIN_CODE, 3));
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "5678", false, 0, 0);
+  assert_find(CREDENTIAL_TYPE_PIN_CODE, "4321", true, 1, 1);
+}
+
+/**
+ * Verifies that the database is searched when it holds more Credentials than
+ * the index (U3C_CREDENTIAL_INDEX_SIZE is 4 in this test).
+ */
+void test_credential_index_full(void)
+{
+  u3c_credential_metadata_t existing = { 0 };
+  u3c_credential_t credential = {
+    .metadata = { .type = CREDENTIAL_TYPE_PIN_CODE, .length = 4 },
+    .data = (uint8_t *)"0005"
+  };
+
+  add_user(1);
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 1, "0001");
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 2, "0002");
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 3, "0003");
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 4, "0004");
+  TEST_ASSERT_TRUE(CC_UserCredential_index_is_complete());
+
+  add_credential(1, CREDENTIAL_TYPE_PIN_CODE, 5, "0005");
+  TEST_ASSERT_FALSE(CC_UserCredential_index_is_complete());
+  TEST_ASSERT_TRUE(find_existing_credential(&credential, &existing));
+  TEST_ASSERT_EQUAL_UINT16(5, existing.slot);
+
+  CC_UserCredential_init_database();
+  TEST_ASSERT_FALSE(CC_UserCredential_index_is_complete());
+
+  TEST_ASSERT_EQUAL(U3C_DB_OPERATION_RESULT_SUCCESS,
+                    CC_UserCredential_delete_credential(CREDENTIAL_TYPE_PIN_CODE, 1));
+  CC_UserCredential_init_database();
+  TEST_ASSERT_TRUE(CC_UserCredential_index_is_complete());
+  TEST_ASSERT_TRUE(find_existing_credential(&credential, &existing));
+  TEST_ASSERT_EQUAL_UINT16(5, existing.slot);
+}
@@ -26,11 +26,22 @@
 /**
  * Frame queue size <1..255:1>
  *
+ * Number of frames that can wait in the low priority lane, i.e. unsolicited frames.
  */
 #if !defined(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE)
 #define ZAF_TRANSPORT_CONFIG_QUEUE_SIZE  2
 #endif /* !defined(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE) */
 
+/**
+ * Frames reserved for the high priority lane <0..255:1>
+ *
+ * Frame buffers that only responses, e.g. Supervision Reports and Get responses, can use. They are
+ * added to the Frame queue size.
+ */
+#if !defined(ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED)
+#define ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED  1
+#endif /* !defined(ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED) */
+
 /**@}*/ /* \addtogroup zaf_transport_configuration */
 
 /**@}*/ /* \addtogroup configuration */
@@ -2,11 +2,18 @@
  * @file
  *
  * This module contains the functionality to send frames from the application
- * to the protocol. It has a FIFO to ensure determinism in the process.
- * The queue size is configurable since it is heavily dependent on the use case
- * of the application.
- * The default size is set to 2 since this is the minimum for our sample
- * applications. The user must configure it for optimal memory usage.
+ * to the protocol. Frames are kept in a pool of pre-allocated frame buffers and
+ * wait in one of two FIFO lanes. The high priority lane is emptied first, so
+ * responses are not held back by queued unsolicited reports.
+ *
+ * A frame can be built directly in a pool buffer with
+ * zaf_transport_tx_frame_alloc() and zaf_transport_tx_frame_send(), or copied
+ * into one with zaf_transport_tx().
+ *
+ * The number of low priority frames (ZAF_TRANSPORT_CONFIG_QUEUE_SIZE) is
+ * configurable since it is heavily dependent on the use case of the
+ * application. The default size is set to 2 since this is the minimum for our
+ * sample applications. The user must configure it for optimal memory usage.
  * @copyright 2023 Silicon Laboratories Inc.
  */
 
@@ -16,6 +23,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "ZAF_types.h"
+#include "ZW_TransportEndpoint.h"
 
 /**
  * @addtogroup ZAF
@@ -24,6 +32,15 @@
  * @{
  */
 
+/**
+ * Transmit priority. It selects the lane a frame waits in.
+ */
+typedef enum {
+  ZAF_TRANSPORT_PRIORITY_LOW = 0,     ///< Unsolicited frames, e.g. lifeline reports.
+  ZAF_TRANSPORT_PRIORITY_HIGH,        ///< Responses to a received frame, e.g. Supervision Reports.
+  ZAF_TRANSPORT_PRIORITY_COUNT
+} zaf_transport_priority_t;
+
 typedef struct {
   uint16_t dest_node_id;              ///< If provided, then the frame is only sent to this node. If zero, then it's sent to entire group
   const agi_profile_t *agi_profile;   ///< AGI profile. If NULL, is lifeline.
@@ -33,16 +50,72 @@ typedef struct {
   security_key_t security_key;        ///< Security key.
   bool bit_addressing;                ///< Tells if bit addressing should be used
   bool use_supervision;               ///< Tells if supervision should be used
+  /**
+   * If set and dest_node_id is zero, then the frame is only sent to these destinations of the
+   * group, as one multicast with singlecast follow-ups. The list must be sorted like an
+   * association group, be followed by a free entry unless it fills a whole group, and stay
+   * valid until the callback. If it holds fewer destinations than the group, the multicast
+   * uses an S2 group ID of its own, so the MPAN of the group is not advanced.
+   */
+  MULTICHAN_NODE_ID *dest_node_list;
+  uint8_t dest_node_list_length;      ///< Number of destinations in dest_node_list.
+  zaf_transport_priority_t priority;  ///< Lane the frame waits in. Set to high by zaf_transport_rx_to_tx_options().
 } zaf_tx_options_t;
 
+/**
+ * Statistics of one transmit lane
+ */
+typedef struct {
+  uint8_t depth;                      ///< Frames waiting in the lane right now.
+  uint8_t max_depth;                  ///< Highest number of frames that waited in the lane.
+  uint32_t sent;                      ///< Frames handed to the protocol from the lane.
+  uint32_t dropped;                   ///< Frames rejected because no frame buffer was free.
+} zaf_transport_lane_stats_t;
+
 /**
  * Type used by the callbacks that are called once the tranmission is done
  */
 typedef void(*zaf_tx_callback_t)(transmission_result_t * pTxResult);
 
+/**
+ * Takes a frame buffer from the pool, so the frame can be built in place.
+ *
+ * A low priority request never takes one of the ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED
+ * buffers. The buffer must be given back with either zaf_transport_tx_frame_send() or
+ * zaf_transport_tx_frame_free().
+ *
+ * @param priority Priority of the frame that will be built.
+ * @return Pointer to the frame buffer, or NULL if none is free. NULL is counted as a drop.
+ */
+ZW_APPLICATION_TX_BUFFER *zaf_transport_tx_frame_alloc(zaf_transport_priority_t priority);
+
+/**
+ * Queues a frame built in a buffer from zaf_transport_tx_frame_alloc(). The frame is not copied.
+ *
+ * The buffer is owned by this module from now on.
+ *
+ * @param frame Frame buffer returned by zaf_transport_tx_frame_alloc()
+ * @param frame_length Frame length
+ * @param callback Callback which is called once the transmission is done
+ * @param zaf_tx_options Transmit options. The priority is the one the buffer was allocated with.
+ * @return true In case the frame was queued
+ * @return false In case frame is not a pool buffer, or it is not allocated, e.g. already queued
+ */
+bool zaf_transport_tx_frame_send(ZW_APPLICATION_TX_BUFFER *frame, uint8_t frame_length, zaf_tx_callback_t callback, zaf_tx_options_t *zaf_tx_options);
+
+/**
+ * Gives back a frame buffer from zaf_transport_tx_frame_alloc() that is not going to be sent.
+ * A buffer that is already queued or free is left alone.
+ *
+ * @param frame Frame buffer returned by zaf_transport_tx_frame_alloc()
+ */
+void zaf_transport_tx_frame_free(ZW_APPLICATION_TX_BUFFER *frame);
+
 /**
  * Sends a frame to the controller which is to be transmitted
  *
+ * The frame is copied into a frame buffer from the pool.
+ *
  * @param frame Pointer to the frame
  * @param frame_length Frame length
  * @param callback Callback which is called once the transmission is done
@@ -52,6 +125,19 @@ typedef void(*zaf_tx_callback_t)(transmission_result_t * pTxResult);
  */
 bool zaf_transport_tx(const uint8_t *frame, uint8_t frame_length, zaf_tx_callback_t callback, zaf_tx_options_t *zaf_tx_options);
 
+/**
+ * Reads the statistics of a lane
+ *
+ * @param priority Lane to read.
+ * @param stats Where to write the statistics.
+ */
+void zaf_transport_get_lane_stats(zaf_transport_priority_t priority, zaf_transport_lane_stats_t *stats);
+
+/**
+ * Clears the max depth, sent and dropped counters of all lanes.
+ */
+void zaf_transport_reset_lane_stats(void);
+
 /**
  * Converts the Receive Options to the Transmit Options needed by this module
  *
@@ -11,31 +11,142 @@
 #include "ZW_TransportSecProtocol.h"
 #include "ZAF_Common_interface.h"
 #include "misc.h"
-#include "FreeRTOS.h"
-#include "queue.h"
 #include "association_plus_base.h"
 //#define DEBUGPRINT
 #include "DebugPrint.h"
 #include "DebugPrintConfig.h"
 
-typedef struct {
-  zaf_tx_callback_t callback;
+#define TRANSPORT_POOL_SIZE (ZAF_TRANSPORT_CONFIG_QUEUE_SIZE + ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED)
+
+/*
+ * The S2 group ID tells the receivers which MPAN a multicast is encrypted
+ * with. A multicast to only part of an association group must not advance
+ * the MPAN of the whole group, so every such subset gets an ID of its own.
+ * ReqNodeList() never makes an ID with a zero low nibble, those are used
+ * here, one per slot. The oldest slot is taken over by a new subset.
+ */
+#define TRANSPORT_SUBSET_COUNT 4
+#define TRANSPORT_SUBSET_GROUP_ID(slot) ((uint8_t)(((slot) + 1) << 4))
+
+/*
+ * The frame is the first member, so a frame pointer handed out by
+ * zaf_transport_tx_frame_alloc() is also a pointer to its descriptor.
+ */
+typedef enum {
+  TRANSPORT_DESCRIPTOR_FREE = 0,
+  TRANSPORT_DESCRIPTOR_ALLOCATED,     ///< Handed out, the frame is being built.
+  TRANSPORT_DESCRIPTOR_QUEUED
+} transport_descriptor_state_t;
+
+typedef struct transport_descriptor {
   ZW_APPLICATION_TX_BUFFER frame;
   zaf_tx_options_t zaf_tx_options;
+  zaf_tx_callback_t callback;
+  struct transport_descriptor *next;
   uint8_t frame_length;
-} transport_queue_item_t;
+  zaf_transport_priority_t priority;  ///< Given at allocation, selects the lane.
+  transport_descriptor_state_t state;
+} transport_descriptor_t;
+
+typedef struct {
+  MULTICHAN_DEST_NODE_ID nodes[CC_ASSOCIATION_MAX_NODES_IN_GROUP];
+  uint8_t length;
+} transport_subset_t;
 
-#define ZAF_TRANSPORT_QUEUE_ITEM_SIZE sizeof(transport_queue_item_t)
+typedef struct {
+  transport_descriptor_t *head;
+  transport_descriptor_t *tail;
+  zaf_transport_lane_stats_t stats;
+} transport_lane_t;
 
 static bool transport_busy;
 static bool transport_queue_paused;
-static StaticQueue_t transport_queue = { 0 };
-static uint8_t transport_queue_buffer[ZAF_TRANSPORT_CONFIG_QUEUE_SIZE * ZAF_TRANSPORT_QUEUE_ITEM_SIZE];
-static QueueHandle_t transport_queue_handle = { 0 };
+static transport_descriptor_t transport_pool[TRANSPORT_POOL_SIZE];
+static transport_descriptor_t *transport_free_list;
+static uint8_t transport_free_count;
+static transport_lane_t transport_lanes[ZAF_TRANSPORT_PRIORITY_COUNT];
 static zaf_tx_callback_t transport_pending_callback;
+static transport_subset_t transport_subsets[TRANSPORT_SUBSET_COUNT];
+static uint8_t transport_subset_next;
 
 static void transport_tx(void);
 
+static transport_descriptor_t *
+transport_descriptor_get(ZW_APPLICATION_TX_BUFFER *frame)
+{
+  for (uint8_t i = 0; i < TRANSPORT_POOL_SIZE; i++) {
+    if (&transport_pool[i].frame == frame) {
+      return &transport_pool[i];
+    }
+  }
+  return NULL;
+}
+
+static void
+transport_descriptor_free(transport_descriptor_t *descriptor)
+{
+  descriptor->state = TRANSPORT_DESCRIPTOR_FREE;
+  descriptor->next = transport_free_list;
+  transport_free_list = descriptor;
+  transport_free_count++;
+}
+
+static transport_descriptor_t *
+transport_lane_pop(void)
+{
+  transport_descriptor_t *descriptor;
+
+  /* The high priority lane is always emptied first */
+  for (int8_t priority = ZAF_TRANSPORT_PRIORITY_COUNT - 1; priority >= 0; priority--) {
+    transport_lane_t *lane = &transport_lanes[priority];
+    descriptor = lane->head;
+    if (descriptor) {
+      lane->head = descriptor->next;
+      if (!lane->head) {
+        lane->tail = NULL;
+      }
+      lane->stats.depth--;
+      lane->stats.sent++;
+      return descriptor;
+    }
+  }
+  return NULL;
+}
+
+static uint8_t
+transport_subset_group_id(const MULTICHAN_NODE_ID *nodes, uint8_t length)
+{
+  transport_subset_t *subset;
+  uint8_t slot;
+  uint8_t i;
+
+  for (slot = 0; slot < TRANSPORT_SUBSET_COUNT; slot++) {
+    subset = &transport_subsets[slot];
+    if (subset->length != length) {
+      continue;
+    }
+    for (i = 0; i < length; i++) {
+      if ((subset->nodes[i].nodeId != nodes[i].node.nodeId)
+          || (subset->nodes[i].endpoint != nodes[i].node.endpoint)) {
+        break;
+      }
+    }
+    if (i == length) {
+      return TRANSPORT_SUBSET_GROUP_ID(slot);
+    }
+  }
+
+  slot = transport_subset_next;
+  transport_subset_next = (uint8_t)((slot + 1) % TRANSPORT_SUBSET_COUNT);
+  subset = &transport_subsets[slot];
+  subset->length = length;
+  for (i = 0; i < length; i++) {
+    subset->nodes[i] = nodes[i].node;
+  }
+  DPRINTF("S2 group ID 0x%02x for %d destinations\n", TRANSPORT_SUBSET_GROUP_ID(slot), length);
+  return TRANSPORT_SUBSET_GROUP_ID(slot);
+}
+
 static void
 transport_callback(transmission_result_t * transmission_result)
 {
@@ -71,53 +182,70 @@ transport_tx_failed(node_id_t node_id)
 static void
 transport_tx(void)
 {
-  transport_queue_item_t queue_item = { 0 };
+  transport_descriptor_t *descriptor;
+  zaf_tx_options_t *zaf_tx_options;
   TRANSMIT_OPTIONS_TYPE_EX *tx_options_ex;
   TRANSMIT_OPTIONS_TYPE_SINGLE_EX tx_options_single_ex = { 0 };
   MULTICHAN_NODE_ID node_id = { 0 };
+  node_id_t dest_node_id;
+  bool queued;
 
-  if (xQueueReceive(transport_queue_handle, &queue_item, 0) == pdPASS) {
+  descriptor = transport_lane_pop();
+  if (descriptor) {
     DPRINT("Transmitting frame\n");
     transport_busy = true;
 
-    transport_pending_callback = queue_item.callback;
-    if (queue_item.zaf_tx_options.dest_node_id) {
+    transport_pending_callback = descriptor->callback;
+    zaf_tx_options = &descriptor->zaf_tx_options;
+    if (zaf_tx_options->dest_node_id) {
       /* Setup tx_options_ex like ReqNodeList does */
-      if (queue_item.zaf_tx_options.use_supervision) {
+      if (zaf_tx_options->use_supervision) {
         tx_options_single_ex.txSecOptions = S2_TXOPTION_VERIFY_DELIVERY;
       } else {
         tx_options_single_ex.txSecOptions = 0;
       }
-      tx_options_single_ex.txOptions = queue_item.zaf_tx_options.tx_options;
-      tx_options_single_ex.sourceEndpoint = queue_item.zaf_tx_options.source_endpoint;
+      tx_options_single_ex.txOptions = zaf_tx_options->tx_options;
+      tx_options_single_ex.sourceEndpoint = zaf_tx_options->source_endpoint;
       tx_options_single_ex.pDestNode = &node_id;
 
       /* Setup destination node information */
-      node_id.node.nodeId = queue_item.zaf_tx_options.dest_node_id;
-      node_id.node.BitAddress = queue_item.zaf_tx_options.bit_addressing;
-      node_id.node.endpoint = queue_item.zaf_tx_options.dest_endpoint & 0x7FU;
-      node_id.nodeInfo.BitMultiChannelEncap = (queue_item.zaf_tx_options.source_endpoint) ? true : false;
-      node_id.nodeInfo.security = queue_item.zaf_tx_options.security_key;
-
-      if (ZAF_Transmit((uint8_t *) &queue_item.frame,
-                       queue_item.frame_length,
-                       &tx_options_single_ex,
-                       transport_callback) != ZAF_ENQUEUE_STATUS_SUCCESS) {
-        transport_tx_failed(queue_item.zaf_tx_options.dest_node_id);
-      }
+      node_id.node.nodeId = zaf_tx_options->dest_node_id;
+      node_id.node.BitAddress = zaf_tx_options->bit_addressing;
+      node_id.node.endpoint = zaf_tx_options->dest_endpoint & 0x7FU;
+      node_id.nodeInfo.BitMultiChannelEncap = (zaf_tx_options->source_endpoint) ? true : false;
+      node_id.nodeInfo.security = zaf_tx_options->security_key;
+
+      queued = ZAF_Transmit((uint8_t *) &descriptor->frame,
+                            descriptor->frame_length,
+                            &tx_options_single_ex,
+                            transport_callback) == ZAF_ENQUEUE_STATUS_SUCCESS;
     } else {
       /* Get transmit options (node list) */
-      tx_options_ex = ReqNodeList(queue_item.zaf_tx_options.agi_profile,
-                                  (cc_group_t *)&queue_item.frame,
-                                  queue_item.zaf_tx_options.source_endpoint);
-      if (!tx_options_ex || ZW_TransportMulticast_SendRequest(
-            (uint8_t *) &queue_item.frame,
-            queue_item.frame_length,
-            queue_item.zaf_tx_options.use_supervision,
-            tx_options_ex,
-            transport_callback) != ETRANSPORTMULTICAST_ADDED_TO_QUEUE) {
-        transport_tx_failed(queue_item.zaf_tx_options.dest_node_id);
+      tx_options_ex = ReqNodeList(zaf_tx_options->agi_profile,
+                                  (cc_group_t *)&descriptor->frame,
+                                  zaf_tx_options->source_endpoint);
+      if (tx_options_ex && zaf_tx_options->dest_node_list) {
+        /* The given destinations are taken from the group, fewer of them are a subset */
+        if (zaf_tx_options->dest_node_list_length < tx_options_ex->list_length) {
+          tx_options_ex->S2_groupID = transport_subset_group_id(zaf_tx_options->dest_node_list,
+                                                                zaf_tx_options->dest_node_list_length);
+        }
+        tx_options_ex->pList = zaf_tx_options->dest_node_list;
+        tx_options_ex->list_length = zaf_tx_options->dest_node_list_length;
       }
+      queued = tx_options_ex && ZW_TransportMulticast_SendRequest(
+            (uint8_t *) &descriptor->frame,
+            descriptor->frame_length,
+            zaf_tx_options->use_supervision,
+            tx_options_ex,
+            transport_callback) == ETRANSPORTMULTICAST_ADDED_TO_QUEUE;
+    }
+
+    /* The frame has been copied into the protocol queue, so the buffer can be reused already */
+    dest_node_id = zaf_tx_options->dest_node_id;
+    transport_descriptor_free(descriptor);
+    if (!queued) {
+      transport_tx_failed(dest_node_id);
     }
   } else {
     DPRINT("No more frames to transmit\n");
@@ -125,25 +253,73 @@ transport_tx(void)
   }
 }
 
+ZW_APPLICATION_TX_BUFFER *
+zaf_transport_tx_frame_alloc(zaf_transport_priority_t priority)
+{
+  transport_descriptor_t *descriptor = transport_free_list;
+
+  if (priority >= ZAF_TRANSPORT_PRIORITY_COUNT) {
+    return NULL;
+  }
+  if (!descriptor
+      || ((priority == ZAF_TRANSPORT_PRIORITY_LOW)
+          && (transport_free_count <= ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED))) {
+    DPRINTF("No free frame buffer for priority %d\n", priority);
+    transport_lanes[priority].stats.dropped++;
+    return NULL;
+  }
+
+  transport_free_list = descriptor->next;
+  transport_free_count--;
+  descriptor->next = NULL;
+  descriptor->priority = priority;
+  descriptor->state = TRANSPORT_DESCRIPTOR_ALLOCATED;
+  return &descriptor->frame;
+}
+
+void
+zaf_transport_tx_frame_free(ZW_APPLICATION_TX_BUFFER *frame)
+{
+  transport_descriptor_t *descriptor = transport_descriptor_get(frame);
+
+  if (descriptor && (descriptor->state == TRANSPORT_DESCRIPTOR_ALLOCATED)) {
+    transport_descriptor_free(descriptor);
+  }
+}
+
 bool
-zaf_transport_tx(const uint8_t *frame, uint8_t frame_length,
-                 zaf_tx_callback_t callback, zaf_tx_options_t *zaf_tx_options)
+zaf_transport_tx_frame_send(ZW_APPLICATION_TX_BUFFER *frame, uint8_t frame_length,
+                            zaf_tx_callback_t callback, zaf_tx_options_t *zaf_tx_options)
 {
-  BaseType_t ret;
-  transport_queue_item_t queue_item = {
-    .callback = callback,
-    .frame_length = frame_length
-  };
-  memcpy(&queue_item.frame, frame, frame_length);
-  memcpy(&queue_item.zaf_tx_options, zaf_tx_options, sizeof(zaf_tx_options_t));
+  transport_descriptor_t *descriptor = transport_descriptor_get(frame);
+  transport_lane_t *lane;
 
-  DPRINT("Adding new frame to queue\n");
-  ret = xQueueSend(transport_queue_handle, &queue_item, 0);
-  if (ret == pdFAIL) {
-    DPRINT("Failed to add new frame to queue\n");
+  if (!descriptor || (descriptor->state != TRANSPORT_DESCRIPTOR_ALLOCATED)) {
+    DPRINT("Frame is not an allocated pool buffer\n");
     return false;
   }
 
+  descriptor->callback = callback;
+  descriptor->frame_length = frame_length;
+  memcpy(&descriptor->zaf_tx_options, zaf_tx_options, sizeof(zaf_tx_options_t));
+  /* The buffer was taken for this priority, also if the options say otherwise */
+  descriptor->zaf_tx_options.priority = descriptor->priority;
+
+  DPRINTF("Adding new frame to lane %d\n", descriptor->priority);
+  lane = &transport_lanes[descriptor->priority];
+  descriptor->state = TRANSPORT_DESCRIPTOR_QUEUED;
+  descriptor->next = NULL;
+  if (lane->tail) {
+    lane->tail->next = descriptor;
+  } else {
+    lane->head = descriptor;
+  }
+  lane->tail = descriptor;
+  lane->stats.depth++;
+  if (lane->stats.depth > lane->stats.max_depth) {
+    lane->stats.max_depth = lane->stats.depth;
+  }
+
   if (!transport_busy && !transport_queue_paused) {
     transport_tx();
   }
@@ -151,16 +327,57 @@ zaf_transport_tx(const uint8_t *frame, uint8_t frame_length,
   return true;
 }
 
+bool
+zaf_transport_tx(const uint8_t *frame, uint8_t frame_length,
+                 zaf_tx_callback_t callback, zaf_tx_options_t *zaf_tx_options)
+{
+  ZW_APPLICATION_TX_BUFFER *buffer;
+
+  if (frame_length > sizeof(ZW_APPLICATION_TX_BUFFER)) {
+    return false;
+  }
+
+  buffer = zaf_transport_tx_frame_alloc(zaf_tx_options->priority);
+  if (!buffer) {
+    DPRINT("Failed to add new frame to queue\n");
+    return false;
+  }
+  memcpy(buffer, frame, frame_length);
+
+  return zaf_transport_tx_frame_send(buffer, frame_length, callback, zaf_tx_options);
+}
+
+void
+zaf_transport_get_lane_stats(zaf_transport_priority_t priority, zaf_transport_lane_stats_t *stats)
+{
+  if (priority < ZAF_TRANSPORT_PRIORITY_COUNT) {
+    memcpy(stats, &transport_lanes[priority].stats, sizeof(zaf_transport_lane_stats_t));
+  }
+}
+
+void
+zaf_transport_reset_lane_stats(void)
+{
+  for (uint8_t i = 0; i < ZAF_TRANSPORT_PRIORITY_COUNT; i++) {
+    transport_lanes[i].stats.max_depth = transport_lanes[i].stats.depth;
+    transport_lanes[i].stats.sent = 0;
+    transport_lanes[i].stats.dropped = 0;
+  }
+}
+
 void
 zaf_transport_init(void)
 {
   transport_busy = false;
   transport_queue_paused = false;
-  memset(transport_queue_buffer, 0, sizeof(transport_queue_buffer));
-  transport_queue_handle = xQueueCreateStatic(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE,
-                                              ZAF_TRANSPORT_QUEUE_ITEM_SIZE,
-                                              transport_queue_buffer,
-                                              &transport_queue);
+  memset(transport_lanes, 0, sizeof(transport_lanes));
+  memset(transport_subsets, 0, sizeof(transport_subsets));
+  transport_subset_next = 0;
+  transport_free_list = NULL;
+  transport_free_count = 0;
+  for (uint8_t i = TRANSPORT_POOL_SIZE; i > 0; i--) {
+    transport_descriptor_free(&transport_pool[i - 1]);
+  }
   DPRINT("zaf transport init\n");
 }
 
@@ -196,4 +413,7 @@ zaf_transport_rx_to_tx_options(RECEIVE_OPTIONS_TYPE_EX *rx_options,
   }
   tx_options->source_endpoint = rx_options->destNode.endpoint;
   tx_options->use_supervision = false;
+  tx_options->dest_node_list = NULL;
+  tx_options->dest_node_list_length = 0;
+  tx_options->priority = ZAF_TRANSPORT_PRIORITY_HIGH;
 }
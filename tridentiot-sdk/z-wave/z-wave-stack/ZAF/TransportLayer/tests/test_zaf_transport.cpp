@@ -0,0 +1,419 @@
+/**
+ * @file
+ *
+ * Tests of the transmit queue of the ZAF transport layer.
+ */
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+  #include "unity.h"
+  #include "zaf_transport_tx.h"
+  #include "ZW_TransportEndpoint_mock.h"
+  #include "ZW_TransportMulticast_mock.h"
+  #include "association_plus_base_mock.h"
+  #include "zaf_transport_config.h"
+}
+
+#define GROUP_NODE_COUNT  3
+#define LIFELINE_S2_GROUP_ID  1
+#define POOL_SIZE  (ZAF_TRANSPORT_CONFIG_QUEUE_SIZE + ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED)
+#define MAX_FRAMES  8
+
+static MULTICHAN_NODE_ID group_nodes[CC_ASSOCIATION_MAX_NODES_IN_GROUP];
+static TRANSMIT_OPTIONS_TYPE_EX group_tx_options;
+
+static ZAF_TX_Callback_t multicast_callback;
+static uint8_t multicast_group_id;
+static MULTICHAN_NODE_ID *multicast_list;
+static uint8_t multicast_list_length;
+
+static uint8_t tx_callback_count;
+static uint8_t tx_callback_status;
+
+static ZAF_TX_Callback_t singlecast_callback;
+static EZAF_EnqueueStatus_t singlecast_status;
+// First octet of every frame passed to ZAF_Transmit()
+static uint8_t singlecast_frames[MAX_FRAMES];
+static uint8_t singlecast_count;
+
+static TRANSMIT_OPTIONS_TYPE_EX *
+ReqNodeList_callback(AGI_PROFILE const * const pProfile,
+                     cc_group_t const * const pCurrentCmdGrp,
+                     const uint8_t sourceEndpoint,
+                     int cmock_num_calls)
+{
+  (void)pProfile;
+  (void)pCurrentCmdGrp;
+  (void)cmock_num_calls;
+
+  /* Like ReqNodeList(), the whole lifeline group every time */
+  group_tx_options.S2_groupID = (uint8_t)(LIFELINE_S2_GROUP_ID + (sourceEndpoint << 4));
+  group_tx_options.txOptions = 0;
+  group_tx_options.sourceEndpoint = sourceEndpoint;
+  group_tx_options.pList = group_nodes;
+  group_tx_options.list_length = GROUP_NODE_COUNT;
+  return &group_tx_options;
+}
+
+static enum ETRANSPORT_MULTICAST_STATUS
+ZW_TransportMulticast_SendRequest_callback(const uint8_t * const p_data,
+                                           uint8_t data_length,
+                                           uint8_t fSupervisionEnable,
+                                           TRANSMIT_OPTIONS_TYPE_EX * p_nodelist,
+                                           ZAF_TX_Callback_t p_callback,
+                                           int cmock_num_calls)
+{
+  (void)p_data;
+  (void)data_length;
+  (void)fSupervisionEnable;
+  (void)cmock_num_calls;
+
+  multicast_callback = p_callback;
+  multicast_group_id = p_nodelist->S2_groupID;
+  multicast_list = p_nodelist->pList;
+  multicast_list_length = p_nodelist->list_length;
+  return ETRANSPORTMULTICAST_ADDED_TO_QUEUE;
+}
+
+static EZAF_EnqueueStatus_t
+ZAF_Transmit_callback(uint8_t* pData,
+                      size_t dataLength,
+                      TRANSMIT_OPTIONS_TYPE_SINGLE_EX* pTxOptionsEx,
+                      ZAF_TX_Callback_t pCallback,
+                      int cmock_num_calls)
+{
+  (void)dataLength;
+  (void)pTxOptionsEx;
+  (void)cmock_num_calls;
+
+  TEST_ASSERT_TRUE(singlecast_count < MAX_FRAMES);
+  singlecast_frames[singlecast_count++] = pData[0];
+  singlecast_callback = pCallback;
+  return singlecast_status;
+}
+
+static void tx_callback(transmission_result_t * pTxResult)
+{
+  tx_callback_status = pTxResult->status;
+  tx_callback_count++;
+}
+
+/**
+ * Ends the transmission of the frame handed to ZAF_Transmit() last.
+ */
+static void finish_singlecast(void)
+{
+  transmission_result_t result;
+  ZAF_TX_Callback_t callback = singlecast_callback;
+
+  memset(&result, 0, sizeof(result));
+  result.status = TRANSMIT_COMPLETE_OK;
+  result.isFinished = TRANSMISSION_RESULT_FINISHED;
+  TEST_ASSERT_NOT_NULL(callback);
+  singlecast_callback = NULL;
+  callback(&result);
+}
+
+/**
+ * Queues a frame to node 2 whose first octet is id.
+ */
+static bool send_frame(uint8_t id, zaf_transport_priority_t priority)
+{
+  uint8_t frame[] = {id, 0x00};
+  zaf_tx_options_t tx_options;
+
+  memset(&tx_options, 0, sizeof(tx_options));
+  tx_options.dest_node_id = 2;
+  tx_options.priority = priority;
+  return zaf_transport_tx(frame, sizeof(frame), tx_callback, &tx_options);
+}
+
+/**
+ * @return The number of buffers that can be taken from the pool, which are given back.
+ */
+static uint8_t count_free_buffers(void)
+{
+  ZW_APPLICATION_TX_BUFFER *buffers[POOL_SIZE + 1];
+  uint8_t count = 0;
+
+  while (count <= POOL_SIZE) {
+    buffers[count] = zaf_transport_tx_frame_alloc(ZAF_TRANSPORT_PRIORITY_HIGH);
+    if (!buffers[count]) {
+      break;
+    }
+    count++;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    zaf_transport_tx_frame_free(buffers[i]);
+  }
+  return count;
+}
+
+static void finish_multicast(void)
+{
+  transmission_result_t result;
+
+  memset(&result, 0, sizeof(result));
+  result.status = TRANSMIT_COMPLETE_OK;
+  result.isFinished = TRANSMISSION_RESULT_FINISHED;
+  TEST_ASSERT_NOT_NULL(multicast_callback);
+  multicast_callback(&result);
+  multicast_callback = NULL;
+}
+
+/**
+ * Sends a lifeline report to the destinations of the group from first on.
+ * A list shorter than the group ends with a free entry, like the TSE builds it.
+ * @return S2 group ID of the multicast.
+ */
+static uint8_t send_to_group_nodes(MULTICHAN_NODE_ID *list, uint8_t first, uint8_t count)
+{
+  uint8_t frame[] = {0x20, 0x03, 0xFF};
+  zaf_tx_options_t tx_options;
+
+  memset(list, 0, CC_ASSOCIATION_MAX_NODES_IN_GROUP * sizeof(MULTICHAN_NODE_ID));
+  memcpy(list, &group_nodes[first], count * sizeof(MULTICHAN_NODE_ID));
+
+  memset(&tx_options, 0, sizeof(tx_options));
+  tx_options.dest_node_list = list;
+  tx_options.dest_node_list_length = count;
+  tx_options.priority = ZAF_TRANSPORT_PRIORITY_LOW;
+
+  multicast_group_id = 0;
+  TEST_ASSERT_TRUE(zaf_transport_tx(frame, sizeof(frame), tx_callback, &tx_options));
+  TEST_ASSERT_EQUAL_PTR(list, multicast_list);
+  TEST_ASSERT_EQUAL_UINT8(count, multicast_list_length);
+  finish_multicast();
+  return multicast_group_id;
+}
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  memset(group_nodes, 0, sizeof(group_nodes));
+  for (uint8_t i = 0; i < GROUP_NODE_COUNT; i++) {
+    group_nodes[i].node.nodeId = (node_id_t)(i + 1);
+  }
+  multicast_callback = NULL;
+  tx_callback_count = 0;
+  tx_callback_status = TRANSMIT_COMPLETE_OK;
+  singlecast_callback = NULL;
+  singlecast_status = ZAF_ENQUEUE_STATUS_SUCCESS;
+  singlecast_count = 0;
+
+  ZAF_Transmit_Stub(ZAF_Transmit_callback);
+  ReqNodeList_Stub(ReqNodeList_callback);
+  ZW_TransportMulticast_SendRequest_Stub(ZW_TransportMulticast_SendRequest_callback);
+  zaf_transport_init();
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * A list with every destination of the group keeps the S2 group ID of the group.
+ */
+void test_multicast_to_whole_group_keeps_group_id(void)
+{
+  MULTICHAN_NODE_ID list[CC_ASSOCIATION_MAX_NODES_IN_GROUP];
+
+  TEST_ASSERT_EQUAL_UINT8(LIFELINE_S2_GROUP_ID, send_to_group_nodes(list, 0, GROUP_NODE_COUNT));
+  TEST_ASSERT_EQUAL_UINT8(1, tx_callback_count);
+}
+
+/**
+ * A list with fewer destinations than the group, e.g. without the node that triggered a
+ * TSE report, gets a group ID of its own. It keeps that ID, and every other subset gets
+ * another one.
+ */
+void test_multicast_to_subset_uses_own_group_id(void)
+{
+  MULTICHAN_NODE_ID list[CC_ASSOCIATION_MAX_NODES_IN_GROUP];
+
+  const uint8_t without_first = send_to_group_nodes(list, 1, GROUP_NODE_COUNT - 1);
+  TEST_ASSERT_NOT_EQUAL(LIFELINE_S2_GROUP_ID, without_first);
+  TEST_ASSERT_EQUAL_HEX8(0, without_first & 0x0F);
+
+  const uint8_t without_last = send_to_group_nodes(list, 0, GROUP_NODE_COUNT - 1);
+  TEST_ASSERT_NOT_EQUAL(LIFELINE_S2_GROUP_ID, without_last);
+  TEST_ASSERT_NOT_EQUAL(without_first, without_last);
+
+  TEST_ASSERT_EQUAL_UINT8(without_first, send_to_group_nodes(list, 1, GROUP_NODE_COUNT - 1));
+  TEST_ASSERT_EQUAL_UINT8(LIFELINE_S2_GROUP_ID, send_to_group_nodes(list, 0, GROUP_NODE_COUNT));
+  TEST_ASSERT_EQUAL_UINT8(without_last, send_to_group_nodes(list, 0, GROUP_NODE_COUNT - 1));
+  TEST_ASSERT_EQUAL_UINT8(5, tx_callback_count);
+}
+
+/**
+ * Frames queued while a frame is being transmitted go out high priority lane first, and in
+ * the order they were queued within a lane.
+ */
+void test_high_priority_lane_first(void)
+{
+  /* The first frame is handed to the protocol right away and its buffer is free again */
+  TEST_ASSERT_TRUE(send_frame(1, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_TRUE(send_frame(2, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_TRUE(send_frame(3, ZAF_TRANSPORT_PRIORITY_HIGH));
+  TEST_ASSERT_TRUE(send_frame(4, ZAF_TRANSPORT_PRIORITY_HIGH));
+  TEST_ASSERT_EQUAL_UINT8(1, singlecast_count);
+
+  for (uint8_t i = 1; i < 4; i++) {
+    finish_singlecast();
+    TEST_ASSERT_EQUAL_UINT8(i + 1, singlecast_count);
+  }
+  finish_singlecast();
+
+  const uint8_t expected[] = {1, 3, 4, 2};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, singlecast_frames, sizeof(expected));
+  TEST_ASSERT_EQUAL_UINT8(4, tx_callback_count);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SIZE, count_free_buffers());
+}
+
+/**
+ * Low priority frames cannot take the buffers reserved for high priority ones. Frames that
+ * find no buffer are counted as dropped in their lane, queued ones in the depth.
+ */
+void test_reserved_high_priority_buffer(void)
+{
+  zaf_transport_lane_stats_t low;
+  zaf_transport_lane_stats_t high;
+  uint8_t id = 1;
+
+  zaf_transport_pause();
+  for (uint8_t i = 0; i < ZAF_TRANSPORT_CONFIG_QUEUE_SIZE; i++) {
+    TEST_ASSERT_TRUE(send_frame(id++, ZAF_TRANSPORT_PRIORITY_LOW));
+  }
+  TEST_ASSERT_FALSE(send_frame(id++, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_NULL(zaf_transport_tx_frame_alloc(ZAF_TRANSPORT_PRIORITY_LOW));
+
+  for (uint8_t i = 0; i < ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED; i++) {
+    TEST_ASSERT_TRUE(send_frame(id++, ZAF_TRANSPORT_PRIORITY_HIGH));
+  }
+  TEST_ASSERT_FALSE(send_frame(id++, ZAF_TRANSPORT_PRIORITY_HIGH));
+  TEST_ASSERT_EQUAL_UINT8(0, singlecast_count);
+
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_LOW, &low);
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_HIGH, &high);
+  TEST_ASSERT_EQUAL_UINT8(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE, low.depth);
+  TEST_ASSERT_EQUAL_UINT8(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE, low.max_depth);
+  TEST_ASSERT_EQUAL_UINT32(2, low.dropped);
+  TEST_ASSERT_EQUAL_UINT32(0, low.sent);
+  TEST_ASSERT_EQUAL_UINT8(ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED, high.depth);
+  TEST_ASSERT_EQUAL_UINT32(1, high.dropped);
+
+  zaf_transport_resume();
+  for (uint8_t i = 0; i < POOL_SIZE; i++) {
+    finish_singlecast();
+  }
+  TEST_ASSERT_EQUAL_UINT8(POOL_SIZE, singlecast_count);
+
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_LOW, &low);
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_HIGH, &high);
+  TEST_ASSERT_EQUAL_UINT8(0, low.depth);
+  TEST_ASSERT_EQUAL_UINT8(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE, low.max_depth);
+  TEST_ASSERT_EQUAL_UINT32(ZAF_TRANSPORT_CONFIG_QUEUE_SIZE, low.sent);
+  TEST_ASSERT_EQUAL_UINT32(ZAF_TRANSPORT_CONFIG_HIGH_PRIORITY_RESERVED, high.sent);
+
+  zaf_transport_reset_lane_stats();
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_LOW, &low);
+  TEST_ASSERT_EQUAL_UINT8(0, low.max_depth);
+  TEST_ASSERT_EQUAL_UINT32(0, low.sent);
+  TEST_ASSERT_EQUAL_UINT32(0, low.dropped);
+}
+
+/**
+ * A frame the protocol refuses is reported as failed, and its buffer goes back to the pool.
+ */
+void test_refused_transmit_frees_buffer(void)
+{
+  singlecast_status = ZAF_ENQUEUE_STATUS_TIMEOUT;
+  TEST_ASSERT_TRUE(send_frame(1, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_EQUAL_UINT8(1, tx_callback_count);
+  TEST_ASSERT_EQUAL_UINT8(TRANSMIT_COMPLETE_FAIL, tx_callback_status);
+
+  /* Not busy any more */
+  singlecast_status = ZAF_ENQUEUE_STATUS_SUCCESS;
+  TEST_ASSERT_TRUE(send_frame(2, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_EQUAL_UINT8(2, singlecast_count);
+  finish_singlecast();
+  TEST_ASSERT_EQUAL_UINT8(POOL_SIZE, count_free_buffers());
+}
+
+/**
+ * A buffer built in place waits in the lane of the priority it was allocated for, whatever
+ * the priority in the options passed to send.
+ */
+void test_frame_send_uses_allocated_priority(void)
+{
+  zaf_transport_lane_stats_t low;
+  zaf_transport_lane_stats_t high;
+  zaf_tx_options_t tx_options;
+
+  zaf_transport_pause();
+  ZW_APPLICATION_TX_BUFFER *frame = zaf_transport_tx_frame_alloc(ZAF_TRANSPORT_PRIORITY_LOW);
+  TEST_ASSERT_NOT_NULL(frame);
+
+  memset(&tx_options, 0, sizeof(tx_options));
+  tx_options.dest_node_id = 2;
+  tx_options.priority = ZAF_TRANSPORT_PRIORITY_HIGH;
+  TEST_ASSERT_TRUE(zaf_transport_tx_frame_send(frame, 2, tx_callback, &tx_options));
+
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_LOW, &low);
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_HIGH, &high);
+  TEST_ASSERT_EQUAL_UINT8(1, low.depth);
+  TEST_ASSERT_EQUAL_UINT8(0, high.depth);
+
+  /* The reserved buffer is still free for a high priority frame */
+  TEST_ASSERT_TRUE(send_frame(2, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_FALSE(send_frame(3, ZAF_TRANSPORT_PRIORITY_LOW));
+  TEST_ASSERT_TRUE(send_frame(4, ZAF_TRANSPORT_PRIORITY_HIGH));
+
+  zaf_transport_resume();
+  for (uint8_t i = 0; i < 3; i++) {
+    finish_singlecast();
+  }
+  TEST_ASSERT_EQUAL_UINT8(POOL_SIZE, count_free_buffers());
+}
+
+/**
+ * A buffer can only be sent or freed once. A queued buffer is not queued again, nor given
+ * back to the pool while it waits.
+ */
+void test_frame_send_rejects_queued_frame(void)
+{
+  zaf_transport_lane_stats_t low;
+  zaf_tx_options_t tx_options;
+
+  zaf_transport_pause();
+  ZW_APPLICATION_TX_BUFFER *frame = zaf_transport_tx_frame_alloc(ZAF_TRANSPORT_PRIORITY_LOW);
+  TEST_ASSERT_NOT_NULL(frame);
+
+  memset(&tx_options, 0, sizeof(tx_options));
+  tx_options.dest_node_id = 2;
+  TEST_ASSERT_TRUE(zaf_transport_tx_frame_send(frame, 2, tx_callback, &tx_options));
+  TEST_ASSERT_FALSE(zaf_transport_tx_frame_send(frame, 2, tx_callback, &tx_options));
+  zaf_transport_tx_frame_free(frame);
+
+  zaf_transport_get_lane_stats(ZAF_TRANSPORT_PRIORITY_LOW, &low);
+  TEST_ASSERT_EQUAL_UINT8(1, low.depth);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SIZE - 1, count_free_buffers());
+
+  zaf_transport_resume();
+  finish_singlecast();
+  TEST_ASSERT_EQUAL_UINT8(1, singlecast_count);
+  TEST_ASSERT_EQUAL_UINT8(1, tx_callback_count);
+
+  /* Sent and back in the pool */
+  TEST_ASSERT_FALSE(zaf_transport_tx_frame_send(frame, 2, tx_callback, &tx_options));
+  zaf_transport_tx_frame_free(frame);
+  TEST_ASSERT_EQUAL_UINT8(POOL_SIZE, count_free_buffers());
+}
@@ -1954,3 +1954,109 @@ void test_filter_add_invalid_frame_types(void)
   TEST_ASSERT_EQUAL(INVALID_PARAMETERS, actualVal);
 }
 
+
+/** Verification that the hit counter of a filter counts the frames passed to its frame handler,
+ *  and that frames from another network are discarded when filters accept other home ids only.
+ */
+void test_receive_filter_hits(void)
+{
+  mock_t* p_mock = NULL;
+  zpal_radio_rx_parameters_t rxParameters = {
+    .speed = ZPAL_RADIO_SPEED_40K,
+    .channel_id = 1,
+    .channel_header_format = ZPAL_RADIO_HEADER_TYPE_2CH,
+    .rssi = 0
+  };
+
+  uint8_t          infoGetFrame[] = {0xca, 0xfe, 0xba, 0xbf, 0x01, 0x51, 0x0a, 0x0c, 0x02,
+                                     0x5e, 0x01,
+                                     0xc5};
+
+  uint8_t          infoGetFrameOtherNetwork[] = {0xde, 0xad, 0xbe, 0xef, 0x01, 0x51, 0x0a, 0x0c, 0x02,
+                                                 0x5e, 0x01,
+                                                 0xc5};
+
+  ZW_ReturnCode_t actualVal;
+  uint32_t hits;
+  zpal_radio_profile_t radioProfile = { REGION_EU, ZPAL_RADIO_WAKEUP_ALWAYS_LISTEN };
+  helper_func_expect_radio_init_eu(&radioProfile, p_mock);
+  actualVal = llInit(&radioProfile);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+
+  ZW_ReceiveFilter_t rxFilter0 = {.homeId = {{0xCA, 0xFE, 0xBA, 0xBF}},
+                                  .destinationNodeId = 0x02,
+                                  .headerType = 0x01,                                 // Single Cast
+                                  .flag = HOMEID_FILTER_FLAG | DESTINATION_NODE_ID_FILTER_FLAG,
+                                  .frameHandler = testFilter0Callback};
+
+  ZW_ReceiveFilter_t rxFilter1 = {.homeId = {{0xCA, 0xFE, 0xBA, 0xBF}},
+                                  .payloadIndex1 = 0x01, .payloadFilterValue1 = 0x01,
+                                  .headerType = 0x01,                                 // Single Cast
+                                  .flag = HOMEID_FILTER_FLAG | PAYLOAD_INDEX_1_FILTER_FLAG,
+                                  .frameHandler = testFilter1Callback};
+
+  // Not added filters have no counter.
+  actualVal = llReceiveFilterGetHits(&rxFilter0, &hits);
+  TEST_ASSERT_EQUAL(INVALID_PARAMETERS, actualVal);
+
+  actualVal = llReceiveFilterAdd(&rxFilter1);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  actualVal = llReceiveFilterAdd(&rxFilter0);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+
+  // Frame from another network.
+  mp_zpal_received_frame->frame_content_length = sizeof(infoGetFrameOtherNetwork);
+  memcpy(mp_zpal_received_frame->frame_content, infoGetFrameOtherNetwork, mp_zpal_received_frame->frame_content_length);
+  radioProfile.receive_handler_cb(&rxParameters, mp_zpal_received_frame);
+  TEST_ASSERT_FALSE(mTestFilter0Called);
+  TEST_ASSERT_FALSE(mTestFilter1Called);
+
+  // Frame to node 2, matching the filter with highest flag value.
+  mp_zpal_received_frame->frame_content_length = sizeof(infoGetFrame);
+  memcpy(mp_zpal_received_frame->frame_content, infoGetFrame, mp_zpal_received_frame->frame_content_length);
+  radioProfile.receive_handler_cb(&rxParameters, mp_zpal_received_frame);
+  radioProfile.receive_handler_cb(&rxParameters, mp_zpal_received_frame);
+  TEST_ASSERT_TRUE(mTestFilter0Called);
+  TEST_ASSERT_FALSE(mTestFilter1Called);
+
+  actualVal = llReceiveFilterGetHits(&rxFilter0, &hits);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  TEST_ASSERT_EQUAL_UINT32(2, hits);
+  actualVal = llReceiveFilterGetHits(&rxFilter1, &hits);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  TEST_ASSERT_EQUAL_UINT32(0, hits);
+
+  // Frame to node 3, matching the payload filter.
+  infoGetFrame[8] = 0x03;
+  memcpy(mp_zpal_received_frame->frame_content, infoGetFrame, mp_zpal_received_frame->frame_content_length);
+  radioProfile.receive_handler_cb(&rxParameters, mp_zpal_received_frame);
+  TEST_ASSERT_TRUE(mTestFilter1Called);
+
+  actualVal = llReceiveFilterGetHits(&rxFilter1, &hits);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  TEST_ASSERT_EQUAL_UINT32(1, hits);
+
+  // Paused filters do not count frames.
+  mTestFilter1Called = false;
+  llReceiveFilterPause(true);
+  radioProfile.receive_handler_cb(&rxParameters, mp_zpal_received_frame);
+  TEST_ASSERT_FALSE(mTestFilter1Called);
+  llReceiveFilterPause(false);
+
+  actualVal = llReceiveFilterGetHits(&rxFilter1, &hits);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  TEST_ASSERT_EQUAL_UINT32(1, hits);
+
+  // The counter is kept when other filters are removed and cleared when the filter is added again.
+  actualVal = llReceiveFilterRemove(&rxFilter0);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  actualVal = llReceiveFilterGetHits(&rxFilter1, &hits);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  TEST_ASSERT_EQUAL_UINT32(1, hits);
+
+  actualVal = llReceiveFilterAdd(&rxFilter0);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  actualVal = llReceiveFilterGetHits(&rxFilter0, &hits);
+  TEST_ASSERT_EQUAL(SUCCESS, actualVal);
+  TEST_ASSERT_EQUAL_UINT32(0, hits);
+}
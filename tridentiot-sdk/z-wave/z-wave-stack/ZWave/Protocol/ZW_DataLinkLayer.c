@@ -21,6 +21,9 @@
 #include <zpal_radio.h>
 
 //#define DO_CHECKSUM_CHECK
+#ifdef DO_CHECKSUM_CHECK
+#include <CRC.h>
+#endif
 
 //#define DEBUGPRINT
 #include <DebugPrint.h>
@@ -183,6 +186,9 @@
 
 #define PACKET_FILTER_SIZE        5    /**< Number of filters supported by each packet type, SingleCast, Explorer, Routed. */
 
+#define RECEIVE_FILTER_ADDRESS_FLAGS  (HOMEID_FILTER_FLAG | DESTINATION_NODE_ID_FILTER_FLAG | SOURCE_NODE_ID_FILTER_FLAG) /**< Receive filter flags for the frame header fields */
+#define RECEIVE_FILTER_PAYLOAD_FLAGS  (PAYLOAD_INDEX_1_FILTER_FLAG | PAYLOAD_INDEX_2_FILTER_FLAG)                          /**< Receive filter flags for the frame payload */
+
 /**
  * These values are used by the convertTXPowerToIndex() function!
  * These values define the boundary of values that can be converted.
@@ -369,25 +375,29 @@ static const FrameHandlerFunc m_cTransferAckHandlerFunc[] =
 /** Member array containing active communication profiles in the system */
 static CommunicationProfile_t     mCommunicationProfileActive[5] = {PROFILE_UNSUPPORTED, };
 
-static const ZW_ReceiveFilter_t * mSingleCastFilter[PACKET_FILTER_SIZE];       /**< Array containing pointers to single cast receive filters */
-static uint8_t                    mSingleCastFilterPaused[PACKET_FILTER_SIZE]; /**< Array for pausing single cast filters */
-static uint32_t                   mSingleCastFilterIndex;                      /**< Current free index single cast receive filters array */
-
-static const ZW_ReceiveFilter_t * mSingleCastRoutedFilter[PACKET_FILTER_SIZE];      /**< Array containing pointers to single cast routed receive filters */
-static uint8_t                    mSingleCastRoutedFilterPaused[PACKET_FILTER_SIZE];/**< Array for pausing single cast routed filters */
-static uint32_t                   mSingleCastRoutedFilterIndex;                     /**< Current free index single cast routed receive filters array */
-
-static const ZW_ReceiveFilter_t * mExplorerFrameFilter[PACKET_FILTER_SIZE];       /**< Array containing pointers to explorer frame receive filters */
-static uint8_t                    mExplorerFrameFilterPaused[PACKET_FILTER_SIZE]; /**< Array for pausing explorer frame receive filters */
-static uint32_t                   mExplorerFrameFilterIndex;                      /**< Current free index explorer frame receive filters array */
-
-static const ZW_ReceiveFilter_t * mMulticastFrameFilter[PACKET_FILTER_SIZE];       /**< Array containing pointers to multicast frame receive filters */
-static uint8_t                    mMulticastFrameFilterPaused[PACKET_FILTER_SIZE]; /**< Array for pausing multicast frame receive filters */
-static uint32_t                   mMulticastFrameFilterIndex;                      /**< Current free index multicast frame receive filters array */
+/**
+ * Receive filters of one frame type.
+ *
+ * The filters are matched in order, highest flag value first. When the list changes, the active
+ * filters are compiled into a mask of the home id hashes and a mask of the destination node id
+ * hashes they accept, see \ref receiveFilterCompile. A frame whose hashes are not in the masks
+ * cannot match any filter and is rejected without looking at the filters.
+ */
+typedef struct
+{
+  const ZW_ReceiveFilter_t * filter[PACKET_FILTER_SIZE]; /**< Array containing pointers to the receive filters */
+  uint8_t                    paused[PACKET_FILTER_SIZE]; /**< Array for pausing the receive filters */
+  uint32_t                   hits[PACKET_FILTER_SIZE];   /**< Number of frames passed to the frame handler of each filter */
+  uint32_t                   count;                      /**< Current free index in the receive filters array */
+  uint32_t                   homeIdMask;                 /**< Home id hashes accepted by the active filters */
+  uint32_t                   destinationMask;            /**< Destination node id hashes accepted by the active filters */
+} ReceiveFilterList_t;
 
-static const ZW_ReceiveFilter_t * mTransferAckFilter[PACKET_FILTER_SIZE];       /**< Array containing pointers to acknowledge frame receive filters */
-static uint8_t                    mTransferAckFilterPaused[PACKET_FILTER_SIZE]; /**< Array for pausing acknowledge frame receive filters */
-static uint32_t                   mTransferAckFilterIndex;                      /**< Current free index acknowledge frame receive filters array */
+static ReceiveFilterList_t mSingleCastFilters;      /**< Single cast receive filters */
+static ReceiveFilterList_t mSingleCastRoutedFilters; /**< Single cast routed receive filters */
+static ReceiveFilterList_t mExplorerFrameFilters;   /**< Explorer frame receive filters */
+static ReceiveFilterList_t mMulticastFrameFilters;  /**< Multicast frame receive filters */
+static ReceiveFilterList_t mTransferAckFilters;     /**< Acknowledge frame receive filters */
 
 
 static uint16_t  mWakeupBeamTimeLength = 0;  //Time in ms of last continous wake up beam fragment
@@ -574,32 +584,9 @@ static void xorCalculator(uint8_t length, uint8_t *pData)
 }
 
 
-static uint16_t crc16CcittCalc(uint8_t length, uint8_t *pData)
-{
-  uint8_t bitMask;
-  uint8_t newBit;
-  uint16_t crc16 = CRC_INITAL_VALUE;
-  uint32_t i;
-
-  for (i = 0; i < length; i++)
-  {
-    for (bitMask = 0x80; bitMask != 0; bitMask >>= 1)
-    {
-      /* Align test bit with next bit of the message byte, starting with msb. */
-      newBit = ((pData[i] & bitMask) != 0) ^ ((crc16 & 0x8000) != 0);
-      crc16 <<= 1;
-      if (newBit)
-      {
-        crc16 ^= 0x1021;
-      }
-    } /* for (bitMask = 0x80; bitMask != 0; bitMask >>= 1) */
-  }
-  return crc16;
-}
-
 static bool doCrc16Check(uint16_t crc16ToTest, uint8_t dataLength, uint8_t *pData)
 {
-  uint16_t crc16 = crc16CcittCalc(dataLength, pData);
+  uint16_t crc16 = CRC_CheckCrc16(CRC_INITAL_VALUE, pData, dataLength);
 
   return (crc16 == crc16ToTest);
 }
@@ -614,7 +601,7 @@ static bool doCrc16Check(uint16_t crc16ToTest, uint8_t dataLength, uint8_t *pDat
  */
 static void crcCcittCalculator(uint8_t length, uint8_t *pData)
 {
-  uint16_t crc = crc16CcittCalc(length -2, pData);
+  uint16_t crc = CRC_CheckCrc16(CRC_INITAL_VALUE, pData, length - 2);
   pData[length-2] = crc >> 8;
   pData[length-1] = crc & 0xFF;
 }
@@ -1269,17 +1256,11 @@ ZW_ReturnCode_t llInit(zpal_radio_profile_t* const pRfProfile)
          PROFILE_UNSUPPORTED,
          sizeof(mCommunicationProfileActive));
 
-  mSingleCastFilterIndex        = 0;
-  mSingleCastRoutedFilterIndex  = 0;
-  mExplorerFrameFilterIndex     = 0;
-  mMulticastFrameFilterIndex    = 0;
-  mTransferAckFilterIndex       = 0;
-
-  memset(mSingleCastFilterPaused,       0, sizeof(mSingleCastFilterPaused));
-  memset(mSingleCastRoutedFilterPaused, 0, sizeof(mSingleCastRoutedFilterPaused));
-  memset(mExplorerFrameFilterPaused,    0, sizeof(mExplorerFrameFilterPaused));
-  memset(mMulticastFrameFilterPaused,   0, sizeof(mMulticastFrameFilterPaused));
-  memset(mTransferAckFilterPaused,      0, sizeof(mTransferAckFilterPaused));
+  memset(&mSingleCastFilters,       0, sizeof(mSingleCastFilters));
+  memset(&mSingleCastRoutedFilters, 0, sizeof(mSingleCastRoutedFilters));
+  memset(&mExplorerFrameFilters,    0, sizeof(mExplorerFrameFilters));
+  memset(&mMulticastFrameFilters,   0, sizeof(mMulticastFrameFilters));
+  memset(&mTransferAckFilters,      0, sizeof(mTransferAckFilters));
 
   pRfProfile->receive_handler_cb = radioFrameReceiveHandler;
 
@@ -1633,83 +1614,185 @@ static void extractLRHeader(ZW_ReceiveFrame_t * pReceiveFrame)
 
 }
 
-/**@brief The is the actual function for handling of single cast frames when \ref llReceiveHandler
- *        has determined the frame type to be a Long Range single cast frame.
+/**@brief Function for hashing a home id to a bit in \ref ReceiveFilterList_t::homeIdMask.
  *
- * @param[in] communicationProfile Communication profile used when receiving this frame
- * @param[in] pRxParameters Pointer to the structure with channel and rssi values
- * @param[in] pFrame        Pointer to the received frame. The frame is expected to be located in
- *                          Z-Wave stack reserved memory and allocated throughout lifetime of stack
- *                          processing. Application should copy payload data if required for
- *                          unsynchronized data processing.
+ * @param[in] homeId Home id, as read from the frame or the filter.
+ *
+ * @return Mask with the single bit of the home id hash set.
  */
-static void singlecastLRHandler(__attribute__((unused)) CommunicationProfile_t   communicationProfile,
-                                __attribute__((unused)) zpal_radio_rx_parameters_t      * pRxParameters,
-                                ZW_ReceiveFrame_t     * pFrame)
+static uint32_t receiveFilterHomeIdBit(uint32_t homeId)
 {
-  uint32_t i;
-  frame*   fr = (frame *)pFrame->frameContent;
+  homeId ^= homeId >> 16;
+  homeId ^= homeId >> 8;
+  homeId ^= homeId >> 5;
+  return (1UL << (homeId & 0x1F));
+}
 
-  uint8_t headerLen = sizeof(frameHeaderSinglecastLR) - sizeof(frameHeaderExtensionLR);
-  if (GET_EXTEND_PRESENT_LR(*fr))
+/**@brief Function for hashing a node id to a bit in \ref ReceiveFilterList_t::destinationMask.
+ *
+ * @param[in] nodeId Node id, classic or Long Range.
+ *
+ * @return Mask with the single bit of the node id hash set.
+ */
+static uint32_t receiveFilterNodeIdBit(node_id_t nodeId)
+{
+  return (1UL << ((nodeId ^ (nodeId >> 5) ^ (nodeId >> 10)) & 0x1F));
+}
+
+/**@brief Function for compiling the active filters of a filter list into its reject masks.
+ *
+ * @details Must be invoked every time a filter is added, removed, paused or enabled.
+ *          A filter that does not filter on home id or destination accepts all hashes.
+ *
+ * @param[in,out] pFilterList Pointer to the filter list to compile.
+ */
+static void receiveFilterCompile(ReceiveFilterList_t * pFilterList)
+{
+  pFilterList->homeIdMask      = 0;
+  pFilterList->destinationMask = 0;
+
+  for (uint32_t i = 0; i < pFilterList->count; i++)
   {
-    headerLen +=  1 + (fr->singlecastLR.extension.extensionInfo & MASK_EXTENSION_LENGTH_LR);
+    const ZW_ReceiveFilter_t * pFilter = pFilterList->filter[i];
+
+    if (pFilterList->paused[i])
+    {
+      continue;
+    }
+
+    pFilterList->homeIdMask |= (pFilter->flag & HOMEID_FILTER_FLAG) ?
+                               receiveFilterHomeIdBit(pFilter->homeId.word) : UINT32_MAX;
+    pFilterList->destinationMask |= (pFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) ?
+                                    receiveFilterNodeIdBit(pFilter->destinationNodeId) : UINT32_MAX;
   }
+}
 
+/**@brief Function for finding the first active filter in a filter list matching a received frame.
+ *
+ * @details Frames from other networks or to other nodes are rejected by the masks compiled by
+ *          \ref receiveFilterCompile, before any filter is compared.
+ *          The hit counter of the matching filter is incremented.
+ *
+ * @param[in,out] pFilterList         Pointer to the filter list for the frame type.
+ * @param[in]     pFrame              Pointer to the received frame.
+ * @param[in]     flagMask            Filter flags that apply to the frame type, other flags in
+ *                                    the filters are ignored.
+ * @param[in]     destinationNodeId   Destination node id of the frame.
+ * @param[in]     sourceNodeId        Source node id of the frame.
+ * @param[in]     payloadLengthOffset Header length used for checking that a payload index is
+ *                                    within the frame.
+ * @param[in]     payloadOffset       Header length used for reading the payload at a payload index.
+ *
+ * @return Pointer to the matching filter or NULL if no filter matches the frame.
+ */
+static const ZW_ReceiveFilter_t * receiveFilterMatch(ReceiveFilterList_t     * pFilterList,
+                                                     const ZW_ReceiveFrame_t * pFrame,
+                                                     uint8_t                   flagMask,
+                                                     node_id_t                 destinationNodeId,
+                                                     node_id_t                 sourceNodeId,
+                                                     uint32_t                  payloadLengthOffset,
+                                                     uint32_t                  payloadOffset)
+{
+  uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                    // Use pHomeId to avoid GCC type punned pointer error
+
+  if ((0 == (pFilterList->homeIdMask & receiveFilterHomeIdBit(*pHomeId))) ||                     // No active filter accepts the home id or destination
+      (0 == (pFilterList->destinationMask & receiveFilterNodeIdBit(destinationNodeId))))          // of the frame, thus discard it without comparing filters.
+  {
+    return NULL;
+  }
 
-  for (i = 0; i < mSingleCastFilterIndex; i++ )
+  for (uint32_t i = 0; i < pFilterList->count; i++)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mSingleCastFilter[i];
+    const ZW_ReceiveFilter_t * currentFilter = pFilterList->filter[i];
+    uint8_t flag = currentFilter->flag & flagMask;
 
-    if (mSingleCastFilterPaused[i])
+    if (pFilterList->paused[i])
     {
       continue;
     }
 
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                  // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                              // Check the filter is configured
+    if ((flag & HOMEID_FILTER_FLAG) &&                                                             // Check the filter is configured
         (currentFilter->homeId.word != *pHomeId))                                                  // If the home id does not match the filter, then continue looping with next filter
     {
       continue;
     }
 
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != GET_SINGLECAST_DESTINATION_NODEID_LR(*fr)))                  // If the destination node does not match the filter, then continue looping with next filter
+    if ((flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                                // Check the filter is configured
+        (currentFilter->destinationNodeId != destinationNodeId))                                   // If the destination node does not match the filter, then continue looping with next filter
     {
       continue;
     }
 
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != GET_SINGLECAST_SOURCE_NODEID_LR(*fr)))                            // If the source node does not match the filter, then continue looping with next filter
+    if ((flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                                     // Check the filter is configured
+        (currentFilter->sourceNodeId != sourceNodeId))                                             // If the source node does not match the filter, then continue looping with next filter
     {
       continue;
     }
 
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (headerLen + currentFilter->payloadIndex1)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[headerLen + currentFilter->payloadIndex1])))
+    if ((flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                                    // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
+          ((pFrame->frameContentLength <= (payloadLengthOffset + currentFilter->payloadIndex1)) || // then discard frame for this filter
+           (currentFilter->payloadFilterValue1 != pFrame->frameContent[payloadOffset + currentFilter->payloadIndex1])))
     {
       continue;
     }
 
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (headerLen + currentFilter->payloadIndex2)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[headerLen + currentFilter->payloadIndex2])))
+    if ((flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                                    // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
+          ((pFrame->frameContentLength <= (payloadLengthOffset + currentFilter->payloadIndex2)) || // then discard frame for this filter
+           (currentFilter->payloadFilterValue2 != pFrame->frameContent[payloadOffset + currentFilter->payloadIndex2])))
     {
       continue;
     }
 
-    pFrame->pPayloadStart = SINGLECAST_PAYLOAD_LR(fr);
+    pFilterList->hits[i]++;
+    return currentFilter;
+  }
 
-    extractLRHeader(pFrame);
+  return NULL;
+}
 
-    pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
+/**@brief The is the actual function for handling of single cast frames when \ref llReceiveHandler
+ *        has determined the frame type to be a Long Range single cast frame.
+ *
+ * @param[in] communicationProfile Communication profile used when receiving this frame
+ * @param[in] pRxParameters Pointer to the structure with channel and rssi values
+ * @param[in] pFrame        Pointer to the received frame. The frame is expected to be located in
+ *                          Z-Wave stack reserved memory and allocated throughout lifetime of stack
+ *                          processing. Application should copy payload data if required for
+ *                          unsynchronized data processing.
+ */
+static void singlecastLRHandler(__attribute__((unused)) CommunicationProfile_t   communicationProfile,
+                                __attribute__((unused)) zpal_radio_rx_parameters_t      * pRxParameters,
+                                ZW_ReceiveFrame_t     * pFrame)
+{
+  frame*   fr = (frame *)pFrame->frameContent;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
+  uint8_t headerLen = sizeof(frameHeaderSinglecastLR) - sizeof(frameHeaderExtensionLR);
+  if (GET_EXTEND_PRESENT_LR(*fr))
+  {
+    headerLen +=  1 + (fr->singlecastLR.extension.extensionInfo & MASK_EXTENSION_LENGTH_LR);
   }
+
+
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mSingleCastFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                GET_SINGLECAST_DESTINATION_NODEID_LR(*fr),
+                                                                GET_SINGLECAST_SOURCE_NODEID_LR(*fr),
+                                                                headerLen,
+                                                                headerLen);
+  if (NULL == currentFilter)
+  {
+    return;
+  }
+
+  pFrame->pPayloadStart = SINGLECAST_PAYLOAD_LR(fr);
+
+  extractLRHeader(pFrame);
+
+  pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
+
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of single cast frames when \ref llReceiveHandler
@@ -1726,7 +1809,6 @@ static void singlecast3chHandler(__attribute__((unused)) CommunicationProfile_t
                                  __attribute__((unused)) zpal_radio_rx_parameters_t       * pRxParameters,
                                  ZW_ReceiveFrame_t      * pFrame)
 {
-  uint32_t i;
   uint8_t headerLen = GENERAL_HEADER_3CH_LENGTH;
   if ((pFrame->frameContent[GENERAL_HEADER_3CH_EXTENDED_INDEX] &
       (1<<EXTENDED_3CH_FRAME_EXTENDEDHEADER_POS)) >> EXTENDED_3CH_FRAME_EXTENDEDHEADER_POS)
@@ -1735,58 +1817,25 @@ static void singlecast3chHandler(__attribute__((unused)) CommunicationProfile_t
   }
 
 
-  for (i = 0; i < mSingleCastFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mSingleCastFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX],
+                                                                headerLen,
+                                                                headerLen);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mSingleCastFilter[i];
-
-    if (mSingleCastFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                  // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                              // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                  // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX])) // If the destination node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (headerLen + currentFilter->payloadIndex1)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[headerLen + currentFilter->payloadIndex1])))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (headerLen + currentFilter->payloadIndex2)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[headerLen + currentFilter->payloadIndex2])))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
 
-    extract3chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
+  extract3chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of single cast frames when \ref llReceiveHandler
@@ -1803,60 +1852,25 @@ static void singlecast2chHandler(__attribute__((unused)) CommunicationProfile_t
                                  __attribute__((unused)) zpal_radio_rx_parameters_t       * pRxParameters,
                                  ZW_ReceiveFrame_t      * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mSingleCastFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mSingleCastFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_2CH_LENGTH,
+                                                                GENERAL_HEADER_2CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mSingleCastFilter[i];
-
-    if (mSingleCastFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                  // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                              // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                  // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX])) // If the destination node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (GENERAL_HEADER_2CH_LENGTH + currentFilter->payloadIndex1)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH + currentFilter->payloadIndex1])))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (GENERAL_HEADER_2CH_LENGTH + currentFilter->payloadIndex2)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH + currentFilter->payloadIndex2])))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
 
-    extract2chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
+  extract2chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 
@@ -1874,64 +1888,30 @@ static void singlecastRouted2chHandler(__attribute__((unused)) CommunicationProf
                                        __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                        ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
   uint32_t routeHeaderLength = 1 + 1 + ((pFrame->frameContent[GENERAL_ROUTED_HEADER_2CH_CONTROL_INDEX] & 0xF0) >> 4);
   // TODO - routeHeaderLength also needs to be corrected for Extended route header if present (extend bit in routeStatus)
 
-  for (i = 0; i < mSingleCastRoutedFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mSingleCastRoutedFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_2CH_LENGTH + routeHeaderLength,
+                                                                GENERAL_HEADER_2CH_LENGTH + routeHeaderLength);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mSingleCastRoutedFilter[i];
-
-    if (mSingleCastRoutedFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                  // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                              // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                  // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX])) // If the destination node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (GENERAL_HEADER_2CH_LENGTH + routeHeaderLength + currentFilter->payloadIndex1)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH + routeHeaderLength + currentFilter->payloadIndex1])))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (GENERAL_HEADER_2CH_LENGTH + routeHeaderLength + currentFilter->payloadIndex2)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH + routeHeaderLength + currentFilter->payloadIndex2])))
-    {
-      continue;
-    }
+    return;
+  }
 
-    // TODO - currently we use ReceiveHandler for handling all frames except Explore frames
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
+  // TODO - currently we use ReceiveHandler for handling all frames except Explore frames
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
 
-    extract2chHeader(pFrame);
-    // TODO - 2 channel - we should internally keep HDRTYP_ROUTED so we can handle routed frames separately in 2 channel also
-    pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
+  extract2chHeader(pFrame);
+  // TODO - 2 channel - we should internally keep HDRTYP_ROUTED so we can handle routed frames separately in 2 channel also
+  pFrame->frameOptions.frameType = HDRTYP_SINGLECAST;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of single cast routed frames when \ref llReceiveHandler
@@ -1948,7 +1928,6 @@ static void singlecastRouted3chHandler(__attribute__((unused)) CommunicationProf
                                        __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                        ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
   uint32_t routeHeaderLength = GENERAL_HEADER_3CH_LENGTH + 3 + ((pFrame->frameContent[GENERAL_ROUTED_HEADER_3CH_CONTROL_INDEX] & 0xF0) >> 4);
   // TODO - routeHeaderLength also needs to be corrected for Extended route header if present (extend bit in routeStatus)
   if ((pFrame->frameContent[GENERAL_HEADER_3CH_EXTENDED_INDEX] &
@@ -1957,60 +1936,27 @@ static void singlecastRouted3chHandler(__attribute__((unused)) CommunicationProf
     routeHeaderLength += pFrame->frameContent[routeHeaderLength] & 0x07;
   }
 
-  for (i = 0; i < mSingleCastRoutedFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mSingleCastRoutedFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX],
+                                                                routeHeaderLength,
+                                                                routeHeaderLength);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mSingleCastRoutedFilter[i];
-
-    if (mSingleCastRoutedFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                  // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                              // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                  // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX])) // If the destination node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (routeHeaderLength + currentFilter->payloadIndex1)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[routeHeaderLength + currentFilter->payloadIndex1])))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (routeHeaderLength + currentFilter->payloadIndex2)) ||  // then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[routeHeaderLength + currentFilter->payloadIndex2])))
-    {
-      continue;
-    }
+    return;
+  }
 
-    // TODO - currently we use ReceiveHandler for handling all frames except Explore frames
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
+  // TODO - currently we use ReceiveHandler for handling all frames except Explore frames
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
 
-    extract3chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_ROUTED;
-    pFrame->frameOptions.routed = 1;
+  extract3chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_ROUTED;
+  pFrame->frameOptions.routed = 1;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of explorer frames when \ref llReceiveHandler
@@ -2027,46 +1973,25 @@ static void explorerFrame2chHandler(__attribute__((unused)) CommunicationProfile
                                     __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                     ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mExplorerFrameFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mExplorerFrameFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_2CH_LENGTH,
+                                                                GENERAL_HEADER_2CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mExplorerFrameFilter[i];
-
-    if (mExplorerFrameFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                         // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                                     // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                         // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX])) // If the destination node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
 
-    extract2chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_EXPLORE;
+  extract2chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_EXPLORE;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of explorer frames when \ref llReceiveHandler
@@ -2083,46 +2008,25 @@ static void explorerFrame3chHandler(__attribute__((unused)) CommunicationProfile
                                     __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                     ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mExplorerFrameFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mExplorerFrameFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_3CH_LENGTH,
+                                                                GENERAL_HEADER_3CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mExplorerFrameFilter[i];
-
-    if (mExplorerFrameFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                         // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                                     // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                         // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&                                        // Check the filter is configured
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX])) // If the destination node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
 
-    extract3chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_EXPLORE;
+  extract3chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_EXPLORE;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of multicast frames when \ref llReceiveHandler
@@ -2139,54 +2043,26 @@ static void multicastFrame2chHandler(__attribute__((unused)) CommunicationProfil
                                      __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                      ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mMulticastFrameFilterIndex; i++ )
+  // Multicast frames does not have destination field, see llReceiveFilterAdd.
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mMulticastFrameFilters,
+                                                                pFrame,
+                                                                HOMEID_FILTER_FLAG | SOURCE_NODE_ID_FILTER_FLAG | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                0,
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX],
+                                                                MULTICAST_HEADER_2CH_LENGTH,
+                                                                GENERAL_HEADER_2CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mMulticastFrameFilter[i];
-
-    if (mMulticastFrameFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                         // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                                     // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                         // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (MULTICAST_HEADER_2CH_LENGTH + currentFilter->payloadIndex1)) ||// then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH + currentFilter->payloadIndex1])))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (MULTICAST_HEADER_2CH_LENGTH + currentFilter->payloadIndex2)) ||// then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH + currentFilter->payloadIndex2])))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
 
-    extract2chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_MULTICAST;
+  extract2chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_MULTICAST;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of multicast frames when \ref llReceiveHandler
@@ -2203,54 +2079,26 @@ static void multicastFrame3chHandler(__attribute__((unused)) CommunicationProfil
                                      __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                      ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mMulticastFrameFilterIndex; i++ )
+  // Multicast frames does not have destination field, see llReceiveFilterAdd.
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mMulticastFrameFilters,
+                                                                pFrame,
+                                                                HOMEID_FILTER_FLAG | SOURCE_NODE_ID_FILTER_FLAG | RECEIVE_FILTER_PAYLOAD_FLAGS,
+                                                                0,
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX],
+                                                                MULTICAST_HEADER_3CH_LENGTH,
+                                                                MULTICAST_HEADER_3CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mMulticastFrameFilter[i];
-
-    if (mMulticastFrameFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);                         // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&                                                     // Check the filter is configured
-        (currentFilter->homeId.word != *pHomeId))                                                         // If the home id does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&                                             // Check the filter is configured
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX]))           // If the source node does not match the filter, then continue looping with next filter
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_1_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (MULTICAST_HEADER_3CH_LENGTH + currentFilter->payloadIndex1)) ||// then discard frame for this filter
-           (currentFilter->payloadFilterValue1 != pFrame->frameContent[MULTICAST_HEADER_3CH_LENGTH + currentFilter->payloadIndex1])))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & PAYLOAD_INDEX_2_FILTER_FLAG) &&                                            // Filter is configured && (FilterIndex != OutOfBounds || FilterValue != MatchFrameContent)
-          ((pFrame->frameContentLength <= (MULTICAST_HEADER_3CH_LENGTH + currentFilter->payloadIndex2)) ||// then discard frame for this filter
-           (currentFilter->payloadFilterValue2 != pFrame->frameContent[MULTICAST_HEADER_3CH_LENGTH + currentFilter->payloadIndex2])))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[MULTICAST_HEADER_3CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[MULTICAST_HEADER_3CH_LENGTH];
 
-    extract3chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_MULTICAST;
+  extract3chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_MULTICAST;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 // Dummy function for catching non-applicable receive frame types
@@ -2277,46 +2125,25 @@ static void ackFrame2chHandler( __attribute__((unused)) CommunicationProfile_t c
                                 __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                 ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mTransferAckFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mTransferAckFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_2CH_LENGTH,
+                                                                GENERAL_HEADER_2CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mTransferAckFilter[i];
-
-    if (mTransferAckFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);    // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&
-        (currentFilter->homeId.word != *pHomeId))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_DESTINATION_INDEX]))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_2CH_SOURCE_INDEX]))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_2CH_LENGTH];
 
-    extract2chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_TRANSFERACK;
+  extract2chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_TRANSFERACK;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 
@@ -2334,46 +2161,25 @@ static void ackFrame3chHandler( __attribute__((unused)) CommunicationProfile_t c
                                 __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                                 ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
-
-  for (i = 0; i < mTransferAckFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mTransferAckFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_3CH_LENGTH,
+                                                                GENERAL_HEADER_3CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mTransferAckFilter[i];
-
-    if (mTransferAckFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);      // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&
-        (currentFilter->homeId.word != *pHomeId))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX]))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX]))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
+  pFrame->pPayloadStart = &pFrame->frameContent[GENERAL_HEADER_3CH_LENGTH];
 
-    extract3chHeader(pFrame);
-    pFrame->frameOptions.frameType = HDRTYP_TRANSFERACK;
+  extract3chHeader(pFrame);
+  pFrame->frameOptions.frameType = HDRTYP_TRANSFERACK;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 /**@brief The is the actual function for handling of Long Range acknowledge frame when \ref llReceiveHandler
@@ -2390,48 +2196,28 @@ static void ackFrameLRHandler(__attribute__((unused)) CommunicationProfile_t com
                               __attribute__((unused)) zpal_radio_rx_parameters_t * pRxParameters,
                               ZW_ReceiveFrame_t * pFrame)
 {
-  uint32_t i;
   frame*   fr = (frame *)pFrame->frameContent;
 
-  for (i = 0; i < mTransferAckFilterIndex; i++ )
+  const ZW_ReceiveFilter_t * currentFilter = receiveFilterMatch(&mTransferAckFilters,
+                                                                pFrame,
+                                                                RECEIVE_FILTER_ADDRESS_FLAGS,
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX],
+                                                                pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX],
+                                                                GENERAL_HEADER_3CH_LENGTH,
+                                                                GENERAL_HEADER_3CH_LENGTH);
+  if (NULL == currentFilter)
   {
-    const ZW_ReceiveFilter_t * currentFilter = mTransferAckFilter[i];
-
-    if (mTransferAckFilterPaused[i])
-    {
-      continue;
-    }
-
-    uint32_t* pHomeId = (uint32_t*)(&pFrame->frameContent[FRAME_HOME_ID_INDEX]);      // Use pHomeId to avoid GCC type punned pointer error
-
-    if ((currentFilter->flag & HOMEID_FILTER_FLAG) &&
-        (currentFilter->homeId.word != *pHomeId))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & DESTINATION_NODE_ID_FILTER_FLAG) &&
-        (currentFilter->destinationNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_DESTINATION_INDEX]))
-    {
-      continue;
-    }
-
-    if ((currentFilter->flag & SOURCE_NODE_ID_FILTER_FLAG) &&
-        (currentFilter->sourceNodeId != pFrame->frameContent[GENERAL_HEADER_3CH_SOURCE_INDEX]))
-    {
-      continue;
-    }
+    return;
+  }
 
-    pFrame->pPayloadStart = SINGLECAST_PAYLOAD_LR(fr);
+  pFrame->pPayloadStart = SINGLECAST_PAYLOAD_LR(fr);
 
-    extractLRHeader(pFrame);
+  extractLRHeader(pFrame);
 
-    pFrame->frameOptions.frameType = HDRTYP_TRANSFERACK;
+  pFrame->frameOptions.frameType = HDRTYP_TRANSFERACK;
 
-    // Invoke receive filter callback.
-    currentFilter->frameHandler(pFrame);
-    break;
-  }
+  // Invoke receive filter callback.
+  currentFilter->frameHandler(pFrame);
 }
 
 
@@ -2648,35 +2434,32 @@ static uint32_t filterCompare(const ZW_ReceiveFilter_t * pFilter0, const ZW_Rece
  *
  * @param[in]     pReceiveFilter Pointer  to the filter to be active
  * @param[in,out] pFilterList    Pointer to the filter list where the new filter should be added.
- *                               When the function returns the filter list contains the new filter
- * @param[in,out] pFilterIndex   Current last index in the filter list wit free slot for a filter.
- *                               When the function returns the filter index has been incremented by
- *                               one
+ *                               When the function returns the filter list contains the new filter,
+ *                               the filter count has been incremented by one and the list has
+ *                               been compiled.
  */
 static void receiveFilterAdd(const ZW_ReceiveFilter_t * pReceiveFilter,
-                             const ZW_ReceiveFilter_t ** pFilterList,
-                             uint32_t           * pFilterListIndex)
+                             ReceiveFilterList_t      * pFilterList)
 {
-  uint32_t compareIndex = *pFilterListIndex;
+  uint32_t compareIndex = pFilterList->count;
   for (; compareIndex > 0; --compareIndex)
   {
-    if (pFilterList[compareIndex - 1]->flag < pReceiveFilter->flag)
+    if (pFilterList->filter[compareIndex - 1]->flag < pReceiveFilter->flag)
     {
-      pFilterList[compareIndex] = pFilterList[compareIndex - 1];
+      pFilterList->filter[compareIndex] = pFilterList->filter[compareIndex - 1];
+      pFilterList->hits[compareIndex]   = pFilterList->hits[compareIndex - 1];
     }
     else
     {
-      pFilterList[compareIndex] = pReceiveFilter;
       break;
     }
   }
 
-  if (0 == compareIndex)
-  {
-    pFilterList[compareIndex] = pReceiveFilter;
-  }
+  pFilterList->filter[compareIndex] = pReceiveFilter;
+  pFilterList->hits[compareIndex]   = 0;
 
-  (*pFilterListIndex)++;
+  pFilterList->count++;
+  receiveFilterCompile(pFilterList);
 }
 
 
@@ -2687,28 +2470,28 @@ ZW_ReturnCode_t llReceiveFilterAdd(const ZW_ReceiveFilter_t * pReceiveFilter)
   {
     case HDRTYP_SINGLECAST:
       // ToDo: Should we use the function pointer and lookup table for 2ch/3ch handling ?
-      if (mSingleCastFilterIndex >= PACKET_FILTER_SIZE)
+      if (mSingleCastFilters.count >= PACKET_FILTER_SIZE)
         return NO_MEMORY;
 
-      receiveFilterAdd(pReceiveFilter, mSingleCastFilter, &mSingleCastFilterIndex);
+      receiveFilterAdd(pReceiveFilter, &mSingleCastFilters);
       return SUCCESS;
 
     case HDRTYP_ROUTED:
-      if (mSingleCastRoutedFilterIndex >= PACKET_FILTER_SIZE)
+      if (mSingleCastRoutedFilters.count >= PACKET_FILTER_SIZE)
         return NO_MEMORY;
 
-      receiveFilterAdd(pReceiveFilter, mSingleCastRoutedFilter, &mSingleCastRoutedFilterIndex);
+      receiveFilterAdd(pReceiveFilter, &mSingleCastRoutedFilters);
       return SUCCESS;
 
     case HDRTYP_EXPLORE:
-      if (mExplorerFrameFilterIndex >= PACKET_FILTER_SIZE)
+      if (mExplorerFrameFilters.count >= PACKET_FILTER_SIZE)
         return NO_MEMORY;
 
-      receiveFilterAdd(pReceiveFilter, mExplorerFrameFilter, &mExplorerFrameFilterIndex);
+      receiveFilterAdd(pReceiveFilter, &mExplorerFrameFilters);
       return SUCCESS;
 
     case HDRTYP_MULTICAST:
-      if (mMulticastFrameFilterIndex >= PACKET_FILTER_SIZE)
+      if (mMulticastFrameFilters.count >= PACKET_FILTER_SIZE)
         return NO_MEMORY;
 
       // Multicast frames does not have destination field.
@@ -2717,12 +2500,12 @@ ZW_ReturnCode_t llReceiveFilterAdd(const ZW_ReceiveFilter_t * pReceiveFilter)
         return INVALID_PARAMETERS;
       }
 
-      receiveFilterAdd(pReceiveFilter, mMulticastFrameFilter, &mMulticastFrameFilterIndex);
+      receiveFilterAdd(pReceiveFilter, &mMulticastFrameFilters);
       return SUCCESS;
 
     case HDRTYP_TRANSFERACK:
       // ToDo: Should we use the function pointer and lookup table for 2ch/3ch handling ?
-      if (mTransferAckFilterIndex>= PACKET_FILTER_SIZE)
+      if (mTransferAckFilters.count >= PACKET_FILTER_SIZE)
         return NO_MEMORY;
 
       // Ack frames does not have payload, thus payload filtering is not possible.
@@ -2731,7 +2514,7 @@ ZW_ReturnCode_t llReceiveFilterAdd(const ZW_ReceiveFilter_t * pReceiveFilter)
         return INVALID_PARAMETERS;
       }
 
-      receiveFilterAdd(pReceiveFilter, mTransferAckFilter, &mTransferAckFilterIndex);
+      receiveFilterAdd(pReceiveFilter, &mTransferAckFilters);
       return SUCCESS;
 
     default:
@@ -2740,63 +2523,112 @@ ZW_ReturnCode_t llReceiveFilterAdd(const ZW_ReceiveFilter_t * pReceiveFilter)
 }
 
 
+/**@brief Function for getting the filter list of a frame type.
+ *
+ * @param[in] frameType Frame type of the filter list.
+ *
+ * @return Pointer to the filter list or NULL if the frame type has no filter list.
+ */
+static ReceiveFilterList_t * receiveFilterListGet(ZW_FrameType_t frameType)
+{
+  switch (frameType)
+  {
+    case HDRTYP_SINGLECAST:
+      return &mSingleCastFilters;
+
+    case HDRTYP_ROUTED:
+      return &mSingleCastRoutedFilters;
+
+    case HDRTYP_EXPLORE:
+      return &mExplorerFrameFilters;
+
+    case HDRTYP_TRANSFERACK:
+      return &mTransferAckFilters;
+
+    case HDRTYP_MULTICAST:
+      return &mMulticastFrameFilters;
+
+    default:
+      return NULL;
+  }
+}
+
+
+/**@brief Function for finding a receive filter in a specific filter list.
+ *
+ * @param[in] pReceiveFilter Pointer to the filter to find
+ * @param[in] pFilterList    Pointer to the filter list to search
+ *
+ * @return Index of the first filter in the list with the same content as \ref pReceiveFilter
+ *         or the filter count if no such filter is in the list.
+ */
+static uint32_t receiveFilterFind(const ZW_ReceiveFilter_t  * pReceiveFilter,
+                                  const ReceiveFilterList_t * pFilterList)
+{
+  uint32_t i;
+  for (i = 0; i < pFilterList->count; i++ )
+  {
+    if (filterCompare(pFilterList->filter[i], pReceiveFilter) == 0)
+      break;
+  }
+  return i;
+}
+
+
 /**@brief Function for removing a receive filter in a specific filter list.
  *
  * @param[in]     pReceiveFilter Pointer to the filter to be removed
  * @param[in,out] pFilterList    Pointer to the filter list where the new filter should be removed.
  *                               When the function returns the filter list contains an updated list
- *                               where \ref pReceiveFilter has been removed
- * @param[in,out] pFilterIndex   Current last index in the filter list wit free slot for a filter.
- *                               When the function returns the filter index has been decremented by
- *                               one
+ *                               where \ref pReceiveFilter has been removed, the filter count has
+ *                               been decremented by one and the list has been compiled.
  */
 static ZW_ReturnCode_t receiveFilterRemove(const ZW_ReceiveFilter_t * pReceiveFilter,
-                                           const ZW_ReceiveFilter_t ** pFilterList,
-                                           uint32_t * pFilterListLength)
+                                           ReceiveFilterList_t      * pFilterList)
 {
-  uint32_t i;
-  for (i = 0; i < *pFilterListLength; i++ )
-  {
-    if (filterCompare(pFilterList[i], pReceiveFilter) != 0)
-      continue;
-    break;
-  }
-  if (*pFilterListLength == i)
+  uint32_t i = receiveFilterFind(pReceiveFilter, pFilterList);
+  if (pFilterList->count == i)
   {
     return INVALID_PARAMETERS;
   }
 
-  for (; i < (*pFilterListLength-1);i++)
+  for (; i < (pFilterList->count - 1); i++)
   {
-    pFilterList[i] = pFilterList[i+1];
+    pFilterList->filter[i] = pFilterList->filter[i + 1];
+    pFilterList->hits[i]   = pFilterList->hits[i + 1];
   }
-  (*pFilterListLength)--;
+  pFilterList->count--;
+  receiveFilterCompile(pFilterList);
   return SUCCESS;
 }
 
 ZW_ReturnCode_t llReceiveFilterRemove(const ZW_ReceiveFilter_t * pReceiveFilter)
 {
-  ZW_FrameType_t frameType = pReceiveFilter->headerType;
-  switch (frameType)
+  ReceiveFilterList_t * pFilterList = receiveFilterListGet(pReceiveFilter->headerType);
+  if (NULL == pFilterList)
   {
-    case HDRTYP_SINGLECAST:
-      return receiveFilterRemove(pReceiveFilter, mSingleCastFilter, &mSingleCastFilterIndex);
-
-    case HDRTYP_ROUTED:
-      return receiveFilterRemove(pReceiveFilter, mSingleCastRoutedFilter, &mSingleCastRoutedFilterIndex);
-
-    case HDRTYP_EXPLORE:
-      return receiveFilterRemove(pReceiveFilter, mExplorerFrameFilter, &mExplorerFrameFilterIndex);
+    return INVALID_PARAMETERS;
+  }
+  return receiveFilterRemove(pReceiveFilter, pFilterList);
+}
 
-    case HDRTYP_TRANSFERACK:
-      return receiveFilterRemove(pReceiveFilter, mTransferAckFilter, &mTransferAckFilterIndex);
 
-    case HDRTYP_MULTICAST:
-      return receiveFilterRemove(pReceiveFilter, mMulticastFrameFilter, &mMulticastFrameFilterIndex);
+ZW_ReturnCode_t llReceiveFilterGetHits(const ZW_ReceiveFilter_t * pReceiveFilter, uint32_t * pHits)
+{
+  const ReceiveFilterList_t * pFilterList = receiveFilterListGet(pReceiveFilter->headerType);
+  if (NULL == pFilterList)
+  {
+    return INVALID_PARAMETERS;
+  }
 
-    default:
-      return INVALID_PARAMETERS;
+  uint32_t i = receiveFilterFind(pReceiveFilter, pFilterList);
+  if (pFilterList->count == i)
+  {
+    return INVALID_PARAMETERS;
   }
+
+  *pHits = pFilterList->hits[i];
+  return SUCCESS;
 }
 
 
@@ -2848,42 +2680,53 @@ uint8_t llIsReTransmitEnabled(ZW_TransmissionFrame_t *pFrame)
 }
 
 
-ZW_ReturnCode_t llReceiveFilterPause(uint8_t pause)
+/**@brief Function for pausing/enabling all exiting filters in a specific filter list.
+ *
+ * @param[in,out] pFilterList Pointer to the filter list. When the function returns the list has
+ *                            been compiled.
+ * @param[in]     pause       Value for the paused flag of all existing filters.
+ *
+ * @retval SUCCESS            The list contains filters
+ * @retval UNSUPPORTED        The list is empty
+ */
+static ZW_ReturnCode_t receiveFilterPause(ReceiveFilterList_t * pFilterList, uint8_t pause)
 {
   ZW_ReturnCode_t retVal = UNSUPPORTED;
-  uint32_t compareIndex = mExplorerFrameFilterIndex;
+  uint32_t compareIndex = pFilterList->count;
 
   for (; compareIndex > 0; --compareIndex)
   {
-    mExplorerFrameFilterPaused[compareIndex - 1] = pause;
+    pFilterList->paused[compareIndex - 1] = pause;
     retVal = SUCCESS;
   }
 
-  compareIndex = mMulticastFrameFilterIndex;
-  for (; compareIndex > 0; --compareIndex)
+  receiveFilterCompile(pFilterList);
+  return retVal;
+}
+
+
+ZW_ReturnCode_t llReceiveFilterPause(uint8_t pause)
+{
+  ZW_ReturnCode_t retVal = UNSUPPORTED;
+
+  if (SUCCESS == receiveFilterPause(&mExplorerFrameFilters, pause))
   {
-    mMulticastFrameFilterPaused[compareIndex - 1] = pause;
     retVal = SUCCESS;
   }
-
-  compareIndex = mSingleCastFilterIndex;
-  for (; compareIndex > 0; --compareIndex)
+  if (SUCCESS == receiveFilterPause(&mMulticastFrameFilters, pause))
   {
-    mSingleCastFilterPaused[compareIndex - 1] = pause;
     retVal = SUCCESS;
   }
-
-  compareIndex = mSingleCastRoutedFilterIndex;
-  for (; compareIndex > 0; --compareIndex)
+  if (SUCCESS == receiveFilterPause(&mSingleCastFilters, pause))
   {
-    mSingleCastRoutedFilterPaused[compareIndex - 1] = pause;
     retVal = SUCCESS;
   }
-
-  compareIndex = mTransferAckFilterIndex;
-  for (; compareIndex > 0; --compareIndex)
+  if (SUCCESS == receiveFilterPause(&mSingleCastRoutedFilters, pause))
+  {
+    retVal = SUCCESS;
+  }
+  if (SUCCESS == receiveFilterPause(&mTransferAckFilters, pause))
   {
-    mTransferAckFilterPaused[compareIndex - 1] = pause;
     retVal = SUCCESS;
   }
   return retVal;
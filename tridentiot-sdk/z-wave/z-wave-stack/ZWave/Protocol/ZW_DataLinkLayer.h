@@ -302,8 +302,9 @@ uint8_t llIsReTransmitEnabled(ZW_TransmissionFrame_t *pFrame);
 
 /**@brief Function for adding a receive filter.
  *
- * @details When the function returns the filter has been added to list of active filters and the memory
- * pointed to by pReceiveFilter can be released.
+ * @details When the function returns the filter has been added to list of active filters.
+ * The list refers to the memory pointed to by pReceiveFilter, which must be kept unchanged until
+ * the filter is removed, as the list is compiled from the filter content when it is added.
  * \note Each frame type, \ref ZW_FrameType_t, has its own list of active filters
  *
  *
@@ -341,6 +342,19 @@ ZW_ReturnCode_t llReceiveFilterRemove(const ZW_ReceiveFilter_t * pReceiveFilter)
  */
 ZW_ReturnCode_t llReceiveFilterPause(uint8_t pause);
 
+/**@brief Function for getting the number of received frames passed to the frame handler of a
+ *        receive filter.
+ *
+ * @details The counter is cleared when the filter is added and kept until it is removed.
+ *
+ * @param[in]  pReceiveFilter Pointer to a filter with the same content as an active filter
+ * @param[out] pHits          Number of frames that matched the filter
+ *
+ * @retval SUCCESS            The number of frames was returned in pHits
+ * @retval INVALID_PARAMETERS No filter matching pReceiveFilter could be found in the list.
+ */
+ZW_ReturnCode_t llReceiveFilterGetHits(const ZW_ReceiveFilter_t * pReceiveFilter, uint32_t * pHits);
+
 /**@brief Function for converting from transmit profile to channel number
  *
  * @param profile CommunicationProfile_t for the profile to convert to channel
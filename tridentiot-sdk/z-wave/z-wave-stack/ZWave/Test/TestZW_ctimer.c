@@ -11,6 +11,7 @@
 #include "mock_control.h"
 #include <ZW_timer.h>
 #include <SwTimer.h>
+#include <stdlib.h>
 
 void setUpSuite(void) {
 
@@ -121,10 +122,6 @@ void test_timer_overflow(void) {
   pMockTimer->compare_rule_arg[2] = COMPARE_NOT_NULL;
   pMockTimer->return_code.v = true;
 
-
-  mock_call_expect(TO_STR(xTaskGetTickCount), &pMockTick);
-  pMockTick->return_code.v = 0;
-  
   ctimer_init();
   
   timer_callback_t CallBack = pMockTimer->actual_arg[2].p;
@@ -199,3 +196,74 @@ void test_timer_overflow(void) {
   TEST_ASSERT_EQUAL( timers_flags[2] , false );  
   mock_calls_verify();
 }
+
+#define MANY_TIMERS_COUNT 4000
+
+static struct ctimer many_timers[MANY_TIMERS_COUNT];
+static uint32_t many_timers_fired;
+static clock_time_t many_timers_last_timeout;
+static bool many_timers_in_order;
+
+static void many_timers_callback(void *ptr)
+{
+  struct ctimer *c = ptr;
+
+  if (c->timeout < many_timers_last_timeout) {
+    many_timers_in_order = false;
+  }
+  many_timers_last_timeout = c->timeout;
+  many_timers_fired++;
+}
+
+/**
+ * Sets, restarts and expires thousands of timers, and verifies that they all
+ * expire in timeout order. TestZW_ctimer_benchmark times the same steps.
+ *
+ * The tick count is stubbed to 0, so every expiry of the SwTimer calls one callback.
+ */
+void test_many_timers(void) {
+  mock_t * pMockTimer;
+  uint32_t i;
+
+  mock_calls_clear();
+  mock_call_use_as_stub(TO_STR(TimerStart));
+  mock_call_use_as_stub(TO_STR(TimerStop));
+  mock_call_use_as_stub(TO_STR(xTaskGetTickCount));
+
+  mock_call_expect(TO_STR(ZwTimerRegister), &pMockTimer);
+  pMockTimer->compare_rule_arg[0] = COMPARE_ANY;
+  pMockTimer->compare_rule_arg[1] = COMPARE_ANY;
+  pMockTimer->compare_rule_arg[2] = COMPARE_NOT_NULL;
+  pMockTimer->return_code.v = true;
+
+  ctimer_init();
+  timer_callback_t CallBack = pMockTimer->actual_arg[2].p;
+
+  srand(1);
+  // Increasing timeouts, as set by the protocol
+  for (i = 0; i < MANY_TIMERS_COUNT / 2; i++) {
+    ctimer_set(&many_timers[i], 1 + i, many_timers_callback, &many_timers[i]);
+  }
+  // Random timeouts
+  for (; i < MANY_TIMERS_COUNT; i++) {
+    ctimer_set(&many_timers[i], 1 + (clock_time_t)(rand() % 10000), many_timers_callback, &many_timers[i]);
+  }
+  // Restart every tenth timer
+  for (i = 0; i < MANY_TIMERS_COUNT; i += 10) {
+    ctimer_set(&many_timers[i], 20000 + i, many_timers_callback, &many_timers[i]);
+  }
+
+  many_timers_fired = 0;
+  many_timers_last_timeout = 0;
+  many_timers_in_order = true;
+  for (i = 0; i < MANY_TIMERS_COUNT; i++) {
+    CallBack(NULL);
+  }
+
+  TEST_ASSERT_EQUAL(MANY_TIMERS_COUNT, many_timers_fired);
+  TEST_ASSERT_TRUE(many_timers_in_order);
+  for (i = 0; i < MANY_TIMERS_COUNT; i++) {
+    TEST_ASSERT_NOT_EQUAL(0, ctimer_expired(&many_timers[i]));
+  }
+  mock_calls_verify();
+}
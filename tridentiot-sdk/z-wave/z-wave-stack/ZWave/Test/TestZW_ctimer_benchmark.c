@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file TestZW_ctimer_benchmark.c
+ *
+ * Prints how long it takes to set and expire thousands of ctimers. Only built
+ * with UNIT_TEST_BENCHMARKS, as the timings depend on the host.
+ */
+#include "ZW_ctimer.h"
+#include "unity.h"
+#include "mock_control.h"
+#include <ZW_timer.h>
+#include <SwTimer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+void setUpSuite(void) {
+
+}
+
+void tearDownSuite(void) {
+
+}
+
+void setUp(void) {
+
+}
+
+void tearDown(void) {
+
+}
+
+#define BENCHMARK_TIMER_COUNT 4000
+
+static struct ctimer benchmark_timers[BENCHMARK_TIMER_COUNT];
+static uint32_t benchmark_fired;
+
+static void benchmark_callback(__attribute__((unused)) void *ptr)
+{
+  benchmark_fired++;
+}
+
+typedef void(*timer_callback_t)(SSwTimer* pTimer);
+
+static unsigned long us_since(clock_t start)
+{
+  return (unsigned long)((clock() - start) * 1000000 / CLOCKS_PER_SEC);
+}
+
+/**
+ * Sets, restarts and expires the same timers as test_many_timers in TestZW_ctimer.
+ *
+ * The tick count is stubbed to 0, so every expiry of the SwTimer calls one callback.
+ */
+void test_timer_benchmark(void) {
+  mock_t * pMockTimer;
+  clock_t start;
+  uint32_t i;
+
+  mock_calls_clear();
+  mock_call_use_as_stub(TO_STR(TimerStart));
+  mock_call_use_as_stub(TO_STR(TimerStop));
+  mock_call_use_as_stub(TO_STR(xTaskGetTickCount));
+
+  mock_call_expect(TO_STR(ZwTimerRegister), &pMockTimer);
+  pMockTimer->compare_rule_arg[0] = COMPARE_ANY;
+  pMockTimer->compare_rule_arg[1] = COMPARE_ANY;
+  pMockTimer->compare_rule_arg[2] = COMPARE_NOT_NULL;
+  pMockTimer->return_code.v = true;
+
+  ctimer_init();
+  timer_callback_t CallBack = pMockTimer->actual_arg[2].p;
+
+  srand(1);
+  start = clock();
+  for (i = 0; i < BENCHMARK_TIMER_COUNT / 2; i++) {
+    ctimer_set(&benchmark_timers[i], 1 + i, benchmark_callback, &benchmark_timers[i]);
+  }
+  for (; i < BENCHMARK_TIMER_COUNT; i++) {
+    ctimer_set(&benchmark_timers[i], 1 + (clock_time_t)(rand() % 10000), benchmark_callback, &benchmark_timers[i]);
+  }
+  for (i = 0; i < BENCHMARK_TIMER_COUNT; i += 10) {
+    ctimer_set(&benchmark_timers[i], 20000 + i, benchmark_callback, &benchmark_timers[i]);
+  }
+  printf("ctimer: %u timers set in %lu us\n", BENCHMARK_TIMER_COUNT, us_since(start));
+
+  benchmark_fired = 0;
+  start = clock();
+  for (i = 0; i < BENCHMARK_TIMER_COUNT; i++) {
+    CallBack(NULL);
+  }
+  printf("ctimer: %u timers expired in %lu us\n", BENCHMARK_TIMER_COUNT, us_since(start));
+
+  TEST_ASSERT_EQUAL(BENCHMARK_TIMER_COUNT, benchmark_fired);
+  mock_calls_verify();
+}
@@ -0,0 +1,758 @@
+// SPDX-FileCopyrightText: Silicon Laboratories Inc. <https://www.silabs.com/>
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+/**
+ * @file TestZW_tx_queue.c
+ *
+ * Tests of the order in which the transmit queue sends its frames. The radio,
+ * the timers and the tick count are fakes: llTransmitFrame() remembers the
+ * frame it was given, and run_until() expires the timers like the timer task
+ * would.
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <ZW_tx_queue.h>
+#include <ZW_transport.h>
+#include <ZW_timer.h>
+#include <SwTimer.h>
+#include <TickTime.h>
+#include <ZW_DataLinkLayer_utils.h>
+#include <zpal_power_manager.h>
+#include <zpal_radio.h>
+
+#define FAKE_TIMER_COUNT      2
+#define MODEL_CHECK_STEPS     20000
+
+typedef struct
+{
+  SSwTimer *pTimer;
+  bool running;
+  uint32_t expiry;
+} fake_timer_t;
+
+static uint32_t m_tick;
+static fake_timer_t m_timers[FAKE_TIMER_COUNT];
+static uint8_t m_timer_count;
+static TxQueueElement *m_transmitted;
+
+bool bApplicationTxAbort;
+bool bLastTxFailed;
+uint8_t bRestartAckTimerAllowed;
+
+/****************************************************************************/
+/*                                 FAKES                                    */
+/****************************************************************************/
+
+void Assert(const char* pFileName, int iLineNumber)
+{
+  (void)pFileName;
+  (void)iLineNumber;
+  TEST_FAIL_MESSAGE("ASSERT in ZW_tx_queue.c");
+}
+
+const void* AssertPtr(const void* ptr, const char* message)
+{
+  TEST_ASSERT_NOT_NULL_MESSAGE(ptr, message);
+  return ptr;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+  return m_tick;
+}
+
+static fake_timer_t *fake_timer(SSwTimer *pTimer)
+{
+  for (uint8_t i = 0; i < m_timer_count; i++)
+  {
+    if (m_timers[i].pTimer == pTimer)
+    {
+      return &m_timers[i];
+    }
+  }
+  TEST_FAIL_MESSAGE("Timer is not registered");
+  return NULL;
+}
+
+/* TxQueueInit() registers the transmit pause timer first and the delayed TX timer second. */
+static fake_timer_t *delayed_tx_timer(void)
+{
+  TEST_ASSERT_EQUAL_UINT8(FAKE_TIMER_COUNT, m_timer_count);
+  return &m_timers[1];
+}
+
+bool ZwTimerRegister(SSwTimer* pTimer, bool bAutoReload, void(*pCallback)(SSwTimer* pTimer))
+{
+  (void)bAutoReload;
+  pTimer->pCallback = pCallback;
+  for (uint8_t i = 0; i < m_timer_count; i++)
+  {
+    if (m_timers[i].pTimer == pTimer)
+    {
+      return true;
+    }
+  }
+  TEST_ASSERT_LESS_THAN_UINT8(FAKE_TIMER_COUNT, m_timer_count);
+  m_timers[m_timer_count].pTimer = pTimer;
+  m_timers[m_timer_count].running = false;
+  m_timer_count++;
+  return true;
+}
+
+ESwTimerStatus TimerStart(SSwTimer* pTimer, uint32_t iTimeout)
+{
+  fake_timer_t *pFake = fake_timer(pTimer);
+  TEST_ASSERT_NOT_EQUAL_MESSAGE(0, iTimeout, "A timeout of zero is illegal");
+  pFake->running = true;
+  pFake->expiry = m_tick + iTimeout;
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+ESwTimerStatus TimerStop(SSwTimer* pTimer)
+{
+  fake_timer(pTimer)->running = false;
+  return ESWTIMER_STATUS_SUCCESS;
+}
+
+bool TimerIsActive(SSwTimer* pTimer)
+{
+  return fake_timer(pTimer)->running;
+}
+
+ZW_ReturnCode_t llTransmitFrame(CommunicationProfile_t communicationProfile, ZW_TransmissionFrame_t* pFrameToTransmit)
+{
+  (void)communicationProfile;
+  TEST_ASSERT_NULL_MESSAGE(m_transmitted, "Transmitted twice without checking");
+  m_transmitted = (TxQueueElement *)((uint8_t *)pFrameToTransmit - offsetof(TxQueueElement, frame));
+  return SUCCESS;
+}
+
+ZW_HeaderFormatType_t llGetCurrentHeaderFormat(node_id_t bNodeID, uint8_t forceLR)
+{
+  (void)bNodeID;
+  (void)forceLR;
+  return HDRFORMATTYP_2CH;
+}
+
+uint8_t llConvertTransmitProfileToPHYChannel(CommunicationProfile_t transmitProfile)
+{
+  (void)transmitProfile;
+  return 0;
+}
+
+uint16_t llGetWakeUpBeamFragmentTime(void)
+{
+  return 0;
+}
+
+void llReTransmitStart(ZW_TransmissionFrame_t* pFrame)
+{
+  (void)pFrame;
+}
+
+void llReTransmitStop(ZW_TransmissionFrame_t* pFrame)
+{
+  (void)pFrame;
+}
+
+uint8_t TransportGetChannel(TxQueueElement *pFrame)
+{
+  (void)pFrame;
+  return 0;
+}
+
+uint8_t TransportGetCurrentRxChannel(void)
+{
+  return 0;
+}
+
+int8_t transportGetTxPower(TxQueueElement* element, ZW_HeaderFormatType_t headerFormat)
+{
+  (void)element;
+  (void)headerFormat;
+  return 0;
+}
+
+zpal_pm_handle_t zpal_pm_register(zpal_pm_type_t type)
+{
+  (void)type;
+  return NULL;
+}
+
+void zpal_pm_stay_awake(zpal_pm_handle_t handle, uint32_t msec)
+{
+  (void)handle;
+  (void)msec;
+}
+
+void zpal_pm_cancel(zpal_pm_handle_t handle)
+{
+  (void)handle;
+}
+
+zpal_radio_protocol_mode_t zpal_radio_get_protocol_mode(void)
+{
+  return ZPAL_RADIO_PROTOCOL_MODE_1;
+}
+
+zpal_radio_lr_channel_t zpal_radio_get_primary_long_range_channel(void)
+{
+  return ZPAL_RADIO_LR_CHANNEL_A;
+}
+
+zpal_radio_lr_channel_config_t zpal_radio_get_lr_channel_config(void)
+{
+  return ZPAL_RADIO_LR_CH_CFG_NO_LR;
+}
+
+void zpal_radio_rf_channel_statistic_tx_frames(void)
+{
+}
+
+/****************************************************************************/
+/*                                HELPERS                                   */
+/****************************************************************************/
+
+/* Advances the tick count one ms at a time and expires the timers on the way. */
+static void run_until(uint32_t tick)
+{
+  while (m_tick != tick)
+  {
+    m_tick++;
+    for (uint8_t i = 0; i < m_timer_count; i++)
+    {
+      if (m_timers[i].running && (m_timers[i].expiry == m_tick))
+      {
+        m_timers[i].running = false;
+        m_timers[i].pTimer->pCallback(m_timers[i].pTimer);
+      }
+    }
+  }
+}
+
+static TxQueueElement *take_transmitted(void)
+{
+  TxQueueElement *e = m_transmitted;
+  m_transmitted = NULL;
+  return e;
+}
+
+static TxQueueElement *allocate(TxQueue_ElementPriority_t priority)
+{
+  TxQueueElement *e = TxQueueGetFreeElement(priority, false);
+  TEST_ASSERT_NOT_NULL(e);
+  return e;
+}
+
+static TxQueueElement *queue_delayed(uint32_t delayMs)
+{
+  TxQueueElement *e = TxQueueGetFreeElement(TX_QUEUE_PRIORITY_LOW, true);
+  TEST_ASSERT_NOT_NULL(e);
+  TxQueueSetOptionFlags(e, TRANSMIT_OPTION_DELAYED_TX);
+  e->delayedTx.timeType = TIME_TYPE_RELATIVE;
+  e->delayedTx.delayedTxMs = delayMs;
+  TxQueueQueueElement(e);
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_DELAYED_TX_WAIT, e->bTxStatus);
+  return e;
+}
+
+/* Queues and sends a low priority frame, which keeps the transmitter busy until finish() */
+static TxQueueElement *start_blocking_frame(void)
+{
+  TxQueueElement *e = allocate(TX_QUEUE_PRIORITY_LOW);
+  TxQueueQueueElement(e);
+  TEST_ASSERT_EQUAL_PTR(e, take_transmitted());
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_TRANSMITTING, e->bTxStatus);
+  return e;
+}
+
+/* Completes the transmission of the frame and releases it like the transport layer does */
+static void finish(TxQueueElement *e)
+{
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_TRANSMITTING, e->bTxStatus);
+  TxQueueTxComplete(RADIO_STATUS_TX_COMPLETE);
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_WAITING, e->bTxStatus);
+  TxQueueReleaseElement(e);
+}
+
+void setUpSuite(void)
+{
+}
+
+void tearDownSuite(void)
+{
+}
+
+void setUp(void)
+{
+  m_tick = 1000;
+  m_timer_count = 0;
+  m_transmitted = NULL;
+  TxQueueInit();
+}
+
+void tearDown(void)
+{
+}
+
+/****************************************************************************/
+/*                                 TESTS                                    */
+/****************************************************************************/
+
+/**
+ * High priority frames are sent before low priority frames, and low priority
+ * frames are held back while another frame is waiting, e.g. for an ack.
+ */
+void test_priority_order(void)
+{
+  TxQueueElement *pBlocking = start_blocking_frame();
+  TxQueueElement *pLow = allocate(TX_QUEUE_PRIORITY_LOW);
+  TxQueueElement *pHigh1 = allocate(TX_QUEUE_PRIORITY_HIGH);
+  TxQueueElement *pHigh2 = allocate(TX_QUEUE_PRIORITY_HIGH);
+
+  TxQueueQueueElement(pLow);
+  TxQueueQueueElement(pHigh2);
+  TxQueueQueueElement(pHigh1);
+  TEST_ASSERT_NULL(take_transmitted());
+  TEST_ASSERT_FALSE(TxQueueIsIdle());
+
+  // A waiting frame does not hold back the high priority frames.
+  TxQueueTxComplete(RADIO_STATUS_TX_COMPLETE);
+  TEST_ASSERT_TRUE(TxQueueIsIdle());
+  TxQueueServiceTransmit();
+  TEST_ASSERT_EQUAL_PTR(pHigh1, take_transmitted());
+
+  finish(pHigh1);
+  TEST_ASSERT_EQUAL_PTR(pHigh2, take_transmitted());
+
+  TxQueueTxComplete(RADIO_STATUS_TX_COMPLETE);
+  TxQueueServiceTransmit();
+  TEST_ASSERT_NULL(take_transmitted());
+
+  TxQueueReleaseElement(pHigh2);
+  TEST_ASSERT_NULL(take_transmitted());
+  TxQueueReleaseElement(pBlocking);
+  TEST_ASSERT_EQUAL_PTR(pLow, take_transmitted());
+
+  finish(pLow);
+  TEST_ASSERT_NULL(take_transmitted());
+  TEST_ASSERT_TRUE(TxQueueIsEmpty());
+}
+
+/**
+ * Frames of the same priority are sent in the order they were allocated, not
+ * in the order they were queued, also when the sequence number wraps around.
+ */
+void test_fifo_across_sequence_wrap(void)
+{
+  TxQueueElement *pBlocking = start_blocking_frame();
+  TxQueueElement *pHigh[3];
+
+  // The sequence number is not reset by TxQueueInit(), so spin it to just before the wrap.
+  for (;;)
+  {
+    TxQueueElement *e = allocate(TX_QUEUE_PRIORITY_HIGH);
+    uint16_t wSequenceNumber = e->wSequenceNumber;
+    TxQueueReleaseElement(e);
+    if (0xFFFE == wSequenceNumber)
+    {
+      break;
+    }
+  }
+
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    pHigh[i] = allocate(TX_QUEUE_PRIORITY_HIGH);
+  }
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, pHigh[0]->wSequenceNumber);
+  TEST_ASSERT_EQUAL_HEX16(0x0000, pHigh[1]->wSequenceNumber);
+  TEST_ASSERT_EQUAL_HEX16(0x0001, pHigh[2]->wSequenceNumber);
+
+  TxQueueQueueElement(pHigh[2]);
+  TxQueueQueueElement(pHigh[1]);
+  TxQueueQueueElement(pHigh[0]);
+  TEST_ASSERT_NULL(take_transmitted());
+
+  finish(pBlocking);
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    TEST_ASSERT_EQUAL_PTR(pHigh[i], take_transmitted());
+    finish(pHigh[i]);
+  }
+  TEST_ASSERT_NULL(take_transmitted());
+}
+
+/**
+ * Delayed frames are released at their deadline, earliest first, whatever the
+ * order they were queued in. The deadlines here wrap around the tick count.
+ */
+void test_delayed_deadlines(void)
+{
+  m_tick = 0xFFFFFF80;
+  const uint32_t start = m_tick;
+
+  TxQueueElement *pLate = queue_delayed(300);
+  TxQueueElement *pEarly = queue_delayed(100);
+  TEST_ASSERT_TRUE(delayed_tx_timer()->running);
+  TEST_ASSERT_EQUAL_UINT32(start + 100, delayed_tx_timer()->expiry);
+
+  run_until(start + 99);
+  TEST_ASSERT_NULL(take_transmitted());
+  run_until(start + 100);
+  TEST_ASSERT_EQUAL_PTR(pEarly, take_transmitted());
+  TEST_ASSERT_EQUAL_UINT32(start + 300, delayed_tx_timer()->expiry);
+  finish(pEarly);
+
+  run_until(start + 299);
+  TEST_ASSERT_NULL(take_transmitted());
+  run_until(start + 300);
+  TEST_ASSERT_EQUAL_PTR(pLate, take_transmitted());
+  TEST_ASSERT_FALSE(delayed_tx_timer()->running);
+  finish(pLate);
+
+  // Frames due at the same time while the transmitter is busy wait their turn in allocation order.
+  TxQueueElement *pBlocking = start_blocking_frame();
+  TxQueueElement *pFirst = queue_delayed(50);
+  TxQueueElement *pSecond = queue_delayed(50);
+  run_until(start + 350);
+  TEST_ASSERT_NULL(take_transmitted());
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_READY_TO_SEND, pFirst->bTxStatus);
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_READY_TO_SEND, pSecond->bTxStatus);
+  TEST_ASSERT_FALSE(delayed_tx_timer()->running);
+
+  finish(pBlocking);
+  TEST_ASSERT_EQUAL_PTR(pFirst, take_transmitted());
+  finish(pFirst);
+  TEST_ASSERT_EQUAL_PTR(pSecond, take_transmitted());
+  finish(pSecond);
+
+  TxQueue_Statistics_t statistics;
+  TxQueueGetStatistics(&statistics);
+  TEST_ASSERT_EQUAL_UINT8(2, statistics.bDelayedPeak);
+}
+
+/**
+ * An element that leaves the ready heap or the delayed list for another
+ * reason than being sent is taken out of it, and the counters follow.
+ */
+void test_status_changes(void)
+{
+  TxQueue_Statistics_t statistics;
+  TxQueueElement *pBlocking = start_blocking_frame();
+
+  TxQueueElement *pDelayed1 = queue_delayed(100);
+  TxQueueElement *pDelayed2 = queue_delayed(200);
+  TEST_ASSERT_EQUAL_UINT32(m_tick + 100, delayed_tx_timer()->expiry);
+
+  // Releasing the earliest delayed frame moves the timer on to the next one.
+  TxQueueReleaseElement(pDelayed1);
+  TEST_ASSERT_EQUAL(TX_QUEUE_STATUS_FREE, pDelayed1->bTxStatus);
+  TEST_ASSERT_TRUE(delayed_tx_timer()->running);
+  TEST_ASSERT_EQUAL_UINT32(m_tick + 200, delayed_tx_timer()->expiry);
+  TxQueueReleaseElement(pDelayed2);
+  TEST_ASSERT_FALSE(delayed_tx_timer()->running);
+
+  TxQueueElement *pReady1 = allocate(TX_QUEUE_PRIORITY_LOW);
+  TxQueueElement *pReady2 = allocate(TX_QUEUE_PRIORITY_LOW);
+  TxQueueQueueElement(pReady1);
+  TxQueueQueueElement(pReady2);
+  TxQueueGetStatistics(&statistics);
+  TEST_ASSERT_EQUAL_UINT8(3, statistics.bUsed);
+
+  // A released ready frame is never sent.
+  TxQueueReleaseElement(pReady1);
+  finish(pBlocking);
+  TEST_ASSERT_EQUAL_PTR(pReady2, take_transmitted());
+  TxQueueGetStatistics(&statistics);
+  TEST_ASSERT_EQUAL_UINT8(1, statistics.bUsed);
+  TEST_ASSERT_EQUAL_UINT8(3, statistics.bUsedPeak);
+
+  TxQueueTxComplete(RADIO_STATUS_TX_COMPLETE);
+  TEST_ASSERT_TRUE(TxQueueIsIdle());
+  TEST_ASSERT_FALSE(TxQueueIsEmpty());
+  TxQueueReleaseElement(pReady2);
+  TEST_ASSERT_TRUE(TxQueueIsEmpty());
+  TEST_ASSERT_NULL(take_transmitted());
+}
+
+/*
+ * The model check below keeps its own view of every element and checks after
+ * each random operation that the queue agrees with it.
+ */
+typedef enum
+{
+  MODEL_FREE,
+  MODEL_ALLOCATED,
+  MODEL_DELAYED,
+  MODEL_READY,
+  MODEL_TRANSMITTING,
+  MODEL_WAITING
+} model_state_t;
+
+typedef struct
+{
+  TxQueueElement *e;
+  model_state_t state;
+  TxQueue_ElementPriority_t priority;
+  uint32_t order;
+  uint32_t deadline;
+} model_element_t;
+
+static model_element_t m_model[TRANSMIT_MAX];
+static uint8_t m_model_count;
+static uint32_t m_model_order;
+static TxQueueElement *m_model_current;
+
+static model_element_t *model_element(TxQueueElement *e)
+{
+  for (uint8_t i = 0; i < m_model_count; i++)
+  {
+    if (m_model[i].e == e)
+    {
+      return &m_model[i];
+    }
+  }
+  TEST_ASSERT_LESS_THAN_UINT8(TRANSMIT_MAX, m_model_count);
+  memset(&m_model[m_model_count], 0, sizeof(m_model[0]));
+  m_model[m_model_count].e = e;
+  return &m_model[m_model_count++];
+}
+
+static uint8_t model_count(model_state_t state)
+{
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < m_model_count; i++)
+  {
+    count += (m_model[i].state == state);
+  }
+  return count;
+}
+
+/* Checks that a sent frame is one the queue was allowed to send, and marks it as being sent. */
+static void model_check_transmitted(void)
+{
+  TxQueueElement *e = take_transmitted();
+  if (NULL == e)
+  {
+    return;
+  }
+  model_element_t *pSent = model_element(e);
+  TEST_ASSERT_EQUAL(MODEL_READY, pSent->state);
+  for (uint8_t i = 0; i < m_model_count; i++)
+  {
+    model_element_t *pOther = &m_model[i];
+    if (pOther == pSent)
+    {
+      continue;
+    }
+    if (MODEL_READY == pOther->state)
+    {
+      TEST_ASSERT_FALSE_MESSAGE((TX_QUEUE_PRIORITY_HIGH == pOther->priority) && (TX_QUEUE_PRIORITY_HIGH != pSent->priority),
+                                "High priority frame skipped");
+      TEST_ASSERT_FALSE_MESSAGE((pOther->priority == pSent->priority) && (pOther->order < pSent->order),
+                                "Allocation order broken");
+    }
+    TEST_ASSERT_FALSE_MESSAGE((TX_QUEUE_PRIORITY_LOW == pSent->priority) && (MODEL_WAITING == pOther->state),
+                              "Low priority frame sent while another frame is waiting");
+  }
+  pSent->state = MODEL_TRANSMITTING;
+  m_model_current = e;
+}
+
+static void model_check_queue(void)
+{
+  static const TxQueue_ElementState_t expected_status[] = {
+    [MODEL_FREE]         = TX_QUEUE_STATUS_FREE,
+    [MODEL_ALLOCATED]    = TX_QUEUE_STATUS_ALLOCATED,
+    [MODEL_DELAYED]      = TX_QUEUE_STATUS_DELAYED_TX_WAIT,
+    [MODEL_READY]        = TX_QUEUE_STATUS_READY_TO_SEND,
+    [MODEL_TRANSMITTING] = TX_QUEUE_STATUS_TRANSMITTING,
+    [MODEL_WAITING]      = TX_QUEUE_STATUS_WAITING,
+  };
+  bool ready_high = false;
+  bool ready_low = false;
+  bool delayed_due = false;
+
+  TEST_ASSERT_EQUAL(model_count(MODEL_FREE) == m_model_count, TxQueueIsEmpty());
+  TEST_ASSERT_EQUAL(0 == model_count(MODEL_TRANSMITTING), TxQueueIsIdle());
+
+  for (uint8_t i = 0; i < m_model_count; i++)
+  {
+    model_element_t *pElement = &m_model[i];
+    if (MODEL_FREE == pElement->state)
+    {
+      continue;
+    }
+    TEST_ASSERT_EQUAL(expected_status[pElement->state], pElement->e->bTxStatus);
+    if (MODEL_READY == pElement->state)
+    {
+      ready_high |= (TX_QUEUE_PRIORITY_HIGH == pElement->priority);
+      ready_low |= (TX_QUEUE_PRIORITY_LOW == pElement->priority);
+    }
+    if (MODEL_DELAYED == pElement->state)
+    {
+      // The timer must expire no later than the deadline, or at the next tick if it has passed.
+      uint32_t latest = ((int32_t)(pElement->deadline - m_tick) > 0) ? pElement->deadline : (m_tick + 1);
+      TEST_ASSERT_TRUE(delayed_tx_timer()->running);
+      TEST_ASSERT_TRUE((int32_t)(delayed_tx_timer()->expiry - latest) <= 0);
+      delayed_due = true;
+    }
+  }
+  TEST_ASSERT_EQUAL(delayed_due, delayed_tx_timer()->running);
+
+  // No frame that may be sent is left behind.
+  if (0 == model_count(MODEL_TRANSMITTING))
+  {
+    TEST_ASSERT_FALSE(ready_high);
+    TEST_ASSERT_FALSE(ready_low && (0 == model_count(MODEL_WAITING)));
+  }
+}
+
+static void model_queue(model_element_t *pElement, uint32_t delayMs)
+{
+  if (0 != delayMs)
+  {
+    TxQueueSetOptionFlags(pElement->e, TRANSMIT_OPTION_DELAYED_TX);
+    pElement->e->delayedTx.timeType = TIME_TYPE_RELATIVE;
+    pElement->e->delayedTx.delayedTxMs = delayMs;
+    pElement->state = MODEL_DELAYED;
+    pElement->deadline = m_tick + delayMs;
+  }
+  else
+  {
+    pElement->state = MODEL_READY;
+  }
+  TxQueueQueueElement(pElement->e);
+  model_check_transmitted();
+}
+
+static void model_release(model_element_t *pElement)
+{
+  pElement->state = MODEL_FREE;
+  TxQueueReleaseElement(pElement->e);
+  model_check_transmitted();
+}
+
+static void model_advance(uint32_t ms)
+{
+  while (ms--)
+  {
+    m_tick++;
+    fake_timer_t *pTimer = delayed_tx_timer();
+    if (pTimer->running && (pTimer->expiry == m_tick))
+    {
+      pTimer->running = false;
+      for (uint8_t i = 0; i < m_model_count; i++)
+      {
+        if ((MODEL_DELAYED == m_model[i].state) && ((int32_t)(m_model[i].deadline - m_tick) <= 0))
+        {
+          m_model[i].state = MODEL_READY;
+        }
+      }
+      pTimer->pTimer->pCallback(pTimer->pTimer);
+      model_check_transmitted();
+    }
+  }
+}
+
+/**
+ * Runs random allocations, queueings, transmissions, failures, releases and
+ * delays against the model, while the tick count wraps around.
+ */
+void test_model_check(void)
+{
+  TxQueue_Statistics_t statistics;
+  uint32_t allocations = 0;
+  uint32_t drops = 0;
+
+  m_tick = 0xFFFFF000;
+  m_model_count = 0;
+  m_model_order = 0;
+  m_model_current = NULL;
+  srand(1);
+
+  for (uint32_t step = 0; step < MODEL_CHECK_STEPS; step++)
+  {
+    uint32_t operation = (uint32_t)rand() % 10;
+
+    if (operation <= 2)
+    {
+      TxQueue_ElementPriority_t priority = (0 == rand() % 4) ? TX_QUEUE_PRIORITY_HIGH : TX_QUEUE_PRIORITY_LOW;
+      bool delayed = (TX_QUEUE_PRIORITY_LOW == priority) && (0 == rand() % 3);
+      TxQueueElement *e = TxQueueGetFreeElement(priority, delayed);
+      if (NULL == e)
+      {
+        drops++;
+      }
+      else
+      {
+        model_element_t *pElement = model_element(e);
+        TEST_ASSERT_EQUAL(MODEL_FREE, pElement->state);
+        allocations++;
+        pElement->state = MODEL_ALLOCATED;
+        pElement->priority = priority;
+        pElement->order = m_model_order++;
+        if (0 != rand() % 8)
+        {
+          model_queue(pElement, delayed ? (1 + (uint32_t)rand() % 1000) : 0);
+        }
+      }
+    }
+    else if ((operation <= 4) && (NULL != m_model_current)
+             && (TX_QUEUE_STATUS_TRANSMITTING == m_model_current->bTxStatus))
+    {
+      model_element_t *pElement = model_element(m_model_current);
+      if (3 == operation)
+      {
+        pElement->state = MODEL_WAITING;
+        TxQueueTxComplete(RADIO_STATUS_TX_COMPLETE);
+        model_check_transmitted();
+        // Done by the callback of the transport layer.
+        TxQueueServiceTransmit();
+        model_check_transmitted();
+      }
+      else
+      {
+        // The transmission fails once the LBT time has passed.
+        model_advance(2000);
+        pElement->state = MODEL_FREE;
+        TxQueueTxComplete(RADIO_STATUS_TX_FAIL);
+        model_check_transmitted();
+        TxQueueReleaseElement(pElement->e);
+        model_check_transmitted();
+      }
+    }
+    else if ((operation <= 6) && (0 != m_model_count))
+    {
+      // Release or queue again a random element.
+      model_element_t *pElement = &m_model[(uint32_t)rand() % m_model_count];
+      if ((MODEL_WAITING == pElement->state) || (MODEL_ALLOCATED == pElement->state))
+      {
+        if (0 == rand() % 2)
+        {
+          model_queue(pElement, 0);
+        }
+        else
+        {
+          model_release(pElement);
+        }
+      }
+      else if ((MODEL_FREE != pElement->state) && (MODEL_TRANSMITTING != pElement->state))
+      {
+        model_release(pElement);
+      }
+    }
+    else
+    {
+      model_advance((uint32_t)rand() % 50);
+    }
+    model_check_queue();
+  }
+
+  TxQueueGetStatistics(&statistics);
+  TEST_ASSERT_EQUAL_UINT32(allocations, statistics.allocations);
+  TEST_ASSERT_EQUAL_UINT32(drops, statistics.drops);
+}
@@ -14,6 +14,7 @@
 #include <ZW_Security_Scheme0.h>
 #include <ZW_protocol.h>
 #include <s2_keystore.h>
+#include <aes.h>
 #include <zpal_entropy.h>
 #include <ZW_transport.h>
 #include <ZW_keystore.h>
@@ -56,8 +57,6 @@ typedef struct {
   uint32_t timeout;
 } rx_session_t;
 
-extern  void AES128_ECB_encrypt(uint8_t* input, const uint8_t* key, uint8_t *output);
-
 #define NONCE_OPT 0
 #define NONCE_TIMEOUT_MSEC ( NONCE_TIMEOUT * CLOCK_SECOND ) /* Validity time of a received nonce in milliseconds*/
 #define TIMEOUT_ON 1
@@ -123,6 +122,19 @@ static uint8_t aFrame[TX_BUFFER_SIZE];
 /************************ AES Helper functions ********************************************/
 static uint8_t aes_key[16];
 static uint8_t aes_iv[16];
+#ifndef ZWAVE_PSA_AES
+static aes128_ctx aes_ctx; // aes_key expanded by aes_load_key()
+#endif
+
+/*
+ * Must be called when aes_key has been changed. The key is expanded once
+ * here instead of for every block of the OFB and CBC-MAC loops.
+ */
+static void aes_load_key(void) {
+#ifndef ZWAVE_PSA_AES
+  AES128_init_ctx(&aes_ctx, aes_key);
+#endif
+}
 
 void aes_encrypt(uint8_t *in, uint8_t* out) {
 #ifdef ZWAVE_PSA_AES
@@ -133,13 +145,14 @@ void aes_encrypt(uint8_t *in, uint8_t* out) {
   /* Remove key from vault */
   zw_psa_destroy_key(key_id);
 #else
-  AES128_ECB_encrypt(in, aes_key, out);
+  AES128_ctx_encrypt(&aes_ctx, in, out);
 #endif
 }
 
 void aes_set_key(uint8_t* key,uint8_t* iv) {
   memcpy(aes_key,key,16);
   memcpy(aes_iv,iv,16);
+  aes_load_key();
 }
 
 void aes_ofb(uint8_t* pData,uint8_t len) {
@@ -322,6 +335,7 @@ sec0_unpersist_netkey(void)
     }
   }
 #endif
+  aes_load_key();
   memset(p,0x55,16);
   aes_encrypt(p,authkey);
   memset(p,0xAA,16);
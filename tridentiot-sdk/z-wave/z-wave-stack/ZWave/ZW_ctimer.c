@@ -49,7 +49,6 @@
  *         Adam Dunkels <adam@sics.se>
  */
 
-#include "linked_list.h"
 #include "FreeRTOS.h"
 #include "FreeRTOSConfig.h"
 #include "task.h"
@@ -57,51 +56,101 @@
 #include <ZW_timer.h>
 #include <SwTimer.h>
 
-LIST(ctimer_list);
+/*
+ * Running timers sorted by their absolute timeout, earliest first.
+ * The timeouts are absolute, so nothing has to be adjusted when time passes.
+ * Expiring a timer only pops the head of the list.
+ */
+static struct ctimer *ctimer_first;
+static struct ctimer *ctimer_last;
 
 static SSwTimer m_CTimerSwTimer;
-static clock_time_t last_ticks;
 static void ctimer_timerCallback(SSwTimer* pTimer);
 
-static void adjust_timeout(void) {
-  struct ctimer *c = list_head(ctimer_list);
-  /*Math here assume that the compiler would always handle the variables as 32-bit*/
-  clock_time_t current_ticks = xTaskGetTickCount();
-  clock_time_t elapsed_ticks = current_ticks - last_ticks;
-  last_ticks = current_ticks;
-
-  if(c) {
-    for (; c != NULL; c = c->next)
-    {
-      if (c->timeout > elapsed_ticks) {
-        c->timeout -= elapsed_ticks;
+/*
+ * The tick count wraps, so compare the signed distance.
+ * Requires the timeouts to be less than 2^31 ticks apart.
+ */
+static bool timeout_before(clock_time_t a, clock_time_t b) {
+  return (int32_t)(a - b) < 0;
+}
+
+static void unlink_timer(struct ctimer *c) {
+  struct ctimer *prev = NULL;
+  struct ctimer *cur;
+
+  for (cur = ctimer_first; cur != NULL; cur = cur->next) {
+    if (cur == c) {
+      if (prev != NULL) {
+        prev->next = c->next;
       } else {
-        c->timeout = 0;
+        ctimer_first = c->next;
+      }
+      if (ctimer_last == c) {
+        ctimer_last = prev;
       }
+      c->next = NULL;
+      return;
     }
+    prev = cur;
   }
 }
 
-static void remove_expired_timers (void) {
-  struct ctimer *elm = list_head(ctimer_list);
-  for (; elm != NULL; elm = elm->next)
-   {
-     // f the timer alrady expired then call the callback function thne remove it from the list
-     if (0 == elm->timeout) {
-       /* call the timeout function */
-       if (elm->f != NULL) elm->f(elm->ptr);
-       list_remove( ctimer_list, elm);
-     }
+static void link_timer(struct ctimer *c) {
+  struct ctimer *cur;
+
+  c->next = NULL;
+  if (NULL == ctimer_first) {
+    ctimer_first = c;
+    ctimer_last = c;
+  } else if (!timeout_before(c->timeout, ctimer_last->timeout)) {
+    // Most timers expire after all the running ones, append them without walking the list
+    ctimer_last->next = c;
+    ctimer_last = c;
+  } else if (timeout_before(c->timeout, ctimer_first->timeout)) {
+    c->next = ctimer_first;
+    ctimer_first = c;
+  } else {
+    // Insert after timers with the same timeout. cur->next is never NULL as c is before the last one.
+    cur = ctimer_first;
+    while (!timeout_before(c->timeout, cur->next->timeout)) {
+      cur = cur->next;
+    }
+    c->next = cur->next;
+    cur->next = c;
   }
 }
+
+static struct ctimer *pop_timer(void) {
+  struct ctimer *c = ctimer_first;
+
+  if (c != NULL) {
+    ctimer_first = c->next;
+    if (NULL == ctimer_first) {
+      ctimer_last = NULL;
+    }
+    c->next = NULL;
+  }
+  return c;
+}
+
+static void remove_expired_timers(clock_time_t now) {
+  struct ctimer *c;
+
+  while ((NULL != ctimer_first) && !timeout_before(now, ctimer_first->timeout)) {
+    c = pop_timer();
+    /* call the timeout function */
+    if (c->f != NULL) c->f(c->ptr);
+  }
+}
+
 /**
  * Update our timer to fire on the next timeout
  */
-static void update_timer(void) {
-  remove_expired_timers();
-  struct ctimer *c = list_head(ctimer_list);
-  if((NULL != c) && c->timeout) {
-    TimerStart(&m_CTimerSwTimer, c->timeout );
+static void update_timer(clock_time_t now) {
+  remove_expired_timers(now);
+  if (NULL != ctimer_first) {
+    TimerStart(&m_CTimerSwTimer, ctimer_first->timeout - now);
   } else {
     TimerStop(&m_CTimerSwTimer);
   }
@@ -109,20 +158,20 @@ static void update_timer(void) {
 
 static void ctimer_timerCallback(__attribute__((unused)) SSwTimer* pTimer)
 {
-  struct ctimer *c = list_pop(ctimer_list);
+  // The SwTimer was started with the time left of the first timer
+  struct ctimer *c = pop_timer();
 
   /* call the timeout function */
-  if (c->f != NULL) c->f(c->ptr);
-  adjust_timeout();
-  update_timer();
+  if ((c != NULL) && (c->f != NULL)) c->f(c->ptr);
+  update_timer(xTaskGetTickCount());
 }
 
 
 
 void ctimer_init(void)
 {
-  list_init(ctimer_list);
-  last_ticks = xTaskGetTickCount();
+  ctimer_first = NULL;
+  ctimer_last = NULL;
   // Initialize timer
   ZwTimerRegister(&m_CTimerSwTimer, false, ctimer_timerCallback);
 }
@@ -131,46 +180,23 @@ void
 ctimer_set(struct ctimer *new_timer, clock_time_t t,
            void (*f)(void *), void *ptr)
 {
-  struct ctimer *cur;
+  clock_time_t now;
 
   /*Make sure that the timer is not already in the list*/
-  list_remove( ctimer_list, new_timer);
-  adjust_timeout();
-  new_timer->timeout = t;
+  unlink_timer(new_timer);
+  now = xTaskGetTickCount();
+  new_timer->timeout = now + t;
   new_timer->f = f;
   new_timer->ptr = ptr;
-
-  if (!list_length(ctimer_list))
-    // List is empty, simply push new elem
-    list_push(ctimer_list, new_timer);
-  else
-  {
-    // Try to find the right place to insert new_elem
-    cur = list_head(ctimer_list);
-    // new_elem has to be inserted in front of the list
-    if (cur->timeout > t)
-      list_push(ctimer_list, new_timer);
-    else
-    {
-      while (cur)
-      {
-        if (!cur->next /* cur is the last elem of the queue */
-            || cur->next->timeout > t /* new_elem has to be inserted between cur & cur->next */)
-          break;
-        cur = cur->next;
-      };
-      list_insert(ctimer_list, cur, new_timer);
-    }
-  }
-  update_timer();
+  link_timer(new_timer);
+  update_timer(now);
 }
 
 void
 ctimer_stop(struct ctimer *c)
 {
-  list_remove(ctimer_list, c);
-  adjust_timeout();
-  update_timer();
+  unlink_timer(c);
+  update_timer(xTaskGetTickCount());
 }
 
 /*---------------------------------------------------------------------------*/
@@ -178,7 +204,7 @@ int
 ctimer_expired(struct ctimer *c)
 {
   struct ctimer *t;
-  for(t = list_head(ctimer_list); t != NULL; t = t->next) {
+  for(t = ctimer_first; t != NULL; t = t->next) {
     if(t == c) {
       return 0;
     }
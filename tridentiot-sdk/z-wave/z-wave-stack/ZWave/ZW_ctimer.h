@@ -96,6 +96,12 @@ struct ctimer {
  *             sometime in the future. When the callback timer expires,
  *             the callback function f will be called with ptr as argument.
  *
+ *             t must be less than 2^31 ticks. If t is 0, f is called
+ *             before ctimer_set() returns.
+ *
+ *             Setting a timer that expires after all the running timers
+ *             does not walk the list of running timers.
+ *
  */
 void ctimer_set(struct ctimer *c, clock_time_t t,
 		            void(*f)(void *), void *ptr);
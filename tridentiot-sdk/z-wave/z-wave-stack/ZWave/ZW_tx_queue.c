@@ -52,6 +52,12 @@ static int beam_fragment_count = 0;
 // The maximum number of delayed transmissions allowed in the TxQueue.
 #define TX_QUEUE_DELAYED_TX_COUNT_MAX                 (TRANSMIT_MAX - TXQUEUE_MIN_FREE_FOR_LOW_PRIORITY)
 
+// Marks the end of the delayed transmission list.
+#define TX_QUEUE_INDEX_NONE                           0xFF
+
+_Static_assert((TRANSMIT_MAX > TXQUEUE_MIN_FREE_FOR_LOW_PRIORITY) && (TRANSMIT_MAX < TX_QUEUE_INDEX_NONE),
+               "error: TRANSMIT_MAX must be in the range 3..254");
+
 /****************************************************************************/
 /*                              PRIVATE DATA                                */
 /****************************************************************************/
@@ -70,10 +76,25 @@ static TxQueueElement m_TxQueue[TRANSMIT_MAX] = {{ 0 }};
 /* Timer for transmit pause */
 static SSwTimer m_TransmitPauseTimer = { 0 };
 
+/* Heap of the elements ready to send, see readyHeapInsert() */
+static uint8_t m_readyHeap[TRANSMIT_MAX];
+static uint8_t m_readyCount = 0;
+
 /* Timer for delayed transmissions. */
 static SSwTimer m_TimerDelayedTX = { 0 };                        // The timer used to do the delaying of the TX.
+static uint8_t  m_delayedTxHead = TX_QUEUE_INDEX_NONE;   // The delayed transmission with the earliest deadline.
 static uint8_t  m_delayedTxCount = 0;                    // Used to count the number of delayed transmissions currently in the TxQueue.
 
+/* Number of elements in a given state, kept by txQueueSetStatus() */
+static uint8_t m_transmittingCount = 0;
+static uint8_t m_waitingCount = 0;
+static uint8_t m_highPriorityCount = 0;
+
+/* Allocation order of the elements */
+static uint16_t m_sequenceNumber = 0;
+
+static TxQueue_Statistics_t m_statistics = { 0 };
+
 /*
  * TODO If would be nicer to have an Abort function, like TxQeueueAbort(*element)  or TxQeueueAbortCurrent()
  */
@@ -93,6 +114,7 @@ LIST(txQueueEmptyEvent_list);
 
 static void ZCB_TransmitPauseTimerTimeout(SSwTimer* pTimer);
 static void ZCB_DelayedTxTimerTimeout(SSwTimer* pTimer);
+static void txQueueSetStatus(TxQueueElement *e, TxQueue_ElementState_t status);
 
 void TxQueueRegisterPowerLocks(void)
 {
@@ -120,12 +142,18 @@ void
 TxQueueInit(void)
 {
   memset(m_TxQueue,0,sizeof(m_TxQueue));
+  m_readyCount = 0;
+  m_delayedTxHead = TX_QUEUE_INDEX_NONE;
+  m_delayedTxCount = 0;
+  m_transmittingCount = 0;
+  m_waitingCount = 0;
+  m_highPriorityCount = 0;
+  memset(&m_statistics, 0, sizeof(m_statistics));
   zpal_pm_cancel(tx_queue_power_lock);
 
   bCurrentTransmit = NULL;
   ZwTimerRegister(&m_TransmitPauseTimer, false, ZCB_TransmitPauseTimerTimeout);
 
-  m_TimerDelayedTX.ptr = NULL;  // No TxQueueElement if currently set to be delayed.
   ZwTimerRegister(&m_TimerDelayedTX, false, ZCB_DelayedTxTimerTimeout);
 
   /* Initialize TxQueue Empty Event callback list */
@@ -139,40 +167,32 @@ TxQueueGetFreeElement(
     bool delayedTx)
 {
   uint8_t bElement = 0xFF;
-  uint8_t bFree = 0;
-  uint8_t fHighPriorityQueued = false;
+  uint8_t bFree = TRANSMIT_MAX - m_statistics.bUsed;
 
   // Check to see if maximum number of allowed delayed transmissions are consumed already.
   if ((m_delayedTxCount >= TX_QUEUE_DELAYED_TX_COUNT_MAX) && (delayedTx == true))
   {
     // The TxQueue has reached its limit in the number of delayed transmissions that it can hold at once.
+    m_statistics.drops++;
+    m_statistics.delayedDrops++;
     return NULL;
   }
 
-  /* Find a free element and count the number of free elements */
-  for (register uint8_t bCount = 0; bCount < TRANSMIT_MAX; bCount++)
+  /* Check if there is at least one free element left if the frame isn't a high priority frame */
+  /* unless there is already another high priority frame in the queue */
+  /* TO#5887 fix - For LOW_PRIORITY frame we need at least 2 free if no HIGH_PRIORITY in */
+  if ((bPriority == TX_QUEUE_PRIORITY_HIGH)
+      || ((bFree >= TXQUEUE_MIN_FREE_FOR_LOW_PRIORITY) || (0 != m_highPriorityCount)))
   {
-    if (m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_FREE)
+    /* Find a free element */
+    for (register uint8_t bCount = 0; (bFree != 0) && (bCount < TRANSMIT_MAX); bCount++)
     {
-      if (bElement == 0xFF)
+      if (m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_FREE)
       {
         bElement = bCount;
+        break;
       }
-      bFree++;
     }
-    else if (m_TxQueue[bCount].bTxPriority == TX_QUEUE_PRIORITY_HIGH)
-    {
-      fHighPriorityQueued = true;
-    }
-  }
-
-  /* Check if there is at least one free element left if the frame isn't a high priority frame */
-  /* unless there is already another high priority frame in the queue */
-  /* TO#5887 fix - For LOW_PRIORITY frame we need at least 2 free if no HIGH_PRIORITY in */
-  if ((bPriority != TX_QUEUE_PRIORITY_HIGH)
-      && ((bFree < TXQUEUE_MIN_FREE_FOR_LOW_PRIORITY) && !fHighPriorityQueued))
-  {
-    bElement = 0xFF;
   }
 
   if (bElement < TRANSMIT_MAX)
@@ -182,11 +202,14 @@ TxQueueGetFreeElement(
 
     m_TxQueue[bElement].frame.txPower = ZPAL_RADIO_TX_POWER_UNINITIALIZED;
 
-    m_TxQueue[bElement].bTxStatus = TX_QUEUE_STATUS_ALLOCATED;
     m_TxQueue[bElement].bTxPriority = bPriority;
+    m_TxQueue[bElement].wSequenceNumber = m_sequenceNumber++;
+    txQueueSetStatus(&m_TxQueue[bElement], TX_QUEUE_STATUS_ALLOCATED);
+    m_statistics.allocations++;
     return (&m_TxQueue[bElement]);
   }
 
+  m_statistics.drops++;
   return (NULL);
 }
 
@@ -356,7 +379,7 @@ static void TxQueueDoTransmit(TxQueueElement* e, bool useLBT)
     //TODO the timer here should not be necessary.... Why not?
     zpal_pm_stay_awake(tx_queue_power_lock, 60000);
     /* Frame is now being transmitted, change status of the frame */
-    e->bTxStatus = TX_QUEUE_STATUS_TRANSMITTING;
+    txQueueSetStatus(e, TX_QUEUE_STATUS_TRANSMITTING);
     /* Allow restart of ack wait timer */
     /* TO#2523 Fix */
     bRestartAckTimerAllowed = 1;
@@ -372,157 +395,264 @@ static void TxQueueDoTransmit(TxQueueElement* e, bool useLBT)
 }
 
 
-/**
- * @brief This function will calculate the time difference from current time to a future time.
- *
- * The function can handle the overflow of the timer value and fold the timer variables if needed.
+/*
+ * Frames ready to send are kept in a binary min-heap of indices into m_TxQueue, ordered by
+ * priority and then by the order in which the elements were allocated. The root is the next
+ * frame to transmit. Each element knows its position in the heap, so it can be removed when
+ * it leaves the ready state for another reason than being transmitted.
  */
-static uint32_t getCircularTimeDifference(uint32_t currentTickTime, uint32_t futureTimeMs)
+static uint8_t txQueuePriorityRank(const TxQueueElement *e)
 {
-  if (currentTickTime <= futureTimeMs)
-  {
-    return futureTimeMs - currentTickTime;  // This much time is remaining till me reach the future time.
-  }
-  else
+  /* TX_QUEUE_PRIORITY_UNDEF wraps around and is ranked after the low priority frames. */
+  return (uint8_t)(e->bTxPriority - TX_QUEUE_PRIORITY_HIGH);
+}
+
+static bool txQueueIsBefore(uint8_t bFirst, uint8_t bSecond)
+{
+  const TxQueueElement *pFirst = &m_TxQueue[bFirst];
+  const TxQueueElement *pSecond = &m_TxQueue[bSecond];
+
+  if (pFirst->bTxPriority != pSecond->bTxPriority)
   {
-    /* First calculate the time untill overflow, and then add that time to the futureTimeMs which start from zero,
-     * so the result is the combined waiting time until the future-time. */
-    return (UINT32_MAX - currentTickTime) + futureTimeMs;
+    return txQueuePriorityRank(pFirst) < txQueuePriorityRank(pSecond);
   }
+  return (int16_t)(pFirst->wSequenceNumber - pSecond->wSequenceNumber) < 0;
 }
 
-
-/*
- * This function will manage the transmissions that are enqueued but set to be delayed.
- * This function will neglect all associations to transmission priority.
- * It will ASSERT in case it finds a high priority transmission that is delayed. (Seen as implementation issue)
- */
-static void handleEnqueuedDelayedTransmissions(void)
+static void readyHeapPlace(uint8_t bPosition, uint8_t bElement)
 {
-  uint32_t pMsUntilTimeout;
-  uint32_t currentTickTime;
-
-  uint32_t shortestDelay = UINT32_MAX;  // Initialize to invalid delay to detect change.
-  TxQueueElement *nextDelayedElementToTransmit = NULL;
+  m_readyHeap[bPosition] = bElement;
+  m_TxQueue[bElement].bHeapPosition = (uint8_t)(bPosition + 1);
+}
 
-  /*
-   * The priority of the transmissions are being neglected!
-   * A delayed high priority transmission makes no sense.
-   */
+static void readyHeapSiftUp(uint8_t bPosition)
+{
+  uint8_t bElement = m_readyHeap[bPosition];
 
-  // Search for enqueued delayed transmissions in the queue and set or modify the timer.
-  for (register uint8_t bCount = 0; bCount < TRANSMIT_MAX; bCount++)
+  while (bPosition > 0)
   {
-    /* First check for high priority frames */
-    if (m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_DELAYED_TX)
+    uint8_t bParent = (uint8_t)((bPosition - 1) / 2);
+    if (!txQueueIsBefore(bElement, m_readyHeap[bParent]))
     {
-      ASSERT(m_TxQueue[bCount].bTxPriority == TX_QUEUE_PRIORITY_LOW);  // Only low priority TX are permitted!
-      ASSERT(m_TxQueue[bCount].delayedTx.timeType == TIME_TYPE_ABSOLUTE);      // Run-time implementation check
-
-      currentTickTime = getTickTime();
-
-      // Search for the first element that needs transmission based on its set delay.
-      if (getCircularTimeDifference(currentTickTime, m_TxQueue[bCount].delayedTx.delayedTxMs) < shortestDelay)
-      {
-        shortestDelay = getCircularTimeDifference(currentTickTime, m_TxQueue[bCount].delayedTx.delayedTxMs);
-        nextDelayedElementToTransmit = &m_TxQueue[bCount];  // Keep the element for further processing.
-      }
+      break;
     }
+    readyHeapPlace(bPosition, m_readyHeap[bParent]);
+    bPosition = bParent;
   }
+  readyHeapPlace(bPosition, bElement);
+}
 
-  /**
-   * NOTE: Due to the fact that we are only queuing the elements for transmission and are not performing the TX,
-   * and that the queuing is done by the RTOS timer task, we cannot miss a deadline and overshoot the delay set for
-   * the transmission.
-   * Therefore, it is not handled!
-   */
+static void readyHeapSiftDown(uint8_t bPosition)
+{
+  uint8_t bElement = m_readyHeap[bPosition];
 
-  if (shortestDelay != UINT32_MAX)  // The maximum allowed delay is limited with TRANSMIT_OPTION_DELAYED_MAX_MS.
+  for (;;)
   {
-    // Is the timer busy with another element in the queue?
-    if (TimerIsActive(&m_TimerDelayedTX) && m_TimerDelayedTX.ptr != nextDelayedElementToTransmit)
+    uint16_t wChild = (uint16_t)(2 * bPosition + 1);
+    if (wChild >= m_readyCount)
     {
-      ASSERT(0);  // Run-time test: The element currently holding the timer busy is not in the queue anymore, or calculation issue!
+      break;
     }
-    else if (TimerIsActive(&m_TimerDelayedTX) && m_TimerDelayedTX.ptr == nextDelayedElementToTransmit)
+    if ((wChild + 1 < m_readyCount) && txQueueIsBefore(m_readyHeap[wChild + 1], m_readyHeap[wChild]))
     {
-      // Integrity check: (TODO convert to debug code, currently not supported)
-
-      // Check to see if the delays still match.
-      TimerGetMsUntilTimeout(&m_TimerDelayedTX, currentTickTime, &pMsUntilTimeout);
-      // The delay in shortestDelay must belong to the currently active element that keeps the timer busy.
-      // No need to do anything.
+      wChild++;
     }
-    else
+    if (!txQueueIsBefore(m_readyHeap[wChild], bElement))
     {
-      nextDelayedElementToTransmit->bTxStatus = TX_QUEUE_STATUS_DELAYED_TX_WAIT;
-      m_TimerDelayedTX.ptr = nextDelayedElementToTransmit;
-      TimerStart(&m_TimerDelayedTX, shortestDelay);
-      m_delayedTxCount++;
+      break;
     }
+    readyHeapPlace(bPosition, m_readyHeap[wChild]);
+    bPosition = (uint8_t)wChild;
   }
-  else
+  readyHeapPlace(bPosition, bElement);
+}
+
+static void readyHeapInsert(TxQueueElement *e)
+{
+  ASSERT(m_readyCount < TRANSMIT_MAX);
+  readyHeapPlace(m_readyCount, (uint8_t)(e - m_TxQueue));
+  readyHeapSiftUp(m_readyCount++);
+}
+
+static void readyHeapRemove(TxQueueElement *e)
+{
+  uint8_t bPosition = e->bHeapPosition - 1;
+  e->bHeapPosition = 0;
+
+  if (bPosition < --m_readyCount)
   {
-    // None of the queued elements are set to be transmitted with a delay! Do nothing.
+    /* Fill the hole with the last element and restore the heap order. */
+    uint8_t bMoved = m_readyHeap[m_readyCount];
+    readyHeapPlace(bPosition, bMoved);
+    readyHeapSiftUp(bPosition);
+    readyHeapSiftDown(m_TxQueue[bMoved].bHeapPosition - 1);
   }
 }
 
+/*
+ * Delayed transmissions are kept in a list sorted by deadline. The delayed TX timer always
+ * runs for the head of the list.
+ */
+static void delayedTxStartTimer(void)
+{
+  if (TX_QUEUE_INDEX_NONE == m_delayedTxHead)
+  {
+    TimerStop(&m_TimerDelayedTX);
+    return;
+  }
+
+  int32_t msUntilDeadline = (int32_t)(m_TxQueue[m_delayedTxHead].delayedTx.delayedTxMs - getTickTime());
+  /* A timeout of zero is illegal. A deadline that has passed is handled at the next tick. */
+  TimerStart(&m_TimerDelayedTX, (msUntilDeadline > 0) ? (uint32_t)msUntilDeadline : 1);
+}
 
-static uint8_t checkForQueuedHighPriorityPackets(void)
+static void delayedTxInsert(TxQueueElement *e)
 {
-  register uint8_t bElement = 0xFF;         // Invalid TxQueueElement Index.
+  ASSERT(TX_QUEUE_PRIORITY_LOW == e->bTxPriority);  // Only low priority TX are permitted!
+  ASSERT(TIME_TYPE_ABSOLUTE == e->delayedTx.timeType);
 
-  if ((NULL == bCurrentTransmit) || (bCurrentTransmit->bTxStatus != TX_QUEUE_STATUS_TRANSMITTING))
+  uint8_t *pLink = &m_delayedTxHead;
+  while ((TX_QUEUE_INDEX_NONE != *pLink)
+         && ((int32_t)(m_TxQueue[*pLink].delayedTx.delayedTxMs - e->delayedTx.delayedTxMs) <= 0))
   {
-    /* Find the next element in the queue to transmit */
-    for (register uint8_t bCount = 0; bCount < TRANSMIT_MAX; bCount++)
-    {
-      /* First check for high priority frames */
-      if (m_TxQueue[bCount].bTxPriority == TX_QUEUE_PRIORITY_HIGH && m_TxQueue[bCount].bTxStatus ==  TX_QUEUE_STATUS_READY_TO_SEND)
-      {
-        bElement = bCount;
-        /* High priority element found, no need to continue */
-        break;
-      }
+    pLink = &m_TxQueue[*pLink].bNextDelayed;
+  }
+  e->bNextDelayed = *pLink;
+  *pLink = (uint8_t)(e - m_TxQueue);
 
-      // Run-time error check (In case of wrong flag setting, the above check wont catch the condition below)
-      ASSERT( !((m_TxQueue[bCount].bTxPriority == TX_QUEUE_PRIORITY_HIGH)
-        && (m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_READY_TO_SEND)) );
-    }
+  m_delayedTxCount++;
+  if (m_delayedTxCount > m_statistics.bDelayedPeak)
+  {
+    m_statistics.bDelayedPeak = m_delayedTxCount;
+  }
+  if (&m_delayedTxHead == pLink)
+  {
+    delayedTxStartTimer();
   }
-  return bElement;
 }
 
-static uint8_t checkForQueuedWaitingAndLowPriorityPackets(void)
+static void delayedTxRemove(TxQueueElement *e)
 {
-  register uint8_t bElement = 0xFF;         // Invalid TxQueueElement Index.
+  uint8_t bElement = (uint8_t)(e - m_TxQueue);
+  uint8_t *pLink = &m_delayedTxHead;
 
-  if ((NULL == bCurrentTransmit) || (bCurrentTransmit->bTxStatus != TX_QUEUE_STATUS_TRANSMITTING))
+  while (*pLink != bElement)
   {
-    /* Find the next element in the queue to transmit */
-    for (register uint8_t bCount = 0; bCount < TRANSMIT_MAX; bCount++)
-    {
-      if (m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_WAITING)
-      {
-        DPRINT("TxQueueServiceTransmit waiting for ack\n");
+    ASSERT(TX_QUEUE_INDEX_NONE != *pLink);
+    pLink = &m_TxQueue[*pLink].bNextDelayed;
+  }
+  *pLink = e->bNextDelayed;
 
-        /* If there is a waiting element then DON'T send any low priority frames */
+  ASSERT(0 != m_delayedTxCount);
+  m_delayedTxCount--;
+  if (&m_delayedTxHead == pLink)
+  {
+    delayedTxStartTimer();
+  }
+}
 
-        /* TODO - Here we could implement a Global timeout - NO TxElement must be in Waiting for longer than... */
-        /* Just make use of the Global 10ms/1ms Ticker. */
+/**
+ * @brief Changes the state of an element and keeps the ready heap, the delayed transmission
+ * list and the counters of the queue in line with it.
+ *
+ * The state of the elements must only be changed through this function.
+ */
+static void txQueueSetStatus(TxQueueElement *e, TxQueue_ElementState_t status)
+{
+  TxQueue_ElementState_t oldStatus = e->bTxStatus;
 
-        // We have a waiting packet for further processing. No low priority packet should be transmitted at this time.
-        bElement = 0xFF;  // Do not make a new transmission.
-        break;
-      }
-      else if (bElement == 0xFF && (m_TxQueue[bCount].bTxPriority == TX_QUEUE_PRIORITY_LOW && m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_READY_TO_SEND))
-      {
-        /* No high priority and no waiting, send low priority */
-        bElement = bCount;  // Do transmission
-      }
+  if (oldStatus == status)
+  {
+    return;
+  }
+  e->bTxStatus = status;
+
+  if (TX_QUEUE_STATUS_READY_TO_SEND == oldStatus)
+  {
+    readyHeapRemove(e);
+  }
+  else if (TX_QUEUE_STATUS_DELAYED_TX_WAIT == oldStatus)
+  {
+    delayedTxRemove(e);
+  }
+  else if (TX_QUEUE_STATUS_TRANSMITTING == oldStatus)
+  {
+    m_transmittingCount--;
+  }
+  else if (TX_QUEUE_STATUS_WAITING == oldStatus)
+  {
+    m_waitingCount--;
+  }
+
+  if (TX_QUEUE_STATUS_READY_TO_SEND == status)
+  {
+    readyHeapInsert(e);
+  }
+  else if (TX_QUEUE_STATUS_DELAYED_TX_WAIT == status)
+  {
+    delayedTxInsert(e);
+  }
+  else if (TX_QUEUE_STATUS_TRANSMITTING == status)
+  {
+    m_transmittingCount++;
+  }
+  else if (TX_QUEUE_STATUS_WAITING == status)
+  {
+    m_waitingCount++;
+  }
+
+  if (TX_QUEUE_STATUS_FREE == status)
+  {
+    m_statistics.bUsed--;
+    if (TX_QUEUE_PRIORITY_HIGH == e->bTxPriority)
+    {
+      m_highPriorityCount--;
+    }
+  }
+  else if (TX_QUEUE_STATUS_FREE == oldStatus)
+  {
+    m_statistics.bUsed++;
+    if (m_statistics.bUsed > m_statistics.bUsedPeak)
+    {
+      m_statistics.bUsedPeak = m_statistics.bUsed;
     }
+    if (TX_QUEUE_PRIORITY_HIGH == e->bTxPriority)
+    {
+      m_highPriorityCount++;
+    }
+  }
+}
+
+
+/**
+ * @brief Returns the next frame to transmit, or NULL if nothing may be transmitted now.
+ *
+ * High priority frames are sent first. Low priority frames are not sent while another frame
+ * is waiting for further processing, e.g. for an acknowledge.
+ */
+static TxQueueElement *getNextElementToTransmit(void)
+{
+  if ((NULL != bCurrentTransmit) && (bCurrentTransmit->bTxStatus == TX_QUEUE_STATUS_TRANSMITTING))
+  {
+    return NULL;
+  }
+  if (0 == m_readyCount)
+  {
+    return NULL;
+  }
+
+  TxQueueElement *e = &m_TxQueue[m_readyHeap[0]];
+  if (TX_QUEUE_PRIORITY_HIGH == e->bTxPriority)
+  {
+    return e;
+  }
+  if (0 != m_waitingCount)
+  {
+    DPRINT("TxQueueServiceTransmit waiting for ack\n");
+    /* TODO - Here we could implement a Global timeout - NO TxElement must be in Waiting for longer than... */
+    return NULL;
   }
-  return bElement;
+  return (TX_QUEUE_PRIORITY_LOW == e->bTxPriority) ? e : NULL;
 }
 
 /*==========================   TxQueueServiceTransmit  ======================
@@ -534,7 +664,7 @@ static uint8_t checkForQueuedWaitingAndLowPriorityPackets(void)
 void
 TxQueueServiceTransmit(void)
 {
-  register uint8_t bElement = 0xFF;         // Invalid TxQueueElement Index.
+  TxQueueElement *e;
 
   DPRINTF("TxQueueServiceTransmit - bTxPriority: %d bTxStatus: %d\n", (NULL == bCurrentTransmit) ? 0 : bCurrentTransmit->bTxPriority, (NULL == bCurrentTransmit) ? 0 : bCurrentTransmit->bTxStatus);
   if (TimerIsActive(&m_TransmitPauseTimer))
@@ -543,32 +673,25 @@ TxQueueServiceTransmit(void)
     return;
   }
 
-  // Regardless of whether we are busy transmitting, handle the newly enqueued DELAYED transmissions in parallel, if any.
-  handleEnqueuedDelayedTransmissions();
-
-  /*
-   * TODO: We should make sure that frames do NOT change place in queue - as we now always
-   * start search for next transmit from index ZERO - we have no in/out pointers...
-   *
-   * IDEA: A simple fix would be to implement an internal sequence number which is generated
-   * when a new TxQueueElement is requested (so that when TxQueueElement are reused the Sequence number
-   * do not change). This Sequence number is then used to select next TxQueueElement to transmit.
-   */
-
-  // HANDLE "HIGH" PRIORITY TRANSMISSIONS !
-  /* Check if we are already transmitting and if not, pick the next HIGH PRIORITY frame in the queue for TX. */
-  bElement = checkForQueuedHighPriorityPackets();
-  if (bElement == 0xFF)
-  {
-    // HANDLE "LOW" PRIORITY TRANSMISSIONS !
-    /* Check if we are already transmitting and if not, pick the next LOW PRIORITY frame in the queue for TX. */
-    bElement = checkForQueuedWaitingAndLowPriorityPackets();
-  }
+  /* Frames of the same priority are sent in the order the elements were allocated,
+   * so that a frame keeps its place in the queue when it is retransmitted. */
+  e = getNextElementToTransmit();
 
   /* Transmit a packet, if any packet were found that is ready for transmission. */
-  if (bElement != 0xFF)
+  if (NULL != e)
   {
-    TxQueueDoTransmit( &m_TxQueue[bElement] , true);
+    if (e->fWaitTimePending)
+    {
+      uint32_t waitTimeMs = getTickTimePassed(e->QueuedTicks);
+      e->fWaitTimePending = false;
+      m_statistics.transmissions++;
+      m_statistics.waitTimeTotalMs += waitTimeMs;
+      if (waitTimeMs > m_statistics.waitTimeMaxMs)
+      {
+        m_statistics.waitTimeMaxMs = waitTimeMs;
+      }
+    }
+    TxQueueDoTransmit(e, true);
     mLbt.startTime = getTickTime();
   }
 }
@@ -608,7 +731,7 @@ TxQueueTxComplete(ZW_Radio_Status_t radioStatus)
     if (bCurrentTransmit->bTxStatus == TX_QUEUE_STATUS_TRANSMITTING)
     {
       DPRINT("Set to TX_QUEUE_STATUS_WAITING\n");
-      bCurrentTransmit->bTxStatus = TX_QUEUE_STATUS_WAITING;
+      txQueueSetStatus(bCurrentTransmit, TX_QUEUE_STATUS_WAITING);
       /* TODO: Global TxQueueElement timeout - sample Global timer tick here. */
       /* Notify the transport layer */
       if (bCurrentTransmit->zcbp_InternalCallback)
@@ -636,7 +759,7 @@ TxQueueTxComplete(ZW_Radio_Status_t radioStatus)
       return;  // Continue with CSMA and do not set the transmission as being done yet.
     }
     ASSERT_PTR(bCurrentTransmit);
-    bCurrentTransmit->bTxStatus = TX_QUEUE_STATUS_FREE;
+    txQueueSetStatus(bCurrentTransmit, TX_QUEUE_STATUS_FREE);
     /* Notify the transport layer */
     if (bCurrentTransmit->zcbp_InternalCallback)
     {
@@ -670,14 +793,7 @@ TxQueueEmptyEvent_Add(
 uint8_t
 TxQueueIsEmpty(void)
 {
-  for (register uint8_t bCount = 0; bCount < TRANSMIT_MAX; bCount++)
-  {
-    if (m_TxQueue[bCount].bTxStatus != TX_QUEUE_STATUS_FREE)
-    {
-      return false;
-    }
-  }
-  return true;
+  return (0 == m_statistics.bUsed);
 }
 
 
@@ -691,14 +807,7 @@ uint8_t
 TxQueueIsIdle(void)
 {
   /* TxQueueIsIdle is called from a non task when starting up. */
-  for (register uint8_t bCount = 0; bCount < TRANSMIT_MAX; bCount++)
-  {
-    if (m_TxQueue[bCount].bTxStatus == TX_QUEUE_STATUS_TRANSMITTING)
-    {
-      return false;
-    }
-  }
-  return true;
+  return (0 == m_transmittingCount);
 }
 
 
@@ -714,7 +823,7 @@ TxQueueReleaseElement(
 {
   /* Free the queue element */
   DPRINTF("TxQueue Release %p\n", pFreeTxElement);
-  pFreeTxElement->bTxStatus = TX_QUEUE_STATUS_FREE;
+  txQueueSetStatus(pFreeTxElement, TX_QUEUE_STATUS_FREE);
   pFreeTxElement->bTxPriority = TX_QUEUE_PRIORITY_UNDEF;
   llReTransmitStop(&pFreeTxElement->frame);
 
@@ -771,13 +880,15 @@ TxQueueQueueElement(
     // This will overflow and it is intentional!
     pNewTxElement->delayedTx.delayedTxMs += getTickTime();  // getTickTime() must always return uint32_t!
 
-    // Explicitly set the TX_QUEUE_STATUS_DELAYED_TX flag in the TxQueueElement.
-    pNewTxElement->bTxStatus = TX_QUEUE_STATUS_DELAYED_TX;
+    // Insert the element in the delayed transmission list, which (re)starts the delayed TX timer if needed.
+    txQueueSetStatus(pNewTxElement, TX_QUEUE_STATUS_DELAYED_TX_WAIT);
   }
   else
   {
     /* Set the element ready to send */
-    pNewTxElement->bTxStatus = TX_QUEUE_STATUS_READY_TO_SEND;
+    pNewTxElement->QueuedTicks = getTickTime();
+    pNewTxElement->fWaitTimePending = true;
+    txQueueSetStatus(pNewTxElement, TX_QUEUE_STATUS_READY_TO_SEND);
   }
 
   pNewTxElement->bTransmitRouteCount++;
@@ -821,27 +932,25 @@ static void ZCB_TransmitPauseTimerTimeout(__attribute__((unused)) SSwTimer* pTim
 **    Side effects:
 **
 **--------------------------------------------------------------------------*/
-static void ZCB_DelayedTxTimerTimeout(SSwTimer* pTimer)
+static void ZCB_DelayedTxTimerTimeout(__attribute__((unused)) SSwTimer* pTimer)
 {
   DPRINT("ZCB_DelayedTxTimerTimeout() \n");
 
-  TxQueueElement *txQueueElem = pTimer->ptr;
-
-  // Clear the timer's pointer to txQueueElement so that it appears not in use.
-  pTimer->ptr = NULL;
-
-  /* Clear the Delayed transmission flag to disable all branches and ASSERTs related to delayed transmission in
-   * TxQueueQueueElement(). */
-  TxQueueClearOptionFlags(txQueueElem, TRANSMIT_OPTION_DELAYED_TX);
-
-  // Indicate to the module that an additional delayed transmissions are accepted.
-  m_delayedTxCount--;
-  ASSERT(m_delayedTxCount != 255);     // Just checking to see if we ever decrement a 0.
+  // Release every delayed transmission whose deadline has been reached, earliest first.
+  while ((TX_QUEUE_INDEX_NONE != m_delayedTxHead)
+         && ((int32_t)(m_TxQueue[m_delayedTxHead].delayedTx.delayedTxMs - getTickTime()) <= 0))
+  {
+    TxQueueElement *txQueueElem = &m_TxQueue[m_delayedTxHead];
 
-  TxQueueQueueElement(txQueueElem);    // Re-enqueue the element, which will set the STATUS to ready to send.
+    /* Clear the Delayed transmission flag to disable all branches and ASSERTs related to delayed transmission in
+     * TxQueueQueueElement(). */
+    TxQueueClearOptionFlags(txQueueElem, TRANSMIT_OPTION_DELAYED_TX);
 
-  // The state machine (TxQueueServiceTransmit()) will be run by TxQueueQueueElement().
-  // If there is any need, this timer will be re-started.
+    // Re-enqueue the element, which will set the STATUS to ready to send and remove it from the delayed list.
+    // The state machine (TxQueueServiceTransmit()) will be run by TxQueueQueueElement().
+    TxQueueQueueElement(txQueueElem);
+  }
+  // The timer has been restarted for the next delayed transmission, if any.
 }
 
 bool
@@ -910,7 +1019,7 @@ TxQueueTxBeamComplete(void)
   {
     if (bCurrentTransmit->bTxStatus == TX_QUEUE_STATUS_TRANSMITTING)
     {
-      bCurrentTransmit->bTxStatus = TX_QUEUE_STATUS_READY_TO_SEND;
+      txQueueSetStatus(bCurrentTransmit, TX_QUEUE_STATUS_READY_TO_SEND);
     }
     beam_fragment_count--;
 
@@ -930,6 +1039,21 @@ TxQueueTxBeamComplete(void)
   }
 }
 
+void TxQueueGetStatistics(TxQueue_Statistics_t *pStatistics)
+{
+  *pStatistics = m_statistics;
+}
+
+void TxQueueClearStatistics(void)
+{
+  uint8_t bUsed = m_statistics.bUsed;
+
+  memset(&m_statistics, 0, sizeof(m_statistics));
+  m_statistics.bUsed = bUsed;
+  m_statistics.bUsedPeak = bUsed;
+  m_statistics.bDelayedPeak = m_delayedTxCount;
+}
+
 /**
  * Get the bFrameOptions value of pElement
  * @param pElement Pointer to a TxQueueElement element
@@ -25,7 +25,9 @@
 /****************************************************************************/
 
 /* Z-Wave internal transmit options */
-#define TRANSMIT_MAX                            4     /* max. number of frames in the transmit queue */
+#ifndef TRANSMIT_MAX
+#define TRANSMIT_MAX                            4     /* max. number of frames in the transmit queue (3..254) */
+#endif
 #define TRANSMIT_OPTION_DELAYED_MAX_MS          1000  /* [ms] The maximum acceptable delay. */
 
 #define BEAM_TRAIN_DURATION_MS      3000
@@ -89,6 +91,11 @@ typedef struct _TxQueueElement_
   uint32_t StartTicks;
   uint8_t forceLR;
   DelayedTx_t delayedTx;         /* Data related to delayed transmission. */
+  uint16_t wSequenceNumber;      /* Allocation order. Frames of the same priority are sent in this order. */
+  uint8_t bHeapPosition;         /* Position in the heap of frames ready to send plus one, 0 if not ready. */
+  uint8_t bNextDelayed;          /* Index of the next element in the delayed transmission list. */
+  bool fWaitTimePending;         /* The time since QueuedTicks is not yet counted in the statistics. */
+  uint32_t QueuedTicks;          /* Tick time at which the frame was made ready to send. */
   // New section begins.
   ZW_TransmissionFrame_t frame;
   // Allocate portion of memory for the payload contents (ZW_TransmissionFrame_t includes payload of 8 bytes)
@@ -138,6 +145,22 @@ typedef enum {
 /* TODO: Check for exact starting addresses of TxQueue, not just NULL pointer */
 #define IS_TXQ_POINTER(p) (NULL != (p))
 
+/**
+ * Statistics of the transmit queue. @see TxQueueGetStatistics
+ */
+typedef struct
+{
+  uint8_t  bUsed;           ///< Number of elements currently in use.
+  uint8_t  bUsedPeak;       ///< Highest number of elements in use at the same time.
+  uint8_t  bDelayedPeak;    ///< Highest number of delayed transmissions waiting at the same time.
+  uint32_t allocations;     ///< Number of elements handed out by TxQueueGetFreeElement().
+  uint32_t drops;           ///< Number of TxQueueGetFreeElement() calls that returned NULL.
+  uint32_t delayedDrops;    ///< Part of drops caused by the limit of delayed transmissions.
+  uint32_t transmissions;   ///< Number of frames taken from the queue for transmission.
+  uint32_t waitTimeTotalMs; ///< [ms] Total time frames were ready to send before being transmitted.
+  uint32_t waitTimeMaxMs;   ///< [ms] Longest time a frame was ready to send before being transmitted.
+} TxQueue_Statistics_t;
+
 struct sTxQueueEmptyEvent
 {
   struct sTxQueueEmptyEvent *next;
@@ -268,6 +291,18 @@ void TxQueueTxBeamComplete(void);
  */
 bool TxQueueBeamACKReceived(node_id_t source_node, node_id_t destination_node);
 
+/**
+ * Get the statistics of the transmit queue.
+ * @param pStatistics Returns the statistics collected since TxQueueInit() or
+ *                    TxQueueClearStatistics().
+ */
+void TxQueueGetStatistics(TxQueue_Statistics_t *pStatistics);
+
+/**
+ * Clear the statistics of the transmit queue. The current use is kept.
+ */
+void TxQueueClearStatistics(void);
+
 /**
  * Get the bFrameOptions value of pElement
  * @param pElement Pointer to a TxQueueElement element